@@ -0,0 +1,204 @@
+/*
+*******************************************************************************
+\file batch.c
+\brief Run a sequence of commands in one process
+\project bee2/cmd 
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "../cmd.h"
+#include <bee2/core/err.h>
+#include <bee2/core/str.h>
+#include <bee2/core/util.h>
+#include <stdio.h>
+
+/*
+*******************************************************************************
+Утилита batch
+
+Функционал:
+- выполнение последовательности команд bee2cmd в одном процессе.
+
+Команды читаются из файла сценария или, если файл не задан или задан
+как "-", из стандартного потока ввода. Каждая строка сценария содержит
+одну команду в том виде, в котором она задается в командной строке
+после bee2cmd (префикс bee2cmd допускается). Строка разбирается
+функцией cmdArgCreate(). Пустые строки и строки, которые начинаются
+с символа '#', пропускаются.
+
+Во время выполнения сценария включен режим кэширования (см. cmd.h):
+личные ключи снимаются с защиты, цепочки сертификатов проверяются, ГСЧ
+запускается только один раз. Кроме этого, однократно выполняется
+самотестирование в утилитах.
+
+По умолчанию выполнение сценария продолжается после ошибки в очередной
+команде. Опция -e прекращает выполнение сценария при первой ошибке.
+
+\warning Если команды читаются из стандартного потока, то данные,
+которые команды запрашивают с консоли (например, пароли), также будут
+прочитаны из этого потока. Пароли в сценариях следует задавать явно
+(pass:, env:, share:).
+
+Примеры:
+  bee2cmd batch script
+  bee2cmd batch -e script
+  bee2cmd batch < script
+*******************************************************************************
+*/
+
+static const char _name[] = "batch";
+static const char _descr[] = "run a sequence of commands in one process";
+
+static int batchUsage()
+{
+	printf(
+		"bee2cmd/%s: %s\n"
+		"Usage:\n"
+		"  batch [-e] [<script>]\n"
+		"    run commands listed in <script> (one command per line)\n"
+		"  options:\n"
+		"    -e -- stop at the first failed command\n"
+		"  \\remark if <script> is omitted or is \"-\", stdin is used\n"
+		"  \\remark lines starting with '#' are ignored\n"
+		,
+		_name, _descr
+	);
+	return -1;
+}
+
+/*
+*******************************************************************************
+Выполнение сценария
+*******************************************************************************
+*/
+
+static err_t batchRun(FILE* fp, bool_t stop)
+{
+	err_t code = ERR_OK;
+	char line[4096];
+	size_t line_len;
+	size_t all_lines = 0;
+	size_t all_cmds = 0;
+	size_t bad_cmds = 0;
+	int argc;
+	char** argv;
+	// цикл по строкам
+	cmdCacheOn();
+	while (fgets(line, sizeof(line), fp))
+	{
+		char* cmd = line;
+		++all_lines;
+		// слишком длинная строка?
+		line_len = strLen(line);
+		if (line_len + 1 == sizeof(line) && line[line_len - 1] != '\n')
+		{
+			fprintf(stderr, "bee2cmd/%s: line %lu is too long\n", _name,
+				(unsigned long)all_lines);
+			code = ERR_CMD_PARAMS;
+			break;
+		}
+		// удалить завершающие символы перевода строки
+		while (line_len && (line[line_len - 1] == '\n' ||
+			line[line_len - 1] == '\r'))
+			line[--line_len] = 0;
+		// пропустить пробелы, пустые строки и комментарии
+		while (*cmd == ' ' || *cmd == '\t')
+			++cmd;
+		if (!*cmd || *cmd == '#')
+			continue;
+		// разобрать строку
+		code = cmdArgCreate(&argc, &argv, cmd);
+		if (code == ERR_OK && argc == 0)
+			continue;
+		++all_cmds;
+		// выполнить команду
+		if (code != ERR_OK)
+			fprintf(stderr, "bee2cmd/%s: line %lu: %s\n", _name,
+				(unsigned long)all_lines, errMsg(code));
+		else
+		{
+			char** args = argv;
+			int count = argc;
+			if (count > 1 && strEq(args[0], "bee2cmd"))
+				++args, --count;
+			if (strEq(args[0], _name))
+				code = ERR_CMD_PARAMS;
+			else if (cmdRun(count, args) != 0)
+				code = ERR_CMD_PARAMS;
+			cmdArgClose(argv);
+			fflush(stdout);
+		}
+		// ошибка?
+		if (code != ERR_OK)
+		{
+			++bad_cmds;
+			fprintf(stderr, "bee2cmd/%s: line %lu: command failed\n", _name,
+				(unsigned long)all_lines);
+			if (stop)
+				break;
+			code = ERR_OK;
+		}
+	}
+	if (code == ERR_OK && ferror(fp))
+		code = ERR_FILE_READ;
+	cmdCacheClose();
+	// итоги
+	if (bad_cmds)
+		fprintf(stderr, bad_cmds == 1 ?
+			"WARNING: %lu command (out of %lu) failed\n" :
+			"WARNING: %lu commands (out of %lu) failed\n",
+			(unsigned long)bad_cmds, (unsigned long)all_cmds);
+	if (code == ERR_OK && bad_cmds)
+		code = ERR_CMD_PARAMS;
+	return code;
+}
+
+/*
+*******************************************************************************
+Главная функция
+*******************************************************************************
+*/
+
+int batchMain(int argc, char* argv[])
+{
+	err_t code;
+	bool_t stop = FALSE;
+	FILE* fp;
+	// разбор опций
+	++argv, --argc;
+	if (argc && strEq(argv[0], "-e"))
+		stop = TRUE, ++argv, --argc;
+	if (argc > 1 || argc && strStartsWith(argv[0], "-") && 
+		!strEq(argv[0], "-"))
+		return batchUsage();
+	// открыть сценарий
+	if (argc == 0 || strEq(argv[0], "-"))
+		fp = stdin;
+	else if (!(fp = fopen(argv[0], "r")))
+	{
+		fprintf(stderr, "bee2cmd/%s: %s\n", _name, errMsg(ERR_FILE_OPEN));
+		return -1;
+	}
+	// выполнить сценарий
+	code = batchRun(fp, stop);
+	if (fp != stdin)
+		fclose(fp);
+	if (code != ERR_OK && code != ERR_CMD_PARAMS)
+		fprintf(stderr, "bee2cmd/%s: %s\n", _name, errMsg(code));
+	return code != ERR_OK ? -1 : 0;
+}
+
+/*
+*******************************************************************************
+Инициализация
+*******************************************************************************
+*/
+
+err_t batchInit()
+{
+	return cmdReg(_name, _descr, batchMain);
+}
@@ -0,0 +1,539 @@
+/*
+*******************************************************************************
+\file bee2d.c
+\brief Signing daemon
+\project bee2/cmd
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "../cmd.h"
+#include <bee2/core/blob.h>
+#include <bee2/core/dec.h>
+#include <bee2/core/err.h>
+#include <bee2/core/mem.h>
+#include <bee2/core/mt.h>
+#include <bee2/core/rng.h>
+#include <bee2/core/str.h>
+#include <bee2/core/tm.h>
+#include <bee2/core/util.h>
+#include <bee2/crypto/bign.h>
+#include <bee2/crypto/job.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/socket.h>
+
+/*
+*******************************************************************************
+Утилита bee2d
+
+Функционал:
+- загрузка личного ключа bign из контейнера;
+- обслуживание запросов на выработку и проверку подписи
+  через локальный сокет;
+- статистика обслуживания.
+
+Личный ключ снимается с защиты один раз при запуске. Запросы принимаются
+в формате, описанном в cmd.h (раздел "Демон подписи"). Каждое соединение
+обслуживается отдельным потоком. Потоки соединений передают операции
+с ключом в обработчик заданий (см. job.h), который объединяет одновременные
+запросы в пакеты.
+
+Пример:
+  bee2d run -j 2 -pass pass:alice privkey2 /tmp/bee2d.sock &
+  bee2cmd sig sign -daemon /tmp/bee2d.sock -certs "cert0 cert1 cert2" \
+    file sig_file
+  bee2d stat /tmp/bee2d.sock
+  bee2d stop /tmp/bee2d.sock
+*******************************************************************************
+*/
+
+static const char _name[] = "bee2d";
+static const char _descr[] = "signing daemon";
+
+/*
+*******************************************************************************
+Справка по использованию
+*******************************************************************************
+*/
+
+static int bee2dUsage()
+{
+	printf(
+		"%s: %s\n"
+		"Usage:\n"
+		"  bee2d run [-j <n>] [-b <n>] -pass <schema> <privkey> <socket>\n"
+		"    serve signing requests using <privkey> on <socket>\n"
+		"      -j <n> -- number of signing threads (1 <= <n> <= 64)\n"
+		"      -b <n> -- maximum batch size (1 <= <n> <= 64)\n"
+		"      -pass <schema> -- password description\n"
+		"  bee2d stat <socket>\n"
+		"    print statistics of the daemon listening on <socket>\n"
+		"  bee2d stop <socket>\n"
+		"    stop the daemon listening on <socket>\n"
+		"  .\n"
+		"  <privkey>\n"
+		"    container with a bign private key (32, 48 or 64 octets)\n"
+		"  <socket>\n"
+		"    path to a Unix domain socket\n"
+		,
+		_name, _descr
+	);
+	return -1;
+}
+
+/*
+*******************************************************************************
+Состояние демона
+
+Счетчики изменяются атомарно и читаются функцией bee2dLoad().
+*******************************************************************************
+*/
+
+#define BEE2D_SLOTS		64		/*< максимальное число соединений */
+#define BEE2D_TIMEOUT	200		/*< период проверки завершения (мс) */
+
+#define BEE2D_FREE		0		/*< слот свободен */
+#define BEE2D_BUSY		1		/*< соединение обслуживается */
+#define BEE2D_DONE		2		/*< соединение обслужено */
+
+typedef struct bee2d_st bee2d_st;
+
+typedef struct
+{
+	size_t state;			/*< состояние слота (BEE2D_XXX) */
+	int conn;				/*< сокет соединения */
+	mt_thrd_t thrd;			/*< поток соединения */
+	bee2d_st* d;			/*< состояние демона */
+} bee2d_slot_st;
+
+struct bee2d_st
+{
+	bign_params params[1];	/*< долговременные параметры */
+	octet oid_der[16];		/*< идентификатор хэш-алгоритма */
+	size_t oid_len;			/*< длина oid_der */
+	octet privkey[64];		/*< личный ключ */
+	size_t privkey_len;		/*< длина личного ключа */
+	octet pubkey[128];		/*< открытый ключ */
+	bool_t rng;				/*< использовать ГСЧ? */
+	job_engine_t* engine;	/*< обработчик заданий */
+	tm_time_t start;		/*< время запуска */
+	size_t stop;			/*< запрос на завершение */
+	size_t conns;			/*< число соединений */
+	size_t reqs;			/*< число запросов */
+	size_t signs;			/*< число подписей */
+	size_t verifies;		/*< число проверок */
+	size_t errors;			/*< число ошибок */
+	bee2d_slot_st slots[BEE2D_SLOTS];	/*< слоты соединений */
+};
+
+static volatile sig_atomic_t _signaled;	/*< получен сигнал завершения */
+
+static void bee2dSignal(int sig)
+{
+	_signaled = 1;
+}
+
+static size_t bee2dLoad(size_t* ctr)
+{
+	return mtAtomicCmpSwap(ctr, 0, 0);
+}
+
+/*
+*******************************************************************************
+Обработка запросов
+
+Функция bee2dHandle() обрабатывает запрос [req_len]req и формирует
+результат [resp_len]resp (без кода ошибки).
+*******************************************************************************
+*/
+
+static err_t bee2dHandle(octet resp[], size_t* resp_len, bee2d_st* d,
+	const octet req[], size_t req_len)
+{
+	const size_t l = d->privkey_len;
+	err_t code;
+	job_t job[1];
+	octet t[64];
+	// пустой запрос?
+	if (req_len == 0)
+		return ERR_BAD_FORMAT;
+	*resp_len = 0;
+	// обработать
+	switch (req[0])
+	{
+	case CMD_DAEMON_INFO:
+		if (req_len != 1)
+			return ERR_BAD_FORMAT;
+		memCopy(resp, d->pubkey, *resp_len = 2 * l);
+		return ERR_OK;
+	case CMD_DAEMON_SIGN:
+		if (req_len != 1 + l)
+			return ERR_BAD_FORMAT;
+		memSetZero(job, sizeof(job_t));
+		job->type = JOB_BIGN_SIGN;
+		job->params = d->params;
+		job->oid_der = d->oid_der, job->oid_len = d->oid_len;
+		job->hash = req + 1;
+		job->privkey = d->privkey;
+		job->sig = resp;
+		if (d->rng)
+			rngStepR(t, l, 0), job->src1 = t, job->count1 = l;
+		code = jobSubmit(d->engine, job);
+		if (code == ERR_OK && (code = jobWait(d->engine, job)) == ERR_OK)
+			*resp_len = l / 2 * 3;
+		memWipe(t, sizeof(t));
+		mtAtomicIncr(&d->signs);
+		return code;
+	case CMD_DAEMON_VERIFY:
+		if (req_len != 1 + l + l / 2 * 3 && req_len != 1 + l + l / 2 * 7)
+			return ERR_BAD_FORMAT;
+		memSetZero(job, sizeof(job_t));
+		job->type = JOB_BIGN_VERIFY;
+		job->params = d->params;
+		job->oid_der = d->oid_der, job->oid_len = d->oid_len;
+		job->hash = req + 1;
+		job->sig = (octet*)req + 1 + l;
+		job->pubkey = req_len == 1 + l + l / 2 * 3 ?
+			d->pubkey : req + 1 + l + l / 2 * 3;
+		code = jobSubmit(d->engine, job);
+		if (code == ERR_OK)
+			code = jobWait(d->engine, job);
+		mtAtomicIncr(&d->verifies);
+		return code;
+	case CMD_DAEMON_STAT:
+	{
+		job_stat_t stat[1];
+		if (req_len != 1)
+			return ERR_BAD_FORMAT;
+		jobEngineStat(stat, d->engine);
+		sprintf((char*)resp, "conns=%lu reqs=%lu signs=%lu verifies=%lu "
+			"errors=%lu jobs=%lu batches=%lu uptime=%lu",
+			(unsigned long)bee2dLoad(&d->conns),
+			(unsigned long)bee2dLoad(&d->reqs),
+			(unsigned long)bee2dLoad(&d->signs),
+			(unsigned long)bee2dLoad(&d->verifies),
+			(unsigned long)bee2dLoad(&d->errors),
+			(unsigned long)stat->jobs, (unsigned long)stat->batches,
+			(unsigned long)(tmTime() - d->start));
+		*resp_len = strLen((char*)resp);
+		return ERR_OK;
+	}
+	case CMD_DAEMON_STOP:
+		if (req_len != 1)
+			return ERR_BAD_FORMAT;
+		mtAtomicCmpSwap(&d->stop, 0, 1);
+		return ERR_OK;
+	}
+	return ERR_NOT_IMPLEMENTED;
+}
+
+/*
+*******************************************************************************
+Обслуживание соединения
+
+Запросы соединения обрабатываются до его закрытия клиентом или до ошибки
+обмена сообщениями. Сокет закрывается основным потоком.
+*******************************************************************************
+*/
+
+static void bee2dConn(void* arg)
+{
+	bee2d_slot_st* slot = (bee2d_slot_st*)arg;
+	bee2d_st* d = slot->d;
+	octet req[CMD_DAEMON_MSG_MAX];
+	octet resp[CMD_DAEMON_MSG_MAX];
+	size_t req_len;
+	size_t resp_len;
+	err_t code;
+	while (cmdDaemonRecv(req, &req_len, slot->conn) == ERR_OK)
+	{
+		mtAtomicIncr(&d->reqs);
+		code = bee2dHandle(resp + 4, &resp_len, d, req, req_len);
+		if (code != ERR_OK)
+			mtAtomicIncr(&d->errors), resp_len = 0;
+		resp[0] = (octet)(code >> 24), resp[1] = (octet)(code >> 16);
+		resp[2] = (octet)(code >> 8), resp[3] = (octet)code;
+		code = cmdDaemonSend(slot->conn, resp, 4 + resp_len);
+		memWipe(resp, sizeof(resp));
+		if (code != ERR_OK)
+			break;
+	}
+	mtAtomicCmpSwap(&slot->state, BEE2D_BUSY, BEE2D_DONE);
+}
+
+/*
+*******************************************************************************
+Цикл обслуживания
+
+Основной поток принимает соединения и назначает им свободные слоты.
+Каждые BEE2D_TIMEOUT мс основной поток проверяет запрос на завершение
+и освобождает слоты обслуженных соединений. При завершении соединения,
+которые еще обслуживаются, принудительно закрываются.
+*******************************************************************************
+*/
+
+static void bee2dReap(bee2d_st* d, bool_t all)
+{
+	size_t pos;
+	for (pos = 0; pos < BEE2D_SLOTS; ++pos)
+	{
+		bee2d_slot_st* slot = d->slots + pos;
+		size_t state = bee2dLoad(&slot->state);
+		if (all && state == BEE2D_BUSY)
+			shutdown(slot->conn, SHUT_RDWR);
+		if (state == BEE2D_DONE || all && state != BEE2D_FREE)
+		{
+			mtThrdJoin(&slot->thrd);
+			cmdDaemonClose(slot->conn, 0);
+			slot->state = BEE2D_FREE;
+		}
+	}
+}
+
+static err_t bee2dServe(bee2d_st* d, const char* socket)
+{
+	err_t code;
+	int sock;
+	int conn;
+	size_t pos;
+	// слушать
+	code = cmdDaemonListen(&sock, socket);
+	ERR_CALL_CHECK(code);
+	signal(SIGPIPE, SIG_IGN);
+	signal(SIGINT, bee2dSignal);
+	signal(SIGTERM, bee2dSignal);
+	printf("%s: listening on %s\n", _name, socket);
+	fflush(stdout);
+	// обслуживать
+	while (!_signaled && !bee2dLoad(&d->stop))
+	{
+		code = cmdDaemonAccept(&conn, sock, BEE2D_TIMEOUT);
+		if (code != ERR_OK)
+			break;
+		bee2dReap(d, FALSE);
+		if (conn < 0)
+			continue;
+		mtAtomicIncr(&d->conns);
+		// найти свободный слот
+		for (pos = 0; pos < BEE2D_SLOTS; ++pos)
+			if (bee2dLoad(&d->slots[pos].state) == BEE2D_FREE)
+				break;
+		// запустить поток соединения
+		if (pos < BEE2D_SLOTS)
+		{
+			bee2d_slot_st* slot = d->slots + pos;
+			slot->conn = conn, slot->d = d;
+			slot->state = BEE2D_BUSY;
+			if (mtThrdCreate(&slot->thrd, bee2dConn, slot))
+				continue;
+			slot->state = BEE2D_FREE;
+		}
+		mtAtomicIncr(&d->errors);
+		cmdDaemonClose(conn, 0);
+	}
+	// завершить
+	bee2dReap(d, TRUE);
+	cmdDaemonClose(sock, socket);
+	return code;
+}
+
+/*
+*******************************************************************************
+Запуск
+
+bee2d run [-j <n>] [-b <n>] -pass <schema> <privkey> <socket>
+*******************************************************************************
+*/
+
+static err_t bee2dNum(size_t* num, int* argc, char** argv[])
+{
+	const char* str = **argv + 2;
+	if (!*str && *argc > 1)
+		str = (*argv)[1], --*argc, ++*argv;
+	if (!decIsValid(str) || !strLen(str) || strLen(str) > 2 ||
+		decCLZ(str) || (*num = (size_t)decToU32(str)) == 0 ||
+		*num > CMD_THREADS_MAX)
+		return ERR_CMD_PARAMS;
+	--*argc, ++*argv;
+	return ERR_OK;
+}
+
+static err_t bee2dParamsStd(bee2d_st* d)
+{
+	err_t code;
+	switch (d->privkey_len)
+	{
+	case 32:
+		code = bignParamsStd(d->params, "1.2.112.0.2.0.34.101.45.3.1");
+		ERR_CALL_CHECK(code);
+		d->oid_len = sizeof(d->oid_der);
+		return bignOidToDER(d->oid_der, &d->oid_len,
+			"1.2.112.0.2.0.34.101.31.81");
+	case 48:
+		code = bignParamsStd(d->params, "1.2.112.0.2.0.34.101.45.3.2");
+		ERR_CALL_CHECK(code);
+		d->oid_len = sizeof(d->oid_der);
+		return bignOidToDER(d->oid_der, &d->oid_len,
+			"1.2.112.0.2.0.34.101.77.12");
+	case 64:
+		code = bignParamsStd(d->params, "1.2.112.0.2.0.34.101.45.3.3");
+		ERR_CALL_CHECK(code);
+		d->oid_len = sizeof(d->oid_der);
+		return bignOidToDER(d->oid_der, &d->oid_len,
+			"1.2.112.0.2.0.34.101.77.13");
+	}
+	return ERR_NOT_IMPLEMENTED;
+}
+
+static err_t bee2dRun(int argc, char* argv[])
+{
+	err_t code = ERR_OK;
+	size_t threads = 0;
+	size_t batch = 0;
+	cmd_pwd_t pwd = 0;
+	bee2d_st* d;
+	// разобрать опции
+	while (argc && strStartsWith(*argv, "-"))
+	{
+		if (strStartsWith(*argv, "-j"))
+		{
+			if (threads)
+			{
+				code = ERR_CMD_DUPLICATE;
+				break;
+			}
+			code = bee2dNum(&threads, &argc, &argv);
+			if (code != ERR_OK)
+				break;
+		}
+		else if (strStartsWith(*argv, "-b"))
+		{
+			if (batch)
+			{
+				code = ERR_CMD_DUPLICATE;
+				break;
+			}
+			code = bee2dNum(&batch, &argc, &argv);
+			if (code != ERR_OK)
+				break;
+		}
+		else if (strEq(*argv, "-pass") && argc > 1)
+		{
+			if (pwd)
+			{
+				code = ERR_CMD_DUPLICATE;
+				break;
+			}
+			code = cmdPwdRead(&pwd, argv[1]);
+			if (code != ERR_OK)
+				break;
+			argc -= 2, argv += 2;
+		}
+		else
+		{
+			code = ERR_CMD_PARAMS;
+			break;
+		}
+	}
+	if (code == ERR_OK && (!pwd || argc != 2))
+		code = ERR_CMD_PARAMS;
+	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
+	// проверить наличие <privkey> и отсутствие <socket>
+	code = cmdFileValExist(1, argv);
+	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
+	// создать состояние
+	code = cmdBlobCreate(d, sizeof(bee2d_st));
+	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
+	// прочитать личный ключ
+	d->privkey_len = 0;
+	code = cmdPrivkeyRead(0, &d->privkey_len, argv[0], pwd);
+	if (code == ERR_OK)
+		code = d->privkey_len <= sizeof(d->privkey) ? ERR_OK :
+			ERR_BAD_PRIVKEY;
+	if (code == ERR_OK)
+		code = cmdPrivkeyRead(d->privkey, 0, argv[0], pwd);
+	cmdPwdClose(pwd);
+	ERR_CALL_HANDLE(code, cmdBlobClose(d));
+	// загрузить параметры и вычислить открытый ключ
+	code = bee2dParamsStd(d);
+	ERR_CALL_HANDLE(code, cmdBlobClose(d));
+	code = bignPubkeyCalc(d->pubkey, d->params, d->privkey);
+	ERR_CALL_HANDLE(code, cmdBlobClose(d));
+	// запустить ГСЧ (без клавиатурного источника)
+	d->rng = rngESHealth() == ERR_OK && rngCreate2(0, 0, 0) == ERR_OK;
+	// создать обработчик
+	d->engine = jobEngineCreate(threads, batch);
+	if (d->engine)
+	{
+		// обслуживать
+		d->start = tmTime();
+		code = bee2dServe(d, argv[1]);
+		jobEngineClose(d->engine);
+	}
+	else
+		code = ERR_OUTOFMEMORY;
+	// завершить
+	if (d->rng)
+		rngClose();
+	cmdBlobClose(d);
+	return code;
+}
+
+/*
+*******************************************************************************
+Управление
+
+bee2d {stat|stop} <socket>
+*******************************************************************************
+*/
+
+static err_t bee2dCtl(octet op, const char* socket)
+{
+	err_t code;
+	int sock;
+	char resp[CMD_DAEMON_MSG_MAX + 1];
+	size_t resp_len;
+	// соединиться
+	code = cmdDaemonConnect(&sock, socket);
+	ERR_CALL_CHECK(code);
+	// выполнить запрос
+	code = cmdDaemonCall(resp, &resp_len, sock, op, 0, 0);
+	cmdDaemonClose(sock, 0);
+	ERR_CALL_CHECK(code);
+	// печатать статистику
+	if (op == CMD_DAEMON_STAT)
+		resp[resp_len] = 0, printf("%s\n", resp);
+	return code;
+}
+
+/*
+*******************************************************************************
+Главная функция
+*******************************************************************************
+*/
+
+int main(int argc, char* argv[])
+{
+	err_t code;
+	// справка
+	if (argc < 2)
+		return bee2dUsage();
+	// разбор команды
+	--argc, ++argv;
+	if (strEq(argv[0], "run"))
+		code = bee2dRun(argc - 1, argv + 1);
+	else if (strEq(argv[0], "stat") && argc == 2)
+		code = bee2dCtl(CMD_DAEMON_STAT, argv[1]);
+	else if (strEq(argv[0], "stop") && argc == 2)
+		code = bee2dCtl(CMD_DAEMON_STOP, argv[1]);
+	else
+		code = ERR_CMD_PARAMS;
+	// завершить
+	if (code != ERR_OK)
+		printf("%s: %s\n", _name, errMsg(code));
+	return code != ERR_OK ? -1 : 0;
+}
@@ -4,7 +4,7 @@
 \brief Hash files using belt-hash / bash-hash
 \project bee2/cmd 
 \created 2014.10.28
-\version 2024.01.22
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -30,15 +30,29 @@
 
 Функционал:
 - хэширование файлов с помощью алгоритмов СТБ 34.101.31 и СТБ 34.101.77;
-- проверка хэш-значений.
+- проверка хэш-значений;
+- параллельная обработка нескольких файлов.
 
 Поддержаны следующие алгоритмы хэширования:
 - belt-hash (СТБ 34.101.31);
 - bash32, bash64, ..., bash512 (СТБ 34.101.77);
-- bash-prg-hashNNND (СТБ 34.101.77), где NNN in {256, 384, 512}, D in {1, 2}.
+- bash-prg-hashNNND (СТБ 34.101.77), где NNN in {256, 384, 512}, D in {1, 2};
+- belt-tree, bash-treeNNN, где NNN in {256, 384, 512}.
 
 \remark В алгоритмах bash-prg-hashNNND используется пустой анонс (annonce, фр.).
 
+В алгоритмах belt-tree и bash-treeNNN файл хэшируется по дереву Меркла
+(см. cmdTreeFile()) с листьями длины BSUM_TREE_LEAF с помощью belt-hash
+и bashNNN соответственно. Хэш-значения не совпадают с хэш-значениями
+belt-hash и bashNNN (за счет разделения доменов). Листья одного файла
+хэшируются в N потоках, заданных опцией -j, а файлы обрабатываются
+последовательно.
+
+Опция -j N задает число потоков, в которых хэшируются файлы (1 <= N <= 64,
+по умолчанию 1). Хэш-значения и результаты проверки выводятся в порядке
+следования файлов в командной строке или в файле хэш-значений независимо
+от числа потоков.
+
 Хэш-значения выводятся в формате
 ```
 	hex(хэш_значение_файла) имя_файла
@@ -53,6 +67,8 @@
 	bee2cmd bsum file1 file2 file3
 	bee2cmd bsum -belt-hash file1 file2 file3 > checksum
 	bee2cmd bsum -c checksum
+	bee2cmd bsum -j 4 -c checksum
+	bee2cmd bsum -bash-tree256 -j 4 file1 file2 > checksum
 	bee2cmd bsum -- -c
 
 Обратим внимание на последнюю команду. В ней лексема "--" означает окончание
@@ -74,14 +90,18 @@ static int bsumUsage()
 	printf(
 		"bee2cmd/%s: %s\n"
 		"Usage:\n" 
-		"  bsum [hash_alg] <file_to_hash> <file_to_hash> ...\n"
-		"  bsum [hash_alg] -c <checksum_file>\n"
+		"  bsum [hash_alg] [-j N] <file_to_hash> <file_to_hash> ...\n"
+		"  bsum [hash_alg] [-j N] -c <checksum_file>\n"
 		"  hash_alg:\n" 
 		"    -belt-hash (STB 34.101.31), by default\n"
 		"    -bash32, -bash64, ..., -bash512 (STB 34.101.77)\n"
 		"    -bash-prg-hashNNND (STB 34.101.77)\n"
 		"      with NNN in {256, 384, 512}, D in {1, 2}\n"
 		"      \\note annonce = NULL\n"
+		"    -belt-tree, -bash-treeNNN (Merkle tree, 256 KB leaves)\n"
+		"      with NNN in {256, 384, 512}\n"
+		"  -j N\n"
+		"    hash files in N threads (1 <= N <= 64), 1 by default\n"
 		"  \\remark use \"--\" to stop parsing options"
 		,
 		_name, _descr
@@ -96,12 +116,20 @@ static int bsumUsage()
 Идентификатор хэш-алгоритма (hid), заданного в командной строке:
 *	0 -- belt-hash;
 *	32, 64, ..., 512 -- bash32, bash64, ..., bash512;
-*	NNND  -- bash-prg-hashNNND (NNN in {256, 384, 512}, D in {1, 2}).
+*	NNND  -- bash-prg-hashNNND (NNN in {256, 384, 512}, D in {1, 2});
+*	BSUM_HID_TREE -- belt-tree;
+*	BSUM_HID_TREE + NNN -- bash-treeNNN (NNN in {256, 384, 512}).
 *******************************************************************************
 */
 
+#define BSUM_HID_TREE 10000
+#define BSUM_TREE_LEAF (256 * 1024)
+
 static bool_t bsumHidIsValid(size_t hid)
 {
+	if (hid >= BSUM_HID_TREE)
+		return hid == BSUM_HID_TREE || hid == BSUM_HID_TREE + 256 ||
+			hid == BSUM_HID_TREE + 384 || hid == BSUM_HID_TREE + 512;
 	return hid == 0 ||
 		(hid <= 512 && hid % 32 == 0) ||
 		(hid % 10 != 0 && hid % 10 <= 2 &&
@@ -111,31 +139,107 @@ static bool_t bsumHidIsValid(size_t hid)
 static size_t bsumHidHashLen(size_t hid)
 {
 	ASSERT(bsumHidIsValid(hid));
+	if (hid >= BSUM_HID_TREE)
+		hid -= BSUM_HID_TREE;
 	return hid == 0 ? 32 : (hid <= 512 ? hid / 8 : hid / 80);
 };
 
+/*
+*******************************************************************************
+Самотестирование
+
+Проверяется обновление корня дерева Меркла. Данные из 19 октетов
+разбиваются на 5 листьев по 4 октета (последний -- из 3 октетов),
+на уровнях дерева 5, 3, 2 и 1 вершина, последний лист дважды
+переносится на следующий уровень. После изменения листа функцией
+cmdTreeUpdate() корень должен совпадать с корнем дерева, построенного
+заново функцией cmdTreeBuild().
+*******************************************************************************
+*/
+
+static err_t bsumTreeRoot(octet root[], size_t hid, const octet data[])
+{
+	err_t code;
+	cmd_tree_t tree[1];
+	size_t num;
+	code = cmdTreeCreate(tree, hid, 4, 19);
+	ERR_CALL_CHECK(code);
+	for (num = 0; code == ERR_OK && num < 5; ++num)
+		code = cmdTreeLeaf(tree, num, data + 4 * num, num < 4 ? 4 : 3);
+	if (code == ERR_OK)
+	{
+		cmdTreeBuild(tree);
+		cmdTreeRoot(root, tree);
+	}
+	cmdTreeClose(tree);
+	return code;
+}
+
+static err_t bsumSelfTest()
+{
+	const size_t hids[] = { 0, 256 };
+	octet data[19];
+	octet root[2][32];
+	cmd_tree_t tree[1];
+	size_t pos, num;
+	err_t code;
+	for (pos = 0; pos < COUNT_OF(hids); ++pos)
+	{
+		// построить дерево
+		for (num = 0; num < sizeof(data); ++num)
+			data[num] = (octet)num;
+		code = cmdTreeCreate(tree, hids[pos], 4, sizeof(data));
+		ERR_CALL_CHECK(code);
+		for (num = 0; code == ERR_OK && num < 5; ++num)
+			code = cmdTreeLeaf(tree, num, data + 4 * num, num < 4 ? 4 : 3);
+		if (code == ERR_OK)
+			cmdTreeBuild(tree);
+		// изменить последний (переносимый) лист, затем лист 1
+		data[17] ^= 1;
+		if (code == ERR_OK)
+			code = cmdTreeUpdate(tree, 4, data + 16, 3);
+		if (code == ERR_OK)
+			cmdTreeRoot(root[0], tree);
+		if (code == ERR_OK)
+			code = bsumTreeRoot(root[1], hids[pos], data);
+		if (code == ERR_OK && !memEq(root[0], root[1], 32))
+			code = ERR_SELFTEST;
+		data[5] ^= 1;
+		if (code == ERR_OK)
+			code = cmdTreeUpdate(tree, 1, data + 4, 4);
+		if (code == ERR_OK)
+			cmdTreeRoot(root[0], tree);
+		if (code == ERR_OK)
+			code = bsumTreeRoot(root[1], hids[pos], data);
+		if (code == ERR_OK && !memEq(root[0], root[1], 32))
+			code = ERR_SELFTEST;
+		cmdTreeClose(tree);
+		ERR_CALL_CHECK(code);
+	}
+	return ERR_OK;
+}
+
 /*
 *******************************************************************************
 Хэширование файла
 
-\remark Если в функции bsumHash() переместить переменную buf в кучу,
-то скорость обработки больших файлов (несколько Gb) существенно упадет.
-Возможные объяснения:
-```
-https://stackoverflow.com/questions/24057331/
-	is-accessing-data-in-the-heap-faster-than-from-the-stack
-```
+Файл читается с помощью cmdFileStream(): чтение совмещается по времени
+с хэшированием (блоки файла читает отдельный поток с опережением).
+При хэшировании по дереву Меркла листья хэшируются в threads потоках.
 *******************************************************************************
 */
 
-static int bsumHash(octet hash[], size_t hid, const char* filename)
+static err_t bsumHash(octet hash[], size_t hid, size_t threads,
+	const char* filename)
 {
-	octet buf[32768];
 	octet state[4096];
 	size_t hash_len;
-	void (*step_hash)(const void*, size_t, void*);
-	FILE* fp;
-	size_t count;
+	cmd_step_i step_hash;
+	err_t code;
+	// дерево Меркла?
+	if (hid >= BSUM_HID_TREE)
+		return cmdTreeFile(hash, hid - BSUM_HID_TREE, BSUM_TREE_LEAF,
+			threads, filename);
 	// pre
 	ASSERT(beltHash_keep() <= sizeof(state));
 	ASSERT(bashHash_keep() <= sizeof(state));
@@ -159,30 +263,13 @@ static int bsumHash(octet hash[], size_t hid, const char* filename)
 		step_hash = bashPrgAbsorbStep;
 	}
 	ASSERT(memIsValid(hash, hash_len));
-	// открыть файл
-	fp = fopen(filename, "rb");
-	if (!fp)
-	{
-		printf("%s: FAILED [open]\n", filename);
-		return -1;
-	}
 	// читать и хэшировать файл
-	do
-	{
-		count = fread(buf, 1, sizeof(buf), fp);
-		step_hash(buf, count, state);
-	}
-	while (count == sizeof(buf));
-	// ошибка чтения?
-	if (ferror(fp))
+	code = cmdFileStream(filename, SIZE_MAX, step_hash, state);
+	if (code != ERR_OK)
 	{
-		fclose(fp);
-		memWipe(buf, sizeof(buf));
 		memWipe(state, sizeof(state));
-		printf("%s: FAILED [read]\n", filename);
-		return -1;
+		return code;
 	}
-	fclose(fp);
 	// возвратить хэш-значение
 	if (hid == 0)
 		beltHashStepG(hash, state);
@@ -191,41 +278,127 @@ static int bsumHash(octet hash[], size_t hid, const char* filename)
 	else
 		bashPrgSqueeze(hash, hash_len, state);
 	// завершить
-	memWipe(buf, sizeof(buf));
 	memWipe(state, sizeof(state));
-	return 0;
+	return ERR_OK;
+}
+
+/*
+*******************************************************************************
+Параллельное хэширование
+
+Файлы хэшируются порциями (не более BSUM_WINDOW файлов). Каждый файл
+порции описывается заданием. Задания выполняются с помощью cmdJobsRun():
+результаты выводятся в том же порядке, что и при последовательной
+обработке. При хэшировании по дереву Меркла файлы обрабатываются
+последовательно, а потоки используются для хэширования листьев.
+*******************************************************************************
+*/
+
+#define BSUM_WINDOW 256
+
+typedef struct
+{
+	const char* name;	/*< имя файла */
+	const char* hex;	/*< контрольное хэш-значение (при проверке) */
+	octet hash[64];		/*< хэш-значение */
+	err_t code;			/*< результат хэширования */
+	char str[1024];		/*< строка файла хэш-значений (при проверке) */
+} bsum_job_st;
+
+typedef struct
+{
+	size_t hid;			/*< идентификатор хэш-алгоритма */
+	size_t hash_len;	/*< длина хэш-значения */
+	size_t threads;		/*< число потоков */
+	size_t bad_files;	/*< число необработанных файлов */
+	size_t bad_hashes;	/*< число несовпавших хэш-значений */
+	bool_t check;		/*< режим проверки */
+} bsum_stat_st;
+
+static void bsumWorker(void* job, void* state)
+{
+	bsum_job_st* j = (bsum_job_st*)job;
+	const bsum_stat_st* stat = (const bsum_stat_st*)state;
+	j->code = bsumHash(j->hash, stat->hid,
+		stat->hid >= BSUM_HID_TREE ? stat->threads : 1, j->name);
 }
 
-static int bsumPrint(size_t hid, int argc, char* argv[])
+static void bsumReport(void* job, void* state)
 {
-	octet hash[64];
+	const bsum_job_st* j = (const bsum_job_st*)job;
+	bsum_stat_st* stat = (bsum_stat_st*)state;
 	char str[64 * 2 + 8];
-	int ret = 0;
-	for (; argc--; argv++)
+	if (j->code != ERR_OK)
 	{
-		if (bsumHash(hash, hid, argv[0]) != 0)
-		{
-			ret = -1;
-			continue;
-		}
-		hexFrom(str, hash, bsumHidHashLen(hid));
+		stat->bad_files++;
+		printf("%s: FAILED [%s]\n", j->name,
+			j->code == ERR_FILE_OPEN ? "open" : "read");
+	}
+	else if (!stat->check)
+	{
+		hexFrom(str, j->hash, stat->hash_len);
 		hexLower(str);
-		printf("%s  %s\n", str, argv[0]);
+		printf("%s  %s\n", str, j->name);
 	}
-	return ret;
+	else if (!hexEq(j->hash, j->hex))
+	{
+		stat->bad_hashes++;
+		printf("%s: FAILED [checksum]\n", j->name);
+	}
+	else
+		printf("%s: OK\n", j->name);
 }
 
-static int bsumCheck(size_t hid, const char* filename)
+static void bsumRun(bsum_stat_st* stat, bsum_job_st jobs[], size_t count)
 {
-	octet hash[64];
+	cmdJobsRun(jobs, sizeof(bsum_job_st), count,
+		stat->hid >= BSUM_HID_TREE ? 1 : stat->threads, bsumWorker,
+		bsumReport, stat);
+}
+
+/*
+*******************************************************************************
+Вычисление и проверка хэш-значений
+*******************************************************************************
+*/
+
+static int bsumPrint(size_t hid, size_t threads, int argc, char* argv[])
+{
+	bsum_job_st* jobs;
+	bsum_stat_st stat[1];
+	size_t count;
+	// подготовить задания
+	jobs = (bsum_job_st*)memAlloc(sizeof(bsum_job_st) * BSUM_WINDOW);
+	if (!jobs)
+	{
+		fprintf(stderr, "bee2cmd/%s: %s\n", _name, errMsg(ERR_OUTOFMEMORY));
+		return -1;
+	}
+	memSetZero(stat, sizeof(stat));
+	stat->hid = hid, stat->hash_len = bsumHidHashLen(hid);
+	stat->threads = threads;
+	// обработать файлы порциями
+	while (argc)
+	{
+		for (count = 0; argc && count < BSUM_WINDOW; --argc, ++argv, ++count)
+			jobs[count].name = argv[0], jobs[count].hex = 0;
+		bsumRun(stat, jobs, count);
+	}
+	memFree(jobs);
+	return stat->bad_files ? -1 : 0;
+}
+
+static int bsumCheck(size_t hid, size_t threads, const char* filename)
+{
+	bsum_job_st* jobs;
+	bsum_stat_st stat[1];
 	size_t hash_len;
-	char str[1024];
+	char* str;
 	size_t str_len;
+	size_t count;
 	FILE* fp;
 	size_t all_lines = 0;
 	size_t bad_lines = 0;
-	size_t bad_files = 0;
-	size_t bad_hashes = 0;
 	// длина хэш-значения в байтах
 	hash_len = bsumHidHashLen(hid);
 	// открыть checksum_file
@@ -235,54 +408,67 @@ static int bsumCheck(size_t hid, const char* filename)
 		printf("%s: No such file\n", filename);
 		return -1;
 	}
-	for (; fgets(str, sizeof(str), fp); ++all_lines)
+	// подготовить задания
+	jobs = (bsum_job_st*)memAlloc(sizeof(bsum_job_st) * BSUM_WINDOW);
+	if (!jobs)
 	{
-		// проверить строку
-		str_len = strLen(str);
-		if (str_len < hash_len * 2 + 2 || 
-			str[2 * hash_len] != ' ' || 
-			str[2 * hash_len + 1] != ' ' ||
-			(str[hash_len * 2] = 0, !hexIsValid(str)))
-		{
-			bad_lines++;
-			continue;
-		}
-		// выделить имя файла
-		if(str[str_len - 1] == '\n') 
-			str[--str_len] = 0;
-		if(str[str_len - 1] == '\r') 
-			str[--str_len] = 0;
-		// хэшировать
-		if (bsumHash(hash, hid, str + 2 * hash_len + 2) == -1)
-		{
-			bad_files++;
-			continue;
-		}
-		if (!hexEq(hash, str))
+		fclose(fp);
+		fprintf(stderr, "bee2cmd/%s: %s\n", _name, errMsg(ERR_OUTOFMEMORY));
+		return -1;
+	}
+	memSetZero(stat, sizeof(stat));
+	stat->hid = hid, stat->hash_len = hash_len, stat->check = TRUE;
+	stat->threads = threads;
+	// обработать строки порциями
+	do
+	{
+		for (count = 0; count < BSUM_WINDOW; ++all_lines)
 		{
-			bad_hashes++;
-			printf("%s: FAILED [checksum]\n", str + 2 * hash_len + 2);
-			continue;
+			str = jobs[count].str;
+			if (!fgets(str, sizeof(jobs[count].str), fp))
+				break;
+			// проверить строку
+			str_len = strLen(str);
+			if (str_len < hash_len * 2 + 2 || 
+				str[2 * hash_len] != ' ' || 
+				str[2 * hash_len + 1] != ' ' ||
+				(str[hash_len * 2] = 0, !hexIsValid(str)))
+			{
+				bad_lines++;
+				continue;
+			}
+			// выделить имя файла
+			if(str[str_len - 1] == '\n') 
+				str[--str_len] = 0;
+			if(str[str_len - 1] == '\r') 
+				str[--str_len] = 0;
+			// создать задание
+			jobs[count].hex = str;
+			jobs[count].name = str + 2 * hash_len + 2;
+			++count;
 		}
-		printf("%s: OK\n", str + 2 * hash_len + 2);
+		// хэшировать и проверить
+		bsumRun(stat, jobs, count);
 	}
+	while (count == BSUM_WINDOW);
 	fclose(fp);
+	memFree(jobs);
 	if (bad_lines)
 		fprintf(stderr, bad_lines == 1 ? 
 			"WARNING: %lu input line (out of %lu) is improperly formatted\n" :
 			"WARNING: %lu input lines (out of %lu) are improperly formatted\n",
 			(unsigned long)bad_lines, (unsigned long)all_lines);
-	if (bad_files)
-		fprintf(stderr, bad_files == 1 ? 
+	if (stat->bad_files)
+		fprintf(stderr, stat->bad_files == 1 ? 
 			"WARNING: %lu listed file could not be opened or read\n" :
 			"WARNING: %lu listed files could not be opened or read\n", 
-			(unsigned long)bad_files);
-	if (bad_hashes)
-		fprintf(stderr, bad_hashes == 1 ? 
+			(unsigned long)stat->bad_files);
+	if (stat->bad_hashes)
+		fprintf(stderr, stat->bad_hashes == 1 ? 
 			"WARNING: %lu computed checksum did not match\n":  
 			"WARNING: %lu computed checksums did not match\n",  
-			(unsigned long)bad_hashes);
-	return (bad_lines || bad_files || bad_hashes) ? -1 : 0;
+			(unsigned long)stat->bad_hashes);
+	return (bad_lines || stat->bad_files || stat->bad_hashes) ? -1 : 0;
 }
 
 /*
@@ -296,6 +482,7 @@ int bsumMain(int argc, char* argv[])
 	err_t code = ERR_OK;
 	size_t hid = SIZE_MAX;
 	bool_t check = FALSE;
+	size_t threads = 0;
 #ifdef OS_WIN
 	setlocale(LC_ALL, "russian_belarus.1251");
 #endif
@@ -317,6 +504,31 @@ int bsumMain(int argc, char* argv[])
 			hid = 0;
 			--argc, ++argv;
 		}
+		// belt-tree
+		else if (strEq(argv[0], "-belt-tree"))
+		{
+			if (hid != SIZE_MAX)
+			{
+				code = ERR_CMD_PARAMS;
+				break;
+			}
+			hid = BSUM_HID_TREE;
+			--argc, ++argv;
+		}
+		// bash-tree
+		else if (strStartsWith(argv[0], "-bash-tree"))
+		{
+			char* alg_name = argv[0] + strLen("-bash-tree");
+			if (hid != SIZE_MAX || !decIsValid(alg_name) ||
+				strLen(alg_name) != 3 || decCLZ(alg_name) ||
+				!bsumHidIsValid(hid = BSUM_HID_TREE +
+					(size_t)decToU32(alg_name)) || hid == BSUM_HID_TREE)
+			{
+				code = ERR_CMD_PARAMS;
+				break;
+			}
+			--argc, ++argv;
+		}
 		// bash-prg-hash
 		else if (strStartsWith(argv[0], "-bash-prg-hash"))
 		{
@@ -355,6 +567,22 @@ int bsumMain(int argc, char* argv[])
 			check = TRUE;
 			--argc, ++argv;
 		}
+		// threads
+		else if (strStartsWith(argv[0], "-j"))
+		{
+			const char* num = argv[0] + strLen("-j");
+			if (!*num && argc > 1)
+				num = argv[1], --argc, ++argv;
+			if (threads || !decIsValid(num) || !strLen(num) ||
+				strLen(num) > 2 || decCLZ(num) ||
+				(threads = (size_t)decToU32(num)) == 0 ||
+				threads > CMD_THREADS_MAX)
+			{
+				code = ERR_CMD_PARAMS;
+				break;
+			}
+			--argc, ++argv;
+		}
 		// --
 		else if (strEq(argv[0], "--"))
 		{
@@ -378,9 +606,19 @@ int bsumMain(int argc, char* argv[])
 	// belt-hash по умолчанию
 	if (hid == SIZE_MAX)
 		hid = 0;
+	// один поток по умолчанию
+	if (threads == 0)
+		threads = 1;
+	// самотестирование
+	if (hid >= BSUM_HID_TREE && (code = cmdSelfTest(bsumSelfTest)) != ERR_OK)
+	{
+		fprintf(stderr, "bee2cmd/%s: %s\n", _name, errMsg(code));
+		return -1;
+	}
 	// вычисление/проверка хэш-значениий
 	ASSERT(bsumHidIsValid(hid));
-	return check ? bsumCheck(hid, argv[0]) : bsumPrint(hid, argc, argv);
+	return check ? bsumCheck(hid, threads, argv[0]) :
+		bsumPrint(hid, threads, argc, argv);
 }
 
 /*
@@ -4,7 +4,7 @@
 \brief Command-line interface to Bee2
 \project bee2/cmd
 \created 2022.06.09
-\version 2023.12.17
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -22,6 +22,7 @@ extern "C" {
 #include <bee2/core/err.h>
 #include <bee2/core/tm.h>
 #include <bee2/crypto/btok.h>
+#include <stdio.h>
 
 /*
 *******************************************************************************
@@ -64,6 +65,274 @@ err_t cmdReg(
 	cmd_main_i fn			/*!< [in] главная функция команды */
 );
 
+/*!	\brief Выполнение команды
+
+	Выполняется зарегистрированная команда с именем argv[0]. Главной
+	функции команды передаются параметры [argc]argv.
+	\return Результат главной функции команды или -1, если команда
+	не найдена (в последнем случае сообщение об ошибке выводится
+	в stderr).
+*/
+int cmdRun(
+	int argc,				/*!< [in] число параметров */
+	char* argv[]			/*!< [in] параметры */
+);
+
+/*!	\brief Функция самотестирования команды */
+typedef err_t (*cmd_selftest_i)();
+
+/*!	\brief Однократное самотестирование
+
+	Выполняется функция самотестирования test(), если она еще не была
+	успешно выполнена в текущем процессе.
+	\return ERR_OK, если тест пройден (сейчас или ранее), и код ошибки
+	test() в противном случае.
+	\remark Повторное самотестирование исключается при выполнении
+	нескольких команд в одном процессе (см. команду batch).
+*/
+err_t cmdSelfTest(
+	cmd_selftest_i test		/*!< [in] функция самотестирования */
+);
+
+/*
+*******************************************************************************
+Кэширование
+
+В режиме кэширования результаты дорогих операций сохраняются в памяти
+процесса и используются повторно при выполнении следующих команд. Режим
+включается командой batch, которая выполняет в одном процессе
+последовательность команд.
+
+Кэшируются:
+-	личные ключи, снятые с защиты в cmdPrivkeyRead() (ключ кэша --
+	имитовставка beltHMAC контейнера на пароле защиты);
+-	подписи сертификатов, успешно проверенные в cmdCVCsVal() (кэш
+	библиотеки, см. btokCVCCacheStart());
+-	запущенный в cmdRngStart() ГСЧ.
+
+Каждый элемент кэша идентифицируется типом и 32-октетным ключом.
+Число элементов ограничено: при переполнении вытесняется самый старый
+элемент. Элементы размещаются в блобах и очищаются при закрытии кэша.
+
+Независимо от режима кэширования самотестирование в утилитах выполняется
+не более одного раза за время работы процесса.
+
+Обращения к кэшу из нескольких потоков синхронизируются.
+*******************************************************************************
+*/
+
+#define CMD_CACHE_PRIVKEY	1	/*!< личный ключ */
+
+/*!	\brief Включение кэширования
+
+	Включается режим кэширования.
+*/
+void cmdCacheOn();
+
+/*!	\brief Кэширование включено?
+
+	Проверяется, что включен режим кэширования.
+	\return Признак включения.
+*/
+bool_t cmdCacheIsOn();
+
+/*!	\brief Поиск в кэше
+
+	В кэше ищется элемент типа type с ключом key. Если элемент найден
+	и длина его значения равна val_len, то значение возвращается в буфере
+	[val_len]val.
+	\return Признак успеха поиска.
+	\remark Если кэширование не включено, то возвращается FALSE.
+*/
+bool_t cmdCacheGet(
+	void* val,				/*!< [out] значение */
+	size_t val_len,			/*!< [in] длина значения */
+	size_t type,			/*!< [in] тип элемента */
+	const octet key[32]		/*!< [in] ключ */
+);
+
+/*!	\brief Размещение в кэше
+
+	В кэше размещается элемент типа type с ключом key и значением
+	[val_len]val. Элемент с тем же типом и ключом заменяется.
+	\remark Если кэширование не включено или не хватает памяти, то элемент
+	не размещается.
+*/
+void cmdCachePut(
+	size_t type,			/*!< [in] тип элемента */
+	const octet key[32],	/*!< [in] ключ */
+	const void* val,		/*!< [in] значение */
+	size_t val_len			/*!< [in] длина значения */
+);
+
+/*!	\brief Закрытие кэша
+
+	Элементы кэша очищаются и освобождаются, режим кэширования выключается.
+*/
+void cmdCacheClose();
+
+/*
+*******************************************************************************
+Параллельная обработка
+
+Однотипные задания (например, хэширование или проверка подписи файлов
+из списка) выполняются исполнителями пула потоков (см. mtPoolCreate()).
+Пул создается однократно и используется повторно. Основной поток
+ожидает готовности заданий в порядке их следования (не опрашивая их,
+а блокируясь в mtPoolWait()) и обрабатывает результаты (например,
+выводит их). Поэтому результаты обрабатываются
+в том же порядке, что и при последовательном выполнении заданий.
+*******************************************************************************
+*/
+
+#define CMD_THREADS_MAX 64	/*!< максимальное число исполнителей */
+
+/*!	\brief Обработка задания
+
+	Выполняется задание job или обрабатывается результат его выполнения.
+	Используется общее для всех заданий состояние state.
+*/
+typedef void (*cmd_job_i)(
+	void* job,			/*!< [in,out] задание */
+	void* state			/*!< [in,out] состояние */
+);
+
+/*!	\brief Выполнение заданий
+
+	Задания jobs[0], jobs[1],..., jobs[count - 1], каждое длины job_size,
+	выполняются функцией run() в threads потоках-исполнителях. Результаты
+	выполнения заданий обрабатываются функцией report() в вызывающем потоке
+	в порядке следования заданий. Функциям run() и report() передается
+	общее состояние state.
+	\pre threads <= CMD_THREADS_MAX.
+	\expect Функция run() только читает state и вызывается одновременно
+	для разных заданий. Функция report() может изменять state, но
+	не те его поля, которые читает run().
+	\remark Если threads <= 1 или потоки-исполнители не удалось создать,
+	то задания выполняются последовательно в вызывающем потоке.
+*/
+void cmdJobsRun(
+	void* jobs,			/*!< [in,out] задания */
+	size_t job_size,	/*!< [in] длина задания */
+	size_t count,		/*!< [in] число заданий */
+	size_t threads,		/*!< [in] число исполнителей */
+	cmd_job_i run,		/*!< [in] выполнение задания */
+	cmd_job_i report,	/*!< [in] обработка результата */
+	void* state			/*!< [in,out] состояние */
+);
+
+/*
+*******************************************************************************
+Хэширование по дереву Меркла
+
+Данные разбиваются на листья фиксированной длины leaf_size, последний лист
+может быть короче. Пустые данные образуют один пустой лист. Хэш-значения
+листьев и внутренних вершин вычисляются с разделением доменов:
+	leaf = h(0x00 || лист),
+	node = h(0x01 || left || right).
+Внутренние вершины строятся по уровням: вершины уровня объединяются
+попарно, непарная последняя вершина переносится на следующий уровень без
+изменений. Корень -- единственная вершина последнего уровня.
+
+В качестве h используется belt-hash (hid == 0) или bash256, bash384,
+bash512 (hid == 256, 384, 512).
+
+Хэш-значения всех вершин сохраняются. Поэтому листья можно хэшировать
+одновременно (в разных потоках), а при изменении одного листа корень
+пересчитывается за O(log n) вызовов h, где n -- число листьев.
+*******************************************************************************
+*/
+
+/*!	\brief Дерево Меркла */
+typedef struct {
+	size_t hid;				/*!< идентификатор хэш-алгоритма */
+	size_t hash_len;		/*!< длина хэш-значения */
+	size_t leaf_size;		/*!< длина листа */
+	size_t size;			/*!< длина данных */
+	size_t count;			/*!< число листьев */
+	octet* nodes;			/*!< хэш-значения вершин (по уровням) */
+} cmd_tree_t;
+
+/*!	\brief Создание дерева
+
+	Создается дерево tree для данных длины size, которые разбиваются
+	на листья длины leaf_size. Хэш-значения вершин не определены.
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+*/
+err_t cmdTreeCreate(
+	cmd_tree_t* tree,		/*!< [out] дерево */
+	size_t hid,				/*!< [in] хэш-алгоритм */
+	size_t leaf_size,		/*!< [in] длина листа */
+	size_t size				/*!< [in] длина данных */
+);
+
+/*!	\brief Хэширование листа
+
+	Вычисляется хэш-значение листа [count]leaf с номером num. Хэш-значения
+	внутренних вершин не пересчитываются.
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+	\remark Функция может вызываться одновременно для разных листьев.
+*/
+err_t cmdTreeLeaf(
+	cmd_tree_t* tree,		/*!< [in,out] дерево */
+	size_t num,				/*!< [in] номер листа */
+	const octet leaf[],		/*!< [in] лист */
+	size_t count			/*!< [in] длина листа */
+);
+
+/*!	\brief Построение дерева
+
+	Пересчитываются хэш-значения всех внутренних вершин дерева tree.
+	\pre Хэш-значения всех листьев определены.
+*/
+void cmdTreeBuild(
+	cmd_tree_t* tree		/*!< [in,out] дерево */
+);
+
+/*!	\brief Обновление листа
+
+	Лист с номером num заменяется на [count]leaf. Пересчитываются
+	хэш-значения листа и вершин на пути от него к корню.
+	\pre Дерево построено.
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+*/
+err_t cmdTreeUpdate(
+	cmd_tree_t* tree,		/*!< [in,out] дерево */
+	size_t num,				/*!< [in] номер листа */
+	const octet leaf[],		/*!< [in] лист */
+	size_t count			/*!< [in] длина листа */
+);
+
+/*!	\brief Корень дерева
+
+	Определяется хэш-значение root корня дерева tree.
+	\pre Дерево построено.
+*/
+void cmdTreeRoot(
+	octet root[],			/*!< [out] корень */
+	const cmd_tree_t* tree	/*!< [in] дерево */
+);
+
+/*!	\brief Закрытие дерева */
+void cmdTreeClose(
+	cmd_tree_t* tree		/*!< [in] дерево */
+);
+
+/*!	\brief Хэширование файла по дереву Меркла
+
+	Определяется корень root дерева Меркла с хэш-алгоритмом hid и листьями
+	длины leaf_size, построенного по содержимому файла file. Листья
+	хэшируются в threads потоках (см. cmdJobsRun()).
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+*/
+err_t cmdTreeFile(
+	octet root[],			/*!< [out] корень */
+	size_t hid,				/*!< [in] хэш-алгоритм */
+	size_t leaf_size,		/*!< [in] длина листа */
+	size_t threads,			/*!< [in] число потоков */
+	const char* file		/*!< [in] файл */
+);
+
 /*
 *******************************************************************************
 Терминал
@@ -121,12 +390,15 @@ err_t cmdRngKbRead(
 
 /*!	\brief Запуск ГСЧ
 
-	Запускается штатный ГСЧ. При установке флага verbose запуск сопровождается
-	экранным выводом.
+	Запускается штатный ГСЧ с механизмом генерации engine. При установке 
+	флага verbose запуск сопровождается экранным выводом.
 	\return ERR_OK в случае успеха и код ошибки в противном случае.
+	\remark При нулевом engine используется механизм по умолчанию
+	(см. rngCreate2()).
 */
 err_t cmdRngStart(
-	bool_t verbose			/*!< [in] печатать подробности */
+	bool_t verbose,			/*!< [in] печатать подробности */
+	const char* engine		/*!< [in] механизм генерации */
 );
 
 /*
@@ -207,6 +479,20 @@ size_t cmdFileSize(
 	const char* file		/*!< [in] имя файла */
 );
 
+/*!	\brief Позиционирование в файле
+
+	Текущая позиция открытого файла fp устанавливается равной offset
+	(отсчитывается от начала файла).
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+	\remark В отличие от fseek(), смещение является 64-битовым на всех
+	платформах. Если платформа не поддерживает смещение offset, то
+	возвращается ERR_OVERFLOW.
+*/
+err_t cmdFileSeek(
+	FILE* fp,				/*!< [in,out] открытый файл */
+	u64 offset				/*!< [in] смещение */
+);
+
 /*!	\brief Запись в файл
 
 	Создается файл file и в него записывается буфер [count]buf.
@@ -257,6 +543,66 @@ err_t cmdFileReadAll(
 	const char* file	/*!< [in] файл */
 );
 
+/*!	\brief Шаг обработки фрагмента файла
+
+	Обрабатывается фрагмент [count]buf файла. Используется состояние state.
+	\remark Интерфейс совпадает с интерфейсом функций beltHashStepH(),
+	bashHashStepH(), bashPrgAbsorbStep().
+*/
+typedef void (*cmd_step_i)(
+	const void* buf,	/*!< [in] фрагмент */
+	size_t count,		/*!< [in] длина фрагмента */
+	void* state			/*!< [in,out] состояние */
+);
+
+/*!	\brief Потоковая обработка файла
+
+	Первые count октетов файла file последовательно, фрагментами,
+	передаются функции step() вместе с состоянием state. При
+	count == SIZE_MAX обрабатываются все октеты файла.
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+	В частности, если в файле меньше count октетов, то возвращается
+	ERR_FILE_READ.
+	\remark Файл читается блоками в кольцо буферов отдельным потоком,
+	который опережает обработку на несколько блоков. Поэтому чтение
+	совмещается по времени с обработкой.
+*/
+err_t cmdFileStream(
+	const char* file,	/*!< [in] файл */
+	size_t count,		/*!< [in] число обрабатываемых октетов */
+	cmd_step_i step,	/*!< [in] функция обработки */
+	void* state			/*!< [in,out] состояние step() */
+);
+
+/*!	\brief Содержимое файла */
+typedef struct {
+	const octet* buf;	/*!< содержимое файла */
+	size_t len;			/*!< длина файла */
+	void* blob;			/*!< блоб с содержимым */
+} cmd_fbuf_t;
+
+/*!	\brief Загрузка файла
+
+	Файл file прочитывается целиком. Адрес и длина содержимого
+	возвращаются в полях buf и len структуры fbuf.
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+	\remark Файл не отображается в память: сокращение файла другим
+	процессом не может привести к аварийному завершению.
+*/
+err_t cmdFileLoad(
+	cmd_fbuf_t* fbuf,	/*!< [out] содержимое */
+	const char* file	/*!< [in] файл */
+);
+
+/*!	\brief Освобождение содержимого файла
+
+	Освобождается содержимое fbuf, загруженное функцией cmdFileLoad().
+	\pre cmdFileLoad() < cmdFileUnload().
+*/
+void cmdFileUnload(
+	cmd_fbuf_t* fbuf	/*!< [in,out] содержимое */
+);
+
 /*!	\brief Проверка отсутствия файлов
 
 	Проверяется, что файлы списка [count]files отсутствуют и, таким образом,
@@ -614,6 +960,179 @@ err_t cmdCVCsPrint(
 	size_t certs_len				/*!< [in] длина коллекции */
 );
 
+/*
+*******************************************************************************
+Кольца сертификатов
+
+Кольцо -- это файл, который содержит коллекцию CV-сертификатов и подпись
+под ней (см. утилиту cvr). Для ускорения поиска в больших кольцах
+рядом с кольцом ring может размещаться индекс -- файл с именем ring.idx.
+
+Индекс содержит описания сертификатов кольца в порядке их следования
+(смещение, длина, имя владельца, хэш-значение beltHash открытого ключа),
+а также два списка номеров описаний: упорядоченный по именам владельцев
+и упорядоченный по хэш-значениям открытых ключей. При равенстве имен
+(хэш-значений) номера следуют по возрастанию. Поэтому сертификат
+по номеру находится за время O(1), а по владельцу или открытому
+ключу -- за время O(log n), где n -- число сертификатов.
+
+Индекс привязан к кольцу: в нем сохраняются длина коллекции и хэш-значение
+подписи кольца. При изменении кольца подпись изменяется, индекс перестает
+соответствовать кольцу и не используется. Без индекса сертификаты кольца
+просматриваются последовательно.
+
+Кольцо без индекса загружается в память (см. cmdFileLoad()). Кольцо
+с индексом не загружается: из индекса читаются заголовок и описания,
+которые просматриваются при поиске, из кольца -- найденные сертификаты
+(см. cmdCVRRead()). Найденный по индексу сертификат сверяется с искомым.
+*******************************************************************************
+*/
+
+/*!	\brief Открытое кольцо */
+typedef struct {
+	cmd_fbuf_t ring;		/*!< содержимое кольца (если нет индекса) */
+	const octet* certs;		/*!< коллекция сертификатов (если нет индекса) */
+	size_t certs_len;		/*!< длина коллекции */
+	FILE* ring_fp;			/*!< файл кольца (если есть индекс) */
+	FILE* idx_fp;			/*!< файл индекса (если есть индекс) */
+	size_t count;			/*!< число сертификатов (если есть индекс) */
+} cmd_cvr_t;
+
+/*!	\brief Открытие кольца
+
+	Открывается кольцо из файла ring. Если рядом с кольцом размещается
+	соответствующий ему индекс, то открывается и индекс.
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+	\remark Подпись кольца не проверяется.
+*/
+err_t cmdCVROpen(
+	cmd_cvr_t* cvr,			/*!< [out] кольцо */
+	const char* ring		/*!< [in] файл кольца */
+);
+
+/*!	\brief Кольцо проиндексировано?
+
+	Проверяется, что при открытии кольца cvr был открыт индекс.
+	\return Признак наличия индекса.
+*/
+bool_t cmdCVRIsIndexed(
+	const cmd_cvr_t* cvr	/*!< [in] кольцо */
+);
+
+/*!	\brief Число сертификатов кольца
+
+	Определяется число сертификатов кольца cvr.
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+*/
+err_t cmdCVRCount(
+	size_t* count,			/*!< [out] число сертификатов */
+	const cmd_cvr_t* cvr	/*!< [in] кольцо */
+);
+
+/*!	\brief Поиск сертификата кольца по номеру
+
+	Определяются смещение offset и длина cert_len сертификата номер num
+	(нумерация от 0) в коллекции сертификатов кольца cvr.
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+	\remark При отсутствии сертификата возвращается ERR_OUTOFRANGE.
+*/
+err_t cmdCVRGet(
+	size_t* offset,			/*!< [out] смещение */
+	size_t* cert_len,		/*!< [out] длина сертификата */
+	const cmd_cvr_t* cvr,	/*!< [in] кольцо */
+	size_t num				/*!< [in] номер сертификата */
+);
+
+/*!	\brief Чтение сертификата кольца
+
+	Из коллекции сертификатов кольца cvr читается сертификат [cert_len]cert
+	со смещением offset. Смещение и длина определяются функциями
+	cmdCVRGet(), cmdCVRFindHolder(), cmdCVRFindPubkey().
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+	\remark Если кольцо проиндексировано, то сертификат читается из файла
+	кольца.
+*/
+err_t cmdCVRRead(
+	octet cert[],			/*!< [out] сертификат */
+	const cmd_cvr_t* cvr,	/*!< [in] кольцо */
+	size_t offset,			/*!< [in] смещение */
+	size_t cert_len			/*!< [in] длина сертификата */
+);
+
+/*!	\brief Поиск сертификата в кольце
+
+	В кольце cvr ищется сертификат [cert_len]cert. Смещение найденного
+	сертификата в коллекции сертификатов кольца возвращается по адресу
+	offset.
+	\return ERR_OK, если сертификат найден, ERR_NOT_FOUND, если не найден,
+	и другой код ошибки в остальных случаях.
+*/
+err_t cmdCVRFind(
+	size_t* offset,			/*!< [out] смещение */
+	const cmd_cvr_t* cvr,	/*!< [in] кольцо */
+	const octet* cert,		/*!< [in] сертификат */
+	size_t cert_len			/*!< [in] длина сертификата */
+);
+
+/*!	\brief Поиск сертификата кольца по владельцу
+
+	В кольце cvr ищется первый сертификат с владельцем holder. Смещение
+	и длина найденного сертификата возвращаются по адресам offset
+	и cert_len.
+	\return ERR_OK, если сертификат найден, ERR_NOT_FOUND, если не найден,
+	и другой код ошибки в остальных случаях.
+*/
+err_t cmdCVRFindHolder(
+	size_t* offset,			/*!< [out] смещение */
+	size_t* cert_len,		/*!< [out] длина сертификата */
+	const cmd_cvr_t* cvr,	/*!< [in] кольцо */
+	const char* holder		/*!< [in] владелец */
+);
+
+/*!	\brief Поиск сертификата кольца по открытому ключу
+
+	В кольце cvr ищется первый сертификат с открытым ключом
+	[pubkey_len]pubkey. Смещение и длина найденного сертификата
+	возвращаются по адресам offset и cert_len.
+	\return ERR_OK, если сертификат найден, ERR_NOT_FOUND, если не найден,
+	и другой код ошибки в остальных случаях.
+*/
+err_t cmdCVRFindPubkey(
+	size_t* offset,			/*!< [out] смещение */
+	size_t* cert_len,		/*!< [out] длина сертификата */
+	const cmd_cvr_t* cvr,	/*!< [in] кольцо */
+	const octet* pubkey,	/*!< [in] открытый ключ */
+	size_t pubkey_len		/*!< [in] длина ключа */
+);
+
+/*!	\brief Закрытие кольца
+
+	Закрывается кольцо cvr, открытое функцией cmdCVROpen().
+*/
+void cmdCVRClose(
+	cmd_cvr_t* cvr			/*!< [in,out] кольцо */
+);
+
+/*!	\brief Индексирование кольца
+
+	Для кольца из файла ring строится индекс, который записывается в файл
+	ring.idx. Ранее созданный индекс перезаписывается.
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+*/
+err_t cmdCVRIndex(
+	const char* ring		/*!< [in] файл кольца */
+);
+
+/*!	\brief Обновление индекса кольца
+
+	Если для кольца из файла ring ранее был создан индекс, то индекс
+	строится заново.
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+*/
+err_t cmdCVRIndexUpdate(
+	const char* ring		/*!< [in] файл кольца */
+);
+
 /*
 *******************************************************************************
 ЭЦП
@@ -698,6 +1217,27 @@ err_t cmdSigSign(
 	size_t privkey_len			/*!< [in] длина личного ключа */
 );
 
+/*!	\brief Подпись файла с помощью демона
+
+	Содержимое файла file подписывается так же, как в функции cmdSigSign(),
+	но подпись вырабатывается демоном подписи, который слушает сокет
+	socket. Личный ключ хранится в демоне: хэш-значение вычисляется
+	локально и передается демону, демон возвращает подпись.
+	\expect{ERR_BAD_KEYPAIR} Если цепочка certs непуста, то ее первый
+	сертификат соответствует открытому ключу демона.
+	\return ERR_OK, если файл успешно подписан, и код ошибки в противном
+	случае.
+	\remark Длина личного ключа определяется по длине открытого ключа,
+	который возвращает демон.
+*/
+err_t cmdSigSignDaemon(
+	const char* sig_file,		/*!< [in] файл подписи */
+	const char* file,			/*!< [in] подписываемый файл */
+	const char* certs,			/*!< [in] цепочка сертификатов */
+	const octet date[6],		/*!< [in] дата подписания */
+	const char* socket			/*!< [in] сокет демона */
+);
+
 /*!	\brief Чтение подписи
 
 	Из файла sig_file прочитывается подпись sig. При ненулевом sig_len по этому
@@ -819,6 +1359,140 @@ err_t cmdSigPrint(
 	const char* scope			/*!< [in] область печати */
 );
 
+/*
+*******************************************************************************
+Демон подписи
+
+Демон подписи (утилита bee2d) один раз загружает личный ключ и обслуживает
+запросы клиентов через локальный сокет (Unix domain socket).
+
+Сообщения передаются в формате
+  [4]len || [len]msg,
+где len -- длина msg в октетах (big-endian), len <= CMD_DAEMON_MSG_MAX.
+Сообщение-запрос имеет вид op || data, где op -- код операции
+(CMD_DAEMON_XXX), data -- аргументы операции. Сообщение-ответ имеет вид
+[4]code || data, где code -- код ошибки (big-endian), data -- результат
+операции (только при code == ERR_OK).
+
+Операции:
+-	CMD_DAEMON_INFO: data запроса пусто, data ответа -- открытый ключ;
+-	CMD_DAEMON_SIGN: data запроса -- хэш-значение (его длина совпадает
+	с длиной личного ключа), data ответа -- подпись;
+-	CMD_DAEMON_VERIFY: data запроса -- хэш-значение || подпись
+	[|| открытый ключ], data ответа пусто. Если открытый ключ
+	не указан, то используется открытый ключ демона;
+-	CMD_DAEMON_STAT: data запроса пусто, data ответа -- статистика
+	в текстовом виде;
+-	CMD_DAEMON_STOP: data запроса и ответа пусты, демон завершает работу.
+
+В одном соединении можно передать несколько запросов. Запросы разных
+соединений обрабатываются параллельно и объединяются демоном в пакеты.
+
+На платформах, отличных от OS_UNIX, функции возвращают
+ERR_NOT_IMPLEMENTED.
+*******************************************************************************
+*/
+
+#define CMD_DAEMON_INFO		'I'		/*!< открытый ключ */
+#define CMD_DAEMON_SIGN		'S'		/*!< выработка подписи */
+#define CMD_DAEMON_VERIFY	'V'		/*!< проверка подписи */
+#define CMD_DAEMON_STAT		'T'		/*!< статистика */
+#define CMD_DAEMON_STOP		'Q'		/*!< завершение работы */
+
+#define CMD_DAEMON_MSG_MAX	1024	/*!< максимальная длина сообщения */
+
+/*!	\brief Создание слушающего сокета
+
+	Создается сокет sock, который слушает локальный адрес name.
+	\expect{ERR_FILE_EXISTS} Файл name не существует.
+	\return ERR_OK, если сокет создан, и код ошибки в противном случае.
+	\remark Доступ к файлу name разрешается только владельцу.
+*/
+err_t cmdDaemonListen(
+	int* sock,				/*!< [out] сокет */
+	const char* name		/*!< [in] адрес */
+);
+
+/*!	\brief Прием соединения
+
+	Слушающий сокет sock ожидает соединения не более timeout миллисекунд.
+	Если соединение установлено, то его сокет возвращается по адресу conn.
+	Если соединения нет, то по адресу conn возвращается -1.
+	\return ERR_OK, если ожидание завершено без ошибок, и код ошибки
+	в противном случае.
+*/
+err_t cmdDaemonAccept(
+	int* conn,				/*!< [out] сокет соединения */
+	int sock,				/*!< [in] слушающий сокет */
+	size_t timeout			/*!< [in] время ожидания (мс) */
+);
+
+/*!	\brief Соединение с демоном
+
+	Устанавливается соединение sock с демоном, который слушает адрес name.
+	\return ERR_OK, если соединение установлено, и код ошибки в противном
+	случае.
+*/
+err_t cmdDaemonConnect(
+	int* sock,				/*!< [out] сокет */
+	const char* name		/*!< [in] адрес */
+);
+
+/*!	\brief Отправка сообщения
+
+	Через сокет sock отправляется сообщение [count]msg.
+	\expect{ERR_BAD_INPUT} count <= CMD_DAEMON_MSG_MAX.
+	\return ERR_OK, если сообщение отправлено, и код ошибки в противном
+	случае.
+*/
+err_t cmdDaemonSend(
+	int sock,				/*!< [in] сокет */
+	const void* msg,		/*!< [in] сообщение */
+	size_t count			/*!< [in] длина msg в октетах */
+);
+
+/*!	\brief Получение сообщения
+
+	Через сокет sock принимается сообщение [count]msg.
+	\expect{ERR_BAD_FORMAT} Длина сообщения не превосходит
+	CMD_DAEMON_MSG_MAX.
+	\return ERR_OK, если сообщение принято, ERR_FILE_EOF, если соединение
+	закрыто до начала сообщения, и код ошибки в противном случае.
+	\pre Буфер msg имеет длину CMD_DAEMON_MSG_MAX.
+*/
+err_t cmdDaemonRecv(
+	void* msg,				/*!< [out] сообщение */
+	size_t* count,			/*!< [out] длина msg в октетах */
+	int sock				/*!< [in] сокет */
+);
+
+/*!	\brief Запрос к демону
+
+	Через сокет sock демону отправляется запрос op || [req_len]req.
+	Результат запроса возвращается в буфере [resp_len]resp.
+	\return Код ошибки, который вернул демон, или код ошибки обмена
+	сообщениями.
+	\pre Буфер resp имеет длину CMD_DAEMON_MSG_MAX.
+*/
+err_t cmdDaemonCall(
+	void* resp,				/*!< [out] результат */
+	size_t* resp_len,		/*!< [out] длина resp в октетах */
+	int sock,				/*!< [in] сокет */
+	octet op,				/*!< [in] код операции */
+	const void* req,		/*!< [in] аргументы */
+	size_t req_len			/*!< [in] длина req в октетах */
+);
+
+/*!	\brief Закрытие сокета
+
+	Закрывается сокет sock. Если name != 0, то удаляется файл name
+	слушающего сокета.
+*/
+void cmdDaemonClose(
+	int sock,				/*!< [in] сокет */
+	const char* name		/*!< [in] адрес */
+);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -4,7 +4,7 @@
 \brief Command-line interface to Bee2: main
 \project bee2/cmd
 \created 2022.06.07
-\version 2023.12.19
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -54,6 +54,47 @@ err_t cmdReg(const char* name, const char* descr, cmd_main_i fn)
 	return ERR_OK;
 }
 
+int cmdRun(int argc, char* argv[])
+{
+	size_t pos;
+	ASSERT(argc > 0);
+	for (pos = 0; pos < _count; ++pos)
+		if (strEq(argv[0], _cmds[pos].name))
+			return _cmds[pos].fn(argc,  argv);
+	printf("bee2cmd: %s\n", errMsg(ERR_CMD_NOT_FOUND));
+	return -1;
+}
+
+/*
+*******************************************************************************
+Самотестирование
+
+Пройденные тесты запоминаются в списке _tested. Команды (в том числе
+команды пакета batch) выполняются последовательно, в одном потоке,
+поэтому список не защищается от одновременного доступа.
+*******************************************************************************
+*/
+
+static size_t _tested_count = 0;		/*< число пройденных тестов */
+static cmd_selftest_i _tested[32];		/*< пройденные тесты */
+
+err_t cmdSelfTest(cmd_selftest_i test)
+{
+	err_t code;
+	size_t pos;
+	// тест уже пройден?
+	for (pos = 0; pos < _tested_count; ++pos)
+		if (_tested[pos] == test)
+			return ERR_OK;
+	// выполнить тест
+	code = test();
+	ERR_CALL_CHECK(code);
+	// запомнить
+	if (_tested_count < COUNT_OF(_tested))
+		_tested[_tested_count++] = test;
+	return ERR_OK;
+}
+
 /*
 *******************************************************************************
 Справка
@@ -116,8 +157,11 @@ extern err_t kgInit();
 extern err_t cvcInit();
 extern err_t cvrInit();
 extern err_t sigInit();
+extern err_t encInit();
+extern err_t decInit();
 extern err_t csrInit();
 extern err_t esInit();
+extern err_t batchInit();
 #ifdef OS_WIN
 extern err_t stampInit();
 #endif
@@ -140,10 +184,16 @@ err_t cmdInit()
 	ERR_CALL_CHECK(code);
 	code = sigInit();
 	ERR_CALL_CHECK(code);
+	code = encInit();
+	ERR_CALL_CHECK(code);
+	code = decInit();
+	ERR_CALL_CHECK(code);
 	code = csrInit();
 	ERR_CALL_CHECK(code);
 	code = esInit();
 	ERR_CALL_CHECK(code);
+	code = batchInit();
+	ERR_CALL_CHECK(code);
 #ifdef OS_WIN
 	code = stampInit();
 	ERR_CALL_CHECK(code);
@@ -160,7 +210,6 @@ err_t cmdInit()
 int main(int argc, char* argv[])
 {
 	err_t code;
-	size_t pos;
 	// старт
 	code = cmdInit();
 	if (code != ERR_OK)
@@ -174,9 +223,5 @@ int main(int argc, char* argv[])
 	// демонстрационный контроль целостности (результат игнорируется!)
 	cmdSelfCheck();
 	// обработка команды
-	for (pos = 0; pos < _count; ++pos)
-		if (strEq(argv[1], _cmds[pos].name))
-			return _cmds[pos].fn(argc - 1,  argv + 1);
-	printf("bee2cmd: %s\n", errMsg(ERR_CMD_NOT_FOUND));
-	return -1;
+	return cmdRun(argc - 1, argv + 1);
 }
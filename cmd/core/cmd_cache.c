@@ -0,0 +1,125 @@
+/*
+*******************************************************************************
+\file cmd_cache.c
+\brief Command-line interface to Bee2: caching
+\project bee2/cmd 
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "../cmd.h"
+#include <bee2/core/blob.h>
+#include <bee2/core/mem.h>
+#include <bee2/core/mt.h>
+#include <bee2/core/util.h>
+
+/*
+*******************************************************************************
+Кэширование
+
+Элемент кэша размещается в блобе: заголовок cmd_cache_entry_st, за которым
+следует значение. Блобы хранятся в кольцевом массиве _entries. Новый
+элемент замещает элемент в позиции _next, после чего позиция сдвигается.
+
+Обращения к элементам выполняются под защитой мьютекса _mtx, который
+создается при включении кэширования.
+
+Одновременно с кэшем включается кэш проверенных подписей CV-сертификатов
+(см. btokCVCCacheStart()) на CMD_CACHE_CVCS_MAX элементов.
+*******************************************************************************
+*/
+
+#define CMD_CACHE_MAX 64
+#define CMD_CACHE_CVCS_MAX 1024
+
+typedef struct
+{
+	size_t type;		/*< тип элемента */
+	octet key[32];		/*< ключ */
+	size_t val_len;		/*< длина значения */
+} cmd_cache_entry_st;
+
+static bool_t _on;								/*< кэширование включено */
+static cmd_cache_entry_st* _entries[CMD_CACHE_MAX];	/*< элементы */
+static size_t _next;							/*< позиция замещения */
+static mt_mtx_t _mtx[1];						/*< мьютекс */
+
+void cmdCacheOn()
+{
+	if (!_on && (_on = mtMtxCreate(_mtx)))
+		btokCVCCacheStart(CMD_CACHE_CVCS_MAX);
+}
+
+bool_t cmdCacheIsOn()
+{
+	return _on;
+}
+
+static cmd_cache_entry_st** cmdCacheFind(size_t type, const octet key[32])
+{
+	size_t pos;
+	for (pos = 0; pos < CMD_CACHE_MAX; ++pos)
+		if (_entries[pos] && _entries[pos]->type == type &&
+			memEq(_entries[pos]->key, key, 32))
+			return _entries + pos;
+	return 0;
+}
+
+bool_t cmdCacheGet(void* val, size_t val_len, size_t type,
+	const octet key[32])
+{
+	cmd_cache_entry_st** entry;
+	ASSERT(memIsValid(key, 32));
+	ASSERT(memIsValid(val, val_len));
+	if (!_on)
+		return FALSE;
+	mtMtxLock(_mtx);
+	if (!(entry = cmdCacheFind(type, key)) || (*entry)->val_len != val_len)
+	{
+		mtMtxUnlock(_mtx);
+		return FALSE;
+	}
+	memCopy(val, *entry + 1, val_len);
+	mtMtxUnlock(_mtx);
+	return TRUE;
+}
+
+void cmdCachePut(size_t type, const octet key[32], const void* val,
+	size_t val_len)
+{
+	cmd_cache_entry_st** entry;
+	cmd_cache_entry_st* e;
+	ASSERT(memIsValid(key, 32));
+	ASSERT(memIsValid(val, val_len));
+	if (!_on)
+		return;
+	// подготовить элемент
+	if (!(e = (cmd_cache_entry_st*)blobCreate(sizeof(*e) + val_len)))
+		return;
+	e->type = type;
+	memCopy(e->key, key, 32);
+	e->val_len = val_len;
+	memCopy(e + 1, val, val_len);
+	// заменить элемент с тем же ключом или самый старый элемент
+	mtMtxLock(_mtx);
+	if (!(entry = cmdCacheFind(type, key)))
+		entry = _entries + _next, _next = (_next + 1) % CMD_CACHE_MAX;
+	blobClose(*entry);
+	*entry = e;
+	mtMtxUnlock(_mtx);
+}
+
+void cmdCacheClose()
+{
+	size_t pos;
+	if (!_on)
+		return;
+	for (pos = 0; pos < CMD_CACHE_MAX; ++pos)
+		blobClose(_entries[pos]), _entries[pos] = 0;
+	mtMtxClose(_mtx);
+	btokCVCCacheStop();
+	_next = 0, _on = FALSE;
+}
@@ -4,7 +4,7 @@
 \brief Command-line interface to Bee2: managing CV-certificates
 \project bee2/cmd
 \created 2022.08.20
-\version 2023.06.19
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -17,6 +17,7 @@
 #include <bee2/core/mem.h>
 #include <bee2/core/str.h>
 #include <bee2/core/util.h>
+#include <bee2/crypto/belt.h>
 #include <stdio.h>
 
 /*
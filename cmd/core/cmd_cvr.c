@@ -0,0 +1,650 @@
+/*
+*******************************************************************************
+\file cmd_cvr.c
+\brief Command-line interface to Bee2: certificate rings
+\project bee2/cmd
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "../cmd.h"
+#include <bee2/core/blob.h>
+#include <bee2/core/err.h>
+#include <bee2/core/mem.h>
+#include <bee2/core/str.h>
+#include <bee2/core/u32.h>
+#include <bee2/core/util.h>
+#include <bee2/crypto/belt.h>
+#include <stdlib.h>
+
+/*
+*******************************************************************************
+Формат индекса
+
+Индекс состоит из заголовка, описаний сертификатов и двух списков номеров
+описаний. Числа кодируются 4 октетами, младший октет первым.
+
+Заголовок (CMD_CVR_HDR_LEN октетов):
+-	[4]"CVRI" -- сигнатура;
+-	[4]version -- версия формата (1);
+-	[4]count -- число сертификатов;
+-	[4]certs_len -- длина коллекции сертификатов;
+-	[32]sig_hash -- хэш-значение beltHash подписи кольца.
+
+Описание сертификата (CMD_CVR_ENTRY_LEN октетов):
+-	[4]offset -- смещение сертификата в коллекции;
+-	[4]len -- длина сертификата;
+-	[16]holder -- имя владельца, дополненное нулями;
+-	[32]pubkey_hash -- хэш-значение beltHash открытого ключа.
+
+Списки номеров (по count номеров, каждый номер -- 4 октета): упорядоченный
+по holder и упорядоченный по pubkey_hash.
+
+Описания и номера, прочитанные из индекса, перед использованием
+проверяются: порча индекса не должна приводить к выходу за пределы
+коллекции.
+*******************************************************************************
+*/
+
+#define CMD_CVR_HDR_LEN		48
+#define CMD_CVR_ENTRY_LEN	56
+#define CMD_CVR_HOLDER		8	/* смещение holder в описании */
+#define CMD_CVR_PUBKEY		24	/* смещение pubkey_hash в описании */
+
+static size_t cmdCVRU32(const octet* buf)
+{
+	u32 w;
+	u32From(&w, buf, 4);
+	return (size_t)w;
+}
+
+static void cmdCVRU32Enc(octet* buf, size_t w)
+{
+	u32 v = (u32)w;
+	u32To(buf, 4, &v);
+}
+
+static char* cmdCVRIndexName(const char* ring)
+{
+	char* name;
+	ASSERT(strIsValid(ring));
+	if (name = (char*)blobCreate(strLen(ring) + 5))
+	{
+		strCopy(name, ring);
+		strCopy(name + strLen(ring), ".idx");
+	}
+	return name;
+}
+
+/*
+*******************************************************************************
+Чтение файлов
+
+Кольцо с индексом в память не загружается. Из индекса читаются заголовок
+и те описания и номера, которые просматриваются при поиске, из кольца --
+подпись (для сверки с заголовком индекса) и найденные сертификаты.
+Чтение выполняется через fseek() / fread(), файлы не отображаются
+в память: сокращение файла другим процессом приводит к ошибке чтения,
+но не к аварийному завершению.
+*******************************************************************************
+*/
+
+static err_t cmdCVRFileRead(void* buf, FILE* fp, size_t offset,
+	size_t count)
+{
+	err_t code = cmdFileSeek(fp, (u64)offset);
+	ERR_CALL_CHECK(code);
+	return fread(buf, 1, count, fp) == count ? ERR_OK : ERR_FILE_READ;
+}
+
+static err_t cmdCVREntryRead(octet entry[CMD_CVR_ENTRY_LEN],
+	const cmd_cvr_t* cvr, size_t num)
+{
+	ASSERT(num < cvr->count);
+	return cmdCVRFileRead(entry, cvr->idx_fp,
+		CMD_CVR_HDR_LEN + num * CMD_CVR_ENTRY_LEN, CMD_CVR_ENTRY_LEN);
+}
+
+static err_t cmdCVRPermRead(size_t* num, const cmd_cvr_t* cvr,
+	bool_t by_pubkey, size_t pos)
+{
+	err_t code;
+	octet buf[4];
+	ASSERT(pos < cvr->count);
+	code = cmdCVRFileRead(buf, cvr->idx_fp, CMD_CVR_HDR_LEN +
+		cvr->count * CMD_CVR_ENTRY_LEN + (by_pubkey ? 4 * cvr->count : 0) +
+		4 * pos, 4);
+	ERR_CALL_CHECK(code);
+	*num = cmdCVRU32(buf);
+	return *num < cvr->count ? ERR_OK : ERR_BAD_CERTRING;
+}
+
+/*
+*******************************************************************************
+Открытие и закрытие
+*******************************************************************************
+*/
+
+static err_t cmdCVRLoad(cmd_cvr_t* cvr, const char* ring, size_t sig_len)
+{
+	err_t code;
+	code = cmdFileLoad(&cvr->ring, ring);
+	ERR_CALL_CHECK(code);
+	if (cvr->ring.len < sig_len)
+		code = ERR_BAD_CERTRING;
+	ERR_CALL_HANDLE(code, cmdFileUnload(&cvr->ring));
+	cvr->certs = cvr->ring.buf;
+	cvr->certs_len = cvr->ring.len - sig_len;
+	return ERR_OK;
+}
+
+static bool_t cmdCVRIndexOpen(cmd_cvr_t* cvr, const char* ring,
+	size_t sig_len)
+{
+	octet hdr[CMD_CVR_HDR_LEN];
+	octet hash[32];
+	octet* sig;
+	size_t ring_len;
+	size_t idx_len;
+	size_t count;
+	char* name;
+	bool_t ok;
+	// открыть индекс
+	if (!(name = cmdCVRIndexName(ring)))
+		return FALSE;
+	idx_len = cmdFileSize(name);
+	if (idx_len != SIZE_MAX)
+		cvr->idx_fp = fopen(name, "rb");
+	cmdBlobClose(name);
+	if (!cvr->idx_fp)
+		return FALSE;
+	// проверить заголовок
+	ring_len = cmdFileSize(ring);
+	ok = ring_len != SIZE_MAX && ring_len >= sig_len &&
+		idx_len >= CMD_CVR_HDR_LEN &&
+		cmdCVRFileRead(hdr, cvr->idx_fp, 0, CMD_CVR_HDR_LEN) == ERR_OK &&
+		memEq(hdr, "CVRI", 4) &&
+		cmdCVRU32(hdr + 4) == 1 &&
+		(count = cmdCVRU32(hdr + 8)) <= (SIZE_MAX - CMD_CVR_HDR_LEN) /
+			(CMD_CVR_ENTRY_LEN + 8) &&
+		idx_len == CMD_CVR_HDR_LEN + count * (CMD_CVR_ENTRY_LEN + 8) &&
+		cmdCVRU32(hdr + 12) == ring_len - sig_len;
+	// сверить хэш-значение подписи кольца
+	if (ok)
+		ok = (cvr->ring_fp = fopen(ring, "rb")) != 0 &&
+			cmdBlobCreate(sig, sig_len) == ERR_OK;
+	if (ok)
+	{
+		ok = cmdCVRFileRead(sig, cvr->ring_fp, ring_len - sig_len,
+			sig_len) == ERR_OK &&
+			beltHash(hash, sig, sig_len) == ERR_OK &&
+			memEq(hdr + 16, hash, 32);
+		cmdBlobClose(sig);
+	}
+	// завершить
+	if (!ok)
+	{
+		if (cvr->ring_fp)
+			fclose(cvr->ring_fp), cvr->ring_fp = 0;
+		fclose(cvr->idx_fp), cvr->idx_fp = 0;
+		return FALSE;
+	}
+	cvr->certs_len = ring_len - sig_len;
+	cvr->count = count;
+	return TRUE;
+}
+
+err_t cmdCVROpen(cmd_cvr_t* cvr, const char* ring)
+{
+	err_t code;
+	cmd_sig_t* sig;
+	size_t sig_len;
+	// pre
+	ASSERT(memIsValid(cvr, sizeof(cmd_cvr_t)));
+	ASSERT(strIsValid(ring));
+	memSetZero(cvr, sizeof(cmd_cvr_t));
+	// определить длину подписи
+	code = cmdBlobCreate(sig, sizeof(cmd_sig_t));
+	ERR_CALL_CHECK(code);
+	code = cmdSigRead(sig, &sig_len, ring);
+	cmdBlobClose(sig);
+	ERR_CALL_CHECK(code);
+	// открыть индекс или загрузить кольцо
+	if (cmdCVRIndexOpen(cvr, ring, sig_len))
+		return ERR_OK;
+	return cmdCVRLoad(cvr, ring, sig_len);
+}
+
+bool_t cmdCVRIsIndexed(const cmd_cvr_t* cvr)
+{
+	ASSERT(memIsValid(cvr, sizeof(cmd_cvr_t)));
+	return cvr->idx_fp != 0;
+}
+
+void cmdCVRClose(cmd_cvr_t* cvr)
+{
+	ASSERT(memIsValid(cvr, sizeof(cmd_cvr_t)));
+	if (cvr->idx_fp)
+		fclose(cvr->idx_fp);
+	if (cvr->ring_fp)
+		fclose(cvr->ring_fp);
+	cmdFileUnload(&cvr->ring);
+	memSetZero(cvr, sizeof(cmd_cvr_t));
+}
+
+/*
+*******************************************************************************
+Поиск
+
+Поиск по владельцу или открытому ключу в индексе -- двоичный: находится
+первая позиция списка номеров, ключ описания в которой не меньше искомого.
+Читаются только описания, которые просматриваются при поиске.
+
+Индексу не доверяется: найденный по индексу сертификат разбирается,
+его владелец (открытый ключ) сверяется с искомым. При несовпадении
+возвращается ERR_BAD_CERTRING.
+*******************************************************************************
+*/
+
+static err_t cmdCVREntryGet(size_t* offset, size_t* cert_len,
+	const cmd_cvr_t* cvr, const octet entry[CMD_CVR_ENTRY_LEN])
+{
+	size_t pos = cmdCVRU32(entry);
+	size_t len = cmdCVRU32(entry + 4);
+	if (len == 0 || pos > cvr->certs_len || len > cvr->certs_len - pos)
+		return ERR_BAD_CERTRING;
+	if (offset)
+		*offset = pos;
+	if (cert_len)
+		*cert_len = len;
+	return ERR_OK;
+}
+
+static err_t cmdCVRLowerBound(size_t* pos, const cmd_cvr_t* cvr,
+	bool_t by_pubkey, const octet* key)
+{
+	err_t code;
+	octet entry[CMD_CVR_ENTRY_LEN];
+	const size_t key_pos = by_pubkey ? CMD_CVR_PUBKEY : CMD_CVR_HOLDER;
+	const size_t key_len = by_pubkey ? 32 : 16;
+	size_t lo = 0, hi = cvr->count;
+	while (lo < hi)
+	{
+		size_t mid = lo + (hi - lo) / 2;
+		size_t num;
+		code = cmdCVRPermRead(&num, cvr, by_pubkey, mid);
+		ERR_CALL_CHECK(code);
+		code = cmdCVREntryRead(entry, cvr, num);
+		ERR_CALL_CHECK(code);
+		if (memCmp(entry + key_pos, key, key_len) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	*pos = lo;
+	return ERR_OK;
+}
+
+static err_t cmdCVRFindKey(size_t* offset, size_t* cert_len,
+	const cmd_cvr_t* cvr, const char* holder, const octet* pubkey,
+	size_t pubkey_len, const octet* cert, size_t len)
+{
+	err_t code;
+	octet key[32];
+	octet entry[CMD_CVR_ENTRY_LEN];
+	const bool_t by_pubkey = holder == 0;
+	const size_t key_pos = by_pubkey ? CMD_CVR_PUBKEY : CMD_CVR_HOLDER;
+	const size_t key_len = by_pubkey ? 32 : 16;
+	btok_cvc_t* cvc;
+	octet* buf;
+	size_t pos;
+	// построить ключ
+	if (by_pubkey)
+	{
+		code = beltHash(key, pubkey, pubkey_len);
+		ERR_CALL_CHECK(code);
+	}
+	else
+	{
+		if (strLen(holder) > 12)
+			return ERR_NOT_FOUND;
+		memSetZero(key, sizeof(key));
+		memCopy(key, holder, strLen(holder));
+	}
+	// найти первую подходящую позицию
+	code = cmdCVRLowerBound(&pos, cvr, by_pubkey, key);
+	ERR_CALL_CHECK(code);
+	// просмотреть позиции с искомым ключом
+	code = cmdBlobCreate(cvc, sizeof(btok_cvc_t));
+	ERR_CALL_CHECK(code);
+	for (code = ERR_NOT_FOUND; pos < cvr->count; ++pos)
+	{
+		size_t num, o, l;
+		err_t code1;
+		if ((code1 = cmdCVRPermRead(&num, cvr, by_pubkey, pos)) != ERR_OK ||
+			(code1 = cmdCVREntryRead(entry, cvr, num)) != ERR_OK)
+		{
+			code = code1;
+			break;
+		}
+		if (!memEq(entry + key_pos, key, key_len))
+			break;
+		// прочитать и разобрать сертификат
+		if ((code1 = cmdCVREntryGet(&o, &l, cvr, entry)) != ERR_OK ||
+			(code1 = cmdBlobCreate(buf, l)) != ERR_OK)
+		{
+			code = code1;
+			break;
+		}
+		if ((code1 = cmdCVRRead(buf, cvr, o, l)) == ERR_OK &&
+			btokCVCUnwrap(cvc, buf, l, 0, 0) != ERR_OK)
+			code1 = ERR_BAD_CERTRING;
+		// сверить с искомым
+		if (code1 == ERR_OK && !(by_pubkey ?
+			cvc->pubkey_len == pubkey_len &&
+				memEq(cvc->pubkey, pubkey, pubkey_len) :
+			strEq(cvc->holder, holder)))
+			code1 = ERR_BAD_CERTRING;
+		if (code1 == ERR_OK && cert && (l != len || !memEq(buf, cert, len)))
+			code1 = ERR_NOT_FOUND;
+		cmdBlobClose(buf);
+		if (code1 == ERR_NOT_FOUND)
+			continue;
+		if (code1 == ERR_OK)
+		{
+			if (offset)
+				*offset = o;
+			if (cert_len)
+				*cert_len = l;
+		}
+		code = code1;
+		break;
+	}
+	cmdBlobClose(cvc);
+	return code;
+}
+
+static err_t cmdCVRFindLinear(size_t* offset, size_t* cert_len,
+	const cmd_cvr_t* cvr, const char* holder, const octet* pubkey,
+	size_t pubkey_len)
+{
+	err_t code;
+	btok_cvc_t* cvc;
+	const octet* certs = cvr->certs;
+	size_t certs_len = cvr->certs_len;
+	size_t len;
+	// подготовить память
+	code = cmdBlobCreate(cvc, sizeof(btok_cvc_t));
+	ERR_CALL_CHECK(code);
+	// цикл по сертификатам
+	for (code = ERR_NOT_FOUND; certs_len; certs += len, certs_len -= len)
+	{
+		len = btokCVCLen(certs, certs_len);
+		if (len == SIZE_MAX ||
+			btokCVCUnwrap(cvc, certs, len, 0, 0) != ERR_OK)
+		{
+			code = ERR_BAD_CERTRING;
+			break;
+		}
+		if (holder ? strEq(cvc->holder, holder) :
+			cvc->pubkey_len == pubkey_len &&
+				memEq(cvc->pubkey, pubkey, pubkey_len))
+		{
+			if (offset)
+				*offset = (size_t)(certs - cvr->certs);
+			if (cert_len)
+				*cert_len = len;
+			code = ERR_OK;
+			break;
+		}
+	}
+	cmdBlobClose(cvc);
+	return code;
+}
+
+err_t cmdCVRCount(size_t* count, const cmd_cvr_t* cvr)
+{
+	ASSERT(memIsValid(cvr, sizeof(cmd_cvr_t)));
+	ASSERT(memIsValid(count, O_PER_S));
+	if (!cmdCVRIsIndexed(cvr))
+		return cmdCVCsCount(count, cvr->certs, cvr->certs_len);
+	*count = cvr->count;
+	return ERR_OK;
+}
+
+err_t cmdCVRGet(size_t* offset, size_t* cert_len, const cmd_cvr_t* cvr,
+	size_t num)
+{
+	err_t code;
+	octet entry[CMD_CVR_ENTRY_LEN];
+	ASSERT(memIsValid(cvr, sizeof(cmd_cvr_t)));
+	if (!cmdCVRIsIndexed(cvr))
+		return cmdCVCsGet(offset, cert_len, cvr->certs, cvr->certs_len, num);
+	if (num >= cvr->count)
+		return ERR_OUTOFRANGE;
+	code = cmdCVREntryRead(entry, cvr, num);
+	ERR_CALL_CHECK(code);
+	return cmdCVREntryGet(offset, cert_len, cvr, entry);
+}
+
+err_t cmdCVRRead(octet cert[], const cmd_cvr_t* cvr, size_t offset,
+	size_t cert_len)
+{
+	err_t code;
+	// pre
+	ASSERT(memIsValid(cvr, sizeof(cmd_cvr_t)));
+	ASSERT(memIsValid(cert, cert_len));
+	// входной контроль
+	if (offset > cvr->certs_len || cert_len > cvr->certs_len - offset)
+		return ERR_BAD_CERTRING;
+	// прочитать
+	if (!cmdCVRIsIndexed(cvr))
+		memCopy(cert, cvr->certs + offset, cert_len);
+	else
+	{
+		code = cmdCVRFileRead(cert, cvr->ring_fp, offset, cert_len);
+		ERR_CALL_CHECK(code);
+	}
+	// проверить длину
+	return btokCVCLen(cert, cert_len) == cert_len ? ERR_OK :
+		ERR_BAD_CERTRING;
+}
+
+err_t cmdCVRFind(size_t* offset, const cmd_cvr_t* cvr, const octet* cert,
+	size_t cert_len)
+{
+	err_t code;
+	btok_cvc_t* cvc;
+	// pre
+	ASSERT(memIsValid(cvr, sizeof(cmd_cvr_t)));
+	ASSERT(memIsValid(cert, cert_len));
+	// нет индекса?
+	if (!cmdCVRIsIndexed(cvr))
+		return cmdCVCsFind(offset, cvr->certs, cvr->certs_len, cert,
+			cert_len);
+	// определить владельца
+	code = cmdBlobCreate(cvc, sizeof(btok_cvc_t));
+	ERR_CALL_CHECK(code);
+	if (btokCVCUnwrap(cvc, cert, cert_len, 0, 0) != ERR_OK)
+		code = ERR_NOT_FOUND;
+	ERR_CALL_HANDLE(code, cmdBlobClose(cvc));
+	// искать
+	code = cmdCVRFindKey(offset, 0, cvr, cvc->holder, 0, 0, cert,
+		cert_len);
+	cmdBlobClose(cvc);
+	return code;
+}
+
+err_t cmdCVRFindHolder(size_t* offset, size_t* cert_len,
+	const cmd_cvr_t* cvr, const char* holder)
+{
+	// pre
+	ASSERT(memIsValid(cvr, sizeof(cmd_cvr_t)));
+	ASSERT(strIsValid(holder));
+	// искать
+	if (!cmdCVRIsIndexed(cvr))
+		return cmdCVRFindLinear(offset, cert_len, cvr, holder, 0, 0);
+	return cmdCVRFindKey(offset, cert_len, cvr, holder, 0, 0, 0, 0);
+}
+
+err_t cmdCVRFindPubkey(size_t* offset, size_t* cert_len,
+	const cmd_cvr_t* cvr, const octet* pubkey, size_t pubkey_len)
+{
+	// pre
+	ASSERT(memIsValid(cvr, sizeof(cmd_cvr_t)));
+	ASSERT(memIsValid(pubkey, pubkey_len));
+	// искать
+	if (!cmdCVRIsIndexed(cvr))
+		return cmdCVRFindLinear(offset, cert_len, cvr, 0, pubkey,
+			pubkey_len);
+	return cmdCVRFindKey(offset, cert_len, cvr, 0, pubkey, pubkey_len,
+		0, 0);
+}
+
+/*
+*******************************************************************************
+Индексирование
+
+Списки номеров строятся сортировкой (qsort()) вспомогательных записей
+"ключ || номер". Номер участвует в сравнении, поэтому номера описаний
+с равными ключами следуют по возрастанию.
+*******************************************************************************
+*/
+
+typedef struct
+{
+	octet key[32];		/*< ключ (holder или pubkey_hash) */
+	size_t num;			/*< номер описания */
+} cmd_cvr_rec_st;
+
+static int cmdCVRRecCmp(const void* a, const void* b)
+{
+	const cmd_cvr_rec_st* ra = (const cmd_cvr_rec_st*)a;
+	const cmd_cvr_rec_st* rb = (const cmd_cvr_rec_st*)b;
+	int cmp = memCmp(ra->key, rb->key, 32);
+	if (cmp)
+		return cmp;
+	return ra->num < rb->num ? -1 : ra->num > rb->num;
+}
+
+err_t cmdCVRIndex(const char* ring)
+{
+	err_t code;
+	cmd_cvr_t cvr[1];
+	cmd_sig_t* sig;
+	size_t sig_len;
+	size_t count;
+	size_t idx_len;
+	octet* idx;
+	cmd_cvr_rec_st* recs;
+	btok_cvc_t* cvc;
+	const octet* certs;
+	size_t len;
+	size_t num;
+	char* name;
+	// pre
+	ASSERT(strIsValid(ring));
+	// загрузить кольцо
+	memSetZero(cvr, sizeof(cmd_cvr_t));
+	code = cmdBlobCreate(sig, sizeof(cmd_sig_t));
+	ERR_CALL_CHECK(code);
+	code = cmdSigRead(sig, &sig_len, ring);
+	cmdBlobClose(sig);
+	ERR_CALL_CHECK(code);
+	code = cmdCVRLoad(cvr, ring, sig_len);
+	ERR_CALL_CHECK(code);
+	// определить число сертификатов
+	code = cmdCVCsCount(&count, cvr->certs, cvr->certs_len);
+	ERR_CALL_HANDLE(code, cmdCVRClose(cvr));
+	if ((u32)count != count || (u32)cvr->certs_len != cvr->certs_len ||
+		count > (SIZE_MAX - CMD_CVR_HDR_LEN) / (CMD_CVR_ENTRY_LEN + 8) ||
+		count > SIZE_MAX / sizeof(cmd_cvr_rec_st))
+		code = ERR_OVERFLOW;
+	ERR_CALL_HANDLE(code, cmdCVRClose(cvr));
+	// выделить и разметить память
+	idx_len = CMD_CVR_HDR_LEN + count * (CMD_CVR_ENTRY_LEN + 8);
+	code = cmdBlobCreate(idx, idx_len + count * sizeof(cmd_cvr_rec_st) +
+		sizeof(btok_cvc_t));
+	ERR_CALL_HANDLE(code, cmdCVRClose(cvr));
+	recs = (cmd_cvr_rec_st*)(idx + idx_len);
+	cvc = (btok_cvc_t*)(recs + count);
+	// заголовок
+	memCopy(idx, "CVRI", 4);
+	cmdCVRU32Enc(idx + 4, 1);
+	cmdCVRU32Enc(idx + 8, count);
+	cmdCVRU32Enc(idx + 12, cvr->certs_len);
+	code = beltHash(idx + 16, cvr->ring.buf + cvr->certs_len, sig_len);
+	ERR_CALL_HANDLE(code, (cmdBlobClose(idx), cmdCVRClose(cvr)));
+	// описания сертификатов
+	certs = cvr->certs;
+	for (num = 0; num < count; ++num, certs += len)
+	{
+		octet* entry = idx + CMD_CVR_HDR_LEN + num * CMD_CVR_ENTRY_LEN;
+		len = btokCVCLen(certs, cvr->certs_len - (certs - cvr->certs));
+		ASSERT(len != SIZE_MAX);
+		code = btokCVCUnwrap(cvc, certs, len, 0, 0);
+		if (code != ERR_OK)
+			code = ERR_BAD_CERTRING;
+		ERR_CALL_HANDLE(code, (cmdBlobClose(idx), cmdCVRClose(cvr)));
+		cmdCVRU32Enc(entry, (size_t)(certs - cvr->certs));
+		cmdCVRU32Enc(entry + 4, len);
+		memCopy(entry + CMD_CVR_HOLDER, cvc->holder, strLen(cvc->holder));
+		code = beltHash(entry + CMD_CVR_PUBKEY, cvc->pubkey,
+			cvc->pubkey_len);
+		ERR_CALL_HANDLE(code, (cmdBlobClose(idx), cmdCVRClose(cvr)));
+	}
+	// список, упорядоченный по владельцам
+	for (num = 0; num < count; ++num)
+	{
+		memSetZero(recs[num].key, 32);
+		memCopy(recs[num].key, idx + CMD_CVR_HDR_LEN +
+			num * CMD_CVR_ENTRY_LEN + CMD_CVR_HOLDER, 16);
+		recs[num].num = num;
+	}
+	if (count)
+		qsort(recs, count, sizeof(cmd_cvr_rec_st), cmdCVRRecCmp);
+	for (num = 0; num < count; ++num)
+		cmdCVRU32Enc(idx + CMD_CVR_HDR_LEN + count * CMD_CVR_ENTRY_LEN +
+			4 * num, recs[num].num);
+	// список, упорядоченный по открытым ключам
+	for (num = 0; num < count; ++num)
+	{
+		memCopy(recs[num].key, idx + CMD_CVR_HDR_LEN +
+			num * CMD_CVR_ENTRY_LEN + CMD_CVR_PUBKEY, 32);
+		recs[num].num = num;
+	}
+	if (count)
+		qsort(recs, count, sizeof(cmd_cvr_rec_st), cmdCVRRecCmp);
+	for (num = 0; num < count; ++num)
+		cmdCVRU32Enc(idx + CMD_CVR_HDR_LEN + count * (CMD_CVR_ENTRY_LEN + 4) +
+			4 * num, recs[num].num);
+	cmdCVRClose(cvr);
+	// записать индекс
+	name = cmdCVRIndexName(ring);
+	code = name ? ERR_OK : ERR_OUTOFMEMORY;
+	ERR_CALL_HANDLE(code, cmdBlobClose(idx));
+	code = cmdFileWrite(name, idx, idx_len);
+	// завершить
+	cmdBlobClose(name);
+	cmdBlobClose(idx);
+	return code;
+}
+
+err_t cmdCVRIndexUpdate(const char* ring)
+{
+	size_t size;
+	char* name;
+	// pre
+	ASSERT(strIsValid(ring));
+	// индекс есть?
+	name = cmdCVRIndexName(ring);
+	if (!name)
+		return ERR_OUTOFMEMORY;
+	size = cmdFileSize(name);
+	cmdBlobClose(name);
+	// обновить индекс
+	return size == SIZE_MAX ? ERR_OK : cmdCVRIndex(ring);
+}
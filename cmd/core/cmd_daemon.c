@@ -0,0 +1,274 @@
+/*
+*******************************************************************************
+\file cmd_daemon.c
+\brief Command-line interface to Bee2: signing daemon protocol
+\project bee2/cmd
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "../cmd.h"
+#include <bee2/core/err.h>
+#include <bee2/core/mem.h>
+#include <bee2/core/str.h>
+#include <bee2/core/util.h>
+#ifdef OS_UNIX
+	#include <errno.h>
+	#include <poll.h>
+	#include <sys/socket.h>
+	#include <sys/stat.h>
+	#include <sys/un.h>
+	#include <unistd.h>
+#endif
+
+/*
+*******************************************************************************
+Длины
+
+Длина сообщения и код ошибки кодируются 4 октетами big-endian.
+*******************************************************************************
+*/
+
+static void cmdDaemonEnc4(octet buf[4], u32 val)
+{
+	buf[0] = (octet)(val >> 24), buf[1] = (octet)(val >> 16);
+	buf[2] = (octet)(val >> 8), buf[3] = (octet)val;
+}
+
+static u32 cmdDaemonDec4(const octet buf[4])
+{
+	return (u32)buf[0] << 24 | (u32)buf[1] << 16 | (u32)buf[2] << 8 |
+		(u32)buf[3];
+}
+
+#ifdef OS_UNIX
+
+/*
+*******************************************************************************
+Сокеты
+
+При записи в закрытый сокет не должен генерироваться сигнал SIGPIPE.
+Там, где доступен флаг MSG_NOSIGNAL, он указывается при отправке.
+В остальных случаях SIGPIPE должен игнорироваться процессом.
+*******************************************************************************
+*/
+
+#ifndef MSG_NOSIGNAL
+	#define MSG_NOSIGNAL 0
+#endif
+
+static err_t cmdDaemonAddr(struct sockaddr_un* addr, const char* name)
+{
+	if (!strIsValid(name) || strLen(name) == 0 ||
+		strLen(name) >= sizeof(addr->sun_path))
+		return ERR_BAD_NAME;
+	memSetZero(addr, sizeof(struct sockaddr_un));
+	addr->sun_family = AF_UNIX;
+	strCopy(addr->sun_path, name);
+	return ERR_OK;
+}
+
+err_t cmdDaemonListen(int* sock, const char* name)
+{
+	err_t code;
+	struct sockaddr_un addr[1];
+	ASSERT(memIsValid(sock, sizeof(int)));
+	// подготовить адрес
+	code = cmdDaemonAddr(addr, name);
+	ERR_CALL_CHECK(code);
+	if (access(name, F_OK) == 0)
+		return ERR_FILE_EXISTS;
+	// создать сокет
+	if ((*sock = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+		return ERR_SYS;
+	// привязать к адресу (доступ только владельцу)
+	{
+		mode_t mask = umask(077);
+		code = bind(*sock, (struct sockaddr*)addr, sizeof(addr)) == 0 ?
+			ERR_OK : ERR_FILE_CREATE;
+		umask(mask);
+	}
+	ERR_CALL_HANDLE(code, close(*sock));
+	// слушать
+	code = listen(*sock, SOMAXCONN) == 0 ? ERR_OK : ERR_SYS;
+	ERR_CALL_HANDLE(code, (close(*sock), unlink(name)));
+	return code;
+}
+
+err_t cmdDaemonAccept(int* conn, int sock, size_t timeout)
+{
+	struct pollfd fd[1];
+	int ret;
+	ASSERT(memIsValid(conn, sizeof(int)));
+	*conn = -1;
+	// ждать соединения
+	fd->fd = sock, fd->events = POLLIN, fd->revents = 0;
+	ret = poll(fd, 1, (int)MIN2(timeout, 60000));
+	if (ret < 0)
+		return errno == EINTR ? ERR_OK : ERR_SYS;
+	if (ret == 0)
+		return ERR_OK;
+	// принять соединение
+	if ((*conn = accept(sock, 0, 0)) < 0)
+	{
+		*conn = -1;
+		return errno == EINTR || errno == ECONNABORTED ? ERR_OK : ERR_SYS;
+	}
+	return ERR_OK;
+}
+
+err_t cmdDaemonConnect(int* sock, const char* name)
+{
+	err_t code;
+	struct sockaddr_un addr[1];
+	ASSERT(memIsValid(sock, sizeof(int)));
+	// подготовить адрес
+	code = cmdDaemonAddr(addr, name);
+	ERR_CALL_CHECK(code);
+	// создать сокет
+	if ((*sock = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+		return ERR_SYS;
+	// соединиться
+	code = connect(*sock, (struct sockaddr*)addr, sizeof(addr)) == 0 ?
+		ERR_OK : ERR_FILE_OPEN;
+	ERR_CALL_HANDLE(code, close(*sock));
+	return code;
+}
+
+static err_t cmdDaemonWriteAll(int sock, const octet* buf, size_t count)
+{
+	while (count)
+	{
+		ssize_t t = send(sock, buf, count, MSG_NOSIGNAL);
+		if (t < 0 && errno == EINTR)
+			continue;
+		if (t <= 0)
+			return ERR_FILE_WRITE;
+		buf += t, count -= (size_t)t;
+	}
+	return ERR_OK;
+}
+
+static err_t cmdDaemonReadAll(octet* buf, size_t count, int sock)
+{
+	while (count)
+	{
+		ssize_t t = recv(sock, buf, count, 0);
+		if (t < 0 && errno == EINTR)
+			continue;
+		if (t < 0)
+			return ERR_FILE_READ;
+		if (t == 0)
+			return ERR_FILE_EOF;
+		buf += t, count -= (size_t)t;
+	}
+	return ERR_OK;
+}
+
+err_t cmdDaemonSend(int sock, const void* msg, size_t count)
+{
+	err_t code;
+	octet len[4];
+	ASSERT(memIsValid(msg, count));
+	if (count > CMD_DAEMON_MSG_MAX)
+		return ERR_BAD_INPUT;
+	cmdDaemonEnc4(len, (u32)count);
+	code = cmdDaemonWriteAll(sock, len, 4);
+	ERR_CALL_CHECK(code);
+	return cmdDaemonWriteAll(sock, (const octet*)msg, count);
+}
+
+err_t cmdDaemonRecv(void* msg, size_t* count, int sock)
+{
+	err_t code;
+	octet len[4];
+	ASSERT(memIsValid(msg, CMD_DAEMON_MSG_MAX));
+	ASSERT(memIsValid(count, sizeof(size_t)));
+	// прочитать длину
+	code = cmdDaemonReadAll(len, 4, sock);
+	ERR_CALL_CHECK(code);
+	*count = cmdDaemonDec4(len);
+	if (*count > CMD_DAEMON_MSG_MAX)
+		return ERR_BAD_FORMAT;
+	// прочитать сообщение
+	code = cmdDaemonReadAll((octet*)msg, *count, sock);
+	return code == ERR_FILE_EOF ? ERR_FILE_READ : code;
+}
+
+void cmdDaemonClose(int sock, const char* name)
+{
+	if (sock >= 0)
+		close(sock);
+	if (name)
+		unlink(name);
+}
+
+#else
+
+err_t cmdDaemonListen(int* sock, const char* name)
+{
+	return ERR_NOT_IMPLEMENTED;
+}
+
+err_t cmdDaemonAccept(int* conn, int sock, size_t timeout)
+{
+	return ERR_NOT_IMPLEMENTED;
+}
+
+err_t cmdDaemonConnect(int* sock, const char* name)
+{
+	return ERR_NOT_IMPLEMENTED;
+}
+
+err_t cmdDaemonSend(int sock, const void* msg, size_t count)
+{
+	return ERR_NOT_IMPLEMENTED;
+}
+
+err_t cmdDaemonRecv(void* msg, size_t* count, int sock)
+{
+	return ERR_NOT_IMPLEMENTED;
+}
+
+void cmdDaemonClose(int sock, const char* name)
+{
+}
+
+#endif
+
+/*
+*******************************************************************************
+Запрос
+*******************************************************************************
+*/
+
+err_t cmdDaemonCall(void* resp, size_t* resp_len, int sock, octet op,
+	const void* req, size_t req_len)
+{
+	err_t code;
+	octet msg[CMD_DAEMON_MSG_MAX];
+	size_t count;
+	ASSERT(memIsValid(resp, CMD_DAEMON_MSG_MAX));
+	ASSERT(memIsValid(resp_len, sizeof(size_t)));
+	ASSERT(memIsValid(req, req_len));
+	// отправить запрос
+	if (req_len >= CMD_DAEMON_MSG_MAX)
+		return ERR_BAD_INPUT;
+	msg[0] = op;
+	memCopy(msg + 1, req, req_len);
+	code = cmdDaemonSend(sock, msg, 1 + req_len);
+	ERR_CALL_CHECK(code);
+	// получить ответ
+	code = cmdDaemonRecv(msg, &count, sock);
+	ERR_CALL_CHECK(code);
+	if (count < 4)
+		return ERR_BAD_FORMAT;
+	code = (err_t)cmdDaemonDec4(msg);
+	ERR_CALL_CHECK(code);
+	// возвратить результат
+	memCopy(resp, msg + 4, *resp_len = count - 4);
+	return ERR_OK;
+}
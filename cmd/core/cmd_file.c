@@ -4,7 +4,7 @@
 \brief Command-line interface to Bee2: file management
 \project bee2/cmd 
 \created 2022.06.08
-\version 2023.06.23
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -14,21 +14,87 @@
 #include <bee2/core/blob.h>
 #include <bee2/core/err.h>
 #include <bee2/core/mem.h>
+#include <bee2/core/mt.h>
 #include <bee2/core/str.h>
 #include <bee2/core/util.h>
 #include <stdio.h>
 #include <stdlib.h>
+#ifdef OS_UNIX
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#elif defined OS_WIN
+	#include <windows.h>
+#endif
 
 /*
 *******************************************************************************
-Размер файла
+Размер файла и позиционирование
+
+Функции ftell() и fseek() работают со смещениями типа long, который
+на некоторых платформах (например, Windows) 32-битовый. Поэтому
+используются их 64-битовые аналоги.
 *******************************************************************************
 */
 
+#ifdef OS_UNIX
+
+static bool_t cmdFileTell(u64* pos, FILE* fp)
+{
+	off_t p = ftello(fp);
+	*pos = (u64)p;
+	return p >= 0;
+}
+
+err_t cmdFileSeek(FILE* fp, u64 offset)
+{
+	ASSERT(fp);
+	if ((u64)(off_t)offset != offset || (off_t)offset < 0)
+		return ERR_OVERFLOW;
+	return fseeko(fp, (off_t)offset, SEEK_SET) == 0 ? ERR_OK : ERR_FILE_READ;
+}
+
+#elif defined OS_WIN
+
+static bool_t cmdFileTell(u64* pos, FILE* fp)
+{
+	__int64 p = _ftelli64(fp);
+	*pos = (u64)p;
+	return p >= 0;
+}
+
+err_t cmdFileSeek(FILE* fp, u64 offset)
+{
+	ASSERT(fp);
+	if ((__int64)offset < 0)
+		return ERR_OVERFLOW;
+	return _fseeki64(fp, (__int64)offset, SEEK_SET) == 0 ?
+		ERR_OK : ERR_FILE_READ;
+}
+
+#else
+
+static bool_t cmdFileTell(u64* pos, FILE* fp)
+{
+	long p = ftell(fp);
+	*pos = (u64)p;
+	return p >= 0;
+}
+
+err_t cmdFileSeek(FILE* fp, u64 offset)
+{
+	ASSERT(fp);
+	if ((u64)(long)offset != offset || (long)offset < 0)
+		return ERR_OVERFLOW;
+	return fseek(fp, (long)offset, SEEK_SET) == 0 ? ERR_OK : ERR_FILE_READ;
+}
+
+#endif
+
 size_t cmdFileSize(const char* file)
 {
 	FILE* fp;
-	long size;
+	u64 size;
 	ASSERT(strIsValid(file));
 	if (!(fp = fopen(file, "rb")))
 		return SIZE_MAX;
@@ -37,9 +103,10 @@ size_t cmdFileSize(const char* file)
 		fclose(fp);
 		return SIZE_MAX;
 	}
-	size = ftell(fp);
+	if (!cmdFileTell(&size, fp) || (u64)(size_t)size != size)
+		size = SIZE_MAX;
 	fclose(fp);
-	return (size == -1L) ? SIZE_MAX : (size_t)size;
+	return (size_t)size;
 }
 
 /*
@@ -108,6 +175,328 @@ err_t cmdFileReadAll(void* buf, size_t* count, const char* file)
 	return code;
 }
 
+/*
+*******************************************************************************
+Последовательное чтение
+
+Функция cmdFileSeqOpen() открывает файл для последовательного чтения.
+ОС получает указание читать файл последовательно (posix_fadvise(
+POSIX_FADV_SEQUENTIAL), флаг FILE_FLAG_SEQUENTIAL_SCAN), т.е. увеличить
+окно упреждающего чтения.
+
+Функция cmdFileSeqRead() читает из файла не более count октетов. Число
+прочитанных октетов возвращается по адресу len. По достижении конца файла
+возвращается *len == 0.
+*******************************************************************************
+*/
+
+#ifdef OS_UNIX
+
+typedef int cmd_file_seq_t;
+
+static err_t cmdFileSeqOpen(cmd_file_seq_t* fh, const char* file)
+{
+	if ((*fh = open(file, O_RDONLY)) == -1)
+		return ERR_FILE_OPEN;
+#ifdef POSIX_FADV_SEQUENTIAL
+	posix_fadvise(*fh, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+	return ERR_OK;
+}
+
+static err_t cmdFileSeqRead(size_t* len, void* buf, size_t count,
+	cmd_file_seq_t fh)
+{
+	ssize_t ret;
+	do
+		ret = read(fh, buf, count);
+	while (ret == -1 && errno == EINTR);
+	if (ret == -1)
+		return ERR_FILE_READ;
+	*len = (size_t)ret;
+	return ERR_OK;
+}
+
+static void cmdFileSeqClose(cmd_file_seq_t fh)
+{
+	close(fh);
+}
+
+#elif defined OS_WIN
+
+typedef HANDLE cmd_file_seq_t;
+
+static err_t cmdFileSeqOpen(cmd_file_seq_t* fh, const char* file)
+{
+	*fh = CreateFileA(file, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING,
+		FILE_FLAG_SEQUENTIAL_SCAN, 0);
+	return *fh != INVALID_HANDLE_VALUE ? ERR_OK : ERR_FILE_OPEN;
+}
+
+static err_t cmdFileSeqRead(size_t* len, void* buf, size_t count,
+	cmd_file_seq_t fh)
+{
+	DWORD ret;
+	if (!ReadFile(fh, buf, (DWORD)count, &ret, 0))
+		return ERR_FILE_READ;
+	*len = (size_t)ret;
+	return ERR_OK;
+}
+
+static void cmdFileSeqClose(cmd_file_seq_t fh)
+{
+	CloseHandle(fh);
+}
+
+#else
+
+typedef FILE* cmd_file_seq_t;
+
+static err_t cmdFileSeqOpen(cmd_file_seq_t* fh, const char* file)
+{
+	return (*fh = fopen(file, "rb")) ? ERR_OK : ERR_FILE_OPEN;
+}
+
+static err_t cmdFileSeqRead(size_t* len, void* buf, size_t count,
+	cmd_file_seq_t fh)
+{
+	*len = fread(buf, 1, count, fh);
+	return ferror(fh) ? ERR_FILE_READ : ERR_OK;
+}
+
+static void cmdFileSeqClose(cmd_file_seq_t fh)
+{
+	fclose(fh);
+}
+
+#endif // OS
+
+/*
+*******************************************************************************
+Потоковая обработка
+
+Файл читается блоками по CMD_FILE_BLOCK_SIZE октетов в кольцо из
+CMD_FILE_RING буферов. Буферы выровнены на границу CMD_FILE_ALIGN октетов
+(страницы памяти). Блоки читает отдельный поток-читатель, а функция
+step() вызывается в потоке cmdFileStream(). Читатель опережает
+обработку на несколько блоков: он приостанавливается, только если все
+буферы кольца заняты необработанными блоками. Таким образом, чтение
+с диска и обработка данных выполняются одновременно, а задержки
+ввода-вывода сглаживаются.
+
+Состояние кольца (счетчики head и tail прочитанных и обработанных блоков,
+признак eof завершения чтения) защищается мьютексом. О его изменении
+потоки оповещают друг друга через условную переменную. Остаток файла
+count читается и изменяется только читателем.
+
+Если файл помещается в один блок или поток-читатель создать не удалось
+(например, ОС не распознана), то файл читается и обрабатывается
+в вызывающем потоке с использованием одного буфера.
+
+При ошибке чтения сначала обрабатываются ранее прочитанные блоки, затем
+возвращается ERR_FILE_READ. Так же ведет себя и синхронное чтение.
+
+Файл не отображается в память: при отображении ошибка чтения или сокращение
+файла во время обработки приводили бы к аварийному завершению (сигнал
+SIGBUS в Unix, исключение EXCEPTION_IN_PAGE_ERROR в Windows), а не
+к возврату ERR_FILE_READ.
+*******************************************************************************
+*/
+
+#define CMD_FILE_BLOCK_SIZE ((size_t)1 << 20)
+#define CMD_FILE_RING 4
+#define CMD_FILE_ALIGN ((size_t)4096)
+
+typedef struct
+{
+	cmd_file_seq_t fh;				/*< файл */
+	size_t count;					/*< остаток (SIZE_MAX -- до конца) */
+	octet* bufs[CMD_FILE_RING];		/*< буферы кольца */
+	size_t lens[CMD_FILE_RING];		/*< длины прочитанных блоков */
+	size_t head;					/*< число прочитанных блоков */
+	size_t tail;					/*< число обработанных блоков */
+	bool_t eof;						/*< чтение завершено? */
+	err_t code;						/*< код завершения чтения */
+	mt_mtx_t mtx[1];				/*< мьютекс кольца */
+	mt_cond_t cv[1];				/*< условная переменная кольца */
+	mt_thrd_t thrd[1];				/*< поток-читатель */
+} cmd_file_stream_st;
+
+static err_t cmdFileStreamRead(size_t* len, octet* buf,
+	cmd_file_stream_st* s)
+{
+	err_t code;
+	const bool_t all = (s->count == SIZE_MAX);
+	*len = 0;
+	if (!all && s->count == 0)
+		return ERR_OK;
+	code = cmdFileSeqRead(len, buf, all ? CMD_FILE_BLOCK_SIZE :
+		MIN2(s->count, CMD_FILE_BLOCK_SIZE), s->fh);
+	ERR_CALL_CHECK(code);
+	if (*len == 0 && !all)
+		return ERR_FILE_READ;
+	if (!all)
+		s->count -= *len;
+	return ERR_OK;
+}
+
+static void cmdFileStreamReader(void* arg)
+{
+	cmd_file_stream_st* s = (cmd_file_stream_st*)arg;
+	size_t pos;
+	size_t len;
+	err_t code;
+	for (pos = 0;; ++pos)
+	{
+		// дождаться свободного буфера
+		mtMtxLock(s->mtx);
+		while (pos - s->tail == CMD_FILE_RING)
+			mtCondWait(s->cv, s->mtx);
+		mtMtxUnlock(s->mtx);
+		// прочитать блок
+		code = cmdFileStreamRead(&len, s->bufs[pos % CMD_FILE_RING], s);
+		// опубликовать блок или завершить чтение
+		mtMtxLock(s->mtx);
+		if (code != ERR_OK || len == 0)
+			s->code = code, s->eof = TRUE;
+		else
+			s->lens[pos % CMD_FILE_RING] = len, s->head = pos + 1;
+		mtCondBroadcast(s->cv);
+		mtMtxUnlock(s->mtx);
+		if (code != ERR_OK || len == 0)
+			break;
+	}
+}
+
+static bool_t cmdFileStreamStart(cmd_file_stream_st* s)
+{
+	if (!mtMtxCreate(s->mtx))
+		return FALSE;
+	if (!mtCondCreate(s->cv))
+	{
+		mtMtxClose(s->mtx);
+		return FALSE;
+	}
+	s->head = s->tail = 0, s->eof = FALSE, s->code = ERR_OK;
+	if (!mtThrdCreate(s->thrd, cmdFileStreamReader, s))
+	{
+		mtCondClose(s->cv);
+		mtMtxClose(s->mtx);
+		return FALSE;
+	}
+	return TRUE;
+}
+
+static err_t cmdFileStreamRun(cmd_file_stream_st* s, cmd_step_i step,
+	void* state)
+{
+	err_t code;
+	size_t pos;
+	size_t len;
+	for (pos = 0;; ++pos)
+	{
+		// дождаться прочитанного блока
+		mtMtxLock(s->mtx);
+		while (pos == s->head && !s->eof)
+			mtCondWait(s->cv, s->mtx);
+		if (pos == s->head)
+		{
+			code = s->code;
+			mtMtxUnlock(s->mtx);
+			break;
+		}
+		len = s->lens[pos % CMD_FILE_RING];
+		mtMtxUnlock(s->mtx);
+		// обработать блок и освободить буфер
+		step(s->bufs[pos % CMD_FILE_RING], len, state);
+		mtMtxLock(s->mtx);
+		s->tail = pos + 1;
+		mtCondBroadcast(s->cv);
+		mtMtxUnlock(s->mtx);
+	}
+	mtThrdJoin(s->thrd);
+	mtCondClose(s->cv);
+	mtMtxClose(s->mtx);
+	return code;
+}
+
+err_t cmdFileStream(const char* file, size_t count, cmd_step_i step,
+	void* state)
+{
+	err_t code;
+	cmd_file_stream_st s[1];
+	size_t size;
+	size_t ring;
+	size_t len;
+	void* stack;
+	octet* buf;
+	// pre
+	ASSERT(strIsValid(file));
+	// определить число буферов
+	size = count == SIZE_MAX ? cmdFileSize(file) : count;
+	ring = size <= CMD_FILE_BLOCK_SIZE ? 1 : CMD_FILE_RING;
+	// открыть файл
+	code = cmdFileSeqOpen(&s->fh, file);
+	ERR_CALL_CHECK(code);
+	s->count = count;
+	// создать выровненные буферы
+	code = cmdBlobCreate(stack, CMD_FILE_ALIGN + ring * CMD_FILE_BLOCK_SIZE);
+	ERR_CALL_HANDLE(code, cmdFileSeqClose(s->fh));
+	buf = (octet*)stack + (CMD_FILE_ALIGN -
+		(size_t)((uintptr_t)stack % CMD_FILE_ALIGN)) % CMD_FILE_ALIGN;
+	for (len = 0; len < ring; ++len)
+		s->bufs[len] = buf + len * CMD_FILE_BLOCK_SIZE;
+	// читать в отдельном потоке
+	if (ring > 1 && cmdFileStreamStart(s))
+		code = cmdFileStreamRun(s, step, state);
+	// читать в вызывающем потоке
+	else
+		while ((code = cmdFileStreamRead(&len, buf, s)) == ERR_OK && len)
+			step(buf, len, state);
+	// завершить
+	cmdFileSeqClose(s->fh);
+	cmdBlobClose(stack);
+	return code;
+}
+
+/*
+*******************************************************************************
+Загрузка
+
+Файл прочитывается целиком в блоб. Пустой файл не загружается (buf == 0,
+len == 0).
+*******************************************************************************
+*/
+
+err_t cmdFileLoad(cmd_fbuf_t* fbuf, const char* file)
+{
+	err_t code;
+	size_t len;
+	// pre
+	ASSERT(memIsValid(fbuf, sizeof(cmd_fbuf_t)));
+	ASSERT(strIsValid(file));
+	memSetZero(fbuf, sizeof(cmd_fbuf_t));
+	// определить длину файла
+	code = cmdFileReadAll(0, &len, file);
+	ERR_CALL_CHECK(code);
+	if (len == 0)
+		return ERR_OK;
+	// прочитать файл
+	code = cmdBlobCreate(fbuf->blob, len);
+	ERR_CALL_CHECK(code);
+	code = cmdFileReadAll(fbuf->blob, &len, file);
+	ERR_CALL_HANDLE(code, (cmdBlobClose(fbuf->blob), fbuf->blob = 0));
+	fbuf->buf = (const octet*)fbuf->blob, fbuf->len = len;
+	return code;
+}
+
+void cmdFileUnload(cmd_fbuf_t* fbuf)
+{
+	ASSERT(memIsValid(fbuf, sizeof(cmd_fbuf_t)));
+	cmdBlobClose(fbuf->blob);
+	memSetZero(fbuf, sizeof(cmd_fbuf_t));
+}
+
 /*
 *******************************************************************************
 Дублирование
@@ -124,19 +513,13 @@ err_t cmdFileDup(const char* ofile, const char* ifile, size_t skip,
 	void* buf;
 	// pre
 	ASSERT(strIsValid(ifile) && strIsValid(ofile));
-	// переполнение?
-	if ((size_t)(long)skip != skip)
-		return ERR_OVERFLOW;
 	// открыть входной файл
 	ifp = fopen(ifile, "rb");
 	if (!ifp)
 		return ERR_FILE_OPEN;
 	// пропустить skip октетов
-	if (fseek(ifp, (long)skip, SEEK_SET))
-	{
-		fclose(ifp);
-		return ERR_FILE_READ;
-	}
+	code = cmdFileSeek(ifp, (u64)skip);
+	ERR_CALL_HANDLE(code, fclose(ifp));
 	// открыть выходной файл
 	ofp = fopen(ofile, "wb");
 	if (!ofp)
@@ -0,0 +1,123 @@
+/*
+*******************************************************************************
+\file cmd_jobs.c
+\brief Command-line interface to Bee2: parallel jobs
+\project bee2/cmd
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "../cmd.h"
+#include <bee2/core/mem.h>
+#include <bee2/core/mt.h>
+#include <bee2/core/util.h>
+
+/*
+*******************************************************************************
+Выполнение заданий
+
+Задания выполняются в пуле потоков _pool (см. mtPoolCreate()). Пул
+создается при первом обращении и используется повторно, пока не
+изменится требуемое число исполнителей. Поэтому при многократном вызове
+cmdJobsRun() (например, при обработке файла порциями) потоки не создаются
+заново. Пул закрывается при завершении работы (с помощью utilOnExit()).
+
+Каждое задание передается в пул как отдельная задача. Основной поток
+дожидается задач в порядке следования заданий с помощью mtPoolWait():
+ожидание не опрашивает признаки готовности, а блокируется на условной
+переменной пула, при этом основной поток выполняет задачи пула. Поэтому
+в пуле создается на одного исполнителя меньше, чем threads.
+
+Функция cmdJobsRun() вызывается только из основного потока. При вызове
+из задания (вложенный вызов) задания выполняются последовательно.
+*******************************************************************************
+*/
+
+static mt_pool_t* _pool;		/*< пул потоков */
+static size_t _workers;			/*< число исполнителей пула */
+static bool_t _busy;			/*< задания выполняются? */
+static bool_t _registered;		/*< закрытие пула зарегистрировано? */
+
+static void cmdJobsClose()
+{
+	if (_pool)
+		mtPoolClose(_pool);
+	_pool = 0, _workers = 0;
+}
+
+static mt_pool_t* cmdJobsPool(size_t workers)
+{
+	// пул подходит?
+	if (_pool && _workers == workers)
+		return _pool;
+	// пересоздать пул
+	cmdJobsClose();
+	if (!_registered && !(_registered = utilOnExit(cmdJobsClose)))
+		return 0;
+	if ((_pool = mtPoolCreate(workers)) && mtPoolWorkers(_pool) == 0)
+		cmdJobsClose();
+	if (_pool)
+		_workers = workers;
+	return _pool;
+}
+
+typedef struct
+{
+	void* job;			/*< задание */
+	cmd_job_i run;		/*< выполнение задания */
+	void* state;		/*< состояние */
+} cmd_jobs_task_st;
+
+static void cmdJobsTask(void* arg)
+{
+	cmd_jobs_task_st* t = (cmd_jobs_task_st*)arg;
+	t->run(t->job, t->state);
+}
+
+void cmdJobsRun(void* jobs, size_t job_size, size_t count, size_t threads,
+	cmd_job_i run, cmd_job_i report, void* state)
+{
+	mt_pool_t* pool = 0;
+	mt_task_t* tasks = 0;
+	cmd_jobs_task_st* args;
+	size_t i;
+	ASSERT(memIsValid(jobs, job_size * count));
+	ASSERT(threads <= CMD_THREADS_MAX);
+	// подготовить пул и задачи
+	if (threads > count)
+		threads = count;
+	if (threads > 1 && !_busy && (pool = cmdJobsPool(threads - 1)) &&
+		!(tasks = (mt_task_t*)memAlloc(count *
+			(sizeof(mt_task_t) + sizeof(cmd_jobs_task_st)))))
+		pool = 0;
+	// последовательная обработка
+	if (!pool)
+	{
+		for (i = 0; i < count; ++i)
+		{
+			run((octet*)jobs + i * job_size, state);
+			report((octet*)jobs + i * job_size, state);
+		}
+		return;
+	}
+	// передать задания в пул
+	_busy = TRUE;
+	args = (cmd_jobs_task_st*)(tasks + count);
+	for (i = 0; i < count; ++i)
+	{
+		args[i].job = (octet*)jobs + i * job_size;
+		args[i].run = run, args[i].state = state;
+		mtPoolSubmit(pool, tasks + i, cmdJobsTask, args + i);
+	}
+	// обработать результаты в порядке заданий
+	for (i = 0; i < count; ++i)
+	{
+		mtPoolWait(pool, tasks + i);
+		report(args[i].job, state);
+	}
+	_busy = FALSE;
+	memFree(tasks);
+}
@@ -4,7 +4,7 @@
 \brief Command-line interface to Bee2: managing private keys
 \project bee2/cmd 
 \created 2022.06.20
-\version 2023.06.18
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -19,6 +19,7 @@
 #include <bee2/core/rng.h>
 #include <bee2/core/str.h>
 #include <bee2/core/util.h>
+#include <bee2/crypto/belt.h>
 #include <bee2/crypto/bign.h>
 #include <bee2/crypto/bpki.h>
 #include <stdio.h>
@@ -89,6 +90,7 @@ err_t cmdPrivkeyRead(octet privkey[], size_t* privkey_len, const char* file,
 	size_t epki_len_max;
 	void* stack;
 	octet* epki;
+	octet* mac;
 	FILE* fp;
 	// pre
 	ASSERT(memIsNullOrValid(privkey_len, sizeof(size_t)));
@@ -132,9 +134,10 @@ err_t cmdPrivkeyRead(octet privkey[], size_t* privkey_len, const char* file,
 	ASSERT(len == 24 || len == 32 || len == 48 || len == 64);
 	ASSERT(memIsValid(privkey, len));
 	// выделить память и разметить ее
-	code = cmdBlobCreate(stack, epki_len_max + 1);
+	code = cmdBlobCreate(stack, epki_len_max + 1 + 32);
 	ERR_CALL_CHECK(code);
 	epki = (octet*)stack;
+	mac = epki + epki_len_max + 1;
 	// прочитать контейнер
 	code = (fp = fopen(file, "rb")) ? ERR_OK : ERR_FILE_OPEN;
 	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
@@ -143,11 +146,26 @@ err_t cmdPrivkeyRead(octet privkey[], size_t* privkey_len, const char* file,
 	code = (epki_len_min <= epki_len && epki_len <= epki_len_max) ?
 		ERR_OK : ERR_BAD_FORMAT;
 	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
+	// ключ в кэше?
+	if (cmdCacheIsOn())
+	{
+		code = beltHMAC(mac, epki, epki_len, (const octet*)pwd,
+			cmdPwdLen(pwd));
+		ERR_CALL_HANDLE(code, cmdBlobClose(stack));
+		if (cmdCacheGet(privkey, len, CMD_CACHE_PRIVKEY, mac))
+		{
+			cmdBlobClose(stack);
+			return ERR_OK;
+		}
+	}
 	// снять защиту
 	code = bpkiPrivkeyUnwrap(privkey, &epki_len_min, epki, epki_len,
 		(const octet*)pwd, cmdPwdLen(pwd));
 	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
 	ASSERT(epki_len_min == len);
+	// сохранить ключ в кэше
+	if (cmdCacheIsOn())
+		cmdCachePut(CMD_CACHE_PRIVKEY, mac, privkey, len);
 	cmdBlobClose(stack);
 	return code;
 }
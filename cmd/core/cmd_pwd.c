@@ -4,7 +4,7 @@
 \brief Command-line interface to Bee2: password management
 \project bee2/cmd 
 \created 2022.06.13
-\version 2023.06.05
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -217,6 +217,51 @@ static err_t cmdPwdGenShare_internal(cmd_pwd_t* pwd, size_t scount,
 	return code;
 }
 
+/*
+*******************************************************************************
+Параллельное снятие защиты с частичных секретов
+
+При снятии защиты с каждого частичного секрета выполняется beltPBKDF2()
+-- самая длительная операция при сборке пароля. Поэтому защита с разных
+частичных секретов снимается одновременно, в отдельных потоках
+(см. cmdJobsRun()).
+*******************************************************************************
+*/
+
+typedef struct
+{
+	const octet* epki;		/*< защищенный частичный секрет */
+	size_t epki_len;		/*< длина epki */
+	octet* share;			/*< частичный секрет */
+	err_t code;				/*< результат снятия защиты */
+} cmd_pwd_job_st;
+
+typedef struct
+{
+	cmd_pwd_t spwd;			/*< пароль защиты частичных секретов */
+	size_t share_len;		/*< длина частичного секрета */
+	err_t code;				/*< первая ошибка */
+} cmd_pwd_stat_st;
+
+static void cmdPwdShareWorker(void* job, void* state)
+{
+	cmd_pwd_job_st* j = (cmd_pwd_job_st*)job;
+	const cmd_pwd_stat_st* stat = (const cmd_pwd_stat_st*)state;
+	size_t share_len;
+	j->code = bpkiShareUnwrap(j->share, &share_len, j->epki, j->epki_len,
+		(const octet*)stat->spwd, cmdPwdLen(stat->spwd));
+	if (j->code == ERR_OK && share_len != stat->share_len)
+		j->code = ERR_BAD_FORMAT;
+}
+
+static void cmdPwdShareReport(void* job, void* state)
+{
+	const cmd_pwd_job_st* j = (const cmd_pwd_job_st*)job;
+	cmd_pwd_stat_st* stat = (cmd_pwd_stat_st*)state;
+	if (stat->code == ERR_OK)
+		stat->code = j->code;
+}
+
 static err_t cmdPwdReadShare_internal(cmd_pwd_t* pwd, size_t scount,
 	size_t len, bool_t crc, char* shares[], const cmd_pwd_t spwd)
 {
@@ -229,6 +274,8 @@ static err_t cmdPwdReadShare_internal(cmd_pwd_t* pwd, size_t scount,
 	octet* state;
 	octet* epki;
 	octet* pwd_bin;
+	cmd_pwd_job_st jobs[16];
+	cmd_pwd_stat_st stat[1];
 	size_t pos;
 	// pre
 	ASSERT(memIsValid(pwd, sizeof(cmd_pwd_t)));
@@ -266,33 +313,36 @@ static err_t cmdPwdReadShare_internal(cmd_pwd_t* pwd, size_t scount,
 		ERR_CALL_CHECK(code);
 	}
 	// выделить память и разметить ее
-	code = cmdBlobCreate(stack, scount * (len + 1) + epki_len_max + 1 + len);
+	code = cmdBlobCreate(stack,
+		scount * (len + 1) + scount * (epki_len_max + 1) + len);
 	ERR_CALL_HANDLE(code, cmdPwdClose(*pwd));
 	share = state = (octet*)stack;
 	epki = share + scount * (len + 1);
-	pwd_bin = epki + epki_len_max + 1;
-	// прочитать частичные секреты
+	pwd_bin = epki + scount * (epki_len_max + 1);
+	// прочитать защищенные частичные секреты
 	for (pos = 0; pos < scount; ++pos, ++shares)
 	{
 		FILE* fp;
-		size_t share_len;
 		// открыть файл для чтения
 		ASSERT(strIsValid(*shares));
 		code = (fp = fopen(*shares, "rb")) ? ERR_OK : ERR_FILE_OPEN;
 		ERR_CALL_HANDLE(code, cmdBlobClose(stack));
 		// читать
-		epki_len = fread(epki, 1, epki_len_max + 1, fp);
+		jobs[pos].epki = epki + pos * (epki_len_max + 1);
+		jobs[pos].epki_len = fread(epki + pos * (epki_len_max + 1), 1,
+			epki_len_max + 1, fp);
 		fclose(fp);
-		code = (epki_len_min <= epki_len && epki_len <= epki_len_max) ?
-			ERR_OK : ERR_BAD_FORMAT;
-		ERR_CALL_HANDLE(code, cmdBlobClose(stack));
-		// декодировать
-		code = bpkiShareUnwrap(share + pos * (len + 1), &share_len,
-			epki, epki_len, (const octet*)spwd, cmdPwdLen(spwd));
-		ERR_CALL_HANDLE(code, cmdBlobClose(stack));
-		code = (share_len == len + 1) ? ERR_OK : ERR_BAD_FORMAT;
+		code = (epki_len_min <= jobs[pos].epki_len &&
+			jobs[pos].epki_len <= epki_len_max) ? ERR_OK : ERR_BAD_FORMAT;
 		ERR_CALL_HANDLE(code, cmdBlobClose(stack));
+		jobs[pos].share = share + pos * (len + 1);
 	}
+	// снять защиту (параллельно)
+	stat->spwd = spwd, stat->share_len = len + 1, stat->code = ERR_OK;
+	cmdJobsRun(jobs, sizeof(cmd_pwd_job_st), scount, scount,
+		cmdPwdShareWorker, cmdPwdShareReport, stat);
+	code = stat->code;
+	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
 	// собрать пароль
 	code = belsRecover2(pwd_bin, scount, len, share);
 	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
@@ -4,7 +4,7 @@
 \brief Command-line interface to Bee2: random number generation
 \project bee2/cmd 
 \created 2022.06.08
-\version 2023.12.16
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -137,9 +137,16 @@ static err_t prngEchoRead(size_t* read, void* buf, size_t count, void* state)
 	return ERR_OK;
 }
 
-err_t cmdRngStart(bool_t verbose)
+err_t cmdRngStart(bool_t verbose, const char* engine)
 {
 	err_t code;
+	// в режиме кэширования использовать запущенный ГСЧ
+	if (cmdCacheIsOn() && rngIsValid())
+	{
+		if (!engine || strEq(engine, rngEngine()))
+			return ERR_OK;
+		rngClose();
+	}
 	if (verbose)
 	{
 		const char* sources[] = { "trng", "trng2", "sys", "sys2", "timer" };
@@ -150,11 +157,11 @@ err_t cmdRngStart(bool_t verbose)
 		for (pos = count = 0; pos < COUNT_OF(sources); ++pos)
 			if (rngESRead(&read, 0, 0, sources[pos]) == ERR_OK)
 				printf(count++ ? ", %s" : "%s", sources[pos]);
-		printf("]... ");
+		printf(engine ? "] (%s)... " : "]... ", engine);
 	}
 	code = rngESHealth();
 	if (code == ERR_OK)
-		code = rngCreate(0, 0);
+		code = rngCreate2(0, 0, engine);
 	else if (code == ERR_NOT_ENOUGH_ENTROPY)
 	{
 		void* stack;
@@ -178,7 +185,7 @@ err_t cmdRngStart(bool_t verbose)
 		// запустить echo-генератор
 		prngEchoStart(state, hash, 32);
 		// запустить генератор
-		code = rngCreate(prngEchoRead, state);
+		code = rngCreate2(prngEchoRead, state, engine);
 		// освободить память
 		cmdBlobClose(stack);
 	}
@@ -4,7 +4,7 @@
 \brief Command-line interface to Bee2: signing files
 \project bee2/cmd
 \created 2022.08.20
-\version 2023.12.19
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -256,29 +256,26 @@ err_t cmdSigRead(cmd_sig_t* sig, size_t* sig_len, const char* sig_file)
 цепочка сертификатов [certs_len]certs и дата date, т.е. буфер
   file[:-drop] || [certs_len]certs || [6]date.
 Алгоритм хэширования определяется по длине возвращаемого хэш-значения.
+Файл читается с помощью cmdFileStream().
 *******************************************************************************
 */
 
 static err_t cmdSigHash(octet hash[], size_t hash_len, const char* file,
 	size_t drop, const octet certs[], size_t certs_len, const octet date[6])
 {
-	const size_t buf_size = 4096;
 	err_t code;
-	octet* stack;
 	octet* state;
 	size_t file_size;
-	FILE* fp;
 	// pre
 	ASSERT(hash_len == 24 || hash_len == 32 || hash_len == 48 ||
 		hash_len == 64);
 	ASSERT(memIsValid(hash, hash_len));
 	ASSERT(strIsValid(file));
 	// выделить память
-	code = cmdBlobCreate(stack, buf_size +
-		(hash_len <= 32 ? beltHash_keep() : bashHash_keep()));
+	code = cmdBlobCreate(state,
+		hash_len <= 32 ? beltHash_keep() : bashHash_keep());
 	ERR_CALL_CHECK(code);
 	// запустить хэширование
-	state = stack + buf_size;
 	if (hash_len <= 32)
 		beltHashStart(state);
 	else
@@ -286,30 +283,15 @@ static err_t cmdSigHash(octet hash[], size_t hash_len, const char* file,
 	// определить размер файла
 	file_size = cmdFileSize(file);
 	code = file_size != SIZE_MAX ? ERR_OK : ERR_FILE_READ;
-	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
+	ERR_CALL_HANDLE(code, cmdBlobClose(state));
 	// определить размер хэшируемой части файла
 	code = drop <= file_size ? ERR_OK : ERR_BAD_FORMAT;
-	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
+	ERR_CALL_HANDLE(code, cmdBlobClose(state));
 	file_size -= drop;
-	// открыть файл для чтения
-	fp = fopen(file, "rb");
-	code = fp ? ERR_OK : ERR_FILE_OPEN;
-	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
 	// хэшировать файл
-	while (file_size)
-	{
-		// прочитать фрагмент
-		size_t count = MIN2(file_size, buf_size);
-		code = fread(stack, 1, count, fp) == count ? ERR_OK : ERR_FILE_READ;
-		ERR_CALL_HANDLE(code, (fclose(fp), cmdBlobClose(stack)));
-		file_size -= count;
-		// хэшировать фрагмент
-		if (hash_len <= 32)
-			beltHashStepH(stack, count, state);
-		else
-			bashHashStepH(stack, count, state);
-	}
-	fclose(fp);
+	code = cmdFileStream(file, file_size,
+		hash_len <= 32 ? beltHashStepH : bashHashStepH, state);
+	ERR_CALL_HANDLE(code, cmdBlobClose(state));
 	// хэшировать сертификаты и дату
 	if (hash_len <= 32)
 	{
@@ -324,7 +306,7 @@ static err_t cmdSigHash(octet hash[], size_t hash_len, const char* file,
 		bashHashStepG(hash, hash_len, state);
 	}
 	// завершить
-	cmdBlobClose(stack);
+	cmdBlobClose(state);
 	return code;
 }
 
@@ -350,12 +332,43 @@ static err_t cmdSigParamsStd(bign_params* params, size_t privkey_len)
 	return ERR_BAD_INPUT;
 }
 
+static err_t cmdSigOidStd(octet oid_der[16], size_t* oid_len,
+	size_t privkey_len)
+{
+	err_t code;
+	*oid_len = 16;
+	code = bignOidToDER(oid_der, oid_len, privkey_len <= 32 ?
+		"1.2.112.0.2.0.34.101.31.81" : privkey_len == 48 ?
+			"1.2.112.0.2.0.34.101.77.12" : "1.2.112.0.2.0.34.101.77.13");
+	ASSERT(code != ERR_OK || *oid_len == 11);
+	return code;
+}
+
 /*
 *******************************************************************************
 Выработка подписи
+
+Функция cmdSigCerts() собирает в sig цепочку сертификатов certs
+и проверяет ее на дату sig->date. Если certs == 0, то цепочка пустая.
 *******************************************************************************
 */
 
+static err_t cmdSigCerts(cmd_sig_t* sig, const char* certs)
+{
+	err_t code;
+	if (!certs)
+	{
+		sig->certs_len = 0;
+		return ERR_OK;
+	}
+	// собрать сертификаты
+	sig->certs_len = sizeof(sig->certs);
+	code = cmdCVCsCreate(sig->certs, &sig->certs_len, certs);
+	ERR_CALL_CHECK(code);
+	// проверить цепочку
+	return cmdCVCsVal(sig->certs, sig->certs_len, sig->date);
+}
+
 err_t cmdSigSign(const char* sig_file, const char* file, const char* certs,
 	const octet date[6], const octet privkey[], size_t privkey_len)
 {
@@ -388,19 +401,9 @@ err_t cmdSigSign(const char* sig_file, const char* file, const char* certs,
 	t = hash + privkey_len;
 	// зафиксировать дату
 	memCopy(sig->date, date, 6);
-	// указаны сертификаты?
-	if (certs)
-	{
-		// собрать сертификаты
-		sig->certs_len = sizeof(sig->certs);
-		code = cmdCVCsCreate(sig->certs, &sig->certs_len, certs);
-		ERR_CALL_HANDLE(code, cmdBlobClose(stack));
-		// проверить цепочку
-		code = cmdCVCsVal(sig->certs, sig->certs_len, sig->date);
-		ERR_CALL_HANDLE(code, cmdBlobClose(stack));
-	}
-	else
-		sig->certs_len = 0;
+	// собрать и проверить сертификаты
+	code = cmdSigCerts(sig, certs);
+	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
 	// проверить соответствие личному ключу
 	if (sig->certs_len)
 	{
@@ -421,19 +424,8 @@ err_t cmdSigSign(const char* sig_file, const char* file, const char* certs,
 	code = cmdSigHash(hash, privkey_len, file, 0, sig->certs, sig->certs_len, 
 		sig->date);
 	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
-	if (privkey_len <= 32)
-	{
-		code = bignOidToDER(oid_der, &oid_len, "1.2.112.0.2.0.34.101.31.81");
-		ERR_CALL_HANDLE(code, cmdBlobClose(stack));
-		ASSERT(oid_len == 11);
-	}
-	else 
-	{
-		code = bignOidToDER(oid_der, &oid_len, privkey_len == 48 ? 
-			"1.2.112.0.2.0.34.101.77.12" : "1.2.112.0.2.0.34.101.77.13");
-		ERR_CALL_HANDLE(code, cmdBlobClose(stack));
-		ASSERT(oid_len == 11);
-	}
+	code = cmdSigOidStd(oid_der, &oid_len, privkey_len);
+	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
 	// получить случайные числа
 	if (rngIsValid())
 		rngStepR(t, t_len = privkey_len, 0);
@@ -463,6 +455,91 @@ err_t cmdSigSign(const char* sig_file, const char* file, const char* certs,
 	return code;
 }
 
+/*
+*******************************************************************************
+Выработка подписи демоном
+
+Хэш-значение вычисляется локально, демону передается только оно.
+Соответствие сертификата подписанта ключу демона проверяется сравнением
+открытых ключей.
+*******************************************************************************
+*/
+
+err_t cmdSigSignDaemon(const char* sig_file, const char* file,
+	const char* certs, const octet date[6], const char* socket)
+{
+	err_t code;
+	void* stack;
+	cmd_sig_t* sig;
+	octet* pubkey;
+	octet* hash;
+	size_t pubkey_len;
+	size_t privkey_len;
+	size_t sig_len;
+	int sock;
+	// входной контроль
+	if (!strIsValid(sig_file) || !strIsValid(file) || !memIsValid(date, 6))
+		return ERR_BAD_INPUT;
+	if (!memIsZero(date, 6) && !tmDateIsValid2(date))
+		return ERR_BAD_DATE;
+	// создать и разметить стек
+	code = cmdBlobCreate(stack, sizeof(cmd_sig_t) + 2 * CMD_DAEMON_MSG_MAX);
+	ERR_CALL_CHECK(code);
+	sig = (cmd_sig_t*)stack;
+	pubkey = (octet*)(sig + 1);
+	hash = pubkey + CMD_DAEMON_MSG_MAX;
+	// соединиться с демоном
+	code = cmdDaemonConnect(&sock, socket);
+	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
+	// определить открытый ключ демона
+	code = cmdDaemonCall(pubkey, &pubkey_len, sock, CMD_DAEMON_INFO, 0, 0);
+	ERR_CALL_HANDLE(code, (cmdDaemonClose(sock, 0), cmdBlobClose(stack)));
+	privkey_len = pubkey_len / 2;
+	if (privkey_len != 32 && privkey_len != 48 && privkey_len != 64)
+		code = ERR_BAD_PUBKEY;
+	ERR_CALL_HANDLE(code, (cmdDaemonClose(sock, 0), cmdBlobClose(stack)));
+	// зафиксировать дату
+	memCopy(sig->date, date, 6);
+	// собрать и проверить сертификаты
+	code = cmdSigCerts(sig, certs);
+	ERR_CALL_HANDLE(code, (cmdDaemonClose(sock, 0), cmdBlobClose(stack)));
+	// проверить соответствие открытому ключу демона
+	if (sig->certs_len)
+	{
+		size_t offset;
+		size_t cert_len;
+		btok_cvc_t cvc[1];
+		code = cmdCVCsGetLast(&offset, &cert_len, sig->certs, sig->certs_len);
+		if (code == ERR_OK)
+			code = btokCVCUnwrap(cvc, sig->certs + offset, cert_len, 0, 0);
+		if (code == ERR_OK && (cvc->pubkey_len != pubkey_len ||
+			!memEq(cvc->pubkey, pubkey, pubkey_len)))
+			code = ERR_BAD_KEYPAIR;
+		ERR_CALL_HANDLE(code, (cmdDaemonClose(sock, 0), cmdBlobClose(stack)));
+	}
+	// хэшировать
+	code = cmdSigHash(hash, privkey_len, file, 0, sig->certs, sig->certs_len,
+		sig->date);
+	ERR_CALL_HANDLE(code, (cmdDaemonClose(sock, 0), cmdBlobClose(stack)));
+	// подписать
+	code = cmdDaemonCall(pubkey, &sig_len, sock, CMD_DAEMON_SIGN, hash,
+		privkey_len);
+	cmdDaemonClose(sock, 0);
+	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
+	sig->sig_len = privkey_len / 2 * 3;
+	code = sig_len == sig->sig_len ? ERR_OK : ERR_BAD_SIG;
+	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
+	memCopy(sig->sig, pubkey, sig_len);
+	// сохранить подпись
+	if (cmdFileAreSame(file, sig_file))
+		code = cmdSigAppend(sig_file, sig);
+	else
+		code = cmdSigWrite(sig_file, sig);
+	// завершить
+	cmdBlobClose(stack);
+	return code;
+}
+
 /*
 *******************************************************************************
 Проверка подписи
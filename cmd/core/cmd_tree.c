@@ -0,0 +1,300 @@
+/*
+*******************************************************************************
+\file cmd_tree.c
+\brief Command-line interface to Bee2: Merkle tree hashing
+\project bee2/cmd
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "../cmd.h"
+#include <bee2/core/err.h>
+#include <bee2/core/mem.h>
+#include <bee2/core/util.h>
+#include <bee2/crypto/bash.h>
+#include <bee2/crypto/belt.h>
+
+/*
+*******************************************************************************
+Вершины
+
+Вершины хранятся по уровням: сначала листья (уровень 0), затем вершины
+уровня 1 и т.д. Уровень, на котором count вершин, сменяется уровнем,
+на котором (count + 1) / 2 вершин.
+
+Функция cmdTreeH() хэширует строку prefix || src1 || src2. Функция
+cmdTreeNode() пересчитывает вершину с номером i уровня, следующего
+за уровнем [count]level.
+*******************************************************************************
+*/
+
+#define CMD_TREE_LEAF	0x00	/*< префикс листа */
+#define CMD_TREE_NODE	0x01	/*< префикс внутренней вершины */
+
+static size_t cmdTreeNodes(size_t count)
+{
+	size_t total = count;
+	for (; count > 1; total += count)
+		count = (count + 1) / 2;
+	return total;
+}
+
+static void cmdTreeH(octet hash[], const cmd_tree_t* tree, octet prefix,
+	const octet src1[], size_t count1, const octet src2[], size_t count2)
+{
+	octet state[4096];
+	// pre
+	ASSERT(beltHash_keep() <= sizeof(state));
+	ASSERT(bashHash_keep() <= sizeof(state));
+	// хэшировать
+	if (tree->hid == 0)
+	{
+		beltHashStart(state);
+		beltHashStepH(&prefix, 1, state);
+		beltHashStepH(src1, count1, state);
+		beltHashStepH(src2, count2, state);
+		beltHashStepG(hash, state);
+	}
+	else
+	{
+		bashHashStart(state, tree->hid / 2);
+		bashHashStepH(&prefix, 1, state);
+		bashHashStepH(src1, count1, state);
+		bashHashStepH(src2, count2, state);
+		bashHashStepG(hash, tree->hash_len, state);
+	}
+}
+
+static void cmdTreeNode(cmd_tree_t* tree, const octet level[], size_t count,
+	size_t i)
+{
+	const size_t hash_len = tree->hash_len;
+	octet* node = (octet*)level + (count + i) * hash_len;
+	ASSERT(2 * i < count);
+	if (2 * i + 1 < count)
+		cmdTreeH(node, tree, CMD_TREE_NODE, level + 2 * i * hash_len,
+			hash_len, level + (2 * i + 1) * hash_len, hash_len);
+	else
+		memCopy(node, level + 2 * i * hash_len, hash_len);
+}
+
+/*
+*******************************************************************************
+Управление деревом
+*******************************************************************************
+*/
+
+err_t cmdTreeCreate(cmd_tree_t* tree, size_t hid, size_t leaf_size,
+	size_t size)
+{
+	size_t total;
+	ASSERT(memIsValid(tree, sizeof(cmd_tree_t)));
+	// проверить входные данные
+	if (hid != 0 && hid != 256 && hid != 384 && hid != 512 || leaf_size == 0)
+		return ERR_BAD_INPUT;
+	// заполнить поля
+	memSetZero(tree, sizeof(cmd_tree_t));
+	tree->hid = hid;
+	tree->hash_len = hid ? hid / 8 : 32;
+	tree->leaf_size = leaf_size;
+	tree->size = size;
+	tree->count = size ? (size - 1) / leaf_size + 1 : 1;
+	// выделить память
+	total = cmdTreeNodes(tree->count);
+	if (total < tree->count || total > SIZE_MAX / tree->hash_len)
+		return ERR_OUTOFMEMORY;
+	tree->nodes = (octet*)memAlloc(total * tree->hash_len);
+	return tree->nodes ? ERR_OK : ERR_OUTOFMEMORY;
+}
+
+err_t cmdTreeLeaf(cmd_tree_t* tree, size_t num, const octet leaf[],
+	size_t count)
+{
+	ASSERT(memIsValid(tree, sizeof(cmd_tree_t)));
+	ASSERT(memIsValid(leaf, count));
+	// проверить входные данные
+	if (num >= tree->count || count != (num + 1 < tree->count ?
+		tree->leaf_size : tree->size - num * tree->leaf_size))
+		return ERR_BAD_INPUT;
+	// хэшировать лист
+	cmdTreeH(tree->nodes + num * tree->hash_len, tree, CMD_TREE_LEAF,
+		leaf, count, 0, 0);
+	return ERR_OK;
+}
+
+void cmdTreeBuild(cmd_tree_t* tree)
+{
+	const octet* level;
+	size_t count;
+	size_t i;
+	ASSERT(memIsValid(tree, sizeof(cmd_tree_t)));
+	for (level = tree->nodes, count = tree->count; count > 1;
+		level += count * tree->hash_len, count = (count + 1) / 2)
+		for (i = 0; 2 * i < count; ++i)
+			cmdTreeNode(tree, level, count, i);
+}
+
+err_t cmdTreeUpdate(cmd_tree_t* tree, size_t num, const octet leaf[],
+	size_t count)
+{
+	err_t code;
+	const octet* level;
+	// обновить лист
+	code = cmdTreeLeaf(tree, num, leaf, count);
+	ERR_CALL_CHECK(code);
+	// пересчитать путь к корню
+	for (level = tree->nodes, count = tree->count; count > 1;
+		level += count * tree->hash_len, count = (count + 1) / 2)
+		cmdTreeNode(tree, level, count, num /= 2);
+	return ERR_OK;
+}
+
+void cmdTreeRoot(octet root[], const cmd_tree_t* tree)
+{
+	ASSERT(memIsValid(tree, sizeof(cmd_tree_t)));
+	ASSERT(memIsValid(root, tree->hash_len));
+	memCopy(root, tree->nodes +
+		(cmdTreeNodes(tree->count) - 1) * tree->hash_len, tree->hash_len);
+}
+
+void cmdTreeClose(cmd_tree_t* tree)
+{
+	ASSERT(memIsValid(tree, sizeof(cmd_tree_t)));
+	memFree(tree->nodes);
+	tree->nodes = 0;
+}
+
+/*
+*******************************************************************************
+Хэширование файла
+
+Файл читается с помощью cmdFileStream() и накапливается в буфере,
+вмещающем window листьев. Заполненный буфер (а в конце -- остаток)
+хэшируется с помощью cmdJobsRun(). Объем буфера не превышает
+CMD_TREE_BUF_SIZE октетов (за исключением случая, когда лист длиннее),
+число листьев в буфере -- CMD_TREE_WINDOW.
+
+Хэшируются первые size октетов файла, где size -- длина файла
+при открытии. Если файл сокращается во время хэширования, то
+возвращается ERR_FILE_READ.
+*******************************************************************************
+*/
+
+#define CMD_TREE_WINDOW 1024
+#define CMD_TREE_BUF_SIZE ((size_t)1 << 24)
+
+typedef struct
+{
+	const octet* leaf;		/*< лист */
+	size_t count;			/*< длина листа */
+	size_t num;				/*< номер листа */
+	err_t code;				/*< результат хэширования */
+} cmd_tree_job_st;
+
+typedef struct
+{
+	cmd_tree_t tree[1];		/*< дерево */
+	err_t code;				/*< первая ошибка */
+	size_t threads;			/*< число исполнителей */
+	size_t window;			/*< число листьев в буфере */
+	octet* buf;				/*< [window * leaf_size] буфер */
+	size_t filled;			/*< число октетов в буфере */
+	size_t num;				/*< номер первого листа в буфере */
+	cmd_tree_job_st* jobs;	/*< [window] задания */
+} cmd_tree_stat_st;
+
+static void cmdTreeWorker(void* job, void* state)
+{
+	cmd_tree_job_st* j = (cmd_tree_job_st*)job;
+	cmd_tree_stat_st* stat = (cmd_tree_stat_st*)state;
+	j->code = cmdTreeLeaf(stat->tree, j->num, j->leaf, j->count);
+}
+
+static void cmdTreeReport(void* job, void* state)
+{
+	const cmd_tree_job_st* j = (const cmd_tree_job_st*)job;
+	cmd_tree_stat_st* stat = (cmd_tree_stat_st*)state;
+	if (stat->code == ERR_OK)
+		stat->code = j->code;
+}
+
+static void cmdTreeFlush(cmd_tree_stat_st* stat)
+{
+	const size_t leaf_size = stat->tree->leaf_size;
+	size_t count;
+	// разметить листья
+	for (count = 0; count == 0 || count * leaf_size < stat->filled; ++count)
+	{
+		stat->jobs[count].leaf = stat->buf + count * leaf_size;
+		stat->jobs[count].count =
+			MIN2(leaf_size, stat->filled - count * leaf_size);
+		stat->jobs[count].num = stat->num + count;
+	}
+	// хэшировать
+	if (stat->code == ERR_OK)
+		cmdJobsRun(stat->jobs, sizeof(cmd_tree_job_st), count,
+			stat->threads, cmdTreeWorker, cmdTreeReport, stat);
+	stat->num += count, stat->filled = 0;
+}
+
+static void cmdTreeStep(const void* buf, size_t count, void* state)
+{
+	cmd_tree_stat_st* stat = (cmd_tree_stat_st*)state;
+	const size_t cap = stat->window * stat->tree->leaf_size;
+	size_t t;
+	while (count)
+	{
+		t = MIN2(count, cap - stat->filled);
+		memCopy(stat->buf + stat->filled, buf, t);
+		buf = (const octet*)buf + t, count -= t;
+		if ((stat->filled += t) == cap)
+			cmdTreeFlush(stat);
+	}
+}
+
+err_t cmdTreeFile(octet root[], size_t hid, size_t leaf_size,
+	size_t threads, const char* file)
+{
+	err_t code;
+	cmd_tree_stat_st stat[1];
+	size_t size;
+	// определить длину файла
+	if ((size = cmdFileSize(file)) == SIZE_MAX)
+		return ERR_FILE_READ;
+	// создать дерево
+	memSetZero(stat, sizeof(cmd_tree_stat_st));
+	code = cmdTreeCreate(stat->tree, hid, leaf_size, size);
+	ERR_CALL_CHECK(code);
+	// подготовить буфер и задания
+	stat->threads = threads;
+	stat->window = MIN2(CMD_TREE_WINDOW, stat->tree->count);
+	stat->window = MIN2(stat->window, MAX2(1, CMD_TREE_BUF_SIZE / leaf_size));
+	if (stat->window > SIZE_MAX / leaf_size)
+		code = ERR_OUTOFMEMORY;
+	ERR_CALL_HANDLE(code, cmdTreeClose(stat->tree));
+	stat->buf = (octet*)memAlloc(stat->window * leaf_size);
+	stat->jobs = (cmd_tree_job_st*)memAlloc(sizeof(cmd_tree_job_st) *
+		stat->window);
+	code = stat->buf && stat->jobs ? ERR_OK : ERR_OUTOFMEMORY;
+	// хэшировать листья
+	if (code == ERR_OK)
+		code = cmdFileStream(file, size, cmdTreeStep, stat);
+	if (code == ERR_OK && stat->num < stat->tree->count)
+		cmdTreeFlush(stat);
+	if (code == ERR_OK)
+		code = stat->code;
+	// построить дерево
+	if (code == ERR_OK)
+	{
+		cmdTreeBuild(stat->tree);
+		cmdTreeRoot(root, stat->tree);
+	}
+	// завершить
+	memFree(stat->jobs);
+	memFree(stat->buf);
+	cmdTreeClose(stat->tree);
+	return code;
+}
@@ -4,7 +4,7 @@
 \brief Manage certificate signing requests
 \project bee2/cmd 
 \created 2023.12.19
-\version 2024.01.22
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -130,7 +130,7 @@ static err_t csrRewrap(int argc, char* argv[])
 	octet* privkey;
 	octet* csr;
 	// самотестирование
-	code = csrSelfTest();
+	code = cmdSelfTest(csrSelfTest);
 	ERR_CALL_CHECK(code);
 	// разбор опций
 	while (argc && strStartsWith(*argv, "-"))
@@ -212,7 +212,7 @@ static err_t csrVal(int argc, char* argv[])
 	void* stack;
 	octet* csr;
 	// самотестирование
-	code = csrSelfTest();
+	code = cmdSelfTest(csrSelfTest);
 	ERR_CALL_CHECK(code);
 	// разбор опций
 	if (argc != 1)
@@ -4,7 +4,7 @@
 \brief Manage CV-certificates
 \project bee2/cmd 
 \created 2022.07.12
-\version 2024.01.19
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -428,7 +428,7 @@ static err_t cvcRoot(int argc, char* argv[])
 	size_t cert_len;
 	octet* cert;
 	// самотестирование
-	code = cvcSelfTest();
+	code = cmdSelfTest(cvcSelfTest);
 	ERR_CALL_CHECK(code);
 	// обработать опции
 	code = cvcParseOptions(cvc, &eid, &esign, &pwd, 0, &readc, argc, argv);
@@ -501,7 +501,7 @@ static err_t cvcReq(int argc, char* argv[])
 	size_t req_len;
 	octet* req;
 	// самотестирование
-	code = cvcSelfTest();
+	code = cmdSelfTest(cvcSelfTest);
 	ERR_CALL_CHECK(code);
 	// обработать опции
 	code = cvcParseOptions(cvc, &eid, &esign, &pwd, 0, &readc, argc, argv);
@@ -588,7 +588,7 @@ static err_t cvcIss(int argc, char* argv[])
 	octet* cert;
 	btok_cvc_t* cvc;
 	// самотестирование
-	code = cvcSelfTest();
+	code = cmdSelfTest(cvcSelfTest);
 	ERR_CALL_CHECK(code);
 	// обработать опции
 	code = cvcParseOptions(cvc0, &eid, &esign, &pwd, 0, &readc, argc, argv);
@@ -696,7 +696,7 @@ static err_t cvcShorten(int argc, char* argv[])
 	octet* cert;
 	btok_cvc_t* cvc;
 	// самотестирование
-	code = cvcSelfTest();
+	code = cmdSelfTest(cvcSelfTest);
 	ERR_CALL_CHECK(code);
 	// обработать опции
 	code = cvcParseOptions(cvc0, 0, 0, &pwd, 0, &readc, argc, argv);
@@ -787,7 +787,7 @@ static err_t cvcVal(int argc, char* argv[])
 	btok_cvc_t* cvc;
 	btok_cvc_t* cvc1;
 	// самотестирование
-	code = cvcSelfTest();
+	code = cmdSelfTest(cvcSelfTest);
 	ERR_CALL_CHECK(code);
 	// обработать опции
 	code = cvcParseOptions(0, 0, 0, 0, date, &readc, argc, argv);
@@ -859,7 +859,7 @@ static err_t cvcMatch(int argc, char* argv[])
 	size_t cert_len;
 	octet* cert;
 	// самотестирование
-	code = cvcSelfTest();
+	code = cmdSelfTest(cvcSelfTest);
 	ERR_CALL_CHECK(code);
 	// обработать опции
 	code = cvcParseOptions(0, 0, 0, &pwd, 0, &readc, argc, argv);
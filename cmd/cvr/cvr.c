@@ -4,7 +4,7 @@
 \brief Manage CV-certificate rings
 \project bee2/cmd 
 \created 2023.06.08
-\version 2023.12.17
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -33,7 +33,8 @@
 - добавление сертификата в кольцо;
 - удаление сертификата из кольца;
 - извлечение сертификата из кольца;
-- печать информации о кольце.
+- печать информации о кольце;
+- индексирование кольца.
 
 Пример (после примера в cvc.c):
   # выпуск дополнительного сертификата
@@ -48,6 +49,8 @@
   bee2cmd sig val -anchor cert2 ring2 ring2
   bee2cmd cvr find ring2 cert3
   bee2cmd cvr extr -cert0 ring2 cert31
+  bee2cmd cvr index ring2
+  bee2cmd cvr extr -holder 590082394655 ring2 cert32
   bee2cmd sig extr -cert0 ring2 cert21
   bee2cmd cvr print ring2
   bee2cmd cvr print -certc ring2
@@ -80,9 +83,15 @@ static int cvrUsage()
 		"      -cert<nnn> -- the <nnn>th certificate\n"
 		"        \\remark certificates are numbered from zero\n"
 		"      -certa -- holder's certificate\n"
+		"  cvr extr {-holder <holder>|-pubkey <pubkey>} <ring> <file>\n"
+		"    extract from <ring> the first certificate of <holder>\n"
+		"    or with <pubkey> and store it in <file>\n"
 		"  cvr print [-certc] <ring>\n"
 		"    print <ring> info: all fields or a specific field\n"
 		"      -certc -- the number of certificates\n"
+		"  cvr index <ring>\n"
+		"    build <ring>.idx to speed up find and extr in large rings\n"
+		"      \\remark init, add and del refresh an existing index\n"
 		"  .\n"
 		,
 		_name, _descr
@@ -170,7 +179,7 @@ static err_t cvrCreate(int argc, char* argv[])
 	octet* privkey;
 	octet date[6];
 	// самотестирование
-	code = cvrSelfTest();
+	code = cmdSelfTest(cvrSelfTest);
 	ERR_CALL_CHECK(code);
 	// обработать опции
 	if (argc != 5 || !strEq(argv[0], "-pass"))
@@ -202,6 +211,9 @@ static err_t cvrCreate(int argc, char* argv[])
 	ERR_CALL_HANDLE(code, cmdBlobClose(privkey));
 	// подписать кольцо
 	code = cmdSigSign(argv[4], argv[4], argv[3], date, privkey, privkey_len);
+	ERR_CALL_HANDLE(code, cmdBlobClose(privkey));
+	// обновить индекс
+	code = cmdCVRIndexUpdate(argv[4]);
 	// завершить
 	cmdBlobClose(privkey);
 	return code;
@@ -234,7 +246,7 @@ static err_t cvrAdd(int argc, char* argv[])
 	octet* certs;
 	octet date[6];
 	// самотестирование
-	code = cvrSelfTest();
+	code = cmdSelfTest(cvrSelfTest);
 	ERR_CALL_CHECK(code);
 	// обработать опции
 	if (argc != 6 || !strEq(argv[0], "-pass"))
@@ -326,6 +338,9 @@ static err_t cvrAdd(int argc, char* argv[])
 	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
 	// подписать файл
 	code = cmdSigSign(argv[5], argv[5], argv[3], date, privkey, privkey_len);
+	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
+	// обновить индекс
+	code = cmdCVRIndexUpdate(argv[5]);
 	// завершить
 	cmdBlobClose(stack);
 	return code;
@@ -359,7 +374,7 @@ static err_t cvrDel(int argc, char* argv[])
 	size_t offset;
 	octet date[6];
 	// самотестирование
-	code = cvrSelfTest();
+	code = cmdSelfTest(cvrSelfTest);
 	ERR_CALL_CHECK(code);
 	// обработать опции
 	if (argc != 6 || !strEq(argv[0], "-pass"))
@@ -442,6 +457,9 @@ static err_t cvrDel(int argc, char* argv[])
 	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
 	// подписать файл
 	code = cmdSigSign(argv[5], argv[5], argv[3], date, privkey, privkey_len);
+	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
+	// обновить индекс
+	code = cmdCVRIndexUpdate(argv[5]);
 	// завершить
 	cmdBlobClose(stack);
 	return code;
@@ -467,7 +485,7 @@ static err_t cvrVal(int argc, char* argv[])
 	void* ring;
 	octet* certs;
 	// самотестирование
-	code = cvrSelfTest();
+	code = cmdSelfTest(cvrSelfTest);
 	ERR_CALL_CHECK(code);
 	// обработать опции
 	if (argc != 2)
@@ -525,44 +543,30 @@ cvr find <ring> <cert>
 static err_t cvrFind(int argc, char* argv[])
 {
 	err_t code;
-	void* stack;
 	size_t cert_len;
 	octet* cert;
-	size_t sig_len;
-	cmd_sig_t* sig;
-	size_t ring_len;
-	octet* certs;
+	cmd_cvr_t cvr[1];
 	// обработать опции
 	if (argc != 2)
 		return ERR_CMD_PARAMS;
 	// проверить наличие файлов
 	code = cmdFileValExist(2, argv);
 	ERR_CALL_CHECK(code);
-	// определить длину cert
+	// прочитать cert
 	code = cmdFileReadAll(0, &cert_len, argv[1]);
 	ERR_CALL_CHECK(code);
-	// определить длину кольца
-	code = cmdFileReadAll(0, &ring_len, argv[0]);
+	code = cmdBlobCreate(cert, cert_len);
 	ERR_CALL_CHECK(code);
-	// выделить и разметить память
-	code = cmdBlobCreate(stack, cert_len + MAX2(sizeof(cmd_sig_t), ring_len));
-	ERR_CALL_CHECK(code);
-	cert = (octet*)stack;
-	certs = cert + cert_len;
-	sig = (cmd_sig_t*)certs;
-	// прочитать cert
 	code = cmdFileReadAll(cert, &cert_len, argv[1]);
-	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
-	// определить длину подписи
-	code = cmdSigRead(sig, &sig_len, argv[0]);
-	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
-	// прочитать кольцо
-	code = cmdFileReadAll(certs, &ring_len, argv[0]);
-	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
+	ERR_CALL_HANDLE(code, cmdBlobClose(cert));
+	// открыть кольцо
+	code = cmdCVROpen(cvr, argv[0]);
+	ERR_CALL_HANDLE(code, cmdBlobClose(cert));
 	// найти сертификат
-	code = cmdCVCsFind(0, certs, ring_len - sig_len, cert, cert_len);
+	code = cmdCVRFind(0, cvr, cert, cert_len);
 	// завершить
-	cmdBlobClose(stack);
+	cmdCVRClose(cvr);
+	cmdBlobClose(cert);
 	return code;
 }
 
@@ -571,6 +575,8 @@ static err_t cvrFind(int argc, char* argv[])
 Извлечение объекта
 
 cvr extr -cert<nnn> <ring> <file>
+cvr extr -holder <holder> <ring> <file>
+cvr extr -pubkey <pubkey> <ring> <file>
 *******************************************************************************
 */
 
@@ -578,49 +584,69 @@ static err_t cvrExtr(int argc, char* argv[])
 {
 	err_t code;
 	const char* scope;
-	size_t num;
-	void* stack;
-	size_t sig_len;
-	cmd_sig_t* sig;
-	size_t ring_len;
-	octet* certs;
+	size_t num = 0;
+	const char* holder = 0;
+	size_t pubkey_len = 0;
+	octet* pubkey = 0;
+	cmd_cvr_t cvr[1];
 	size_t offset;
 	size_t cert_len;
+	octet* cert;
 	// обработать опции
-	scope = argv[0];
-	if (argc != 3 || !strStartsWith(scope, "-cert"))
+	if (argc < 1)
 		return ERR_CMD_PARAMS;
-	scope += strLen("-cert");
-	// определить номер сертификата
-	if (!decIsValid(scope) || strLen(scope) < 1 || strLen(scope) > 8)
+	scope = argv[0];
+	if (argc == 4 && strEq(scope, "-holder"))
+		holder = argv[1], --argc, ++argv;
+	else if (argc == 4 && strEq(scope, "-pubkey"))
+	{
+		code = cmdFileValExist(1, argv + 1);
+		ERR_CALL_CHECK(code);
+		code = cmdFileReadAll(0, &pubkey_len, argv[1]);
+		ERR_CALL_CHECK(code);
+		code = cmdBlobCreate(pubkey, pubkey_len);
+		ERR_CALL_CHECK(code);
+		code = cmdFileReadAll(pubkey, &pubkey_len, argv[1]);
+		ERR_CALL_HANDLE(code, cmdBlobClose(pubkey));
+		--argc, ++argv;
+	}
+	else if (argc == 3 && strStartsWith(scope, "-cert"))
+	{
+		// определить номер сертификата
+		scope += strLen("-cert");
+		if (!decIsValid(scope) || strLen(scope) < 1 || strLen(scope) > 8)
+			return ERR_CMD_PARAMS;
+		num = (size_t)decToU32(scope);
+	}
+	else
 		return ERR_CMD_PARAMS;
-	num = (size_t)decToU32(scope);
 	// проверить наличие/отсутствие файлов
 	code = cmdFileValExist(1, argv + 1);
-	ERR_CALL_CHECK(code);
+	ERR_CALL_HANDLE(code, cmdBlobClose(pubkey));
 	code = cmdFileValNotExist(1, argv + 2);
-	ERR_CALL_CHECK(code);
-	// определить длину кольца
-	code = cmdFileReadAll(0, &ring_len, argv[1]);
-	ERR_CALL_CHECK(code);
-	// выделить и разметить память
-	code = cmdBlobCreate(stack, MAX2(sizeof(cmd_sig_t), ring_len));
-	ERR_CALL_CHECK(code);
-	sig = (cmd_sig_t*)stack;
-	certs = (octet*)stack;
-	// определить длину подписи
-	code = cmdSigRead(sig, &sig_len, argv[1]);
-	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
-	// прочитать кольцо
-	code = cmdFileReadAll(certs, &ring_len, argv[1]);
-	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
+	ERR_CALL_HANDLE(code, cmdBlobClose(pubkey));
+	// открыть кольцо
+	code = cmdCVROpen(cvr, argv[1]);
+	ERR_CALL_HANDLE(code, cmdBlobClose(pubkey));
 	// найти сертификат
-	code = cmdCVCsGet(&offset, &cert_len, certs, ring_len - sig_len, num);
-	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
+	if (holder)
+		code = cmdCVRFindHolder(&offset, &cert_len, cvr, holder);
+	else if (pubkey)
+		code = cmdCVRFindPubkey(&offset, &cert_len, cvr, pubkey, pubkey_len);
+	else
+		code = cmdCVRGet(&offset, &cert_len, cvr, num);
+	cmdBlobClose(pubkey);
+	ERR_CALL_HANDLE(code, cmdCVRClose(cvr));
+	// прочитать сертификат
+	code = cmdBlobCreate(cert, cert_len);
+	ERR_CALL_HANDLE(code, cmdCVRClose(cvr));
+	code = cmdCVRRead(cert, cvr, offset, cert_len);
+	cmdCVRClose(cvr);
+	ERR_CALL_HANDLE(code, cmdBlobClose(cert));
 	// записать сертификат в файл
-	code = cmdFileWrite(argv[2], certs + offset, cert_len);
+	code = cmdFileWrite(argv[2], cert, cert_len);
 	// завершить
-	cmdBlobClose(stack);
+	cmdBlobClose(cert);
 	return code;
 }
 
@@ -632,15 +658,30 @@ cvr print [-certc] <ring>
 *******************************************************************************
 */
 
+static err_t cvrPrintIndexed(const cmd_cvr_t* cvr, size_t count)
+{
+	err_t code = ERR_OK;
+	size_t num, offset, cert_len;
+	octet* cert;
+	for (num = 0; code == ERR_OK && num < count; ++num)
+	{
+		code = cmdCVRGet(&offset, &cert_len, cvr, num);
+		ERR_CALL_CHECK(code);
+		code = cmdBlobCreate(cert, cert_len);
+		ERR_CALL_CHECK(code);
+		code = cmdCVRRead(cert, cvr, offset, cert_len);
+		if (code == ERR_OK)
+			code = cmdCVCsPrint(cert, cert_len);
+		cmdBlobClose(cert);
+	}
+	return code;
+}
+
 static err_t cvrPrint(int argc, char* argv[])
 {
 	err_t code;
 	const char* scope;
-	void* stack;
-	size_t sig_len;
-	cmd_sig_t* sig;
-	size_t ring_len;
-	octet* certs;
+	cmd_cvr_t cvr[1];
 	size_t count;
 	// обработать опции
 	if (argc == 1)
@@ -652,24 +693,12 @@ static err_t cvrPrint(int argc, char* argv[])
 	// проверить наличие/отсутствие файлов
 	code = cmdFileValExist(1, argv);
 	ERR_CALL_CHECK(code);
-	// определить длину кольца
-	code = cmdFileReadAll(0, &ring_len, argv[0]);
-	ERR_CALL_CHECK(code);
-	// выделить и разметить память
-	code = cmdBlobCreate(stack, MAX2(sizeof(cmd_sig_t), ring_len));
+	// открыть кольцо
+	code = cmdCVROpen(cvr, argv[0]);
 	ERR_CALL_CHECK(code);
-	sig = (cmd_sig_t*)stack;
-	certs = (octet*)stack;
-	// определить длину подписи
-	code = cmdSigRead(sig, &sig_len, argv[0]);
-	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
-	// прочитать кольцо
-	code = cmdFileReadAll(certs, &ring_len, argv[0]);
-	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
 	// определить число сертификатов
-	ASSERT(sig_len <= ring_len);
-	code = cmdCVCsCount(&count, certs, ring_len - sig_len);
-	ERR_CALL_HANDLE(code, cmdBlobClose(stack));
+	code = cmdCVRCount(&count, cvr);
+	ERR_CALL_HANDLE(code, cmdCVRClose(cvr));
 	// печатать 
 	if (!scope)
 	{
@@ -677,16 +706,40 @@ static err_t cvrPrint(int argc, char* argv[])
 		if (count)
 		{
 			printf("certs:\n");
-			code = cmdCVCsPrint(certs, ring_len - sig_len);
+			if (!cmdCVRIsIndexed(cvr))
+				code = cmdCVCsPrint(cvr->certs, cvr->certs_len);
+			else
+				code = cvrPrintIndexed(cvr, count);
 		}
 	}
 	else 
 		printf("%u\n", (unsigned)count);
 	// завершить
-	cmdBlobClose(stack);
+	cmdCVRClose(cvr);
 	return code;
 }
 
+/*
+*******************************************************************************
+Индексирование
+
+cvr index <ring>
+*******************************************************************************
+*/
+
+static err_t cvrIndex(int argc, char* argv[])
+{
+	err_t code;
+	// обработать опции
+	if (argc != 1)
+		return ERR_CMD_PARAMS;
+	// проверить наличие файлов
+	code = cmdFileValExist(1, argv);
+	ERR_CALL_CHECK(code);
+	// построить индекс
+	return cmdCVRIndex(argv[0]);
+}
+
 /*
 *******************************************************************************
 Главная функция
@@ -715,6 +768,8 @@ int cvrMain(int argc, char* argv[])
 		code = cvrExtr(argc - 1, argv + 1);
 	else if (strEq(argv[0], "print"))
 		code = cvrPrint(argc - 1, argv + 1);
+	else if (strEq(argv[0], "index"))
+		code = cvrIndex(argc - 1, argv + 1);
 	else
 		code = ERR_CMD_NOT_FOUND;
 	// завершить
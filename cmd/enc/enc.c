@@ -0,0 +1,752 @@
+/*
+*******************************************************************************
+\file enc.c
+\brief Encrypt and decrypt files
+\project bee2/cmd
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "../cmd.h"
+#include <bee2/core/blob.h>
+#include <bee2/core/dec.h>
+#include <bee2/core/err.h>
+#include <bee2/core/hex.h>
+#include <bee2/core/mem.h>
+#include <bee2/core/rng.h>
+#include <bee2/core/str.h>
+#include <bee2/core/u32.h>
+#include <bee2/core/u64.h>
+#include <bee2/core/util.h>
+#include <bee2/crypto/belt.h>
+#include <stdio.h>
+
+/*
+*******************************************************************************
+Утилиты enc и dec
+
+Функционал:
+- зашифрование файла на пароле;
+- расшифрование файла или заданного фрагмента файла.
+
+Пример:
+  bee2cmd enc -pass pass:zed file file.enc
+  bee2cmd enc -che -chunk 16 -j4 -pass pass:zed file file.enc
+  bee2cmd dec -j4 -pass pass:zed file.enc file2
+  bee2cmd dec -range 1000:200 -pass pass:zed file.enc file3
+
+Формат зашифрованного файла:
+- заголовок (ENC_HDR_LEN октетов):
+  - "BENC" (4 октета);
+  - номер версии формата (1 октет, 1);
+  - алгоритм (1 октет: 1 -- belt-dwp, 2 -- belt-che);
+  - резерв (2 октета, нули);
+  - длина фрагмента (4 октета, младшие вперед);
+  - число итераций PBKDF2 (4 октета, младшие вперед);
+  - длина исходного файла (8 октетов, младшие вперед);
+  - синхропосылка PBKDF2 salt (16 октетов);
+  - одноразовый номер nonce (8 октетов);
+  - имитовставка mac предыдущих полей (8 октетов);
+- зашифрованные фрагменты, каждый из которых сопровождается 8-октетной
+  имитовставкой.
+
+Исходный файл разбивается на фрагменты фиксированной длины, последний
+фрагмент может быть короче. Пустой файл не содержит фрагментов.
+
+По паролю с помощью beltPBKDF2() строится ключ theta. Ключ заголовка
+и ключ фрагментов получаются из theta с помощью beltKRP() при различных
+заголовках D. Имитовставка заголовка вычисляется с помощью beltMAC().
+
+Фрагмент номер i защищается в режиме DWP или CHE. Синхропосылка --
+nonce || <i>_64, открытые данные -- mac || <i>_64. Тем самым фрагменты
+нельзя переставить, перенести в другой файл или отделить от заголовка.
+Усечение файла обнаруживается по длине исходного файла из заголовка.
+
+Фрагменты обрабатываются независимо: параллельно (с помощью
+cmdJobsRun()) и в произвольном порядке. Фрагменты считываются порциями
+по ENC_WINDOW_MUL фрагментов на поток, но не более ENC_WINDOW_SIZE
+октетов (и не менее одного фрагмента). Поэтому объем памяти не зависит
+от длины файла и числа потоков. Фрагмент файла расшифровывается без чтения
+непокрывающих его фрагментов.
+*******************************************************************************
+*/
+
+static const char _name[] = "enc";
+static const char _descr[] = "encrypt files";
+
+static const char _name2[] = "dec";
+static const char _descr2[] = "decrypt files";
+
+#define ENC_HDR_LEN			56
+#define ENC_TAG_LEN			8
+#define ENC_ITER			10000
+#define ENC_CHUNK_DEF		64
+#define ENC_CHUNK_MAX		16384
+#define ENC_WINDOW_MUL		4
+#define ENC_WINDOW_SIZE		((size_t)64 << 20)
+
+#define ENC_ALG_DWP			1
+#define ENC_ALG_CHE			2
+
+static int encUsage()
+{
+	printf(
+		"bee2cmd/%s: %s\n"
+		"Usage:\n"
+		"  enc [-che] [-chunk <size>] [-j <n>] -pass <schema> <file> <encfile>\n"
+		"    encrypt <file> and store the result in <encfile>\n"
+		"  options:\n"
+		"    -che -- use belt-che instead of belt-dwp\n"
+		"    -chunk <size> -- chunk size in Kbytes\n"
+		"      (1 <= <size> <= 16384, 64 by default)\n"
+		"    -j <n> -- number of threads (1 <= <n> <= 64, 1 by default)\n"
+		"    -pass <schema> -- password description\n"
+		,
+		_name, _descr
+	);
+	return -1;
+}
+
+static int decUsage()
+{
+	printf(
+		"bee2cmd/%s: %s\n"
+		"Usage:\n"
+		"  dec [-j <n>] [-range <offset>:<count>] -pass <schema> <encfile> <file>\n"
+		"    decrypt <encfile> and store the result in <file>\n"
+		"  options:\n"
+		"    -j <n> -- number of threads (1 <= <n> <= 64, 1 by default)\n"
+		"    -range <offset>:<count> -- decrypt only <count> bytes\n"
+		"      starting from <offset>\n"
+		"    -pass <schema> -- password description\n"
+		,
+		_name2, _descr2
+	);
+	return -1;
+}
+
+/*
+*******************************************************************************
+Самотестирование
+*******************************************************************************
+*/
+
+static err_t encSelfTest()
+{
+	octet buf[32];
+	octet mac[8];
+	octet level[12];
+	// belt-dwp: тест A.19-1
+	if (beltDWPWrap(buf, mac, beltH(), 16, beltH() + 16, 32,
+			beltH() + 128, 32, beltH() + 192) != ERR_OK ||
+		!hexEq(buf,
+			"52C9AF96FF50F64435FC43DEF56BD797") ||
+		!hexEq(mac,
+			"3B2E0AEB2B91854B"))
+		return ERR_SELFTEST;
+	if (beltDWPUnwrap(buf, buf, 16, beltH() + 16, 32, mac,
+			beltH() + 128, 32, beltH() + 192) != ERR_OK ||
+		!memEq(buf, beltH(), 16))
+		return ERR_SELFTEST;
+	// belt-che: тест A.19-2
+	if (beltCHEWrap(buf, mac, beltH(), 15, beltH() + 16, 32,
+			beltH() + 128, 32, beltH() + 192) != ERR_OK ||
+		!hexEq(buf,
+			"BF3DAEAF5D18D2BCC30EA62D2E70A4") ||
+		!hexEq(mac,
+			"548622B844123FF7"))
+		return ERR_SELFTEST;
+	// belt-keyrep: тест A.28-3
+	memSetZero(level, 12);
+	level[0] = 1;
+	if (beltKRP(buf, 32, beltH() + 128, 32, level, beltH() + 32) != ERR_OK ||
+		!hexEq(buf,
+			"76E166E6AB21256B6739397B672B8796"
+			"14B81CF05955FC3AB09343A745C48F77"))
+		return ERR_SELFTEST;
+	// все нормально
+	return ERR_OK;
+}
+
+/*
+*******************************************************************************
+Заголовок и ключи
+
+Заголовок, в котором не установлена имитовставка, формируется функцией
+encHdrEnc() и разбирается функцией encHdrDec(). Функция encKeys()
+строит ключ заголовка и ключ фрагментов.
+*******************************************************************************
+*/
+
+typedef struct
+{
+	octet alg;				/*< алгоритм */
+	size_t chunk;			/*< длина фрагмента */
+	u32 iter;				/*< число итераций PBKDF2 */
+	size_t size;			/*< длина исходного файла */
+	octet salt[16];			/*< синхропосылка PBKDF2 */
+	octet nonce[8];			/*< одноразовый номер */
+	octet mac[8];			/*< имитовставка заголовка */
+} enc_hdr_st;
+
+static void encHdrEnc(octet buf[ENC_HDR_LEN], const enc_hdr_st* hdr)
+{
+	u32 w;
+	u64 size;
+	memCopy(buf, "BENC", 4);
+	buf[4] = 1, buf[5] = hdr->alg, buf[6] = buf[7] = 0;
+	w = (u32)hdr->chunk;
+	u32To(buf + 8, 4, &w);
+	u32To(buf + 12, 4, &hdr->iter);
+	size = (u64)hdr->size;
+	u64To(buf + 16, 8, &size);
+	memCopy(buf + 24, hdr->salt, 16);
+	memCopy(buf + 40, hdr->nonce, 8);
+	memCopy(buf + 48, hdr->mac, 8);
+}
+
+static err_t encHdrDec(enc_hdr_st* hdr, const octet buf[ENC_HDR_LEN])
+{
+	u32 w;
+	u64 size;
+	if (!memEq(buf, "BENC", 4) || buf[4] != 1 ||
+		buf[5] != ENC_ALG_DWP && buf[5] != ENC_ALG_CHE ||
+		buf[6] != 0 || buf[7] != 0)
+		return ERR_BAD_FORMAT;
+	hdr->alg = buf[5];
+	u32From(&w, buf + 8, 4);
+	if (w == 0 || w > ENC_CHUNK_MAX * 1024)
+		return ERR_BAD_FORMAT;
+	hdr->chunk = (size_t)w;
+	u32From(&hdr->iter, buf + 12, 4);
+	if (hdr->iter == 0)
+		return ERR_BAD_FORMAT;
+	u64From(&size, buf + 16, 8);
+	hdr->size = (size_t)size;
+	if ((u64)hdr->size != size)
+		return ERR_BAD_FORMAT;
+	memCopy(hdr->salt, buf + 24, 16);
+	memCopy(hdr->nonce, buf + 40, 8);
+	memCopy(hdr->mac, buf + 48, 8);
+	return ERR_OK;
+}
+
+static void encKeys(octet hdr_key[32], octet key[32], const enc_hdr_st* hdr,
+	const cmd_pwd_t pwd)
+{
+	octet level[12];
+	octet d[16];
+	// theta <- PBKDF2(pwd, iter, salt)
+	beltPBKDF2(key, (const octet*)pwd, cmdPwdLen(pwd), hdr->iter,
+		hdr->salt, 16);
+	// hdr_key <- KRP(theta, 0, 1), key <- KRP(theta, 0, 2)
+	memSetZero(level, 12);
+	memSetZero(d, 16);
+	d[0] = 1;
+	beltKRP(hdr_key, 32, key, 32, level, d);
+	d[0] = 2;
+	beltKRP(key, 32, key, 32, level, d);
+}
+
+/*
+*******************************************************************************
+Обработка фрагментов
+
+Задание -- один фрагмент. Буфер задания содержит фрагмент и следующую
+за ним имитовставку. Задания выполняются функцией encWorker() в потоках
+cmdJobsRun(), результаты записываются в выходной файл функцией
+encReport() в порядке следования фрагментов.
+*******************************************************************************
+*/
+
+typedef struct
+{
+	octet* buf;				/*< фрагмент || имитовставка */
+	size_t len;				/*< длина фрагмента */
+	u64 num;				/*< номер фрагмента */
+	err_t code;				/*< результат обработки */
+} enc_job_st;
+
+typedef struct
+{
+	octet key[32];			/*< ключ фрагментов */
+	octet nonce[8];			/*< одноразовый номер */
+	octet mac[8];			/*< имитовставка заголовка */
+	bool_t che;				/*< режим CHE? */
+	bool_t wrap;			/*< зашифрование? */
+	FILE* fp;				/*< выходной файл */
+	size_t skip;			/*< пропустить октетов первого фрагмента */
+	size_t left;			/*< осталось вывести октетов */
+	err_t code;				/*< первая ошибка */
+} enc_stat_st;
+
+static void encWorker(void* job, void* state)
+{
+	enc_job_st* j = (enc_job_st*)job;
+	const enc_stat_st* stat = (const enc_stat_st*)state;
+	octet iv[16];
+	octet ad[16];
+	// iv <- nonce || <num>_64, ad <- mac || <num>_64
+	memCopy(iv, stat->nonce, 8);
+	u64To(iv + 8, 8, &j->num);
+	memCopy(ad, stat->mac, 8);
+	memCopy(ad + 8, iv + 8, 8);
+	// обработать фрагмент
+	if (stat->wrap)
+		j->code = stat->che ?
+			beltCHEWrap(j->buf, j->buf + j->len, j->buf, j->len, ad, 16,
+				stat->key, 32, iv) :
+			beltDWPWrap(j->buf, j->buf + j->len, j->buf, j->len, ad, 16,
+				stat->key, 32, iv);
+	else
+		j->code = stat->che ?
+			beltCHEUnwrap(j->buf, j->buf, j->len, ad, 16, j->buf + j->len,
+				stat->key, 32, iv) :
+			beltDWPUnwrap(j->buf, j->buf, j->len, ad, 16, j->buf + j->len,
+				stat->key, 32, iv);
+}
+
+static void encReport(void* job, void* state)
+{
+	const enc_job_st* j = (const enc_job_st*)job;
+	enc_stat_st* stat = (enc_stat_st*)state;
+	const octet* buf;
+	size_t count;
+	// ошибка уже обнаружена?
+	if (stat->code != ERR_OK)
+		return;
+	if (j->code != ERR_OK)
+	{
+		stat->code = j->code;
+		return;
+	}
+	// определить выводимые данные
+	if (stat->wrap)
+		buf = j->buf, count = j->len + ENC_TAG_LEN;
+	else
+	{
+		ASSERT(stat->skip < j->len);
+		buf = j->buf + stat->skip, count = j->len - stat->skip;
+		if (count > stat->left)
+			count = stat->left;
+		stat->skip = 0, stat->left -= count;
+	}
+	// вывести данные
+	if (fwrite(buf, 1, count, stat->fp) != count)
+		stat->code = ERR_FILE_WRITE;
+}
+
+static err_t encProcess(enc_stat_st* stat, FILE* fp, const enc_hdr_st* hdr,
+	u64 num, size_t count, size_t threads)
+{
+	err_t code;
+	size_t window;
+	size_t size;
+	void* stack;
+	enc_job_st* jobs;
+	octet* bufs;
+	// выделить память
+	window = ENC_WINDOW_MUL * (threads ? threads : 1);
+	window = MIN2(window, ENC_WINDOW_SIZE / (hdr->chunk + ENC_TAG_LEN));
+	if (window == 0)
+		window = 1;
+	code = cmdBlobCreate(stack,
+		window * (sizeof(enc_job_st) + hdr->chunk + ENC_TAG_LEN));
+	ERR_CALL_CHECK(code);
+	jobs = (enc_job_st*)stack;
+	bufs = (octet*)(jobs + window);
+	// обрабатывать фрагменты порциями
+	while (count && stat->code == ERR_OK)
+	{
+		for (size = 0; count && size < window; ++size, --count, ++num)
+		{
+			enc_job_st* job = jobs + size;
+			size_t len;
+			job->buf = bufs + size * (hdr->chunk + ENC_TAG_LEN);
+			job->len = MIN2(hdr->chunk, hdr->size - (size_t)num * hdr->chunk);
+			job->num = num;
+			job->code = ERR_OK;
+			len = stat->wrap ? job->len : job->len + ENC_TAG_LEN;
+			if (fread(job->buf, 1, len, fp) != len)
+			{
+				stat->code = ERR_FILE_READ;
+				break;
+			}
+		}
+		if (stat->code == ERR_OK)
+			cmdJobsRun(jobs, sizeof(enc_job_st), size, threads, encWorker,
+				encReport, stat);
+	}
+	cmdBlobClose(stack);
+	return stat->code;
+}
+
+/*
+*******************************************************************************
+Разбор опций
+
+В функции encParseSize() разбирается десятичное число.
+*******************************************************************************
+*/
+
+static err_t encParseThreads(size_t* threads, int* argc, char** argv[])
+{
+	const char* num = **argv + strLen("-j");
+	if (*threads)
+		return ERR_CMD_DUPLICATE;
+	if (!*num && *argc > 1)
+		num = (*argv)[1], --*argc, ++*argv;
+	if (!decIsValid(num) || !strLen(num) || strLen(num) > 2 ||
+		decCLZ(num) || (*threads = (size_t)decToU32(num)) == 0 ||
+		*threads > CMD_THREADS_MAX)
+		return ERR_CMD_PARAMS;
+	--*argc, ++*argv;
+	return ERR_OK;
+}
+
+static err_t encParseSize(size_t* val, const char* str)
+{
+	u64 v;
+	if (!decIsValid(str) || !strLen(str) || strLen(str) > 19 ||
+		strLen(str) > 1 && decCLZ(str))
+		return ERR_CMD_PARAMS;
+	v = decToU64(str);
+	*val = (size_t)v;
+	return (u64)*val == v ? ERR_OK : ERR_CMD_PARAMS;
+}
+
+static err_t encParsePwd(cmd_pwd_t* pwd, int* argc, char** argv[])
+{
+	err_t code;
+	if (*pwd)
+		return ERR_CMD_DUPLICATE;
+	--*argc, ++*argv;
+	if (!*argc)
+		return ERR_CMD_PARAMS;
+	code = cmdPwdRead(pwd, **argv);
+	ERR_CALL_CHECK(code);
+	ASSERT(cmdPwdIsValid(*pwd));
+	--*argc, ++*argv;
+	return ERR_OK;
+}
+
+/*
+*******************************************************************************
+Зашифрование
+
+enc [-che] [-chunk <size>] [-j <n>] -pass <schema> <file> <encfile>
+*******************************************************************************
+*/
+
+static err_t encEnc(int argc, char* argv[])
+{
+	err_t code = ERR_OK;
+	cmd_pwd_t pwd = 0;
+	bool_t che = FALSE;
+	size_t chunk = 0;
+	size_t threads = 0;
+	octet hdr_key[32];
+	octet buf[ENC_HDR_LEN];
+	enc_hdr_st hdr[1];
+	enc_stat_st* stat;
+	FILE* ifp;
+	// самотестирование
+	code = cmdSelfTest(encSelfTest);
+	ERR_CALL_CHECK(code);
+	// разбор опций
+	while (argc && strStartsWith(*argv, "-"))
+	{
+		if (strEq(*argv, "-che"))
+		{
+			if (che)
+			{
+				code = ERR_CMD_DUPLICATE;
+				break;
+			}
+			che = TRUE, ++argv, --argc;
+		}
+		else if (strEq(*argv, "-chunk"))
+		{
+			if (chunk)
+			{
+				code = ERR_CMD_DUPLICATE;
+				break;
+			}
+			if (argc < 2 || encParseSize(&chunk, argv[1]) != ERR_OK ||
+				chunk == 0 || chunk > ENC_CHUNK_MAX)
+			{
+				code = ERR_CMD_PARAMS;
+				break;
+			}
+			argv += 2, argc -= 2;
+		}
+		else if (strStartsWith(*argv, "-j"))
+		{
+			code = encParseThreads(&threads, &argc, &argv);
+			if (code != ERR_OK)
+				break;
+		}
+		else if (strEq(*argv, "-pass"))
+		{
+			code = encParsePwd(&pwd, &argc, &argv);
+			if (code != ERR_OK)
+				break;
+		}
+		else
+		{
+			code = ERR_CMD_PARAMS;
+			break;
+		}
+	}
+	if (code == ERR_OK && (!pwd || argc != 2))
+		code = ERR_CMD_PARAMS;
+	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
+	// проверить наличие / отсутствие файлов
+	code = cmdFileValExist(1, argv);
+	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
+	code = cmdFileValNotExist(1, argv + 1);
+	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
+	// подготовить заголовок
+	memSetZero(hdr, sizeof(hdr));
+	hdr->alg = che ? ENC_ALG_CHE : ENC_ALG_DWP;
+	hdr->chunk = (chunk ? chunk : ENC_CHUNK_DEF) * 1024;
+	hdr->iter = ENC_ITER;
+	hdr->size = cmdFileSize(argv[0]);
+	code = hdr->size != SIZE_MAX ? ERR_OK : ERR_FILE_READ;
+	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
+	code = cmdRngStart(FALSE, 0);
+	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
+	rngStepR(hdr->salt, 16, 0);
+	rngStepR(hdr->nonce, 8, 0);
+	// построить ключи
+	code = cmdBlobCreate(stat, sizeof(enc_stat_st));
+	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
+	encKeys(hdr_key, stat->key, hdr, pwd);
+	cmdPwdClose(pwd);
+	// выработать имитовставку заголовка
+	encHdrEnc(buf, hdr);
+	beltMAC(hdr->mac, buf, ENC_HDR_LEN - 8, hdr_key, 32);
+	memWipe(hdr_key, 32);
+	encHdrEnc(buf, hdr);
+	// открыть файлы
+	ifp = fopen(argv[0], "rb");
+	code = ifp ? ERR_OK : ERR_FILE_OPEN;
+	ERR_CALL_HANDLE(code, cmdBlobClose(stat));
+	stat->fp = fopen(argv[1], "wb");
+	code = stat->fp ? ERR_OK : ERR_FILE_CREATE;
+	ERR_CALL_HANDLE(code, (fclose(ifp), cmdBlobClose(stat)));
+	// записать заголовок
+	code = fwrite(buf, 1, ENC_HDR_LEN, stat->fp) == ENC_HDR_LEN ?
+		ERR_OK : ERR_FILE_WRITE;
+	// зашифровать фрагменты
+	if (code == ERR_OK)
+	{
+		memCopy(stat->nonce, hdr->nonce, 8);
+		memCopy(stat->mac, hdr->mac, 8);
+		stat->che = che, stat->wrap = TRUE;
+		code = encProcess(stat, ifp, hdr, 0,
+			(hdr->size + hdr->chunk - 1) / hdr->chunk, threads);
+	}
+	// завершить
+	if (fclose(stat->fp) != 0 && code == ERR_OK)
+		code = ERR_FILE_WRITE;
+	fclose(ifp);
+	cmdBlobClose(stat);
+	if (code != ERR_OK)
+		remove(argv[1]);
+	return code;
+}
+
+/*
+*******************************************************************************
+Расшифрование
+
+dec [-j <n>] [-range <offset>:<count>] -pass <schema> <encfile> <file>
+*******************************************************************************
+*/
+
+static err_t encDec(int argc, char* argv[])
+{
+	err_t code = ERR_OK;
+	cmd_pwd_t pwd = 0;
+	size_t threads = 0;
+	bool_t range = FALSE;
+	size_t offset = 0;
+	size_t count = 0;
+	size_t enc_size;
+	size_t tags_size;
+	size_t chunks;
+	size_t first;
+	octet hdr_key[32];
+	octet mac[8];
+	octet buf[ENC_HDR_LEN];
+	enc_hdr_st hdr[1];
+	enc_stat_st* stat;
+	FILE* ifp;
+	// самотестирование
+	code = cmdSelfTest(encSelfTest);
+	ERR_CALL_CHECK(code);
+	// разбор опций
+	while (argc && strStartsWith(*argv, "-"))
+	{
+		if (strStartsWith(*argv, "-j"))
+		{
+			code = encParseThreads(&threads, &argc, &argv);
+			if (code != ERR_OK)
+				break;
+		}
+		else if (strEq(*argv, "-range"))
+		{
+			char* sep;
+			if (range)
+			{
+				code = ERR_CMD_DUPLICATE;
+				break;
+			}
+			if (argc >= 2)
+				for (sep = argv[1]; *sep && *sep != ':'; ++sep);
+			if (argc < 2 || *sep != ':')
+			{
+				code = ERR_CMD_PARAMS;
+				break;
+			}
+			*sep = 0;
+			if (encParseSize(&offset, argv[1]) != ERR_OK ||
+				encParseSize(&count, sep + 1) != ERR_OK)
+			{
+				code = ERR_CMD_PARAMS;
+				break;
+			}
+			*sep = ':', range = TRUE;
+			argv += 2, argc -= 2;
+		}
+		else if (strEq(*argv, "-pass"))
+		{
+			code = encParsePwd(&pwd, &argc, &argv);
+			if (code != ERR_OK)
+				break;
+		}
+		else
+		{
+			code = ERR_CMD_PARAMS;
+			break;
+		}
+	}
+	if (code == ERR_OK && (!pwd || argc != 2))
+		code = ERR_CMD_PARAMS;
+	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
+	// проверить наличие / отсутствие файлов
+	code = cmdFileValExist(1, argv);
+	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
+	code = cmdFileValNotExist(1, argv + 1);
+	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
+	// прочитать заголовок
+	enc_size = cmdFileSize(argv[0]);
+	code = enc_size != SIZE_MAX ? ERR_OK : ERR_FILE_READ;
+	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
+	ifp = fopen(argv[0], "rb");
+	code = ifp ? ERR_OK : ERR_FILE_OPEN;
+	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
+	code = fread(buf, 1, ENC_HDR_LEN, ifp) == ENC_HDR_LEN ?
+		ERR_OK : ERR_BAD_FORMAT;
+	ERR_CALL_HANDLE(code, (fclose(ifp), cmdPwdClose(pwd)));
+	code = encHdrDec(hdr, buf);
+	ERR_CALL_HANDLE(code, (fclose(ifp), cmdPwdClose(pwd)));
+	// проверить длину зашифрованного файла
+	chunks = hdr->size / hdr->chunk + (hdr->size % hdr->chunk ? 1 : 0);
+	code = enc_size >= ENC_HDR_LEN && enc_size - ENC_HDR_LEN >= hdr->size ?
+		ERR_OK : ERR_BAD_FORMAT;
+	ERR_CALL_HANDLE(code, (fclose(ifp), cmdPwdClose(pwd)));
+	tags_size = enc_size - ENC_HDR_LEN - hdr->size;
+	code = tags_size % ENC_TAG_LEN == 0 &&
+		tags_size / ENC_TAG_LEN == chunks ? ERR_OK : ERR_BAD_FORMAT;
+	ERR_CALL_HANDLE(code, (fclose(ifp), cmdPwdClose(pwd)));
+	// проверить фрагмент
+	if (!range)
+		count = hdr->size;
+	code = offset <= hdr->size && count <= hdr->size - offset ?
+		ERR_OK : ERR_CMD_PARAMS;
+	ERR_CALL_HANDLE(code, (fclose(ifp), cmdPwdClose(pwd)));
+	// построить ключи
+	code = cmdBlobCreate(stat, sizeof(enc_stat_st));
+	ERR_CALL_HANDLE(code, (fclose(ifp), cmdPwdClose(pwd)));
+	encKeys(hdr_key, stat->key, hdr, pwd);
+	cmdPwdClose(pwd);
+	// проверить имитовставку заголовка
+	beltMAC(mac, buf, ENC_HDR_LEN - 8, hdr_key, 32);
+	memWipe(hdr_key, 32);
+	code = memEq(mac, hdr->mac, 8) ? ERR_OK : ERR_BAD_PWD;
+	ERR_CALL_HANDLE(code, (fclose(ifp), cmdBlobClose(stat)));
+	// перейти к первому фрагменту
+	first = count ? offset / hdr->chunk : 0;
+	code = cmdFileSeek(ifp, (u64)ENC_HDR_LEN +
+		(u64)first * (hdr->chunk + ENC_TAG_LEN));
+	ERR_CALL_HANDLE(code, (fclose(ifp), cmdBlobClose(stat)));
+	// открыть выходной файл
+	stat->fp = fopen(argv[1], "wb");
+	code = stat->fp ? ERR_OK : ERR_FILE_CREATE;
+	ERR_CALL_HANDLE(code, (fclose(ifp), cmdBlobClose(stat)));
+	// расшифровать фрагменты
+	memCopy(stat->nonce, hdr->nonce, 8);
+	memCopy(stat->mac, hdr->mac, 8);
+	stat->che = hdr->alg == ENC_ALG_CHE, stat->wrap = FALSE;
+	stat->skip = offset - first * hdr->chunk, stat->left = count;
+	if (count)
+		code = encProcess(stat, ifp, hdr, (u64)first,
+			(offset + count - 1) / hdr->chunk - first + 1, threads);
+	// завершить
+	if (fclose(stat->fp) != 0 && code == ERR_OK)
+		code = ERR_FILE_WRITE;
+	fclose(ifp);
+	cmdBlobClose(stat);
+	if (code != ERR_OK)
+		remove(argv[1]);
+	return code;
+}
+
+/*
+*******************************************************************************
+Главные функции
+*******************************************************************************
+*/
+
+static int encMain(int argc, char* argv[])
+{
+	err_t code;
+	// справка
+	if (argc < 2)
+		return encUsage();
+	// зашифрование
+	code = encEnc(argc - 1, argv + 1);
+	// завершить
+	if (code != ERR_OK)
+		printf("bee2cmd/%s: %s\n", _name, errMsg(code));
+	return code != ERR_OK ? -1 : 0;
+}
+
+static int decMain(int argc, char* argv[])
+{
+	err_t code;
+	// справка
+	if (argc < 2)
+		return decUsage();
+	// расшифрование
+	code = encDec(argc - 1, argv + 1);
+	// завершить
+	if (code != ERR_OK)
+		printf("bee2cmd/%s: %s\n", _name2, errMsg(code));
+	return code != ERR_OK ? -1 : 0;
+}
+
+err_t encInit()
+{
+	return cmdReg(_name, _descr, encMain);
+}
+
+err_t decInit()
+{
+	return cmdReg(_name2, _descr2, decMain);
+}
@@ -4,7 +4,7 @@
 \brief Dealing with entropy sources
 \project bee2/cmd 
 \created 2021.04.20
-\version 2023.12.16
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -31,11 +31,13 @@
 - перечень доступных источников энтропии;
 - проверка работоспосбности источников энтропии;
 - выгрузка данных от стандартных источников энтропии;
-- эксперименты с источником timer.
+- эксперименты с источником timer;
+- выгрузка данных от штатного ГСЧ с заданным механизмом генерации.
 
 Пример:
   bee2cmd es print
   bee2cmd es read trng2 128 file
+  bee2cmd es gen bash-prg 1024 file
 *******************************************************************************
 */
 
@@ -51,8 +53,11 @@ static int esUsage()
 		"    list available entropy sources and determine their health\n"
 		"  es read <source> <count> <file>\n"
 		"    read <count> Kbytes from <source> and store them in <file>\n"
+		"  es gen <engine> <count> <file>\n"
+		"    start RNG with <engine>, generate <count> Kbytes and store them in <file>\n"
 		"  <source> in {trng, trng2, sys, sys2, timer, timerNN}\n"
 		"    timerNNN -- use NNN sleep delays to produce one output bit\n"
+		"  <engine> in {brng-ctr, bash-prg}\n"
 		,
 		_name, _descr
 	);
@@ -209,6 +214,59 @@ static err_t esRead(int argc, char *argv[])
 	return ERR_OK;
 }
 
+/*
+*******************************************************************************
+Генерация
+
+es gen <engine> <count> <file>
+*******************************************************************************
+*/
+
+static err_t esGen(int argc, char *argv[])
+{
+	err_t code;
+	size_t count;
+	FILE* fp;
+	octet buf[2048];
+	// разбор командной строки: число параметров
+	if (argc != 3)
+		return ERR_CMD_PARAMS;
+	// разбор командной строки: механизм генерации
+	if (!strEq(argv[0], "brng-ctr") && !strEq(argv[0], "bash-prg"))
+		return ERR_CMD_PARAMS;
+	// разбор командной строки: число Кбайтов
+	if (!decIsValid(argv[1]) || !strLen(argv[1]) || 
+		strLen(argv[1]) > 4 || decCLZ(argv[1]))
+		return ERR_CMD_PARAMS;
+	count = (size_t)decToU32(argv[1]);
+	if (((count << 10) >> 10) != count)
+		return ERR_OUTOFRANGE;
+	count <<= 10;
+	// разбор командной строки: имя выходного файла
+	code = cmdFileValNotExist(1, argv + 2);
+	ERR_CALL_CHECK(code);
+	// запустить ГСЧ
+	code = cmdRngStart(FALSE, argv[0]);
+	ERR_CALL_CHECK(code);
+	fp = fopen(argv[2], "wb");
+	if (!fp)
+		return ERR_FILE_OPEN;
+	// выгрузка данных
+	while (count)
+	{
+		size_t len = MIN2(sizeof(buf), count);
+		rngStepR2(buf, len, 0);
+		code = fwrite(buf, 1, len, fp) == len ? ERR_OK : ERR_FILE_WRITE;
+		ERR_CALL_HANDLE(code, fclose(fp));
+		count -= len;
+	}
+	// завершение
+	rngRekey();
+	memWipe(buf, sizeof(buf));
+	fclose(fp);
+	return ERR_OK;
+}
+
 /*
 *******************************************************************************
 Главная функция
@@ -227,6 +285,8 @@ int esMain(int argc, char* argv[])
 		code = esPrint(argc - 1, argv + 1);
 	else if (strEq(argv[0], "read"))
 		code = esRead(argc - 1, argv + 1);
+	else if (strEq(argv[0], "gen"))
+		code = esGen(argc - 1, argv + 1);
 	else
 		code = ERR_CMD_NOT_FOUND;
 	// завершить
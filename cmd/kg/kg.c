@@ -4,7 +4,7 @@
 \brief Generate and manage private keys
 \project bee2/cmd 
 \created 2022.06.08
-\version 2023.12.19
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -40,6 +40,7 @@
 Пример:
   bee2cmd pwd gen share:"-l256 -t3 -pass pass:zed s1 s2 s3 s4 s5"
   bee2cmd kg gen -l256 -pass share:"-pass pass:zed s2 s3 s4" privkey
+  bee2cmd kg gen -rng bash-prg -pass pass:zed privkey2
   bee2cmd kg val -pass share:"-pass pass:zed s1 s2 s4" privkey
   bee2cmd kg chp -passin share:"-pass pass:zed s3 s1 s4" \
     -passout pass:"1?23&aaA..." privkey
@@ -56,7 +57,7 @@ static int kgUsage()
 	printf(
 		"bee2cmd/%s: %s\n"
 		"Usage:\n"
-		"  kg gen [-l<nnn>] -pass <schema> <privkey>\n"
+		"  kg gen [-l<nnn>] [-rng <engine>] -pass <schema> <privkey>\n"
 		"    generate a private key and store it in <privkey>\n"
 		"  kg chp -passin <schema> -passout <schema> <privkey>\n"
 		"    change the password used to protect <privkey>\n"
@@ -68,6 +69,7 @@ static int kgUsage()
 		"    validate <privkey> and print the corresponding public key\n"
 		"  options:\n"
 		"    -l<nnn> -- security level: 96, 128 (by default), 192 or 256\n"
+		"    -rng <engine> -- RNG engine: brng-ctr (by default) or bash-prg\n"
 		"    -pass <schema> -- password description\n"
 		"    -passin <schema> -- input password description\n"
 		"    -passout <schema> -- output password description\n"
@@ -180,7 +182,7 @@ static err_t kgSelfTest()
 *******************************************************************************
 Генерация ключа
 
-gen [-lnnn] -pass <schema> <privkey>
+gen [-lnnn] [-rng <engine>] -pass <schema> <privkey>
 *******************************************************************************
 */
 
@@ -189,12 +191,13 @@ static err_t kgGen(int argc, char* argv[])
 	err_t code = ERR_OK;
 	size_t len = 0;
 	cmd_pwd_t pwd = 0;
+	const char* engine = 0;
 	bign_params params[1];
 	void* stack = 0;
 	octet* privkey;
 	octet* pubkey;
 	// самотестирование
-	code = kgSelfTest();
+	code = cmdSelfTest(kgSelfTest);
 	ERR_CALL_CHECK(code);
 	// разбор опций
 	while (argc && strStartsWith(*argv, "-"))
@@ -216,6 +219,22 @@ static err_t kgGen(int argc, char* argv[])
 			}
 			len /= 4, ++argv, --argc;
 		}
+		else if (strEq(*argv, "-rng"))
+		{
+			if (engine)
+			{
+				code = ERR_CMD_DUPLICATE;
+				break;
+			}
+			++argv, --argc;
+			if (!argc || !strEq(*argv, "brng-ctr") && !strEq(*argv, "bash-prg"))
+			{
+				code = ERR_CMD_PARAMS;
+				break;
+			}
+			engine = *argv;
+			++argv, --argc;
+		}
 		else if (strEq(*argv, "-pass"))
 		{
 			if (pwd)
@@ -253,7 +272,7 @@ static err_t kgGen(int argc, char* argv[])
 	code = kgParamsStd(params, len);
 	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
 	// запустить ГСЧ
-	code = cmdRngStart(TRUE);
+	code = cmdRngStart(TRUE, engine);
 	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
 	// выделить память
 	code = cmdBlobCreate(stack, 3 * len);
@@ -289,7 +308,7 @@ static err_t kgChp(int argc, char* argv[])
 	size_t len = 0;
 	octet* privkey;
 	// самотестирование
-	code = kgSelfTest();
+	code = cmdSelfTest(kgSelfTest);
 	ERR_CALL_CHECK(code);
 	// разбор опций
 	while (argc && strStartsWith(*argv, "-"))
@@ -355,7 +374,7 @@ static err_t kgChp(int argc, char* argv[])
 	cmdPwdClose(pwdin);
 	ERR_CALL_HANDLE(code, (cmdBlobClose(privkey), cmdPwdClose(pwdout)));
 	// запустить ГСЧ
-	code = cmdRngStart(TRUE);
+	code = cmdRngStart(TRUE, 0);
 	ERR_CALL_HANDLE(code, (cmdBlobClose(privkey), cmdPwdClose(pwdout)));
 	// сохранить личный ключ
 	code = cmdPrivkeyWrite(privkey, len, argv[0], pwdout);
@@ -379,7 +398,7 @@ static err_t kgVal(int argc, char* argv[])
 	size_t len = 0;
 	octet* privkey;
 	// самотестирование
-	code = kgSelfTest();
+	code = cmdSelfTest(kgSelfTest);
 	ERR_CALL_CHECK(code);
 	// разбор опций
 	while (argc && strStartsWith(*argv, "-"))
@@ -446,7 +465,7 @@ static err_t kgExtr(int argc, char* argv[])
 	octet* privkey;
 	octet* pubkey;
 	// самотестирование
-	code = kgSelfTest();
+	code = cmdSelfTest(kgSelfTest);
 	ERR_CALL_CHECK(code);
 	// разбор опций
 	while (argc && strStartsWith(*argv, "-"))
@@ -529,7 +548,7 @@ static err_t kgPrint(int argc, char* argv[])
 	octet* pubkey;
 	char* hex;
 	// самотестирование
-	code = kgSelfTest();
+	code = cmdSelfTest(kgSelfTest);
 	ERR_CALL_CHECK(code);
 	// разбор опций
 	while (argc && strStartsWith(*argv, "-"))
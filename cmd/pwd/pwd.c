@@ -4,7 +4,7 @@
 \brief Generate and manage passwords
 \project bee2/cmd 
 \created 2022.06.23
-\version 2023.12.17
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -151,10 +151,10 @@ static err_t pwdGen(int argc, char* argv[])
 	if (argc != 1)
 		return ERR_BAD_PARAMS;
 	// самотестирование
-	code = pwdSelfTest();
+	code = cmdSelfTest(pwdSelfTest);
 	ERR_CALL_CHECK(code);
 	// запустить ГСЧ
-	code = cmdRngStart(TRUE);
+	code = cmdRngStart(TRUE, 0);
 	ERR_CALL_CHECK(code);
 	// генерировать пароль
 	code = cmdPwdGen(&pwd, *argv);
@@ -178,7 +178,7 @@ static err_t pwdVal(int argc, char* argv[])
 	if (argc != 1)
 		return ERR_BAD_PARAMS;
 	// самотестирование
-	code = pwdSelfTest();
+	code = cmdSelfTest(pwdSelfTest);
 	ERR_CALL_CHECK(code);
 	// определить пароль (с одновременной проверкой)
 	code = cmdPwdRead(&pwd, *argv);
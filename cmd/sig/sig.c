@@ -4,7 +4,7 @@
 \brief Sign files and verify signatures
 \project bee2/cmd
 \created 2022.08.01
-\version 2023.12.17
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -47,6 +47,8 @@
   bee2cmd sig val -pubkey pubkey2 sig_file sig_file
   bee2cmd sig print sig_file
   bee2cmd sig print -certc sig_file
+  # проверка подписей списка файлов
+  bee2cmd sig val -anchor cert0 -j4 -list sig_list
   bee2cmd sig print -date sig_file
   # извлечение частей
   bee2cmd sig extr -body sig_file body
@@ -71,8 +73,13 @@ static int sigUsage()
         "Usage:\n"
         "  sig sign [options] <privkey> <file> <sig>\n"
         "    sign <file> using <privkey> and store the signature in <sig>\n"
+		"  sig sign [options] -daemon <socket> <file> <sig>\n"
+		"    sign <file> using the key of the daemon listening on <socket>\n"
 		"  sig val {-pubkey <pubkey>|-anchor <anchor>} <file> <sig>\n"
 		"    verify <sig> of <file> using either <pubkey> or <anchor>\n"
+		"  sig val {-pubkey <pubkey>|-anchor <anchor>} [-j <n>] -list <list>\n"
+		"    verify signatures of files enumerated in <list>\n"
+		"      -j <n> -- number of threads (1 <= <n> <= 64, 1 by default)\n"
 		"  sig extr {-cert<n>|-body|-sig} <sig> <file>\n"
 		"    extract from <sig> an object and store it in <file>\n"
 		"      -cert<n> -- the <n>th attached certificate\n"
@@ -89,10 +96,12 @@ static int sigUsage()
 		"    file with a public key\n"
 		"  <anchor>\n"
 		"    file with a trusted sertificate\n"
+		"  <list>\n"
+		"    file with lines \"<file> <sig>\" or \"<sig>\" (attached signature)\n"
 		"  options:\n"
 		"    -certs <certs> -- certificate chain (optional)\n"
 		"    -date <YYMMDD> -- date of signing (optional)\n"
-		"    -pass <schema> -- password description\n"
+		"    -pass <schema> -- password description (not used with -daemon)\n"
 		"  field:\n"
         "    {-certc|-date|-sig}\n"
 		"      -certc -- the number of attached certificates\n"
@@ -164,6 +173,10 @@ static err_t sigSelfTest()
 Выработка подписи
 
 sig sign [-certs <certs>] [-date <YYMMDD>] -pass <schema> <file> <sig>
+sig sign [-certs <certs>] [-date <YYMMDD>] -daemon <socket> <file> <sig>
+
+С опцией -daemon личный ключ не читается: подпись вырабатывается демоном
+bee2d, который слушает сокет <socket>.
 *******************************************************************************
 */
 
@@ -171,12 +184,13 @@ static err_t sigSign(int argc, char* argv[])
 {
 	err_t code;
 	const char* certs = 0;
+	const char* socket = 0;
 	octet date[6];
 	cmd_pwd_t pwd = 0;
 	size_t privkey_len;
 	octet* privkey;
 	// самотестирование
-	code = sigSelfTest();
+	code = cmdSelfTest(sigSelfTest);
 	ERR_CALL_CHECK(code);
 	// без даты по умолчанию
 	memSetZero(date, 6);
@@ -214,6 +228,18 @@ static err_t sigSign(int argc, char* argv[])
 				break;
 			--argc, ++argv;
 		}
+		else if (strEq(*argv, "-daemon"))
+		{
+			if (socket)
+			{
+				code = ERR_CMD_DUPLICATE;
+				break;
+			}
+			++argv, --argc;
+			ASSERT(argc > 0);
+			socket = *argv;
+			++argv, --argc;
+		}
 		else if (strStartsWith(*argv, "-pass"))
 		{
 			if (pwd)
@@ -235,9 +261,21 @@ static err_t sigSign(int argc, char* argv[])
 			break;
 		}
 	}
-	if (code == ERR_OK && (!pwd || argc != 3))
+	if (code == ERR_OK && (socket ? pwd || argc != 2 : !pwd || argc != 3))
 		code = ERR_CMD_PARAMS;
 	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
+	// подписать с помощью демона
+	if (socket)
+	{
+		code = cmdFileValExist(1, argv);
+		ERR_CALL_CHECK(code);
+		if (!cmdFileAreSame(argv[0], argv[1]))
+		{
+			code = cmdFileValNotExist(1, argv + 1);
+			ERR_CALL_CHECK(code);
+		}
+		return cmdSigSignDaemon(argv[1], argv[0], certs, date, socket);
+	}
 	// проверить наличие <privkey> и <file>
 	code = cmdFileValExist(2, argv);
 	ERR_CALL_HANDLE(code, cmdPwdClose(pwd));
@@ -263,11 +301,191 @@ static err_t sigSign(int argc, char* argv[])
 	return code;
 }
 
+/*
+*******************************************************************************
+Проверка подписей списка файлов
+
+sig val {-pubkey <pubkey> | -anchor <anchor>} [-j <n>] -list <list>
+
+Каждая строка файла <list> содержит имена файла и подписи или только
+имя файла со встроенной подписью. Имена разделяются пробелами, имена
+с пробелами заключаются в кавычки. Пустые строки и строки, которые
+начинаются с символа '#', пропускаются.
+
+Открытый ключ или доверенный сертификат читается один раз. Подписи
+проверяются порциями (не более SIG_WINDOW подписей) с помощью
+cmdJobsRun(). На время проверки включается кэширование (если оно еще
+не включено): промежуточные сертификаты, общие для нескольких цепочек,
+проверяются только один раз.
+*******************************************************************************
+*/
+
+#define SIG_WINDOW 256
+
+typedef struct
+{
+	const char* file;	/*< имя подписанного файла */
+	const char* sig;	/*< имя файла подписи */
+	err_t code;			/*< результат проверки */
+	char str[1024];		/*< имена файлов */
+} sig_job_st;
+
+typedef struct
+{
+	const octet* key;	/*< открытый ключ / доверенный сертификат */
+	size_t key_len;		/*< длина key */
+	bool_t anchor;		/*< key -- доверенный сертификат? */
+	size_t bad_sigs;	/*< число непрошедших проверку подписей */
+	err_t code;			/*< первая ошибка */
+} sig_stat_st;
+
+static void sigValWorker(void* job, void* state)
+{
+	sig_job_st* j = (sig_job_st*)job;
+	const sig_stat_st* stat = (const sig_stat_st*)state;
+	if (stat->anchor)
+		j->code = cmdSigVerify2(j->file, j->sig, stat->key, stat->key_len);
+	else
+		j->code = cmdSigVerify(j->file, j->sig, stat->key, stat->key_len);
+}
+
+static void sigValReport(void* job, void* state)
+{
+	const sig_job_st* j = (const sig_job_st*)job;
+	sig_stat_st* stat = (sig_stat_st*)state;
+	if (j->code == ERR_OK)
+		printf("%s: OK\n", j->file);
+	else
+	{
+		stat->bad_sigs++;
+		if (stat->code == ERR_OK)
+			stat->code = j->code;
+		printf("%s: FAILED [%s]\n", j->file, errMsg(j->code));
+	}
+}
+
+static bool_t sigValParseLine(sig_job_st* job)
+{
+	int argc;
+	char** argv;
+	if (cmdArgCreate(&argc, &argv, job->str) != ERR_OK)
+		return FALSE;
+	if (argc < 1 || argc > 2 ||
+		strLen(argv[0]) + strLen(argv[argc - 1]) + 2 > sizeof(job->str))
+	{
+		cmdArgClose(argv);
+		return FALSE;
+	}
+	job->file = job->str;
+	job->sig = job->str + strLen(argv[0]) + 1;
+	strCopy(job->str, argv[0]);
+	strCopy(job->str + strLen(argv[0]) + 1, argv[argc - 1]);
+	cmdArgClose(argv);
+	return TRUE;
+}
+
+static err_t sigValList(bool_t anchor, const char* key_name, size_t threads,
+	const char* list)
+{
+	err_t code;
+	size_t count;
+	octet* key;
+	sig_job_st* jobs;
+	sig_stat_st stat[1];
+	char* str;
+	size_t str_len;
+	FILE* fp;
+	bool_t cache;
+	size_t all_lines = 0;
+	size_t bad_lines = 0;
+	// прочитать pubkey / anchor
+	code = cmdFileReadAll(0, &count, key_name);
+	ERR_CALL_CHECK(code);
+	code = cmdBlobCreate(key, count);
+	ERR_CALL_CHECK(code);
+	code = cmdFileReadAll(key, &count, key_name);
+	ERR_CALL_HANDLE(code, cmdBlobClose(key));
+	// подготовить задания
+	jobs = (sig_job_st*)memAlloc(sizeof(sig_job_st) * SIG_WINDOW);
+	code = jobs ? ERR_OK : ERR_OUTOFMEMORY;
+	ERR_CALL_HANDLE(code, cmdBlobClose(key));
+	// открыть список
+	fp = fopen(list, "rb");
+	code = fp ? ERR_OK : ERR_FILE_OPEN;
+	ERR_CALL_HANDLE(code, (memFree(jobs), cmdBlobClose(key)));
+	// включить кэширование
+	if (!(cache = cmdCacheIsOn()))
+		cmdCacheOn();
+	// обработать строки порциями
+	memSetZero(stat, sizeof(stat));
+	stat->key = key, stat->key_len = count, stat->anchor = anchor;
+	do
+	{
+		for (count = 0; count < SIG_WINDOW; )
+		{
+			str = jobs[count].str;
+			if (!fgets(str, sizeof(jobs[count].str), fp))
+				break;
+			++all_lines;
+			// слишком длинная строка?
+			str_len = strLen(str);
+			if (str_len + 1 == sizeof(jobs[count].str) &&
+				str[str_len - 1] != '\n')
+			{
+				int ch;
+				while ((ch = fgetc(fp)) != EOF && ch != '\n');
+				bad_lines++;
+				continue;
+			}
+			// удалить завершающие символы перевода строки
+			while (str_len && (str[str_len - 1] == '\n' ||
+				str[str_len - 1] == '\r'))
+				str[--str_len] = 0;
+			// пропустить пустую строку или комментарий
+			while (*str == ' ' || *str == '\t')
+				++str;
+			if (!*str || *str == '#')
+				continue;
+			// создать задание
+			if (!sigValParseLine(jobs + count))
+			{
+				bad_lines++;
+				continue;
+			}
+			++count;
+		}
+		// проверить подписи
+		cmdJobsRun(jobs, sizeof(sig_job_st), count, threads, sigValWorker,
+			sigValReport, stat);
+	}
+	while (count == SIG_WINDOW);
+	// завершить
+	if (!cache)
+		cmdCacheClose();
+	fclose(fp);
+	memFree(jobs);
+	cmdBlobClose(key);
+	if (bad_lines)
+		fprintf(stderr, bad_lines == 1 ?
+			"WARNING: %lu input line (out of %lu) is improperly formatted\n" :
+			"WARNING: %lu input lines (out of %lu) are improperly formatted\n",
+			(unsigned long)bad_lines, (unsigned long)all_lines);
+	if (stat->bad_sigs)
+		fprintf(stderr, stat->bad_sigs == 1 ?
+			"WARNING: %lu signature did NOT verify\n" :
+			"WARNING: %lu signatures did NOT verify\n",
+			(unsigned long)stat->bad_sigs);
+	if (stat->code == ERR_OK && bad_lines)
+		stat->code = ERR_BAD_FORMAT;
+	return stat->code;
+}
+
 /*
 *******************************************************************************
 Проверка подписи
 
 sig val {-pubkey <pubkey> | -anchor <anchor>} <file> <sig>
+sig val {-pubkey <pubkey> | -anchor <anchor>} [-j <n>] -list <list>
 *******************************************************************************
 */
 
@@ -276,13 +494,43 @@ static err_t sigVal(int argc, char* argv[])
 	err_t code;
 	size_t count;
 	octet* stack;
+	size_t threads = 0;
 	// самотестирование
-	code = sigSelfTest();
+	code = cmdSelfTest(sigSelfTest);
 	ERR_CALL_CHECK(code);
 	// проверить опции
-	if (argc != 4 ||
+	if (argc < 2 ||
 		!strEq(argv[0], "-pubkey") && !strEq(argv[0], "-anchor"))
 		return ERR_CMD_PARAMS;
+	// список файлов?
+	if (argc > 2 && (strStartsWith(argv[2], "-j") || strEq(argv[2], "-list")))
+	{
+		char* key_name = argv[1];
+		bool_t anchor = strEq(argv[0], "-anchor");
+		argc -= 2, argv += 2;
+		// threads
+		if (strStartsWith(argv[0], "-j"))
+		{
+			const char* num = argv[0] + strLen("-j");
+			if (!*num && argc > 1)
+				num = argv[1], --argc, ++argv;
+			if (!decIsValid(num) || !strLen(num) || strLen(num) > 2 ||
+				decCLZ(num) || (threads = (size_t)decToU32(num)) == 0 ||
+				threads > CMD_THREADS_MAX)
+				return ERR_CMD_PARAMS;
+			--argc, ++argv;
+		}
+		// -list <list>
+		if (argc != 2 || !strEq(argv[0], "-list"))
+			return ERR_CMD_PARAMS;
+		code = cmdFileValExist(1, &key_name);
+		ERR_CALL_CHECK(code);
+		code = cmdFileValExist(1, argv + 1);
+		ERR_CALL_CHECK(code);
+		return sigValList(anchor, key_name, threads, argv[1]);
+	}
+	if (argc != 4)
+		return ERR_CMD_PARAMS;
 	// проверить наличие {<pubkey> | <anchor>} <file> <sig>
 	code = cmdFileValExist(3, argv + 1);
 	ERR_CALL_CHECK(code);
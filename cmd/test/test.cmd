@@ -3,7 +3,7 @@ rem ===========================================================================
 rem \brief Testing command-line interface
 rem \project bee2evp/cmd
 rem \created 2022.06.24
-rem \version 2024.01.22
+rem \version 2026.10.18
 rem \pre The working directory contains zed.csr.
 rem ===========================================================================
 
@@ -27,7 +27,7 @@ rem ===========================================================================
 
 echo ****** Testing bee2cmd/bsum...
 
-del /q check32 check256 -c 2> nul
+del /q check32 check256 check256j checkt checktj -c 2> nul
 
 bee2cmd bsum -bash31 bee2cmd.exe
 if %ERRORLEVEL% equ 0 goto Error
@@ -74,6 +74,51 @@ if %ERRORLEVEL% equ 0 goto Error
 bee2cmd bsum -b -c -- -c
 if %ERRORLEVEL% equ 0 goto Error
 
+bee2cmd bsum -j 4 bee2cmd.exe test.cmd > check256j
+if %ERRORLEVEL% neq 0 goto Error
+
+fc /b check256 check256j > nul
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd bsum -j4 -c check256
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd bsum -j 4 -bash32 -c check32
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd bsum -j 0 -c check256
+if %ERRORLEVEL% equ 0 goto Error
+
+bee2cmd bsum -j 65 -c check256
+if %ERRORLEVEL% equ 0 goto Error
+
+bee2cmd bsum -j 2 -j 2 -c check256
+if %ERRORLEVEL% equ 0 goto Error
+
+bee2cmd bsum -belt-tree bee2cmd.exe test.cmd > checkt
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd bsum -belt-tree -j4 bee2cmd.exe test.cmd > checktj
+if %ERRORLEVEL% neq 0 goto Error
+
+fc /b checkt checktj > nul
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd bsum -belt-tree -j 3 -c checkt
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd bsum -c checkt
+if %ERRORLEVEL% equ 0 goto Error
+
+bee2cmd bsum -bash-tree256 -c checkt
+if %ERRORLEVEL% equ 0 goto Error
+
+bee2cmd bsum -bash-tree128 test.cmd
+if %ERRORLEVEL% equ 0 goto Error
+
+bee2cmd bsum -bash-tree512 -j 2 bee2cmd.exe
+if %ERRORLEVEL% neq 0 goto Error
+
 echo ****** OK
 
 rem ===========================================================================
@@ -208,7 +253,7 @@ for /f "tokens=1" %%A in (pubkey1) do @echo|set /p="%%A" > pubkey1
 for %%A in (pubkey1) do set pubkey1_len=%%~zA
 if %pubkey1_len% neq 192 goto Error
 
-bee2cmd kg gen -pass pass:alice privkey2
+bee2cmd kg gen -rng bash-prg -pass pass:alice privkey2
 if %ERRORLEVEL% neq 0 goto Error
 
 bee2cmd kg extr -pass pass:alice privkey2 pubkey2
@@ -503,6 +548,40 @@ if %ERRORLEVEL% neq 0 goto Error
 bee2cmd sig val -anchor cert3 ff ff
 if %ERRORLEVEL% neq 0 goto Error
 
+del /q f1 s1 f2 s2 sig_list 2> nul
+echo test1> f1
+echo test2> f2
+
+bee2cmd sig sign -certs "cert0 cert1 cert2" -pass pass:alice privkey2 f1 s1
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd sig sign -certs "cert0 cert1 cert2" -pass pass:alice privkey2 f2 s2
+if %ERRORLEVEL% neq 0 goto Error
+
+(
+  echo f1 s1
+  echo # comment
+  echo   f2 s2
+  echo ff
+) > sig_list
+
+bee2cmd sig val -anchor cert1 -list sig_list
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd sig val -anchor cert1 -j 3 -list sig_list
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd sig val -anchor cert0 -j2 -list sig_list
+if %ERRORLEVEL% equ 0 goto Error
+
+bee2cmd sig val -pubkey pubkey3 -list sig_list
+if %ERRORLEVEL% equ 0 goto Error
+
+echo f1 s2>> sig_list
+
+bee2cmd sig val -anchor cert1 -j2 -list sig_list
+if %ERRORLEVEL% equ 0 goto Error
+
 echo ****** OK
 
 rem ===========================================================================
@@ -511,7 +590,7 @@ rem ===========================================================================
 
 echo ****** Testing bee2cmd/cvr...
 
-del /q ring2 cert21 cert31 2> nul
+del /q ring2 ring2.idx cert21 cert31 cert32 cert33 cert12 2> nul
 
 bee2cmd cvr init -pass pass:alice privkey2 cert2 ring2
 if %ERRORLEVEL% neq 0 goto Error
@@ -566,9 +645,39 @@ for /f "tokens=* USEBACKQ" %%F in (`bee2cmd cvr print -certc ring2`) do (
 )
 if "%certc%" neq "3" goto Error
 
+bee2cmd cvr index ring2
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd cvr find ring2 cert1
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd cvr find ring2 cert2
+if %ERRORLEVEL% equ 0 goto Error
+
+bee2cmd cvr extr -holder 590082394655 ring2 cert32
+if %ERRORLEVEL% neq 0 goto Error
+
+fc /b cert3 cert32 > nul
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd cvr extr -pubkey pubkey3 ring2 cert33
+if %ERRORLEVEL% neq 0 goto Error
+
+fc /b cert3 cert33 > nul
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd cvr extr -cert2 ring2 cert12
+if %ERRORLEVEL% neq 0 goto Error
+
+fc /b cert1 cert12 > nul
+if %ERRORLEVEL% neq 0 goto Error
+
 bee2cmd cvr del -pass pass:alice privkey2 cert2 cert1 ring2
 if %ERRORLEVEL% neq 0 goto Error
 
+bee2cmd cvr find ring2 cert1
+if %ERRORLEVEL% equ 0 goto Error
+
 bee2cmd cvr del -pass pass:alice privkey2 cert2 cert0 ring2
 if %ERRORLEVEL% neq 0 goto Error
 
@@ -603,7 +712,7 @@ rem ===========================================================================
 rem  bee2cmd/es
 rem ===========================================================================
 
-del /q dd 2> nul
+del /q dd dd2 2> nul
 
 bee2cmd es print
 if %ERRORLEVEL% neq 0 goto Error
@@ -614,6 +723,95 @@ if %ERRORLEVEL% neq 0 goto Error
 for %%A in (dd) do set dd_len=%%~zA
 if %dd_len% neq 1024 goto Error
 
+bee2cmd es gen bash-prg 2 dd2
+if %ERRORLEVEL% neq 0 goto Error
+
+for %%A in (dd2) do set dd2_len=%%~zA
+if %dd2_len% neq 2048 goto Error
+
+echo ****** OK
+
+rem ===========================================================================
+rem  bee2cmd/enc
+rem ===========================================================================
+
+echo ****** Testing bee2cmd/enc...
+
+del /q ef ef1 ef2 ef3 ef4 ef5 ef6 2> nul
+
+bee2cmd es gen bash-prg 10 ef
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd enc -chunk 1 -j4 -pass pass:zed ef ef1
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd dec -j3 -pass pass:zed ef1 ef2
+if %ERRORLEVEL% neq 0 goto Error
+
+fc /b ef ef2 > nul
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd enc -che -pass pass:zed ef ef3
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd dec -pass pass:zed ef3 ef4
+if %ERRORLEVEL% neq 0 goto Error
+
+fc /b ef ef4 > nul
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd dec -pass pass:zed2 ef1 ef5
+if %ERRORLEVEL% equ 0 goto Error
+
+bee2cmd dec -j2 -range 0:10240 -pass pass:zed ef1 ef5
+if %ERRORLEVEL% neq 0 goto Error
+
+fc /b ef ef5 > nul
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd dec -range 10000:241 -pass pass:zed ef1 ef6
+if %ERRORLEVEL% equ 0 goto Error
+
+echo ****** OK
+
+rem ===========================================================================
+rem  bee2cmd/batch
+rem ===========================================================================
+
+echo ****** Testing bee2cmd/batch...
+
+del /q batch1 bcert1 bcert2 bcert3 bcert4 2> nul
+
+echo # issue certificates with one CA key> batch1
+echo cvc iss -pass pass:root privkey0 cert0 req1 bcert1>> batch1
+echo bee2cmd cvc iss -pass pass:root privkey0 cert0 req1 bcert2>> batch1
+echo cvc val cert0 bcert1>> batch1
+echo cvc val cert0 bcert2>> batch1
+
+bee2cmd batch batch1
+if %ERRORLEVEL% neq 0 goto Error
+
+bee2cmd cvc val cert0 bcert2
+if %ERRORLEVEL% neq 0 goto Error
+
+echo cvc iss -pass pass:root privkey0 cert0 req1 bcert3> batch1
+echo cvc iss -pass pass:wrong privkey0 cert0 req1 bcert4>> batch1
+
+bee2cmd batch batch1
+if %ERRORLEVEL% equ 0 goto Error
+
+bee2cmd cvc val cert0 bcert3
+if %ERRORLEVEL% neq 0 goto Error
+
+echo cvc val cert0 bcert1| bee2cmd batch
+if %ERRORLEVEL% neq 0 goto Error
+
+echo batch batch1| bee2cmd batch -
+if %ERRORLEVEL% equ 0 goto Error
+
+bee2cmd batch -e -e batch1
+if %ERRORLEVEL% equ 0 goto Error
+
 echo ****** OK
 
 rem ===========================================================================
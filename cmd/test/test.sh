@@ -3,7 +3,7 @@
 # \brief Testing command-line interface
 # \project bee2evp/cmd
 # \created 2022.06.24
-# \version 2024.01.22
+# \version 2026.10.18
 # \pre The working directory contains zed.csr.
 # =============================================================================
 
@@ -16,6 +16,7 @@ if [ ! -f "${bee2cmd}" ]; then
     exit 1
   fi
 fi
+bee2d="${BEE2D:-$(dirname "${bee2cmd}")/bee2d}"
 this=$(realpath $BASH_SOURCE)
 
 function pause() {
@@ -32,7 +33,8 @@ test_ver() {
 }
 
 test_bsum() {
-  rm -rf -- check32 check256 -c \
+  rm -rf -- check32 check256 check256j checkt checktj checkk tree0 treez \
+    -c \
     || return 2
   $bee2cmd bsum -bash31 $bee2cmd \
     && return 1
@@ -64,6 +66,53 @@ test_bsum() {
     && return 1
   $bee2cmd bsum -b -c -- -c \
     && return 1
+  $bee2cmd bsum -j 4 $bee2cmd $this > check256j \
+    || return 1
+  cmp check256 check256j \
+    || return 1
+  $bee2cmd bsum -j4 -c check256 \
+    || return 1
+  $bee2cmd bsum -j 4 -bash32 -c check32 \
+    || return 1
+  $bee2cmd bsum -j 0 -c check256 \
+    && return 1
+  $bee2cmd bsum -j 65 -c check256 \
+    && return 1
+  $bee2cmd bsum -j 2 -j 2 -c check256 \
+    && return 1
+  $bee2cmd bsum -belt-tree $bee2cmd $this > checkt \
+    || return 1
+  $bee2cmd bsum -belt-tree -j4 $bee2cmd $this > checktj \
+    || return 1
+  cmp checkt checktj \
+    || return 1
+  $bee2cmd bsum -belt-tree -j 3 -c checkt \
+    || return 1
+  $bee2cmd bsum -c checkt \
+    && return 1
+  $bee2cmd bsum -bash-tree256 -c checkt \
+    && return 1
+  $bee2cmd bsum -bash-tree128 $this \
+    && return 1
+  $bee2cmd bsum -bash-tree512 -j 2 $bee2cmd \
+    || return 1
+  : > tree0
+  dd if=/dev/zero of=treez bs=1000 count=700 2>/dev/null \
+    || return 2
+  printf "%s  tree0\n%s  treez\n" \
+    8165445794395d318bdfabbe085373b1c79a422d78f3ba2d56a4367d1776c0b3 \
+    d761d2a606ed9d3120ddb248577f4e95e4f8fe2c82a990ec39196c80d94d1cb4 \
+    > checkk
+  $bee2cmd bsum -belt-tree -c checkk \
+    || return 1
+  $bee2cmd bsum -belt-tree -j 3 -c checkk \
+    || return 1
+  printf "%s  tree0\n%s  treez\n" \
+    3fd9cd47065716f4cc4943787381b951cd26bef7722ea32fa98be12400dee063 \
+    f9167211eab386f8c3cf1e37e11b2e5ce46a0c318c17331ee6ea0b2ec5874f04 \
+    > checkk
+  $bee2cmd bsum -bash-tree256 -j 2 -c checkk \
+    || return 1
   return 0
 }
 
@@ -134,7 +183,8 @@ test_pwd() {
 }
 
 test_kg() {
-  rm -rf privkey0 privkey1 privkey2 privkey3 pubkey1 pubkey2 pubkey3 \
+  rm -rf privkey0 privkey1 privkey2 privkey3 privkey4 privkey5 \
+    pubkey1 pubkey2 pubkey3 \
     || return 2
 
   $bee2cmd kg gen -l256 -pass share:"-pass pass:zed s2 s3 s4" \
@@ -174,6 +224,13 @@ test_kg() {
   $bee2cmd kg extr -pass pass:bob privkey3 pubkey3 \
     || return 1
 
+  $bee2cmd kg gen -rng bash-prg -pass pass:carol privkey4 \
+    || return 1
+  $bee2cmd kg val -pass pass:carol privkey4 \
+    || return 1
+  $bee2cmd kg gen -rng bash-xyz -pass pass:carol privkey5 \
+    && return 1
+
   return 0
 }
 
@@ -274,7 +331,7 @@ test_cvc() {
 }
 
 test_sig(){
-  rm -rf ss ff cert01 cert11 cert21 body sig\
+  rm -rf ss ff cert01 cert11 cert21 body sig f1 s1 f2 s2 sig_list\
     || return 2
 
   echo test> ff
@@ -384,11 +441,34 @@ test_sig(){
   $bee2cmd sig val -anchor cert3 ff ff \
     || return 1
 
+  echo test1> f1
+  echo test2> f2
+  $bee2cmd sig sign -certs "cert0 cert1 cert2" -pass pass:alice privkey2 \
+    f1 s1 \
+    || return 1
+  $bee2cmd sig sign -certs "cert0 cert1 cert2" -pass pass:alice privkey2 \
+    f2 s2 \
+    || return 1
+  printf "f1 s1\n# comment\n\n  f2 s2\nff\n" > sig_list
+  $bee2cmd sig val -anchor cert1 -list sig_list \
+    || return 1
+  $bee2cmd sig val -anchor cert1 -j 3 -list sig_list \
+    || return 1
+  $bee2cmd sig val -anchor cert0 -j2 -list sig_list \
+    && return 1
+  $bee2cmd sig val -pubkey pubkey3 -list sig_list \
+    && return 1
+  printf "f1 s2\n" >> sig_list
+  $bee2cmd sig val -anchor cert1 -j2 -list sig_list \
+    && return 1
+  $bee2cmd sig val -anchor cert1 -j 65 -list sig_list \
+    && return 1
+
   return 0
 }
 
 test_cvr(){
-  rm -rf ring2 cert21 cert31 \
+  rm -rf ring2 ring2.idx cert21 cert31 cert32 cert33 cert12 \
     || return 2
 
   $bee2cmd cvr init -pass pass:alice privkey2 cert2 ring2 \
@@ -426,8 +506,47 @@ test_cvr(){
   if [ "$($bee2cmd cvr print -certc ring2)" != "3" ]; then 
     return 1
   fi
+  $bee2cmd cvr index ring2 \
+    || return 1
+  if [ "$($bee2cmd cvr print -certc ring2)" != "3" ]; then 
+    return 1
+  fi
+  $bee2cmd cvr find ring2 cert1 \
+    || return 1
+  $bee2cmd cvr find ring2 cert2 \
+    && return 1
+  $bee2cmd cvr extr -holder 590082394655 ring2 cert32 \
+    || return 1
+  diff cert3 cert32 \
+    || return 1
+  $bee2cmd cvr extr -pubkey pubkey3 ring2 cert33 \
+    || return 1
+  diff cert3 cert33 \
+    || return 1
+  $bee2cmd cvr extr -cert2 ring2 cert12 \
+    || return 1
+  diff cert1 cert12 \
+    || return 1
+  $bee2cmd cvr extr -holder 590082394656 ring2 cert34 \
+    && return 1
+  $bee2cmd cvr print ring2 \
+    || return 1
+  cp ring2.idx ring2.idx.bak \
+    || return 1
+  dd if=ring2.idx.bak of=ring2.idx bs=1 skip=104 seek=48 count=8 \
+    conv=notrunc 2>/dev/null \
+    || return 1
+  $bee2cmd cvr extr -holder 590082394655 ring2 cert35 \
+    && return 1
+  mv ring2.idx.bak ring2.idx \
+    || return 1
   $bee2cmd cvr del -pass pass:alice privkey2 cert2 cert1 ring2 \
     || return 1
+  $bee2cmd cvr find ring2 cert1 \
+    && return 1
+  if [ "$($bee2cmd cvr print -certc ring2)" != "2" ]; then 
+    return 1
+  fi
   $bee2cmd cvr del -pass pass:alice privkey2 cert2 cert0 ring2 \
     || return 1
   $bee2cmd cvr del -pass pass:alice privkey2 cert2 cert0 ring2 \
@@ -452,7 +571,7 @@ test_csr(){
 }
 
 test_es() {
-  rm -rf dd\
+  rm -rf dd dd2\
     || return 2
 
   $bee2cmd es print \
@@ -462,6 +581,132 @@ test_es() {
   if [ "$(wc -c dd | awk '{print $1}')" != "1024" ]; then
     return 1
   fi
+  $bee2cmd es gen bash-prg 2 dd2 \
+    || return 1
+  if [ "$(wc -c dd2 | awk '{print $1}')" != "2048" ]; then
+    return 1
+  fi
+
+  return 0
+}
+
+test_enc() {
+  rm -rf ef ef1 ef2 ef3 ef4 ef5 ef6 ef7 ef8 ef9\
+    || return 2
+
+  $bee2cmd es gen bash-prg 10 ef \
+    || return 1
+  $bee2cmd enc -chunk 1 -j4 -pass pass:zed ef ef1 \
+    || return 1
+  $bee2cmd dec -j3 -pass pass:zed ef1 ef2 \
+    || return 1
+  cmp ef ef2 \
+    || return 1
+  $bee2cmd enc -che -pass pass:zed ef ef3 \
+    || return 1
+  $bee2cmd dec -pass pass:zed ef3 ef4 \
+    || return 1
+  cmp ef ef4 \
+    || return 1
+  $bee2cmd dec -pass pass:zed2 ef1 ef5 \
+    && return 1
+  $bee2cmd dec -j2 -range 1000:5000 -pass pass:zed ef1 ef5 \
+    || return 1
+  dd if=ef bs=1 skip=1000 count=5000 2>/dev/null | cmp - ef5 \
+    || return 1
+  $bee2cmd dec -range 10000:241 -pass pass:zed ef1 ef6 \
+    && return 1
+  cp ef1 ef7 \
+    || return 2
+  printf '\001' | dd of=ef7 bs=1 seek=5000 conv=notrunc 2>/dev/null \
+    || return 2
+  $bee2cmd dec -pass pass:zed ef7 ef8 \
+    && return 1
+  if [ -f ef8 ]; then
+    return 1
+  fi
+  head -c 5000 ef1 > ef9 \
+    || return 2
+  $bee2cmd dec -pass pass:zed ef9 ef8 \
+    && return 1
+
+  return 0
+}
+
+test_batch() {
+  rm -rf batch1 bcert1 bcert2 bcert3 bcert4 \
+    || return 2
+
+  echo "# issue certificates with one CA key" > batch1
+  echo "cvc iss -pass pass:root privkey0 cert0 req1 bcert1" >> batch1
+  echo "bee2cmd cvc iss -pass pass:root privkey0 cert0 req1 bcert2" >> batch1
+  echo "" >> batch1
+  echo "cvc val cert0 bcert1" >> batch1
+  echo "cvc val cert0 bcert2" >> batch1
+  $bee2cmd batch batch1 \
+    || return 1
+  $bee2cmd cvc val cert0 bcert2 \
+    || return 1
+  echo "cvc iss -pass pass:root privkey0 cert0 req1 bcert3" > batch1
+  echo "cvc iss -pass pass:wrong privkey0 cert0 req1 bcert4" >> batch1
+  $bee2cmd batch batch1 \
+    && return 1
+  $bee2cmd cvc val cert0 bcert3 \
+    || return 1
+  echo "cvc val cert0 bcert1" | $bee2cmd batch \
+    || return 1
+  echo "batch batch1" | $bee2cmd batch - \
+    && return 1
+  printf "ver ver\nver\n" | $bee2cmd batch -e \
+    && return 1
+  printf "ver ver\nver\n" | $bee2cmd batch \
+    && return 1
+  $bee2cmd batch -e -e batch1 \
+    && return 1
+
+  return 0
+}
+
+test_daemon() {
+  rm -rf dsock dff dss dss2 \
+    || return 2
+
+  echo test> dff
+
+  $bee2d run -pass pass:alice privkey2 \
+    && return 1
+  $bee2d run -j 2 -b 4 -pass pass:wrong privkey2 dsock \
+    && return 1
+  $bee2d run -j 2 -b 4 -pass pass:alice privkey2 dsock &
+  for i in $(seq 50); do
+    [ -S dsock ] && break
+    sleep 0.1
+  done
+  [ -S dsock ] \
+    || return 1
+
+  $bee2cmd sig sign -daemon dsock -pass pass:alice dff dss \
+    && return 1
+  $bee2cmd sig sign -certs "cert1 cert2" -daemon dsock dff dss \
+    || { $bee2d stop dsock; return 1; }
+  $bee2cmd sig val -pubkey pubkey2 dff dss \
+    || { $bee2d stop dsock; return 1; }
+  $bee2cmd sig val -anchor cert1 dff dss \
+    || { $bee2d stop dsock; return 1; }
+  $bee2cmd sig sign -certs "cert0 cert1" -daemon dsock dff dss2 \
+    && { $bee2d stop dsock; return 1; }
+  $bee2cmd sig sign -daemon dsock dff dff \
+    || { $bee2d stop dsock; return 1; }
+  $bee2cmd sig val -pubkey pubkey2 dff dff \
+    || { $bee2d stop dsock; return 1; }
+
+  $bee2d stat dsock \
+    || { $bee2d stop dsock; return 1; }
+  $bee2d stop dsock \
+    || return 1
+  wait
+  [ -e dsock ] \
+    && return 1
 
   return 0
 }
@@ -477,4 +722,5 @@ run_test() {
 } 
 
 run_test ver && run_test bsum && run_test pwd && run_test kg && run_test cvc \
-  && run_test sig && run_test cvr && run_test csr && run_test es
+  && run_test sig && run_test cvr && run_test csr && run_test es \
+  && run_test enc && run_test batch && run_test daemon
@@ -4,7 +4,7 @@
 \brief Version and build information
 \project bee2/cmd 
 \created 2022.06.22
-\version 2024.01.25
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -12,6 +12,7 @@
 
 #include "../cmd.h"
 #include <bee2/core/util.h>
+#include <bee2/crypto/bash.h>
 #include <stdio.h>
 
 /*
@@ -164,8 +165,6 @@ static const char* verSafe()
 *******************************************************************************
 */
 
-extern const char bash_platform[];
-
 static void verPrint()
 {
 	printf(
@@ -190,7 +189,7 @@ static void verPrint()
 		verCompiler(),
 		verNDebug(),
 		verSafe(),
-		bash_platform
+		bashPlatform()
 	);
 }
 
@@ -4,7 +4,7 @@
 \brief Blobs
 \project bee2 [cryptographic library]
 \created 2012.04.01
-\version 2022.06.17
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -41,6 +41,17 @@ memcpy, memset. Дополнительно по указателю можно о
 например, через файл подкачки. Поэтому в блобах рекомендуется размещать
 ключи и другие критические объекты.
 
+Небольшие блобы (до 64 Кбайт) размещаются в пуле. Пул состоит из блоков
+нескольких размерных классов. Блоки нарезаются из фрагментов памяти,
+которые по возможности закрепляются в оперативной памяти. Освобожденные
+блоки очищаются и кэшируются в потоке, в котором они освобождены.
+Объем кэша потока ограничен, излишки возвращаются в общий пул.
+Память пула возвращается ОС при завершении процесса, если к этому
+моменту закрыты все блобы пула. Пул можно использовать после fork(),
+но блоки, кэшированные в других потоках родителя, в дочернем процессе
+недоступны, а закрепление памяти не наследуется.
+Статистику работы с блобами можно получить с помощью функции blobStat().
+
 \pre В функциях работы с блобами дескрипторы входных блобов корректны.
 *******************************************************************************
 */
@@ -153,6 +164,34 @@ int blobCmp(
 	const blob_t blob2		/*!< [in] второй блоб */
 );
 
+/*!	\brief Статистика блобов
+
+	Описывает текущее состояние блобов и пула. Долю выделений из пула
+	можно определить как hits / (hits + misses).
+*/
+typedef struct
+{
+	size_t count;		/*!< число блобов */
+	size_t size;		/*!< суммарный размер блобов */
+	size_t hits;		/*!< число выделений памяти из пула */
+	size_t misses;		/*!< число выделений памяти мимо пула */
+	size_t pooled;		/*!< объем памяти пула */
+	size_t locked;		/*!< объем закрепленной памяти пула */
+} blob_stat_t;
+
+/*!	\brief Статистика блобов
+
+	Определяется статистика stat работы с блобами.
+	\remark Счетчики меняются в разных потоках независимо друг от друга.
+	Поэтому статистика является приблизительной.
+	\remark Выделение памяти мимо пула (misses) происходит при создании
+	больших блобов, при нарезке новых фрагментов памяти пула, а также
+	в том случае, когда пул не поддерживается.
+*/
+void blobStat(
+	blob_stat_t* stat		/*!< [out] статистика */
+);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,152 @@
+/*
+*******************************************************************************
+\file cache.h
+\brief Caches of digests
+\project bee2 [cryptographic library]
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file cache.h
+\brief Кэши хэш-значений
+*******************************************************************************
+*/
+
+#ifndef __BEE2_CACHE_H
+#define __BEE2_CACHE_H
+
+#include "bee2/defs.h"
+#include "bee2/core/mt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+*******************************************************************************
+\file cache.h
+
+Кэш хранит 32-октетные хэш-значения объектов, для которых уже выполнена
+дорогая проверка: долговременных параметров, подписей сертификатов.
+При повторной проверке объекта достаточно рассчитать его хэш-значение
+и найти его в кэше.
+
+Элементы кэша хранятся в кольцевом массиве. Новый элемент замещает
+самый старый. Для поиска элементов поддерживается хэш-таблица
+с открытой адресацией (линейное пробирование). Начальная позиция
+элемента в таблице определяется первым машинным словом хэш-значения,
+число позиций -- степень двойки, не меньшая удвоенного числа элементов.
+Поиск, добавление и вытеснение выполняются в среднем за O(1).
+
+Кэш описывается структурой cache_t. Структура размещается в статической
+памяти модуля, который использует кэш, и перед первым использованием
+обнуляется (как любая статическая переменная). Кэш включается функцией
+cacheStart() и выключается функцией cacheStop(). Выключенный кэш пуст:
+в нем ничего не находится, в него ничего не добавляется.
+
+Обращения к кэшу синхронизируются мьютексом кэша: функции cacheFind(),
+cacheAdd() и cacheStat() могут вызываться одновременно из нескольких
+потоков. Мьютекс создается при первом включении кэша. Мьютексы всех
+включенных кэшей закрываются, а кэши выключаются при завершении работы
+(с помощью utilOnExit()).
+*******************************************************************************
+*/
+
+/*! \brief Максимальное число элементов кэша */
+#define CACHE_MAX	65536
+
+/*! \brief Кэш хэш-значений */
+typedef struct cache_st
+{
+	size_t state;			/*< состояние мьютекса (0 -- не создан) */
+	mt_mtx_t mtx[1];		/*< мьютекс */
+	octet* digests;			/*< элементы */
+	u32* table;				/*< хэш-таблица (номера элементов + 1) */
+	size_t mask;			/*< число позиций таблицы - 1 */
+	size_t capacity;		/*< число элементов (0 -- кэш выключен) */
+	size_t count;			/*< число заполненных элементов */
+	size_t next;			/*< позиция замещения */
+	size_t hits;			/*< число попаданий */
+	size_t misses;			/*< число промахов */
+	struct cache_st* link;	/*< следующий кэш в списке созданных */
+} cache_t;
+
+/*!	\brief Включение кэша
+
+	Включается кэш cache, который вмещает не более capacity элементов.
+	Если кэш уже включен, то он очищается и пересоздается. Счетчики
+	попаданий и промахов обнуляются.
+	\expect{ERR_BAD_INPUT} 0 < capacity <= CACHE_MAX.
+	\return ERR_OK в случае успеха и код ошибки в противном случае
+	(ERR_SYS, если не удалось создать мьютекс).
+	\warning Функции cacheStart() и cacheStop() не должны вызываться
+	одновременно с другими функциями для того же кэша.
+*/
+err_t cacheStart(
+	cache_t* cache,			/*!< [in,out] кэш */
+	size_t capacity			/*!< [in] число элементов */
+);
+
+/*!	\brief Кэш включен?
+
+	Проверяется, что кэш cache включен.
+	\return Признак включения.
+*/
+bool_t cacheIsOn(
+	cache_t* cache			/*!< [in] кэш */
+);
+
+/*!	\brief Поиск в кэше
+
+	В кэше cache ищется хэш-значение digest. Поиск во включенном кэше
+	учитывается как попадание или промах.
+	\return TRUE, если хэш-значение найдено, и FALSE, если не найдено
+	или кэш выключен.
+*/
+bool_t cacheFind(
+	cache_t* cache,			/*!< [in,out] кэш */
+	const octet digest[32]	/*!< [in] хэш-значение */
+);
+
+/*!	\brief Добавление в кэш
+
+	Хэш-значение digest добавляется в кэш cache, если кэш включен
+	и хэш-значения в нем еще нет. При переполнении вытесняется самый
+	старый элемент.
+*/
+void cacheAdd(
+	cache_t* cache,			/*!< [in,out] кэш */
+	const octet digest[32]	/*!< [in] хэш-значение */
+);
+
+/*!	\brief Статистика кэша
+
+	Возвращаются число попаданий hits и число промахов misses в кэше
+	cache с момента его включения.
+	\remark Указатели hits и misses могут быть нулевыми.
+	\remark Если кэш выключен, то возвращаются нули.
+*/
+void cacheStat(
+	cache_t* cache,			/*!< [in] кэш */
+	size_t* hits,			/*!< [out] число попаданий */
+	size_t* misses			/*!< [out] число промахов */
+);
+
+/*!	\brief Выключение кэша
+
+	Кэш cache очищается и выключается.
+*/
+void cacheStop(
+	cache_t* cache			/*!< [in,out] кэш */
+);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __BEE2_CACHE_H */
@@ -4,7 +4,7 @@
 \brief Multithreading
 \project bee2 [cryptographic library]
 \created 2014.10.10
-\version 2023.02.02
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -130,13 +130,131 @@ void mtMtxClose(
 *******************************************************************************
 \file mt.h
 
+\section mt-cond Условные переменные
+
+Условная переменная позволяет потоку дождаться выполнения условия над
+общими объектами, которые защищены мьютексом. Поток блокирует мьютекс,
+проверяет условие и, если оно не выполнено, вызывает mtCondWait().
+Функция атомарно разблокирует мьютекс и приостанавливает поток. Другой
+поток, который изменил общие объекты, будит ожидающие потоки с помощью
+функций mtCondSignal() (хотя бы один поток) или mtCondBroadcast() (все
+потоки). Проснувшийся поток снова владеет мьютексом и должен повторно
+проверить условие: допускаются ложные пробуждения.
+
+Если операционная система не распознана, то ожидание на условной
+переменной не выполняется: mtCondWait() сразу возвращает управление.
+
+\typedef mt_cond_t
+\brief Условная переменная
+*******************************************************************************
+*/
+
+#ifdef OS_WIN
+	typedef CONDITION_VARIABLE mt_cond_t;
+#elif defined OS_UNIX
+	typedef pthread_cond_t mt_cond_t;
+#else
+	typedef size_t mt_cond_t;
+#endif
+
+/*!	\brief Создание условной переменной
+
+	Создается условная переменная cv.
+	\return Признак успеха.
+*/
+bool_t mtCondCreate(
+	mt_cond_t* cv		/*!< [out] условная переменная */
+);
+
+/*!	\brief Ожидание на условной переменной
+
+	Мьютекс mtx разблокируется, и поток приостанавливается до пробуждения
+	по условной переменной cv. Перед возвратом мьютекс снова блокируется.
+	\pre Мьютекс mtx заблокирован вызывающим потоком.
+	\remark Возможны ложные пробуждения.
+*/
+void mtCondWait(
+	mt_cond_t* cv,		/*!< [in,out] условная переменная */
+	mt_mtx_t* mtx		/*!< [in,out] мьютекс */
+);
+
+/*!	\brief Пробуждение потока
+
+	Пробуждается хотя бы один поток, ожидающий на условной переменной cv.
+*/
+void mtCondSignal(
+	mt_cond_t* cv		/*!< [in,out] условная переменная */
+);
+
+/*!	\brief Пробуждение всех потоков
+
+	Пробуждаются все потоки, ожидающие на условной переменной cv.
+*/
+void mtCondBroadcast(
+	mt_cond_t* cv		/*!< [in,out] условная переменная */
+);
+
+/*!	\brief Закрытие условной переменной
+
+	Условная переменная cv закрывается.
+	\pre На условной переменной нет ожидающих потоков.
+*/
+void mtCondClose(
+	mt_cond_t* cv		/*!< [in,out] условная переменная */
+);
+
+/*!
+*******************************************************************************
+\file mt.h
+
 \section mt-thrd Управление потоками
 
 Управление потоками реализуется по схемам, заданным в стандарте языка Си
 ISO/IEC 9899:2011 (см. заголовочный файл threads.h).
+
+Интерфейс потоков упрощен по сравнению со стандартом: поток выполняет
+функцию без возвращаемого значения, поток можно только создать и затем
+дождаться его завершения.
+
+Если операционная система не распознана, то потоки не создаются.
+
+\typedef mt_thrd_t
+\brief Поток
 *******************************************************************************
 */
 
+#ifdef OS_WIN
+	typedef HANDLE mt_thrd_t;
+#elif defined OS_UNIX
+	typedef pthread_t mt_thrd_t;
+#else
+	typedef size_t mt_thrd_t;
+#endif
+
+/*!	\brief Создание потока
+
+	Создается поток thrd, в котором выполняется функция fn() с аргументом arg.
+	\return Признак успеха.
+	\post В случае успеха по завершении работы с потоком должна быть вызвана
+	функция mtThrdJoin().
+	\remark Если операционная система не распознана, то поток не создается
+	и возвращается FALSE.
+*/
+bool_t mtThrdCreate(
+	mt_thrd_t* thrd,		/*!< [out] поток */
+	void (*fn)(void*),		/*!< [in] функция потока */
+	void* arg				/*!< [in] аргумент fn() */
+);
+
+/*!	\brief Ожидание завершения потока
+
+	Ожидается завершение потока thrd, после чего освобождаются ресурсы потока.
+	\pre Поток thrd создан с помощью mtThrdCreate() и еще не ожидался.
+*/
+void mtThrdJoin(
+	mt_thrd_t* thrd		/*!< [in,out] поток */
+);
+
 /*!	\brief Приостановка потока
 
 	Текущий поток приостанавливается на ms миллисекунд.
@@ -210,6 +328,143 @@ size_t mtAtomicCmpSwap(
 	size_t swap		/*!< [in] новое значение */
 );
 
+/*!
+*******************************************************************************
+\file mt.h
+
+\section mt-pool Пул потоков
+
+Пул состоит из фиксированного числа исполнителей (рабочих потоков),
+которые выполняют задачи. Задача -- это функция с аргументом. Задача
+описывается структурой mt_task_t, память для которой готовит вызывающая
+программа. Структура служит дескриптором завершения: дождаться выполнения
+задачи можно с помощью функции mtPoolWait().
+
+У каждого исполнителя есть собственная очередь задач с двумя концами
+(дек). Исполнитель берет задачи с одного конца своего дека, а при
+исчерпании собственных задач "крадет" задачи с другого конца деков
+других исполнителей. Новые задачи распределяются по декам по кругу.
+
+Поток, который ожидает завершения задачи, не простаивает, а выполняет
+задачи из деков. Поэтому задачи могут создавать и ожидать подзадачи
+без риска взаимной блокировки.
+
+Функция mtPoolFor() разбивает диапазон [0, count) на фрагменты и
+обрабатывает их параллельно. Функция удобна для обработки длинных
+массивов октетов.
+
+Если потоки не поддерживаются или не удалось создать ни одного
+исполнителя, то задачи выполняются сразу при передаче в пул.
+
+\typedef mt_pool_t
+\brief Пул потоков
+*******************************************************************************
+*/
+
+/*! \brief Максимальное число исполнителей пула */
+#define MT_POOL_MAX 64
+
+typedef struct mt_pool_st mt_pool_t;
+
+/*!	\brief Задача
+
+	Структура описывает задачу и служит дескриптором ее завершения.
+	\remark Поля структуры устанавливаются в mtPoolSubmit() и не должны
+	меняться вызывающей программой вплоть до завершения mtPoolWait().
+*/
+typedef struct
+{
+	void (*fn)(void*);		/*!< функция задачи */
+	void* arg;				/*!< аргумент fn() */
+	size_t done;			/*!< признак завершения */
+} mt_task_t;
+
+/*!	\brief Число процессоров
+
+	Определяется число процессоров (логических ядер), доступных процессу.
+	\return Число процессоров (не менее 1).
+*/
+size_t mtCPUCount();
+
+/*!	\brief Создание пула потоков
+
+	Создается пул из workers исполнителей. Если workers == 0, то число
+	исполнителей совпадает с числом процессоров.
+	\return Пул или 0 при нехватке памяти.
+	\remark Число исполнителей ограничивается величиной MT_POOL_MAX.
+	\remark Если создать исполнителей не удалось, то пул все равно
+	создается, но задачи в нем выполняются последовательно в потоке,
+	который их передает.
+*/
+mt_pool_t* mtPoolCreate(
+	size_t workers		/*!< [in] число исполнителей */
+);
+
+/*!	\brief Число исполнителей пула
+
+	Определяется число исполнителей пула pool.
+	\return Число исполнителей (0, если задачи выполняются без
+	исполнителей).
+*/
+size_t mtPoolWorkers(
+	const mt_pool_t* pool	/*!< [in] пул */
+);
+
+/*!	\brief Передача задачи в пул
+
+	В пул pool передается задача task, которая состоит в вызове fn(arg).
+	\remark При нехватке памяти для очереди задача выполняется немедленно
+	в вызывающем потоке.
+	\post Должна быть вызвана функция mtPoolWait(pool, task).
+*/
+void mtPoolSubmit(
+	mt_pool_t* pool,		/*!< [in,out] пул */
+	mt_task_t* task,		/*!< [out] задача */
+	void (*fn)(void*),		/*!< [in] функция задачи */
+	void* arg				/*!< [in] аргумент fn() */
+);
+
+/*!	\brief Ожидание завершения задачи
+
+	Ожидается завершение задачи task пула pool. Во время ожидания
+	вызывающий поток выполняет другие задачи пула.
+	\pre Задача task передана в пул pool.
+*/
+void mtPoolWait(
+	mt_pool_t* pool,		/*!< [in,out] пул */
+	mt_task_t* task			/*!< [in,out] задача */
+);
+
+/*!	\brief Параллельная обработка диапазона
+
+	Диапазон [0, count) разбивается на фрагменты [offset, offset + len),
+	которые обрабатываются функцией fn(offset, len, arg) в исполнителях
+	пула pool. Длина каждого фрагмента, кроме, может быть, последнего,
+	кратна grain.
+	\pre grain > 0.
+	\remark Функция возвращает управление после обработки всех фрагментов.
+	\remark При нехватке памяти диапазон обрабатывается целиком
+	в вызывающем потоке.
+*/
+void mtPoolFor(
+	mt_pool_t* pool,		/*!< [in,out] пул */
+	size_t count,			/*!< [in] длина диапазона */
+	size_t grain,			/*!< [in] кратность длин фрагментов */
+	void (*fn)(size_t offset, size_t len, void* arg),
+							/*!< [in] функция обработки фрагмента */
+	void* arg				/*!< [in] аргумент fn() */
+);
+
+/*!	\brief Закрытие пула
+
+	Пул pool закрывается: дожидается завершения исполнителей
+	и освобождаются ресурсы.
+	\pre Все задачи, переданные в пул, завершены.
+*/
+void mtPoolClose(
+	mt_pool_t* pool		/*!< [in] пул */
+);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,256 @@
+/*
+*******************************************************************************
+\file perf.h
+\brief Performance counters and tracepoints
+\project bee2 [cryptographic library]
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file perf.h
+\brief Счетчики производительности и точки трассировки
+*******************************************************************************
+*/
+
+#ifndef __BEE2_PERF_H
+#define __BEE2_PERF_H
+
+#include "bee2/defs.h"
+#include "bee2/core/tm.h"
+#ifdef BEE2_USDT
+	#include <sys/sdt.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+*******************************************************************************
+\file perf.h
+
+Модуль ведет счетчики производительности для точек измерения --
+открытых функций библиотеки:
+-	PERF_BELT_HASH -- beltHashStepH();
+-	PERF_BELT_DWP_WRAP -- beltDWPWrap(), beltDWPWrap_ws();
+-	PERF_BELT_CHE_WRAP -- beltCHEWrap(), beltCHEWrap_ws();
+-	PERF_BELT_KWP_WRAP -- beltKWPWrap();
+-	PERF_BELT_PBKDF2 -- beltPBKDF2();
+-	PERF_BASH_HASH -- bashHash();
+-	PERF_BIGN_SIGN -- bignSign(), bignSign2() и их редакции _ws;
+-	PERF_BIGN_VERIFY -- bignVerify(), bignVerify_ws();
+-	PERF_BAKE_BMQV -- шаги bakeBMQVStepX();
+-	PERF_BAKE_BSTS -- шаги bakeBSTSStepX();
+-	PERF_BAKE_BPACE -- шаги bakeBPACEStepX();
+-	PERF_RNG -- rngStepR().
+
+Для каждой точки учитываются: число вызовов, число вызовов, которые
+завершились с ошибкой, число обработанных октетов (длина хэшируемых,
+защищаемых или генерируемых данных, длина пароля в beltPBKDF2();
+для остальных точек -- 0), суммарное время выполнения в тактах таймера
+tmTicks() и гистограмма времени выполнения. В i-й ячейке гистограммы
+учитываются вызовы, время выполнения которых лежит в интервале
+[2^i, 2^{i + 1}). В ячейку 0 попадают также вызовы с нулевым временем,
+в последнюю ячейку -- вызовы с временем не меньше 2^{PERF_HIST_SIZE - 1}.
+
+Учитываются все вызовы, в том числе завершившиеся с ошибкой. Время
+таких вызовов входит в суммарное время и в гистограмму, обработанные
+октеты не учитываются. Вызов bignVerify(), в котором подпись признана
+недействительной, считается завершившимся с ошибкой ERR_BAD_SIG.
+
+Счетчики ведутся, только если библиотека собрана с макросом BEE2_PERF
+(опция BUILD_PERF системы сборки). В остальных случаях измерения
+исключаются при компиляции, и счетчики остаются нулевыми. Проверить
+режим сборки можно с помощью функции perfIsEnabled().
+
+Счетчики общие для всех потоков и обновляются атомарно. Снимок
+счетчиков, полученный функцией perfSnapshot(), не является мгновенным:
+каждый счетчик читается атомарно, но счетчики одной точки могут
+соответствовать разным моментам времени.
+
+Для измерений в функциях библиотеки используются макросы PERF_START
+и PERF_STOP:
+\code
+	tm_ticks_t ticks = PERF_START();
+	code = ...;
+	PERF_STOP(PERF_BASH_HASH, code, count, ticks);
+\endcode
+Чтобы учесть все пути выхода, тело измеряемой функции выносится
+во вспомогательную функцию, а PERF_START и PERF_STOP окружают ее вызов.
+
+Кроме счетчиков, в функции библиотеки встроены статические точки
+трассировки (USDT) провайдера bee2. Точки трассировки подключаются,
+если библиотека собрана с макросом BEE2_USDT (опция BUILD_USDT системы
+сборки, требуется заголовочный файл sys/sdt.h). В остальных случаях
+точки исключаются при компиляции. Неактивная точка трассировки
+представляет собой одну инструкцию nop, активировать ее можно без
+пересборки библиотеки (например, с помощью bpftrace или perf).
+
+Точки трассировки (в скобках -- аргументы):
+-	bign_sign_entry(), bign_sign_return(code) -- вход в bignSign(),
+	bignSign2(), их редакции _ws, и выход из них (code -- код
+	возврата);
+-	bign_verify_entry(), bign_verify_return(code) -- вход
+	в bignVerify(), bignVerify_ws() и выход из них (code -- код
+	возврата, ERR_BAD_SIG для недействительной подписи);
+-	ec_mula_entry(m), ec_mula_return(ret) -- вход в ecMulA() и выход
+	из нее (m -- длина кратности в машинных словах, ret -- результат);
+-	bake_step_entry(proto, step), bake_step_return(proto, step, code) --
+	вход в шаг протокола bake и выход из него (proto -- PERF_BAKE_BMQV,
+	PERF_BAKE_BSTS или PERF_BAKE_BPACE, step -- символ шага: '2', '3',
+	'4', '5', '6' или 'G', code -- код возврата);
+-	rng_lock(count), rng_locked(count), rng_unlock(count) -- запрос
+	блокировки генератора в rngStepR(), rngStepR2(), ее получение
+	и снятие (count -- длина генерируемых данных);
+-	blob_create_entry(size), blob_create_return(blob) -- вход
+	в blobCreate() и выход из нее (blob -- созданный блоб или 0);
+-	belt_pbkdf2_entry(iter), belt_pbkdf2_return(code) -- вход
+	в beltPBKDF2() и выход из нее (iter -- число итераций, code -- код
+	возврата).
+
+Точки выхода срабатывают на каждом пути выхода из функции, в том числе
+при ошибках. Если функция возвращает код ошибки, то он передается
+в точку выхода.
+
+Например, время удержания блокировки генератора можно измерить так:
+\code
+	bpftrace -e '
+		usdt:libbee2.so:bee2:rng_locked { @t[tid] = nsecs; }
+		usdt:libbee2.so:bee2:rng_unlock /@t[tid]/ {
+			@hold = hist(nsecs - @t[tid]); delete(@t[tid]); }'
+\endcode
+
+Для встраивания точек трассировки используются макросы PERF_PROBE,
+PERF_PROBE1, PERF_PROBE2 и PERF_PROBE3.
+*******************************************************************************
+*/
+
+/*! \brief Хэширование belt */
+#define PERF_BELT_HASH			0
+/*! \brief Установка защиты DWP */
+#define PERF_BELT_DWP_WRAP		1
+/*! \brief Установка защиты CHE */
+#define PERF_BELT_CHE_WRAP		2
+/*! \brief Установка защиты KWP */
+#define PERF_BELT_KWP_WRAP		3
+/*! \brief Построение ключа по паролю */
+#define PERF_BELT_PBKDF2		4
+/*! \brief Хэширование bash */
+#define PERF_BASH_HASH			5
+/*! \brief Выработка ЭЦП bign */
+#define PERF_BIGN_SIGN			6
+/*! \brief Проверка ЭЦП bign */
+#define PERF_BIGN_VERIFY		7
+/*! \brief Шаги протокола BMQV */
+#define PERF_BAKE_BMQV			8
+/*! \brief Шаги протокола BSTS */
+#define PERF_BAKE_BSTS			9
+/*! \brief Шаги протокола BPACE */
+#define PERF_BAKE_BPACE			10
+/*! \brief Генерация случайных чисел */
+#define PERF_RNG				11
+/*! \brief Число точек измерения */
+#define PERF_COUNT				12
+
+/*! \brief Число ячеек гистограммы */
+#define PERF_HIST_SIZE			32
+
+/*! \brief Счетчики точки измерения */
+typedef struct
+{
+	size_t calls;					/*!< число вызовов */
+	size_t errors;					/*!< число вызовов с ошибкой */
+	size_t octets;					/*!< число обработанных октетов */
+	size_t ticks;					/*!< суммарное время выполнения */
+	size_t hist[PERF_HIST_SIZE];	/*!< гистограмма времени выполнения */
+} perf_stat_t;
+
+#ifdef BEE2_PERF
+	#define PERF_START()\
+		tmTicks()
+	#define PERF_STOP(id, code, octets, start)\
+		perfAdd(id, code, octets, tmTicks() - (start))
+#else
+	#define PERF_START()\
+		((tm_ticks_t)0)
+	#define PERF_STOP(id, code, octets, start)\
+		((void)(octets), (void)(start))
+#endif
+
+#ifdef BEE2_USDT
+	#define PERF_PROBE(name)\
+		DTRACE_PROBE(bee2, name)
+	#define PERF_PROBE1(name, a1)\
+		DTRACE_PROBE1(bee2, name, a1)
+	#define PERF_PROBE2(name, a1, a2)\
+		DTRACE_PROBE2(bee2, name, a1, a2)
+	#define PERF_PROBE3(name, a1, a2, a3)\
+		DTRACE_PROBE3(bee2, name, a1, a2, a3)
+#else
+	#define PERF_PROBE(name)\
+		((void)0)
+	#define PERF_PROBE1(name, a1)\
+		((void)0)
+	#define PERF_PROBE2(name, a1, a2)\
+		((void)0)
+	#define PERF_PROBE3(name, a1, a2, a3)\
+		((void)0)
+#endif
+
+/*!	\brief Счетчики ведутся?
+
+	Проверяется, что библиотека собрана с макросом BEE2_PERF.
+	\return Признак сборки с макросом.
+*/
+bool_t perfIsEnabled();
+
+/*!	\brief Имя точки измерения
+
+	Определяется имя точки измерения id.
+	\return Имя точки или 0, если id >= PERF_COUNT.
+*/
+const char* perfName(
+	size_t id				/*!< [in] точка измерения */
+);
+
+/*!	\brief Учет вызова
+
+	В счетчиках точки измерения id учитывается вызов, который завершился
+	с кодом code, обработал octets октетов и затратил ticks тактов.
+	Если code != ERR_OK, то вызов учитывается как ошибочный, а octets
+	игнорируется.
+	\pre id < PERF_COUNT.
+	\remark Функция вызывается из макроса PERF_STOP.
+*/
+void perfAdd(
+	size_t id,				/*!< [in] точка измерения */
+	err_t code,				/*!< [in] код завершения */
+	size_t octets,			/*!< [in] число обработанных октетов */
+	tm_ticks_t ticks		/*!< [in] время выполнения */
+);
+
+/*!	\brief Снимок счетчиков
+
+	В stats записываются счетчики всех точек измерения: stats[id] --
+	счетчики точки id.
+*/
+void perfSnapshot(
+	perf_stat_t stats[PERF_COUNT]	/*!< [out] счетчики */
+);
+
+/*!	\brief Сброс счетчиков
+
+	Обнуляются счетчики всех точек измерения.
+*/
+void perfReset();
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __BEE2_PERF_H */
@@ -4,7 +4,7 @@
 \brief Entropy sources and random number generators
 \project bee2 [cryptographic library]
 \created 2014.10.13
-\version 2023.12.19
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -225,6 +225,20 @@ brngCTR (см. crypto/brng.h).
 ключа случайные числа, сгенерированные ранее, будет невозможно определить
 даже если при их генерации не использовались источники энтропии, а новый ключ
 стал известен противнику.
+
+Вместо brngCTR может использоваться программируемый автомат bash-prg
+(см. crypto/bash.h). Механизм генерации (engine) задается при создании
+генератора в функции rngCreate2():
+-	"brng-ctr": механизм brngCTR (по умолчанию);
+-	"bash-prg": автомат bash-prg в ключевом режиме. Данные от источников,
+	используемые в rngStepR(), загружаются в автомат командой absorb.
+	Выходные данные выгружаются командой squeeze. После каждого вызова 
+	rngStepR(), rngStepR2() и в rngRekey() выполняется команда ratchet, 
+	которая необратимо изменяет состояние автомата. 
+.
+
+На платформах с поддержкой расширенных наборов инструкций (см. bashPlatform())
+механизм bash-prg вырабатывает данные в несколько раз быстрее brngCTR.
 *******************************************************************************
 */
 
@@ -253,6 +267,34 @@ err_t rngCreate(
 	void* source_state		/*!< [in] состояние дополнительного источника */
 );
 
+/*!	\brief Создание генератора с выбором механизма
+
+	Создается генератор случайных чисел с механизмом генерации engine.
+	В остальном функция повторяет rngCreate().
+	\expect{ERR_NOT_ENOUGH_ENTROPY} В совокупности все работоспособные
+	источники выдают не менее 32 октетов случайных данных.
+	\return ERR_OK в случае успеха, ERR_BAD_PARAMS, если механизм engine 
+	не поддерживается или отличается от механизма ранее созданного 
+	генератора, и другой код ошибки в остальных случаях.
+	\remark При нулевом engine используется механизм "brng-ctr" или, 
+	если генератор уже создан, механизм созданного генератора.
+	\remark Вызов rngCreate(source, source_state) эквивалентен вызову
+	rngCreate2(source, source_state, 0).
+*/
+err_t rngCreate2(
+	read_i source,			/*!< [in] дополнительный источник */
+	void* source_state,		/*!< [in] состояние дополнительного источника */
+	const char* engine		/*!< [in] механизм: "brng-ctr" или "bash-prg" */
+);
+
+/*!	\brief Механизм генератора
+
+	Определяется механизм генерации, используемый генератором.
+	\return Имя механизма ("brng-ctr" или "bash-prg") или 0, если генератор 
+	не создан.
+*/
+const char* rngEngine();
+
 /*!	\brief Корректный генератор?
 
 	Проверяется корректность генератора случайных чисел.
@@ -301,6 +343,8 @@ void rngStepR2(
 	Ключ генератора обновляется: в его качестве выступают генеририруемые
 	случайные числа. При обновлении ключа данные от источников энтропии
 	не используются.
+	\remark Для механизма "bash-prg" вместо обновления ключа выполняется 
+	команда ratchet.
 	\pre Генератор корректен.
 	\expect rngСreate() < rngRekey()*.
 */
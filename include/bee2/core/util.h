@@ -4,7 +4,7 @@
 \brief Utilities
 \project bee2 [cryptographic library]
 \created 2012.07.16
-\version 2023.02.02
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -231,6 +231,33 @@ u32 utilFNV32(
 */
 u32 utilNonce32();
 
+/*
+*******************************************************************************
+Возможности процессора
+*******************************************************************************
+*/
+
+/*!	\brief Поддержка возможности процессора
+
+	Проверяется, что процессор поддерживает возможность feature и что 
+	операционная система сохраняет соответствующие регистры при переключении
+	контекста. Распознаются возможности:
+	-	"sse2" -- инструкции SSE2;
+	-	"avx2" -- инструкции AVX2;
+	-	"avx512f" -- базовые инструкции AVX-512 (AVX512F);
+	-	"pclmul" -- инструкция PCLMULQDQ (умножение многочленов);
+	-	"neon" -- инструкции ARM NEON.
+	\return Признак поддержки.
+	\remark Процессор опрашивается (с помощью cpuid на платформе x86) 
+	однократно, при первом обращении к функции.
+	\remark Функция предназначена для выбора оптимизированных реализаций
+	алгоритмов во время выполнения (см., например, bashPlatform()).
+	Нераспознанные возможности не поддерживаются.
+*/
+bool_t utilCPUHas(
+	const char* feature	/*!< [in] возможность */
+);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
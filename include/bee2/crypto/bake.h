@@ -4,7 +4,7 @@
 \brief STB 34.101.66 (bake): authenticated key establishment (AKE) protocols
 \project bee2 [cryptographic library]
 \created 2014.04.14
-\version 2023.09.22
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -167,6 +167,34 @@ err_t bakeKDF(
 	size_t num				/*!< [in] номер ключа */
 );
 
+/*!	\brief Длина рабочей памяти алгоритма bakeKDF
+
+	Возвращается длина рабочей памяти (в октетах) функции bakeKDF_ws().
+	\return Длина рабочей памяти.
+*/
+size_t bakeKDF_keep();
+
+/*!	\brief Построение ключа с рабочей памятью
+
+	Выполняются действия функции bakeKDF() с использованием рабочей
+	памяти workspace.
+	\pre По адресу workspace зарезервировано bakeKDF_keep() октетов.
+	\return Как в функции bakeKDF().
+	\warning Рабочая память не очищается. В ней остается состояние
+	beltKRP на промежуточном ключе belt-hash(secret || iv), по которому
+	строятся ключи с любыми номерами. Рабочую память следует очистить
+	(memWipe()) после использования.
+*/
+err_t bakeKDF_ws(
+	octet key[32],			/*!< [out] ключ */
+	const octet secret[],	/*!< [in] секретное слово */
+	size_t secret_len,		/*!< [in] длина secret */
+	const octet iv[],		/*!< [in] дополнительное слово */
+	size_t iv_len,			/*!< [in] длина iv */
+	size_t num,				/*!< [in] номер ключа */
+	void* workspace			/*!< [in,out] рабочая память */
+);
+
 /*!	\brief Построение точки эллиптической кривой
 
 	При долговременных параметрах params по сообщению [l / 4]msg строится 
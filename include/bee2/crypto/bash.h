@@ -4,7 +4,7 @@
 \brief STB 34.101.77 (bash): sponge-based algorithms
 \project bee2 [cryptographic library]
 \created 2014.07.15
-\version 2023.02.02
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -50,8 +50,21 @@ sponge-функции bash-f, реализованной в bashF(). Sponge-фу
 По умолчанию используется реализация для платформы BASH_64 либо, если
 64-разрядные регистры не поддерживаются, BASH_32.
 
+На платформе x64 по умолчанию (или при явном запросе BASH_DISPATCH)
+в библиотеку включаются сразу несколько реализаций: BASH_64, BASH_AVX2,
+BASH_AVX512. Выбор между ними выполняется во время выполнения, при первом
+обращении к bashF(), по возможностям процессора. Имя выбранной (или
+запрошенной при сборке) платформы возвращает функция bashPlatform().
+
 Глубина стека bashF() определяется с помощью функции bashF_deep().
 
+Функции bashFx2(), bashFx4(), bashFx8() одновременно преобразуют несколько 
+независимых состояний. На платформах AVX2 и AVX512 состояния размещаются 
+в дорожках векторных регистров, что ускоряет обработку по сравнению 
+с последовательными вызовами bashF(). Число дорожек возвращает функция
+bashFxLanes(). Многобуферная sponge-функция используется в bashHashMulti() 
+для одновременного хэширования нескольких сообщений.
+
 Конкретный алгоритм хэширования bashHashNNN возвращает NNN-битовые хэш-значения,
 где NNN кратно 32 и не превосходит 512. Параметр NNN регулируется уровнем 
 стойкости l = NNN / 2. 
@@ -126,6 +139,17 @@ bashPrgCmdStep(), где Cmd -- имя команды. Обратим внима
 */
 size_t bashF_deep();
 
+/*!	\brief Платформа sponge-функции
+
+	Возвращается имя платформы, для которой оптимизирована используемая
+	реализация bashF(): "BASH_32", "BASH_64", "BASH_SSE2", "BASH_AVX2",
+	"BASH_AVX512" или "BASH_NEON".
+	\return Имя платформы.
+	\remark В режиме BASH_DISPATCH при первом вызове функции выполняется
+	выбор реализации.
+*/
+const char* bashPlatform();
+
 /*!	\brief Sponge-функция
 
 	Буфер block преобразуется с помощью sponge-функции bash-f.
@@ -136,6 +160,53 @@ void bashF(
 	void* stack			/*!< [in,out] стек */
 );
 
+/*!	\brief Многобуферная sponge-функция: 2 состояния
+
+	Буферы blocks[0], blocks[1] независимо преобразуются с помощью
+	sponge-функции bash-f.
+	\pre Буферы blocks[i] корректны и не пересекаются.
+	\pre По адресу stack зарезервировано bashF_deep() октетов.
+*/
+void bashFx2(
+	octet* blocks[2],	/*!< [in,out] прообразы/образы */
+	void* stack			/*!< [in,out] стек */
+);
+
+/*!	\brief Многобуферная sponge-функция: 4 состояния
+
+	Буферы blocks[0],..., blocks[3] независимо преобразуются с помощью
+	sponge-функции bash-f.
+	\pre Буферы blocks[i] корректны и не пересекаются.
+	\pre По адресу stack зарезервировано bashF_deep() октетов.
+*/
+void bashFx4(
+	octet* blocks[4],	/*!< [in,out] прообразы/образы */
+	void* stack			/*!< [in,out] стек */
+);
+
+/*!	\brief Многобуферная sponge-функция: 8 состояний
+
+	Буферы blocks[0],..., blocks[7] независимо преобразуются с помощью
+	sponge-функции bash-f.
+	\pre Буферы blocks[i] корректны и не пересекаются.
+	\pre По адресу stack зарезервировано bashF_deep() октетов.
+*/
+void bashFx8(
+	octet* blocks[8],	/*!< [in,out] прообразы/образы */
+	void* stack			/*!< [in,out] стек */
+);
+
+/*!	\brief Число дорожек многобуферной sponge-функции
+
+	Возвращается число состояний, которые многобуферная sponge-функция
+	обрабатывает одновременно в дорожках векторных регистров: 8 (AVX512),
+	4 (AVX2) или 1 (векторные регистры не используются).
+	\return Число дорожек.
+	\remark Функции bashFxN() с N, отличным от числа дорожек, реализуются
+	последовательными вызовами bashF() или функций меньшей размерности.
+*/
+size_t bashFxLanes();
+
 /*
 *******************************************************************************
 Алгоритмы хэширования (bashHash)
@@ -173,6 +244,18 @@ void bashHashStepH(
 	void* state			/*!< [in,out] состояние */
 );
 
+/*!	\brief Хэширование фрагментированных данных
+
+	Текущее хэш-значение, размещенное в state, пересчитывается с учетом
+	фрагментов данных [iov_count]iov (см. iov_t).
+	\expect bashHashStart() < bashHashStepHV()*.
+*/
+void bashHashStepHV(
+	const iov_t iov[],	/*!< [in] фрагменты данных */
+	size_t iov_count,	/*!< [in] число фрагментов */
+	void* state			/*!< [in,out] состояние */
+);
+
 /*!	\brief Определение хэш-значения
 
 	Определяются первые октеты [hash_len]hash окончательного хэш-значения 
@@ -209,7 +292,7 @@ bool_t bashHashStepV(
 
 	С помощью алгоритма bash уровня стойкости l определяется хэш-значение 
 	[l / 4]hash буфера [count]src.
-	\expect{ERR_BAD_PARAM} l > 0 && l % 16 == 0 && l <= 256.
+	\expect{ERR_BAD_PARAMS} l > 0 && l % 16 == 0 && l <= 256.
 	\expect{ERR_BAD_INPUT} Буферы hash, src корректны.
 	\return ERR_OK, если хэширование завершено успешно, и код ошибки
 	в противном случае.
@@ -222,6 +305,31 @@ err_t bashHash(
 	size_t count		/*!< [in] число октетов данных */
 );
 
+/*!	\brief Многобуферное хэширование
+
+	С помощью алгоритма bash уровня стойкости l определяются хэш-значения
+	[l / 4]hash[i * l / 4] сообщений [count[i]]src[i], i = 0, 1,..., n - 1.
+	Сообщения обрабатываются одновременно с помощью многобуферной 
+	sponge-функции: если сообщение завершено, то освободившаяся дорожка 
+	получает следующее сообщение.
+	\expect{ERR_BAD_PARAMS} l > 0 && l % 16 == 0 && l <= 256.
+	\expect{ERR_BAD_INPUT} Буферы hash, src, count, src[i] корректны.
+	\pre Буфер hash не пересекается с буферами src[i].
+	\return ERR_OK, если хэширование завершено успешно, и код ошибки
+	в противном случае.
+	\remark Хэш-значения совпадают с теми, которые возвращает bashHash().
+	\remark Многобуферное хэширование ускоряет обработку большого числа
+	коротких сообщений. Длинные сообщения выгоднее обрабатывать, когда
+	их длины близки: тогда дорожки загружены равномерно.
+*/
+err_t bashHashMulti(
+	octet hash[],				/*!< [out] хэш-значения */
+	size_t l,					/*!< [in] уровень стойкости */
+	const void* const src[],	/*!< [in] сообщения */
+	const size_t count[],		/*!< [in] длины сообщений */
+	size_t n					/*!< [in] число сообщений */
+);
+
 /*
 *******************************************************************************
 bash256
@@ -349,6 +457,17 @@ void bashPrgAbsorbStep(
 	void* state			/*!< [in,out] автомат */
 );
 
+/*!	\brief Шаг загрузки фрагментированных данных
+
+	Выполняется загрузка в автомат state фрагментов данных [iov_count]iov.
+	\expect bashPrgAbsorbStart() < bashPrgAbsorbStepV()*.
+*/
+void bashPrgAbsorbStepV(
+	const iov_t iov[],	/*!< [in] фрагменты данных */
+	size_t iov_count,	/*!< [in] число фрагментов */
+	void* state			/*!< [in,out] автомат */
+);
+
 /*!	\brief Загрузка данных
 
 	В автомат state загружаются данные [count]buf. 
@@ -415,6 +534,18 @@ void bashPrgEncrStep(
 	void* state			/*!< [inout] автомат */
 );
 
+/*!	\brief Шаг зашифрования фрагментированных данных
+
+	Выполняется зашифрование фрагментов данных [iov_count]iov на автомате
+	state. Результаты зашифрования сохраняются в iov[i].buf.
+	\expect bashPrgEncrStart() < bashPrgEncrStepV()*.
+*/
+void bashPrgEncrStepV(
+	const iov_t iov[],	/*!< [in] фрагменты данных */
+	size_t iov_count,	/*!< [in] число фрагментов */
+	void* state			/*!< [in,out] автомат */
+);
+
 /*!	\brief Зашифрование
 
 	С помощью автомата state зашифровываются данные [count]buf.
@@ -449,6 +580,18 @@ void bashPrgDecrStep(
 	void* state			/*!< [in,out] автомат */
 );
 
+/*!	\brief Шаг расшифрования фрагментированных данных
+
+	Выполняется расшифрование фрагментов данных [iov_count]iov на автомате
+	state. Результаты расшифрования сохраняются в iov[i].buf.
+	\expect bashPrgDecrStart() < bashPrgDecrStepV()*.
+*/
+void bashPrgDecrStepV(
+	const iov_t iov[],	/*!< [in] фрагменты данных */
+	size_t iov_count,	/*!< [in] число фрагментов */
+	void* state			/*!< [in,out] автомат */
+);
+
 /*!	\brief Расшифрование
 
 	С помощью автомата state расшифровываются данные [count]buf. 
@@ -471,6 +614,82 @@ void bashPrgRatchet(
 	void* state			/*!< [in,out] автомат */
 );
 
+/*
+*******************************************************************************
+Сохранение и восстановление состояний
+
+Состояния bash-hash и автомата bash-prg можно сохранить, чтобы затем
+продолжить обработку данных в другом процессе или после перезапуска.
+Например, можно периодически сохранять промежуточное состояние хэширования
+длинного потока данных и после сбоя возобновить хэширование с места
+сохранения.
+
+Сохраненное состояние начинается с заголовка из 4 октетов: номер версии 
+формата (сейчас 1), код алгоритма и длина сохраненного состояния. Формат не 
+зависит от платформы: состояние, сохраненное на одной платформе, может быть 
+восстановлено на другой. Стеки, копии переменных и другие вспомогательные 
+данные не сохраняются.
+*******************************************************************************
+*/
+
+/*!	\brief Сохранение состояния bash-hash
+
+	Состояние state, сформированное функциями bashHashStart(), bashHashStep*(),
+	сохраняется в буфере [?count]buf.
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+*/
+err_t bashHashStateEnc(
+	octet buf[],		/*!< [out] сохраненное состояние */
+	size_t* count,		/*!< [in,out] длина buf */
+	const void* state	/*!< [in] состояние */
+);
+
+/*!	\brief Восстановление состояния bash-hash
+
+	Состояние state восстанавливается по данным [count]buf, подготовленным
+	функцией bashHashStateEnc().
+	\pre По адресу state зарезервировано bashHash_keep() октетов.
+	\return ERR_OK в случае успеха, ERR_BAD_FORMAT, если данные buf 
+	некорректны, и другой код ошибки в остальных случаях.
+	\remark Восстановленное состояние можно обрабатывать функциями
+	bashHashStep*().
+*/
+err_t bashHashStateDec(
+	void* state,		/*!< [out] состояние */
+	const octet buf[],	/*!< [in] сохраненное состояние */
+	size_t count		/*!< [in] длина buf */
+);
+
+/*!	\brief Сохранение состояния bash-prg
+
+	Состояние автомата state сохраняется в буфере [?count]buf.
+	\remark Команда, которая выполняется автоматом (например, absorb), 
+	может быть продолжена после восстановления.
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+	\warning Если автомат находится в ключевом режиме, то сохраненное 
+	состояние содержит ключевые данные и должно защищаться так же, как ключ.
+*/
+err_t bashPrgStateEnc(
+	octet buf[],		/*!< [out] сохраненное состояние */
+	size_t* count,		/*!< [in,out] длина buf */
+	const void* state	/*!< [in] автомат */
+);
+
+/*!	\brief Восстановление состояния bash-prg
+
+	Состояние state восстанавливается по данным [count]buf, подготовленным
+	функцией bashPrgStateEnc().
+	\pre По адресу state зарезервировано bashPrg_keep() октетов.
+	\return ERR_OK в случае успеха, ERR_BAD_FORMAT, если данные buf 
+	некорректны, и другой код ошибки в остальных случаях.
+	\remark Восстановленный автомат продолжает выполнять команды.
+*/
+err_t bashPrgStateDec(
+	void* state,		/*!< [out] автомат */
+	const octet buf[],	/*!< [in] сохраненное состояние */
+	size_t count		/*!< [in] длина buf */
+);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -4,7 +4,7 @@
 \brief STB 34.101.60 (bels): secret sharing algorithms
 \project bee2 [cryptographic library]
 \created 2013.05.14
-\version 2023.02.02
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -215,6 +215,41 @@ err_t belsShare(
 	void* rng_state			/*!< [in,out] состояние генератора */
 );
 
+/*!	\brief Длина рабочей памяти разделения секрета
+
+	Возвращается длина рабочей памяти (в октетах) функции belsShare_ws()
+	при пороговом числе threshold и длине секрета len.
+	\return Длина рабочей памяти.
+*/
+size_t belsShare_keep(
+	size_t threshold,		/*!< [in] пороговое число */
+	size_t len				/*!< [in] длина секрета в октетах */
+);
+
+/*!	\brief Разделение секрета с рабочей памятью
+
+	Выполняются действия функции belsShare() с использованием рабочей
+	памяти workspace.
+	\pre По адресу workspace зарезервировано belsShare_keep(threshold, len)
+	октетов.
+	\return Как в функции belsShare().
+	\warning Рабочая память не очищается. В ней остаются коэффициенты
+	многочлена, по которым восстанавливается секрет s. Рабочую память
+	следует очистить (memWipe()) после использования.
+*/
+err_t belsShare_ws(
+	octet si[],				/*!< [out] частичные секреты */
+	size_t count,			/*!< [in] число пользователей */
+	size_t threshold,		/*!< [in] пороговое число */
+	size_t len,				/*!< [in] длина секрета в октетах */
+	const octet s[],		/*!< [in] секрет */
+	const octet m0[],		/*!< [in] общий открытый ключ */
+	const octet mi[],		/*!< [in] открытые ключи пользователей */
+	gen_i rng,				/*!< [in] генератор случайных чисел */
+	void* rng_state,		/*!< [in,out] состояние генератора */
+	void* workspace			/*!< [in,out] рабочая память */
+);
+
 /*!	\brief Разделение секрета на стандартных открытых ключах
 
 	Секрет [len]s разделяется с порогом threshold на count частичных секретов,
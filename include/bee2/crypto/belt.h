@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): data encryption and integrity algorithms
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2023.02.02
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -116,6 +116,14 @@ ZZ_mod = {0, 1,..., mod - 1}. Здесь mod -- размер алфавита и
 обрабатывает все данные целиком. В высокоуровневых функциях есть
 проверка входных данных.
 
+Высокоуровневые функции выделяют память для состояния в куче. Для
+функций beltCTR(), beltMAC(), beltDWPWrap(), beltDWPUnwrap(), beltCHEWrap(),
+beltCHEUnwrap(), beltHash() предусмотрены варианты с суффиксом _ws.
+Эти варианты используют рабочую память workspace, которую готовит
+вызывающая программа. Объем рабочей памяти определяется функцией _keep
+соответствующей связки. Варианты _ws не обращаются к куче и не очищают
+рабочую память после использования.
+
 Механизмы MAC, Hash, HMAC, DWP, CHE реализованы с поддержкой принципа 
 get-then-continue. Это означает, что после обработки определенной порции данных
 можно вызвать функцию типа StepG, а затем продолжить обработку.
@@ -740,6 +748,24 @@ err_t beltCTR(
 	const octet iv[16]		/*!< [in] синхропосылка */
 );
 
+/*!	\brief Шифрование в режиме CTR с рабочей памятью
+
+	Выполняются действия функции beltCTR() с использованием рабочей
+	памяти workspace.
+	\pre По адресу workspace зарезервировано beltCTR_keep() октетов.
+	\return Как в функции beltCTR().
+	\remark Рабочая память не очищается.
+*/
+err_t beltCTR_ws(
+	void* dest,				/*!< [out] шифртекст / открытый текст */
+	const void* src,		/*!< [in] открытый текст / шифртекст */
+	size_t count,			/*!< [in] число октетов текста */
+	const octet key[],		/*!< [in] ключ */
+	size_t len,				/*!< [in] длина ключа */
+	const octet iv[16],		/*!< [in] синхропосылка */
+	void* workspace			/*!< [in,out] рабочая память */
+);
+
 /*
 *******************************************************************************
 Имитозащита (belt-mac, MAC)
@@ -780,6 +806,18 @@ void beltMACStepA(
 	void* state			/*!< [in,out] состояние */
 );
 
+/*!	\brief Имитозащита фрагментированных данных в режиме MAC
+
+	Текущая имитовставка, размещенная в state, пересчитывается с учетом
+	фрагментов данных [iov_count]iov (см. iov_t).
+	\expect beltMACStart() < beltMACStepAV()*.
+*/
+void beltMACStepAV(
+	const iov_t iov[],	/*!< [in] фрагменты данных */
+	size_t iov_count,	/*!< [in] число фрагментов */
+	void* state			/*!< [in,out] состояние */
+);
+
 /*!	\brief Определение имитовставки в режиме MAC
 
 	Определяется окончательная имитовставка mac всех данных,
@@ -851,6 +889,23 @@ err_t beltMAC(
 	size_t len				/*!< [in] длина ключа */
 );
 
+/*!	\brief Имитозащита в режиме MAC с рабочей памятью
+
+	Выполняются действия функции beltMAC() с использованием рабочей
+	памяти workspace.
+	\pre По адресу workspace зарезервировано beltMAC_keep() октетов.
+	\return Как в функции beltMAC().
+	\remark Рабочая память не очищается.
+*/
+err_t beltMAC_ws(
+	octet mac[8],			/*!< [out] имитовставка */
+	const void* src,		/*!< [in] данные */
+	size_t count,			/*!< [in] число октетов данных */
+	const octet key[],		/*!< [in] ключ */
+	size_t len,				/*!< [in] длина ключа */
+	void* workspace			/*!< [in,out] рабочая память */
+);
+
 /*
 *******************************************************************************
 Аутентифицированное шифрование по схеме DWP (belt-dwp, DWP)
@@ -892,6 +947,18 @@ void beltDWPStepE(
 	void* state			/*!< [in,out] состояние */
 );
 
+/*!	\brief Зашифрование фрагментированных критических данных в режиме DWP
+
+	Фрагменты критических данных [iov_count]iov зашифровываются на ключе,
+	размещенном в state. Результаты зашифрования сохраняются в iov[i].buf.
+	\expect beltDWPStart() < beltDWPStepEV()*.
+*/
+void beltDWPStepEV(
+	const iov_t iov[],	/*!< [in] фрагменты данных */
+	size_t iov_count,	/*!< [in] число фрагментов */
+	void* state			/*!< [in,out] состояние */
+);
+
 /*!	\brief Имитозащита открытого фрагмента в режиме DWP
 
 	Текущая имитовставка, размещенная в state, пересчитывается с учетом нового
@@ -920,6 +987,18 @@ void beltDWPStepA(
 	void* state			/*!< [in,out] состояние */
 );
 
+/*!	\brief Имитозащита фрагментированных критических данных в режиме DWP
+
+	Текущая имитовставка, размещенная в state, пересчитывается с учетом
+	фрагментов зашифрованных критических данных [iov_count]iov.
+	\expect beltDWPStepE()* < beltDWPStepAV()*.
+*/
+void beltDWPStepAV(
+	const iov_t iov[],	/*!< [in] фрагменты данных */
+	size_t iov_count,	/*!< [in] число фрагментов */
+	void* state			/*!< [in,out] состояние */
+);
+
 /*!	\brief Определение имитовставки в режиме DWP
 
 	Определяется окончательная имитовставка mac всех данных,
@@ -964,6 +1043,19 @@ void beltDWPStepD(
 	void* state			/*!< [in,out] состояние */
 );
 
+/*!	\brief Расшифрование фрагментированных критических данных в режиме DWP
+
+	Фрагменты зашифрованных критических данных [iov_count]iov 
+	расшифровываются на ключе, размещенном в state. Результаты 
+	расшифрования сохраняются в iov[i].buf.
+	\expect beltDWPStepA()* < beltDWPStepDV().
+*/
+void beltDWPStepDV(
+	const iov_t iov[],	/*!< [in] фрагменты данных */
+	size_t iov_count,	/*!< [in] число фрагментов */
+	void* state			/*!< [in,out] состояние */
+);
+
 /*!	\brief Установка защиты в режиме DWP
 
 	На ключе [len]key с использованием имитовставки iv устанавливается 
@@ -991,6 +1083,27 @@ err_t beltDWPWrap(
 	const octet iv[16]		/*!< [in] синхропосылка */
 );
 
+/*!	\brief Установка защиты в режиме DWP с рабочей памятью
+
+	Выполняются действия функции beltDWPWrap() с использованием рабочей
+	памяти workspace.
+	\pre По адресу workspace зарезервировано beltDWP_keep() октетов.
+	\return Как в функции beltDWPWrap().
+	\remark Рабочая память не очищается.
+*/
+err_t beltDWPWrap_ws(
+	void* dest,				/*!< [out] зашифрованные критические данные */
+	octet mac[8],			/*!< [out] имитовставка */
+	const void* src1,		/*!< [in] критические данные */
+	size_t count1,			/*!< [in] число октетов критических данных */
+	const void* src2,		/*!< [in] открытые данные */
+	size_t count2,			/*!< [in] число октетов открытых данных */
+	const octet key[],		/*!< [in] ключ */
+	size_t len,				/*!< [in] длина ключа */
+	const octet iv[16],		/*!< [in] синхропосылка */
+	void* workspace			/*!< [in,out] рабочая память */
+);
+
 /*!	\brief Снятие защиты в режиме DWP
 
 	На ключе [len]key октетов с использованием имитовставки iv
@@ -1016,6 +1129,27 @@ err_t beltDWPUnwrap(
 	const octet iv[16]		/*!< [in] синхропосылка */
 );
 
+/*!	\brief Снятие защиты в режиме DWP с рабочей памятью
+
+	Выполняются действия функции beltDWPUnwrap() с использованием рабочей
+	памяти workspace.
+	\pre По адресу workspace зарезервировано beltDWP_keep() октетов.
+	\return Как в функции beltDWPUnwrap().
+	\remark Рабочая память не очищается.
+*/
+err_t beltDWPUnwrap_ws(
+	void* dest,				/*!< [out] расшифрованные критические данные */
+	const void* src1,		/*!< [in] зашифрованные критические данные */
+	size_t count1,			/*!< [in] число октетов критических данных */
+	const void* src2,		/*!< [in] открытые данные */
+	size_t count2,			/*!< [in] число октетов открытых данных */
+	const octet mac[8],		/*!< [in] имитовставка */
+	const octet key[],		/*!< [in] ключ */
+	size_t len,				/*!< [in] длина ключа */
+	const octet iv[16],		/*!< [in] синхропосылка */
+	void* workspace			/*!< [in,out] рабочая память */
+);
+
 /*
 *******************************************************************************
 Аутентифицированное шифрование по схеме CHE (belt-che, CHE)
@@ -1156,6 +1290,27 @@ err_t beltCHEWrap(
 	const octet iv[16]		/*!< [in] синхропосылка */
 );
 
+/*!	\brief Установка защиты в режиме CHE с рабочей памятью
+
+	Выполняются действия функции beltCHEWrap() с использованием рабочей
+	памяти workspace.
+	\pre По адресу workspace зарезервировано beltCHE_keep() октетов.
+	\return Как в функции beltCHEWrap().
+	\remark Рабочая память не очищается.
+*/
+err_t beltCHEWrap_ws(
+	void* dest,				/*!< [out] зашифрованные критические данные */
+	octet mac[8],			/*!< [out] имитовставка */
+	const void* src1,		/*!< [in] критические данные */
+	size_t count1,			/*!< [in] число октетов критических данных */
+	const void* src2,		/*!< [in] открытые данные */
+	size_t count2,			/*!< [in] число октетов открытых данных */
+	const octet key[],		/*!< [in] ключ */
+	size_t len,				/*!< [in] длина ключа */
+	const octet iv[16],		/*!< [in] синхропосылка */
+	void* workspace			/*!< [in,out] рабочая память */
+);
+
 /*!	\brief Снятие защиты в режиме CHE
 
 	На ключе [len]key октетов с использованием имитовставки iv
@@ -1181,6 +1336,27 @@ err_t beltCHEUnwrap(
 	const octet iv[16]		/*!< [in] синхропосылка */
 );
 
+/*!	\brief Снятие защиты в режиме CHE с рабочей памятью
+
+	Выполняются действия функции beltCHEUnwrap() с использованием рабочей
+	памяти workspace.
+	\pre По адресу workspace зарезервировано beltCHE_keep() октетов.
+	\return Как в функции beltCHEUnwrap().
+	\remark Рабочая память не очищается.
+*/
+err_t beltCHEUnwrap_ws(
+	void* dest,				/*!< [out] расшифрованные критические данные */
+	const void* src1,		/*!< [in] зашифрованные критические данные */
+	size_t count1,			/*!< [in] число октетов критических данных */
+	const void* src2,		/*!< [in] открытые данные */
+	size_t count2,			/*!< [in] число октетов открытых данных */
+	const octet mac[8],		/*!< [in] имитовставка */
+	const octet key[],		/*!< [in] ключ */
+	size_t len,				/*!< [in] длина ключа */
+	const octet iv[16],		/*!< [in] синхропосылка */
+	void* workspace			/*!< [in,out] рабочая память */
+);
+
 /*
 *******************************************************************************
 Шифрование и имитозащита ключей (belt-kwp, KWP)
@@ -1276,6 +1452,18 @@ void beltHashStepH(
 	void* state			/*!< [in,out] состояние */
 );
 
+/*!	\brief Хэширование фрагментированных данных
+
+	Текущее хэш-значение, размещенное в state, пересчитывается с учетом
+	фрагментов данных [iov_count]iov (см. iov_t).
+	\expect beltHashStart() < beltHashStepHV()*.
+*/
+void beltHashStepHV(
+	const iov_t iov[],	/*!< [in] фрагменты данных */
+	size_t iov_count,	/*!< [in] число фрагментов */
+	void* state			/*!< [in,out] состояние */
+);
+
 /*!	\brief Определение хэш-значения
 
 	Определяется окончательное хэш-значение hash всех данных,
@@ -1344,6 +1532,21 @@ err_t beltHash(
 	size_t count		/*!< [in] число октетов данных */
 );
 
+/*!	\brief Хэширование с рабочей памятью
+
+	Выполняются действия функции beltHash() с использованием рабочей
+	памяти workspace.
+	\pre По адресу workspace зарезервировано beltHash_keep() октетов.
+	\return Как в функции beltHash().
+	\remark Рабочая память не очищается.
+*/
+err_t beltHash_ws(
+	octet hash[32],		/*!< [out] хэш-значение */
+	const void* src,	/*!< [in] данные */
+	size_t count,		/*!< [in] число октетов данных */
+	void* workspace		/*!< [in,out] рабочая память */
+);
+
 /*
 *******************************************************************************
 Блоковое дисковое шифрование (belt-bde, BDE)
@@ -1860,6 +2063,111 @@ err_t beltPBKDF2(
 	size_t salt_len			/*!< [in] длина синхропосылки (в октетах) */
 );
 
+/*
+*******************************************************************************
+Сохранение и восстановление состояний
+
+Состояния belt-hash, belt-mac, belt-hmac можно сохранить, чтобы затем
+продолжить обработку данных в другом процессе или после перезапуска.
+Например, можно периодически сохранять промежуточное состояние хэширования
+длинного потока данных и после сбоя возобновить хэширование с места
+сохранения.
+
+Сохраненное состояние начинается с заголовка из 4 октетов: номер версии 
+формата (сейчас 1), код алгоритма и длина сохраненного состояния. Формат не 
+зависит от платформы: состояние, сохраненное на одной платформе, может быть 
+восстановлено на другой. Стеки, копии переменных и другие вспомогательные 
+данные не сохраняются.
+*******************************************************************************
+*/
+
+/*!	\brief Сохранение состояния belt-hash
+
+	Состояние state, сформированное функциями beltHashStart(), beltHashStep*(),
+	сохраняется в буфере [?count]buf.
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+*/
+err_t beltHashStateEnc(
+	octet buf[],		/*!< [out] сохраненное состояние */
+	size_t* count,		/*!< [in,out] длина buf */
+	const void* state	/*!< [in] состояние */
+);
+
+/*!	\brief Восстановление состояния belt-hash
+
+	Состояние state восстанавливается по данным [count]buf, подготовленным
+	функцией beltHashStateEnc().
+	\pre По адресу state зарезервировано beltHash_keep() октетов.
+	\return ERR_OK в случае успеха, ERR_BAD_FORMAT, если данные buf 
+	некорректны, и другой код ошибки в остальных случаях.
+	\remark Восстановленное состояние можно обрабатывать функциями
+	beltHashStep*().
+*/
+err_t beltHashStateDec(
+	void* state,		/*!< [out] состояние */
+	const octet buf[],	/*!< [in] сохраненное состояние */
+	size_t count		/*!< [in] длина buf */
+);
+
+/*!	\brief Сохранение состояния belt-mac
+
+	Состояние state, сформированное функциями beltMACStart(), beltMACStep*(),
+	сохраняется в буфере [?count]buf.
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+	\warning Сохраненное состояние содержит ключевые данные и должно 
+	защищаться так же, как ключ.
+*/
+err_t beltMACStateEnc(
+	octet buf[],		/*!< [out] сохраненное состояние */
+	size_t* count,		/*!< [in,out] длина buf */
+	const void* state	/*!< [in] состояние */
+);
+
+/*!	\brief Восстановление состояния belt-mac
+
+	Состояние state восстанавливается по данным [count]buf, подготовленным
+	функцией beltMACStateEnc().
+	\pre По адресу state зарезервировано beltMAC_keep() октетов.
+	\return ERR_OK в случае успеха, ERR_BAD_FORMAT, если данные buf 
+	некорректны, и другой код ошибки в остальных случаях.
+	\remark Восстановленное состояние можно обрабатывать функциями
+	beltMACStep*().
+*/
+err_t beltMACStateDec(
+	void* state,		/*!< [out] состояние */
+	const octet buf[],	/*!< [in] сохраненное состояние */
+	size_t count		/*!< [in] длина buf */
+);
+
+/*!	\brief Сохранение состояния belt-hmac
+
+	Состояние state, сформированное функциями beltHMACStart(), beltHMACStep*(),
+	сохраняется в буфере [?count]buf.
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+	\warning Сохраненное состояние содержит ключевые данные и должно 
+	защищаться так же, как ключ.
+*/
+err_t beltHMACStateEnc(
+	octet buf[],		/*!< [out] сохраненное состояние */
+	size_t* count,		/*!< [in,out] длина buf */
+	const void* state	/*!< [in] состояние */
+);
+
+/*!	\brief Восстановление состояния belt-hmac
+
+	Состояние state восстанавливается по данным [count]buf, подготовленным
+	функцией beltHMACStateEnc().
+	\pre По адресу state зарезервировано beltHMAC_keep() октетов.
+	\return ERR_OK в случае успеха, ERR_BAD_FORMAT, если данные buf 
+	некорректны, и другой код ошибки в остальных случаях.
+	\remark Восстановленное состояние можно обрабатывать функциями
+	beltHMACStep*().
+*/
+err_t beltHMACStateDec(
+	void* state,		/*!< [out] состояние */
+	const octet buf[],	/*!< [in] сохраненное состояние */
+	size_t count		/*!< [in] длина buf */
+);
 
 #ifdef __cplusplus
 } /* extern "C" */
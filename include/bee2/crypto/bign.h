@@ -4,7 +4,7 @@
 \brief STB 34.101.45 (bign): digital signature and key transport algorithms
 \project bee2 [cryptographic library]
 \created 2012.04.27
-\version 2023.09.25
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -94,6 +94,9 @@ err_t bignParamsStd(
 	Проверяется корректность долговременных параметров params.
 	\return ERR_OK, если параметры корректны, и код ошибки в противном случае.
 	\remark Реализован алгоритм 6.1.4.
+	\remark Хэш-значения проверенных параметров запоминаются в кэше
+	ограниченного объема. Повторная проверка тех же параметров сводится
+	к поиску в кэше. В кэш заранее занесены стандартные параметры.
 */
 err_t bignParamsVal(
 	const bign_params* params	/*!< [in] долговременные параметры */
@@ -316,6 +319,33 @@ err_t bignDH(
 	size_t key_len				/*!< [in] длина key в октетах */
 );
 
+/*!	\brief Длина рабочей памяти построения общего ключа
+
+	Возвращается длина рабочей памяти (в октетах) функции bignDH_ws()
+	при уровне стойкости l.
+	\return Длина рабочей памяти.
+*/
+size_t bignDH_keep(
+	size_t l			/*!< [in] уровень стойкости */
+);
+
+/*!	\brief Построение общего ключа Диффи -- Хеллмана с рабочей памятью
+
+	Выполняются действия функции bignDH() с использованием рабочей
+	памяти workspace.
+	\pre По адресу workspace зарезервировано bignDH_keep(params->l) октетов.
+	\return Как в функции bignDH().
+	\remark Рабочая память не очищается.
+*/
+err_t bignDH_ws(
+	octet key[],				/*!< [out] общий ключ */
+	const bign_params* params,	/*!< [in] долговременные параметры */
+	const octet privkey[],		/*!< [in] личный ключ */
+	const octet pubkey[],		/*!< [in] открытый ключ (другой стороны) */
+	size_t key_len,				/*!< [in] длина key в октетах */
+	void* workspace				/*!< [in,out] рабочая память */
+);
+
 /*
 *******************************************************************************
 Электронная цифровая подпись (ЭЦП)
@@ -350,6 +380,39 @@ err_t bignSign(
 	void* rng_state				/*!< [in,out] состояние генератора */
 );
 
+/*!	\brief Длина рабочей памяти выработки ЭЦП
+
+	Возвращается длина рабочей памяти (в октетах) функции bignSign_ws()
+	при уровне стойкости l.
+	\return Длина рабочей памяти.
+*/
+size_t bignSign_keep(
+	size_t l			/*!< [in] уровень стойкости */
+);
+
+/*!	\brief Выработка ЭЦП с рабочей памятью
+
+	Выполняются действия функции bignSign() с использованием рабочей
+	памяти workspace.
+	\pre По адресу workspace зарезервировано bignSign_keep(params->l) октетов.
+	\return Как в функции bignSign().
+	\warning Рабочая память не очищается. После выхода в ней остаются
+	личный ключ d и одноразовый личный ключ k, по которым (вместе
+	с подписью) восстанавливается d. Вызывающая сторона должна очистить
+	рабочую память (memWipe()) сразу после использования.
+*/
+err_t bignSign_ws(
+	octet sig[],				/*!< [out] подпись */
+	const bign_params* params,	/*!< [in] долговременные параметры */
+	const octet oid_der[],		/*!< [in] идентификатор хэш-алгоритма */
+	size_t oid_len,				/*!< [in] длина oid_der в октетах */
+	const octet hash[],			/*!< [in] хэш-значение */
+	const octet privkey[],		/*!< [in] личный ключ */
+	gen_i rng,					/*!< [in] генератор случайных чисел */
+	void* rng_state,			/*!< [in,out] состояние генератора */
+	void* workspace				/*!< [in,out] рабочая память */
+);
+
 /*!	\brief Детерминированная выработка ЭЦП
 
 	Вырабатывается подпись [3 * l / 8]sig сообщения с хэш-значением 
@@ -378,6 +441,38 @@ err_t bignSign2(
 	size_t t_len				/*!< [in] размер дополнительных данных */
 );
 
+/*!	\brief Длина рабочей памяти детерминированной выработки ЭЦП
+
+	Возвращается длина рабочей памяти (в октетах) функции bignSign2_ws()
+	при уровне стойкости l.
+	\return Длина рабочей памяти.
+*/
+size_t bignSign2_keep(
+	size_t l			/*!< [in] уровень стойкости */
+);
+
+/*!	\brief Детерминированная выработка ЭЦП с рабочей памятью
+
+	Выполняются действия функции bignSign2() с использованием рабочей
+	памяти workspace.
+	\pre По адресу workspace зарезервировано bignSign2_keep(params->l) октетов.
+	\return Как в функции bignSign2().
+	\warning Рабочая память не очищается и содержит личный ключ d
+	и одноразовый личный ключ k. Ее следует очистить так же, как
+	в bignSign_ws().
+*/
+err_t bignSign2_ws(
+	octet sig[],				/*!< [out] подпись */
+	const bign_params* params,	/*!< [in] долговременные параметры */
+	const octet oid_der[],		/*!< [in] идентификатор хэш-алгоритма */
+	size_t oid_len,				/*!< [in] длина oid_der в октетах */
+	const octet hash[],			/*!< [in] хэш-значение */
+	const octet privkey[],		/*!< [in] личный ключ */
+	const void* t,				/*!< [in] дополнительные данные */
+	size_t t_len,				/*!< [in] размер дополнительных данных */
+	void* workspace				/*!< [in,out] рабочая память */
+);
+
 /*!	\brief Проверка ЭЦП
 
 	Проверяется ЭЦП [3 * l / 8]sig сообщения с хэш-значением [l / 4]hash. При 
@@ -401,6 +496,141 @@ err_t bignVerify(
 	const octet pubkey[]		/*!< [in] открытый ключ */
 );
 
+/*!	\brief Длина рабочей памяти проверки ЭЦП
+
+	Возвращается длина рабочей памяти (в октетах) функции bignVerify_ws()
+	при уровне стойкости l.
+	\return Длина рабочей памяти.
+*/
+size_t bignVerify_keep(
+	size_t l			/*!< [in] уровень стойкости */
+);
+
+/*!	\brief Проверка ЭЦП с рабочей памятью
+
+	Выполняются действия функции bignVerify() с использованием рабочей
+	памяти workspace.
+	\pre По адресу workspace зарезервировано bignVerify_keep(params->l) октетов.
+	\return Как в функции bignVerify().
+	\remark Рабочая память не очищается.
+*/
+err_t bignVerify_ws(
+	const bign_params* params,	/*!< [in] долговременные параметры */
+	const octet oid_der[],		/*!< [in] идентификатор хэш-алгоритма */
+	size_t oid_len,				/*!< [in] длина oid_der в октетах */
+	const octet hash[],			/*!< [in] хэш-значение */
+	const octet sig[],			/*!< [in] подпись */
+	const octet pubkey[],		/*!< [in] открытый ключ */
+	void* workspace				/*!< [in,out] рабочая память */
+);
+
+/*
+*******************************************************************************
+Предвычисления
+
+Кратные базовой точки, которые рассчитываются при выработке ключей
+и подписей, можно ускорить с помощью таблицы предвычислений (см. ecPreA()
+в ec.h). Построение таблицы требует заметного времени, поэтому таблицу
+целесообразно построить один раз, сохранить в файле и затем загружать
+(например, отображать в память только для чтения) в рабочих процессах.
+
+Предвычисления сериализуются в строку октетов следующего формата:
+-	заголовок (BIGN_PRE_HDR октетов):
+	-	[8] сигнатура "bee2pre" (с завершающим нулем);
+	-	[4] версия формата (1);
+	-	[4] маркер порядка октетов 0x01020304;
+	-	[4] число битов в машинном слове B_PER_W;
+	-	[4] уровень стойкости l;
+	-	[4] ширина окна w;
+	-	[4] резерв (0);
+	-	[32] хэш-значение belt-hash долговременных параметров
+		(p || a || b || q || yG, каждое из чисел -- l / 4 октетов);
+-	таблица ecPreA() кратных базовой точки;
+-	[32] контрольная сумма: хэш-значение belt-hash заголовка и таблицы.
+
+Числовые поля заголовка имеют тип u32 и записываются с порядком
+октетов платформы. Таблица содержит элементы поля во внутреннем
+представлении. Поэтому предвычисления можно использовать только
+на платформе с тем же порядком октетов и той же длиной машинного слова,
+что и на платформе, где они были построены. Указатели в предвычисления
+не входят: строку можно размещать по любому адресу, выровненному
+на границу машинного слова.
+
+После проверки предвычисления подключаются к уровню стойкости l
+функцией bignPreAttach(). После подключения таблица используется
+функциями bignKeypairGen(), bignKeypairVal(), bignPubkeyCalc(),
+bignSign(), bignSign2() и их редакциями _ws, bignKeyWrap(), bignIdSign(),
+bignIdSign2(), если они вызываются с теми же долговременными параметрами.
+Подключенные предвычисления не копируются.
+*******************************************************************************
+*/
+
+#define BIGN_PRE_HDR 64
+
+/*!	\brief Построение предвычислений
+
+	По долговременным параметрам params строятся предвычисления
+	[*count]pre с шириной окна w. Если pre == 0, то определяется только
+	длина предвычислений *count.
+	\expect{ERR_BAD_PARAMS} Параметры params корректны.
+	\expect{ERR_BAD_INPUT} 1 <= w <= 8.
+	\return ERR_OK, если предвычисления построены (длина определена),
+	и код ошибки в противном случае.
+	\remark Длина предвычислений при l == 128 и w == 4 составляет около
+	60 Кбайт и растет с увеличением w пропорционально 2^w / w.
+*/
+err_t bignPreCreate(
+	octet pre[],				/*!< [out] предвычисления */
+	size_t* count,				/*!< [out] длина pre в октетах */
+	const bign_params* params,	/*!< [in] долговременные параметры */
+	size_t w					/*!< [in] ширина окна */
+);
+
+/*!	\brief Проверка предвычислений
+
+	Проверяется, что предвычисления [count]pre построены для
+	долговременных параметров params и не повреждены, и что все точки
+	таблицы лежат на кривой.
+	\expect{ERR_BAD_PARAMS} Параметры params корректны.
+	\return ERR_OK, если предвычисления корректны, и код ошибки
+	в противном случае: ERR_BAD_FORMAT (неверный формат, версия или
+	платформа), ERR_BAD_PARAMS (предвычисления построены для других
+	параметров), ERR_BAD_HASH (нарушена контрольная сумма),
+	ERR_BAD_POINT (точка таблицы не лежит на кривой), ERR_BAD_INPUT
+	(некорректные или невыровненные входные данные).
+	\warning Контрольная сумма обнаруживает случайные повреждения,
+	но не подмену: злоумышленник может пересчитать ее. Проверка точек
+	не гарантирует, что таблица содержит кратные именно базовой точки,
+	а с подмененной таблицей bignSign() выработает неверную подпись
+	и может раскрыть личный ключ. Поэтому файл предвычислений должен
+	поступать из доверенного источника и храниться так же, как
+	исполняемые файлы библиотеки (с защитой от записи посторонними).
+*/
+err_t bignPreVal(
+	const bign_params* params,	/*!< [in] долговременные параметры */
+	const octet pre[],			/*!< [in] предвычисления */
+	size_t count				/*!< [in] длина pre в октетах */
+);
+
+/*!	\brief Подключение предвычислений
+
+	Проверяются предвычисления [count]pre для долговременных параметров
+	params и, в случае успеха, подключаются к уровню стойкости params->l.
+	Ранее подключенные к этому уровню предвычисления отключаются.
+	Если pre == 0, то только отключаются предвычисления уровня params->l.
+	\pre Функция не вызывается одновременно с другими функциями bign
+	(как правило, она вызывается при запуске программы, до создания
+	рабочих потоков).
+	\pre Буфер pre не изменяется и не освобождается до отключения
+	предвычислений.
+	\return Как в функции bignPreVal().
+*/
+err_t bignPreAttach(
+	const bign_params* params,	/*!< [in] долговременные параметры */
+	const octet pre[],			/*!< [in] предвычисления */
+	size_t count				/*!< [in] длина pre в октетах */
+);
+
 /*
 *******************************************************************************
 Транспорт ключа
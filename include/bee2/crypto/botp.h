@@ -4,7 +4,7 @@
 \brief STB 34.101.47/botp: OTP algorithms
 \project bee2 [cryptographic library]
 \created 2015.11.02
-\version 2023.02.02
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -228,6 +228,24 @@ err_t botpHOTPVerify(
 	const octet ctr[8]		/*!< [in] счетчик */
 );
 
+/*!	\brief Проверка пароля в режиме HOTP с рабочей памятью
+
+	Выполняются действия функции botpHOTPVerify() с использованием рабочей
+	памяти workspace.
+	\pre По адресу workspace зарезервировано botpHOTP_keep() октетов.
+	\return Как в функции botpHOTPVerify().
+	\warning Рабочая память не очищается. В ней остается состояние
+	HMAC на ключе key. Рабочую память следует очистить (memWipe())
+	после использования.
+*/
+err_t botpHOTPVerify_ws(
+	const char* otp,		/*!< [in] контрольный пароль */
+	const octet key[],		/*!< [in] ключ */
+	size_t key_len,			/*!< [in] длина ключа в октетах */
+	const octet ctr[8],		/*!< [in] счетчик */
+	void* workspace			/*!< [in,out] рабочая память */
+);
+
 /*!
 *******************************************************************************
 \file botp.h
@@ -4,7 +4,7 @@
 \brief STB 34.101.79 (btok): cryptographic tokens
 \project bee2 [cryptographic library]
 \created 2022.07.04
-\version 2023.06.17
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -480,6 +480,50 @@ err_t btokCVCVal2(
 	const octet* date			/*!< [in] дата проверки */
 );
 
+/*!	\brief Включение кэша проверенных подписей CV-сертификатов
+
+	Включается кэш, в котором сохраняются результаты успешной проверки
+	подписей CV-сертификатов в функциях btokCVCVal(), btokCVCVal2().
+	Кэш вмещает не более capacity элементов. Если кэш уже включен, то он
+	очищается и пересоздается.
+	\expect{ERR_BAD_INPUT} 0 < capacity <= 65536.
+	\return ERR_OK в случае успеха и код ошибки в противном случае.
+	\remark Элемент кэша -- хэш-значение beltHash сертификата и открытого
+	ключа издателя, на котором проверена подпись сертификата. При
+	повторной проверке сертификата на том же ключе вместо bignVerify()
+	(две кратные точки) вычисляется хэш-значение. Остальные проверки
+	(соответствие издателю, сроки действия, дата date) выполняются всегда.
+	Поэтому дата проверки не входит в ключ кэша: результат проверки
+	подписи от нее не зависит.
+	\remark При переполнении вытесняется самый старый элемент.
+	\remark Обращения к кэшу синхронизируются, функции btokCVCVal(),
+	btokCVCVal2() могут вызываться одновременно из нескольких потоков.
+	\warning Функции btokCVCCacheStart(), btokCVCCacheStop() не должны
+	вызываться одновременно с функциями проверки.
+*/
+err_t btokCVCCacheStart(
+	size_t capacity			/*!< [in] число элементов */
+);
+
+/*!	\brief Статистика кэша проверенных подписей
+
+	Возвращаются число попаданий hits (подпись не проверялась) и число
+	промахов misses (подпись проверялась) в кэше, включенном функцией
+	btokCVCCacheStart().
+	\remark Указатели hits и misses могут быть нулевыми.
+	\remark Если кэш не включен, то возвращаются нули.
+*/
+void btokCVCCacheStat(
+	size_t* hits,			/*!< [out] число попаданий */
+	size_t* misses			/*!< [out] число промахов */
+);
+
+/*!	\brief Выключение кэша проверенных подписей
+
+	Кэш, включенный функцией btokCVCCacheStart(), очищается и выключается.
+*/
+void btokCVCCacheStop();
+
 /*!	\brief Проверка соответствия CV-сертификата
 
 	Проверяется соответствие между CV-сертификатом [cert_len]cert и личным
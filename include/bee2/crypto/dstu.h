@@ -4,7 +4,7 @@
 \brief DSTU 4145-2002 (Ukraine): digital signature algorithms
 \project bee2 [cryptographic library]
 \created 2012.04.27
-\version 2023.09.22
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -126,6 +126,10 @@ err_t dstuParamsStd(
 	\return ERR_OK, если параметры корректны, и код ошибки в противном
 	случае.
 	\remark Проверяется корректность в том числе и базовой точки P.
+	\remark Хэш-значения проверенных параметров запоминаются в кэше
+	ограниченного объема. Повторная проверка тех же параметров сводится
+	к поиску в кэше. В кэш заранее занесены стандартные параметры кривой
+	curve163pb (для других кривых базовая точка не стандартизирована).
 */
 err_t dstuParamsVal(
 	const dstu_params* params	/*!< [in] параметры */
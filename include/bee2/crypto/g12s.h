@@ -4,7 +4,7 @@
 \brief GOST R 34.10-94 (Russia): digital signature algorithms
 \project bee2 [cryptographic library]
 \created 2012.04.27
-\version 2023.09.22
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -127,6 +127,9 @@ err_t g12sParamsStd(
 	Проверяется корректность долговременных параметров params.
 	\return ERR_OK, если параметры корректны, и код ошибки в противном
 	случае.
+	\remark Хэш-значения проверенных параметров запоминаются в кэше
+	ограниченного объема. Повторная проверка тех же параметров сводится
+	к поиску в кэше. В кэш заранее занесены стандартные параметры.
 */
 err_t g12sParamsVal(
 	const g12s_params* params	/*!< [in] параметры */
@@ -0,0 +1,261 @@
+/*
+*******************************************************************************
+\file job.h
+\brief Asynchronous cryptographic jobs
+\project bee2 [cryptographic library]
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file job.h
+\brief Асинхронное выполнение криптографических заданий
+*******************************************************************************
+*/
+
+#ifndef __BEE2_JOB_H
+#define __BEE2_JOB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "bee2/defs.h"
+#include "bee2/crypto/bign.h"
+
+/*!
+*******************************************************************************
+\file job.h
+
+\section job-common Общие положения
+
+Модуль позволяет выполнять криптографические операции асинхронно:
+вызывающий поток передает задание в обработчик и продолжает работу,
+а задание выполняется в пуле потоков обработчика (см. mtPoolCreate()).
+
+Задание описывается структурой job_t, память для которой готовит
+вызывающая программа. Тип задания задается полем type:
+-	JOB_BIGN_SIGN -- выработка ЭЦП bign (bignSign() или bignSign2());
+-	JOB_BIGN_VERIFY -- проверка ЭЦП bign (bignVerify());
+-	JOB_BIGN_DH -- построение общего ключа bign (bignDH());
+-	JOB_BELT_DWP_WRAP, JOB_BELT_DWP_UNWRAP -- установка и снятие защиты
+	в режиме DWP (beltDWPWrap(), beltDWPUnwrap());
+-	JOB_BELT_CHE_WRAP, JOB_BELT_CHE_UNWRAP -- установка и снятие защиты
+	в режиме CHE (beltCHEWrap(), beltCHEUnwrap()).
+
+Остальные поля job_t являются аргументами соответствующих функций.
+Используемые поля:
+-	JOB_BIGN_SIGN: params, oid_der, oid_len, hash, privkey, sig (выход),
+	rng, rng_state. Если rng == 0, то подпись вырабатывается
+	детерминированно функцией bignSign2() c дополнительными данными
+	[count1]src1;
+-	JOB_BIGN_VERIFY: params, oid_der, oid_len, hash, sig, pubkey;
+-	JOB_BIGN_DH: params, privkey, pubkey, dest (выход), key_len;
+-	JOB_BELT_XXX_WRAP: src1, count1, src2, count2, key, key_len, iv,
+	dest (выход), mac (выход);
+-	JOB_BELT_XXX_UNWRAP: src1, count1, src2, count2, mac, key, key_len, iv,
+	dest (выход).
+
+Результат выполнения задания (код ошибки соответствующей функции)
+возвращается в поле code. О завершении задания можно узнать двумя
+способами:
+-	функция обратного вызова callback(job, arg) вызывается в потоке
+	исполнителя по завершении задания. После вызова обработчик к заданию
+	больше не обращается, и память задания можно освободить прямо
+	в callback;
+-	если callback == 0, то завершение задания можно проверить с помощью
+	функции jobIsDone() или дождаться с помощью функции jobWait().
+
+Задания из очереди обработчика забирают исполнители -- задачи пула,
+число которых не превышает числа потоков пула. Исполнитель забирает
+пакет заданий: первое (самое старое) задание и совместимые с ним
+задания, которые следуют за ним в очереди. Совместимые задания имеют
+один тип и одни долговременные параметры params. Задания пакета
+выполняются подряд в общей рабочей памяти исполнителя с помощью функций
+с суффиксом _ws. Рабочая память создается один раз на исполнителя
+и очищается после каждого пакета.
+
+Пакет формируется только из заданий, которые уже ожидают в очереди,
+поэтому обработка не задерживается ради накопления пакета: при низкой
+нагрузке пакеты состоят из одного задания, при высокой -- растут
+до заданного размера batch. Задержка выполнения задания ограничена
+временем обработки предшествующих заданий очереди.
+
+Пакетная обработка экономит выделение памяти, постановку в очередь
+и пробуждение потоков, но не арифметику: задания пакета выполняются
+независимо. Задания JOB_BIGN_SIGN ускоряются таблицей кратных базовой
+точки, если она подключена функцией bignPreAttach() для параметров
+задания.
+
+Обработчик не создает копий данных: указатели задания должны оставаться
+действительными до его завершения. Генератор rng может вызываться
+одновременно из нескольких исполнителей и поэтому должен допускать
+многопоточное использование (например, rngStepR()).
+
+\expect{ERR_BAD_INPUT} Все входные указатели корректны.
+*******************************************************************************
+*/
+
+/*! \brief Выработка ЭЦП bign */
+#define JOB_BIGN_SIGN			1
+/*! \brief Проверка ЭЦП bign */
+#define JOB_BIGN_VERIFY			2
+/*! \brief Построение общего ключа bign */
+#define JOB_BIGN_DH				3
+/*! \brief Установка защиты в режиме DWP */
+#define JOB_BELT_DWP_WRAP		4
+/*! \brief Снятие защиты в режиме DWP */
+#define JOB_BELT_DWP_UNWRAP		5
+/*! \brief Установка защиты в режиме CHE */
+#define JOB_BELT_CHE_WRAP		6
+/*! \brief Снятие защиты в режиме CHE */
+#define JOB_BELT_CHE_UNWRAP		7
+
+/*! \brief Размер пакета по умолчанию */
+#define JOB_BATCH_DEFAULT		16
+
+/*! \brief Задание */
+typedef struct job_st job_t;
+
+/*! \brief Описание задания
+
+	Поля, помеченные [in], заполняются вызывающей программой до передачи
+	задания в обработчик. Служебные поля заполняются обработчиком.
+*/
+struct job_st
+{
+	size_t type;				/*!< [in] тип задания (JOB_XXX) */
+	const bign_params* params;	/*!< [in] долговременные параметры bign */
+	const octet* oid_der;		/*!< [in] идентификатор хэш-алгоритма */
+	size_t oid_len;				/*!< [in] длина oid_der в октетах */
+	const octet* hash;			/*!< [in] хэш-значение */
+	octet* sig;					/*!< [in,out] подпись */
+	const octet* privkey;		/*!< [in] личный ключ bign */
+	const octet* pubkey;		/*!< [in] открытый ключ bign */
+	gen_i rng;					/*!< [in] генератор случайных чисел */
+	void* rng_state;			/*!< [in,out] состояние генератора */
+	const octet* key;			/*!< [in] ключ belt */
+	size_t key_len;				/*!< [in] длина ключа belt / общего ключа */
+	const octet* iv;			/*!< [in] синхропосылка belt */
+	const void* src1;			/*!< [in] критические данные */
+	size_t count1;				/*!< [in] число октетов src1 */
+	const void* src2;			/*!< [in] открытые данные */
+	size_t count2;				/*!< [in] число октетов src2 */
+	void* dest;					/*!< [out] результат */
+	octet* mac;					/*!< [in,out] имитовставка */
+	void (*callback)(job_t* job, void* arg);
+								/*!< [in] функция обратного вызова */
+	void* arg;					/*!< [in] аргумент callback */
+	err_t code;					/*!< [out] код завершения */
+	size_t done;				/*!< признак завершения (служебное) */
+	job_t* next;				/*!< следующее задание (служебное) */
+};
+
+/*! \brief Обработчик заданий */
+typedef struct job_engine_st job_engine_t;
+
+/*!	\brief Создание обработчика
+
+	Создается обработчик заданий с пулом из workers потоков
+	(см. mtPoolCreate()). Исполнители обработчика забирают из очереди
+	пакеты не более чем из batch заданий. Если workers == 0, то число
+	потоков совпадает с числом процессоров. Если batch == 0, то
+	используется размер пакета JOB_BATCH_DEFAULT.
+	\return Обработчик или 0 при нехватке памяти.
+	\remark Число потоков ограничивается величиной MT_POOL_MAX.
+	\remark Если создать потоки не удалось, то обработчик все равно
+	создается, но задания выполняются сразу при передаче в обработчик.
+*/
+job_engine_t* jobEngineCreate(
+	size_t workers,			/*!< [in] число исполнителей */
+	size_t batch			/*!< [in] размер пакета */
+);
+
+/*!	\brief Число потоков обработчика
+
+	Определяется число потоков пула обработчика engine.
+	\return Число потоков (0, если задания выполняются без потоков,
+	при передаче в обработчик).
+*/
+size_t jobEngineWorkers(
+	const job_engine_t* engine	/*!< [in] обработчик */
+);
+
+/*! \brief Статистика обработчика */
+typedef struct
+{
+	size_t jobs;			/*!< число заданий, взятых на выполнение */
+	size_t batches;			/*!< число пакетов, взятых на выполнение */
+} job_stat_t;
+
+/*!	\brief Статистика обработчика
+
+	Определяется статистика stat обработчика engine: число заданий,
+	взятых исполнителями на выполнение, и число пакетов, в которые эти
+	задания были сгруппированы.
+	\remark Отношение jobs / batches -- средний размер пакета.
+*/
+void jobEngineStat(
+	job_stat_t* stat,			/*!< [out] статистика */
+	job_engine_t* engine		/*!< [in] обработчик */
+);
+
+/*!	\brief Передача задания в обработчик
+
+	Задание job ставится в очередь обработчика engine.
+	\expect{ERR_BAD_PARAMS} Параметры bign корректны.
+	\return ERR_OK, если задание поставлено в очередь, и код ошибки
+	в противном случае. Ошибка выполнения задания возвращается
+	не здесь, а в поле job->code.
+	\remark Проверяются только тип задания и параметры bign. Остальные
+	поля проверяются при выполнении задания.
+	\post Если задание поставлено в очередь и job->callback == 0,
+	то должна быть вызвана функция jobWait(engine, job) или функция
+	jobIsDone(job) должна вернуть TRUE.
+*/
+err_t jobSubmit(
+	job_engine_t* engine,	/*!< [in,out] обработчик */
+	job_t* job				/*!< [in,out] задание */
+);
+
+/*!	\brief Задание завершено?
+
+	Проверяется, что задание job, переданное в обработчик без функции
+	обратного вызова, завершено.
+	\return Признак завершения.
+	\remark Функция не блокирует вызывающий поток.
+*/
+bool_t jobIsDone(
+	job_t* job				/*!< [in] задание */
+);
+
+/*!	\brief Ожидание завершения задания
+
+	Ожидается завершение задания job, переданного в обработчик engine
+	без функции обратного вызова.
+	\return Код завершения задания (job->code).
+*/
+err_t jobWait(
+	job_engine_t* engine,	/*!< [in,out] обработчик */
+	job_t* job				/*!< [in] задание */
+);
+
+/*!	\brief Закрытие обработчика
+
+	Обработчик engine закрывается: выполняются задания очереди,
+	закрывается пул потоков и освобождаются ресурсы.
+	\pre Новые задания в обработчик не передаются.
+*/
+void jobEngineClose(
+	job_engine_t* engine	/*!< [in] обработчик */
+);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __BEE2_JOB_H */
@@ -4,7 +4,7 @@
 \brief Basic definitions
 \project bee2 [cryptographic library]
 \created 2012.04.01
-\version 2024.01.24
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -554,4 +554,35 @@ typedef err_t (*write_i)(
 	void* file			/*!< [in,out] описание файла */
 );
 
+/*!
+*******************************************************************************
+\brief Фрагмент данных
+
+Структура iov_t описывает фрагмент данных [count]buf. Массив фрагментов
+описывает данные, размещенные в памяти несмежными частями (например, пакет,
+полученный из сети, в виде заголовка и нескольких фрагментов содержимого).
+Данные образуются конкатенацией фрагментов в порядке их следования.
+
+Массивы фрагментов обрабатываются функциями вида xxxStepYV(), где xxxStepY()
+-- функция обработки одного фрагмента. Вызов xxxStepYV(iov, iov_count, state)
+эквивалентен последовательности вызовов xxxStepY(iov[i].buf, iov[i].count,
+state), i = 0, 1,..., iov_count - 1.
+
+Функция xxxStepYV() обрабатывает фрагменты сама, без вызовов xxxStepY():
+неполный блок дополняется октетами следующих фрагментов, полные блоки
+обрабатываются непосредственно в памяти фрагментов. Функция xxxStepY()
+сводится к xxxStepYV() с одним фрагментом.
+
+\remark Структура iov_t повторяет (с точностью до имен полей) структуру
+iovec стандарта POSIX (sys/uio.h). На распространенных платформах массивы 
+iovec можно передавать в функции xxxStepYV() после приведения типа.
+*******************************************************************************
+*/
+
+typedef struct
+{
+	void* buf;			/*!< данные */
+	size_t count;		/*!< число октетов данных */
+} iov_t;
+
 #endif /* __BEE2_DEFS_H */
@@ -95,6 +95,9 @@ mkdir build
 cd build
 cmake [-DCMAKE_BUILD_TYPE={Release|Debug|Coverage|ASan|ASanDbg|MemSan|MemSanDbg|Check}]\
       [-DBUILD_FAST=ON]\
+      [-DBUILD_PROFILE_QR=ON]\
+      [-DBUILD_PERF=ON]\
+      [-DBUILD_USDT=ON]\
       [-DBASH_PLATFORM={BASH_32|BASH_64|BASH_AVX2|BASH_AVX512|BASH_NEON}] ..
 \endverbatim
 
@@ -110,6 +113,17 @@ cmake [-DCMAKE_BUILD_TYPE={Release|Debug|Coverage|ASan|ASanDbg|MemSan|MemSanDbg|
 Опция BUILD_FAST (по умолчанию отключена) переключает между безопасными 
 (constant-time) и быстрыми (non-constant-time) редакциями функций.
 
+Опция BUILD_PROFILE_QR (по умолчанию отключена) включает счетчики операций
+в кольцах вычетов (см. qr.h).
+
+Опция BUILD_PERF (по умолчанию отключена) включает счетчики
+производительности открытых функций библиотеки (см. perf.h).
+
+Опция BUILD_USDT (по умолчанию отключена) встраивает в функции библиотеки
+статические точки трассировки USDT (см. perf.h). Для сборки с этой опцией
+требуется заголовочный файл sys/sdt.h (пакет systemtap-sdt-dev
+или systemtap-sdt-devel).
+
 Сборка:
 
 \verbatim
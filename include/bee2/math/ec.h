@@ -4,7 +4,7 @@
 \brief Elliptic curves
 \project bee2 [cryptographic library]
 \created 2012.04.19
-\version 2023.03.30
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -620,6 +620,98 @@ bool_t ecAddMulA(
 
 size_t ecAddMulA_deep(size_t n, size_t ec_d, size_t ec_deep, size_t k,...);
 
+/*
+*******************************************************************************
+Кратные фиксированной точки
+
+Если кратные одной и той же аффинной точки a (как правило, базовой точки
+ec->base) вычисляются многократно, то их можно ускорить с помощью
+таблицы предвычислений. Таблица строится по ширине окна w и длине
+кратностей m (в машинных словах). Кратность разбивается на
+k = \lceil B_OF_W(m) / w\rceil окон по w битов. Таблица состоит из k строк,
+в i-й строке (i = 0, 1,..., k - 1) записываются аффинные точки
+	j 2^{w i} a, j = 1, 2,..., 2^w - 1.
+Точки записываются друг за другом, каждая точка занимает 2 * ec->f->n
+машинных слов. При вычислении кратной точки выполняется не более k
+сложений с точками таблицы и не выполняется ни одного удвоения.
+
+Таблица не содержит указателей и может размещаться в памяти, доступной
+только для чтения, например, отображенной в память из файла. Элементы
+поля записываются во внутреннем представлении ec->f, поэтому таблицу
+можно использовать только с тем же описанием кривой (и в той же сборке
+библиотеки), с которым она построена.
+*******************************************************************************
+*/
+
+/*!	\brief Длина таблицы кратных точки
+
+	Определяется длина (в октетах) таблицы кратных точки кривой
+	над полем, элементы которого задаются n машинными словами. Таблица
+	рассчитывается для ширины окна w и длины кратностей m.
+	\pre 1 <= w <= 8.
+	\return Длина таблицы.
+*/
+size_t ecPreA_keep(
+	size_t n,			/*!< [in] длина элемента поля в машинных словах */
+	size_t w,			/*!< [in] ширина окна */
+	size_t m			/*!< [in] длина кратностей в машинных словах */
+);
+
+/*!	\brief Таблица кратных точки
+
+	Для аффинной точки [2 * ec->f->n]a кривой ec строится таблица
+	[ecPreA_keep(ec->f->n, w, m)]pre кратных точки с шириной окна w
+	для кратностей длины m.
+	\pre Описание ec работоспособно.
+	\pre 1 <= w <= 8.
+	\pre Координаты a лежат в базовом поле.
+	\expect Описание ec корректно.
+	\expect Точка a лежит на ec.
+	\return TRUE, если таблица построена, и FALSE, если одна из кратных
+	точек оказалась бесконечно удаленной (порядок a слишком мал).
+	\remark При построении выполняется k (2^w - 1) обращений в поле.
+	\deep{stack} ecPreA_deep(ec->f->n, ec->d, ec->deep).
+*/
+bool_t ecPreA(
+	word pre[],			/*!< [out] таблица */
+	const word a[],		/*!< [in] точка */
+	const ec_o* ec,		/*!< [in] описание кривой */
+	size_t w,			/*!< [in] ширина окна */
+	size_t m,			/*!< [in] длина кратностей в машинных словах */
+	void* stack			/*!< [in] вспомогательная память */
+);
+
+size_t ecPreA_deep(size_t n, size_t ec_d, size_t ec_deep);
+
+/*!	\brief Кратная точка по таблице
+
+	Определяется аффинная точка [2 * ec->f->n]b эллиптической кривой ec,
+	которая является [m]d-кратной точки a, для которой построена таблица
+	pre с шириной окна w:
+	\code
+		b <- d a.
+	\endcode
+	\pre Описание ec работоспособно.
+	\pre Таблица pre построена функцией ecPreA() для кривой ec, ширины
+	окна w и длины кратностей m.
+	\return TRUE, если кратная точка является аффинной, и FALSE в противном
+	случае (b == O).
+	\remark Результат совпадает с результатом ecMulA(b, a, ec, d, m, stack).
+	\deep{stack} ecMulPreA_deep(ec->f->n, ec->d, ec->deep).
+	\remark Глубина стека ecMulPreA() не превышает глубины стека ecMulA().
+*/
+bool_t ecMulPreA(
+	word b[],			/*!< [out] кратная точка */
+	const word pre[],	/*!< [in] таблица */
+	size_t w,			/*!< [in] ширина окна */
+	const ec_o* ec,		/*!< [in] описание кривой */
+	const word d[],		/*!< [in] кратность */
+	size_t m,			/*!< [in] длина d в машинных словах */
+	void* stack			/*!< [in] вспомогательная память */
+);
+
+size_t ecMulPreA_deep(size_t n, size_t ec_d, size_t ec_deep);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -4,7 +4,7 @@
 \brief Binary fields
 \project bee2 [cryptographic library]
 \created 2012.04.17
-\version 2015.02.01
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -166,19 +166,19 @@ qr_sub_i, qr_neg_i идут прямые обращения к wwXor(), wwXor2()
 	(gf2Deg(f) % B_PER_W == 0 || wwCmp(a, (f)->mod, (f)->n) < 0)
 
 #define gf2Add(c, a, b, f)\
-	wwXor(c, a, b, (f)->n)
+	QR_PROF(f, QR_PROF_ADD, wwXor(c, a, b, (f)->n))
 
 #define gf2Add2(b, a, f)\
-	wwXor2(b, a, (f)->n)
+	QR_PROF(f, QR_PROF_ADD, wwXor2(b, a, (f)->n))
 
 #define gf2Sub(c, a, b, f)\
-	wwXor(c, a, b, (f)->n)
+	QR_PROF(f, QR_PROF_ADD, wwXor(c, a, b, (f)->n))
 
 #define gf2Sub2(b, a, f)\
-	wwXor2(b, a, (f)->n)
+	QR_PROF(f, QR_PROF_ADD, wwXor2(b, a, (f)->n))
 
 #define gf2Neg(b, a, f)\
-	wwCopy(b, a, (f)->n)
+	QR_PROF(f, QR_PROF_ADD, wwCopy(b, a, (f)->n))
 
 /*
 *******************************************************************************
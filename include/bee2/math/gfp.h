@@ -4,7 +4,7 @@
 \brief Prime fields
 \project bee2 [cryptographic library]
 \created 2012.07.11
-\version 2014.04.17
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -106,10 +106,10 @@ size_t gfpIsValid_deep(size_t n);
 */
 
 #define gfpDouble(b, a, f)\
-	zzDoubleMod(b, a, (f)->mod, (f)->n)
+	QR_PROF(f, QR_PROF_ADD, zzDoubleMod(b, a, (f)->mod, (f)->n))
 
 #define gfpHalf(b, a, f)\
-	zzHalfMod(b, a, (f)->mod, (f)->n)
+	QR_PROF(f, QR_PROF_ADD, zzHalfMod(b, a, (f)->mod, (f)->n))
 
 #ifdef __cplusplus
 } /* extern "C" */
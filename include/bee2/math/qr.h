@@ -4,7 +4,7 @@
 \brief Quotient rings
 \project bee2 [cryptographic library]
 \created 2013.08.09
-\version 2015.09.01
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -142,6 +142,35 @@ qr_sqr_i.
 результата либо не пересекается, либо совпадает с буферами входных элементов.
 
 \safe todo
+
+\section qr-prof Профилирование
+
+Если библиотека собрана с макросом BEE2_PROFILE_QR (опция BUILD_PROFILE_QR
+системы сборки), то псевдонимы qrAdd(), qrAddUnity(), qrSub(), qrSubUnity(),
+qrNeg(), qrMul(), qrSqr(), qrInv(), qrDiv() и акселераторы аддитивных
+операций (zmAdd(), gfpDouble(), gf2Add() и др.) ведут счет операций.
+Сложения, вычитания, аддитивные обращения, удвоения и деления пополам
+учитываются как сложения.
+
+Счетчики колец хранятся вне их описаний, в таблице, которая связывает
+адрес описания со счетчиками. Поэтому описание кольца (qr_o) не зависит
+от сборки. В таблице не более QR_PROF_RINGS колец. Кольцо попадает
+в таблицу при первой учтенной операции и удаляется из нее функцией
+qrProfReset(). Конструкторы колец сбрасывают счетчики по адресу нового
+описания. Если таблица заполнена, то место для нового кольца
+освобождается за счет кольца, попавшего в таблицу раньше других.
+
+Кроме этого, операции учитываются в общих счетчиках, которые относятся
+ко всем кольцам. Общие счетчики позволяют определить стоимость вызова
+высокоуровневой функции, которая строит описание кольца самостоятельно
+(например, bignSign()): перед вызовом счетчики сбрасываются, после
+вызова -- читаются.
+
+Счетчики не синхронизируются. Профилирование корректно, если кольца
+и общие счетчики используются одним потоком.
+
+Если макрос BEE2_PROFILE_QR не определен, то счет операций не ведется
+и счетчики остаются нулевыми.
 *******************************************************************************
 */
 
@@ -306,6 +335,16 @@ typedef void (*qr_div_i)(
 	void* stack				/*!< [in] вспомогательная память */
 );
 
+/*!	\brief Счетчики операций в кольце вычетов */
+typedef struct
+{
+	size_t add;			/*!< число сложений */
+	size_t mul;			/*!< число умножений */
+	size_t sqr;			/*!< число возведений в квадрат */
+	size_t inv;			/*!< число обращений */
+	size_t div;			/*!< число делений */
+} qr_prof_t;
+
 /*!	\brief Описание кольца вычетов
 
 	Описывается кольцо вычетов, правила представления его элементов и функции, 
@@ -339,9 +378,34 @@ typedef struct qr_o
 /*
 *******************************************************************************
 Псевдонимы
+
+При сборке с макросом BEE2_PROFILE_QR перед выполнением операции op
+в кольце r вызывается функция qrProfCount(r, op) (см. QR_PROF).
 *******************************************************************************
 */
 
+/*! \brief Сложение */
+#define QR_PROF_ADD		1
+/*! \brief Умножение */
+#define QR_PROF_MUL		2
+/*! \brief Возведение в квадрат */
+#define QR_PROF_SQR		3
+/*! \brief Обращение */
+#define QR_PROF_INV		4
+/*! \brief Деление */
+#define QR_PROF_DIV		5
+
+/*! \brief Максимальное число колец с собственными счетчиками */
+#define QR_PROF_RINGS	16
+
+#ifdef BEE2_PROFILE_QR
+	#define QR_PROF(r, op, expr)\
+		(qrProfCount(r, op), expr)
+#else
+	#define QR_PROF(r, op, expr)\
+		expr
+#endif
+
 #define qrIsZero(a, r)\
 	wwIsZero(a, (r)->n)
 
@@ -367,31 +431,31 @@ typedef struct qr_o
 	(r)->to(b, a, r, stack)
 
 #define qrAdd(c, a, b, r)\
-	(r)->add(c, a, b, r)
+	QR_PROF(r, QR_PROF_ADD, (r)->add(c, a, b, r))
 
 #define qrAddUnity(b, a, r)\
-	(r)->add(b, a, (r)->unity, r)
+	QR_PROF(r, QR_PROF_ADD, (r)->add(b, a, (r)->unity, r))
 
 #define qrSub(c, a, b, r)\
-	(r)->sub(c, a, b, r)
+	QR_PROF(r, QR_PROF_ADD, (r)->sub(c, a, b, r))
 
 #define qrSubUnity(a, r)\
-	(r)->sub(a, a, (r)->unity, r)
+	QR_PROF(r, QR_PROF_ADD, (r)->sub(a, a, (r)->unity, r))
 
 #define qrNeg(b, a, r)\
-	(r)->neg(b, a, r)
+	QR_PROF(r, QR_PROF_ADD, (r)->neg(b, a, r))
 
 #define qrMul(c, a, b, r, stack)\
-	(r)->mul(c, a, b, r, stack)
+	QR_PROF(r, QR_PROF_MUL, (r)->mul(c, a, b, r, stack))
 
 #define qrSqr(b, a, r, stack)\
-	(r)->sqr(b, a, r, stack)
+	QR_PROF(r, QR_PROF_SQR, (r)->sqr(b, a, r, stack))
 
 #define qrInv(b, a, r, stack)\
-	(r)->inv(b, a, r, stack)
+	QR_PROF(r, QR_PROF_INV, (r)->inv(b, a, r, stack))
 
 #define qrDiv(b, divident, a, r, stack)\
-	(r)->div(b, divident, a, r, stack)
+	QR_PROF(r, QR_PROF_DIV, (r)->div(b, divident, a, r, stack))
 
 /*
 *******************************************************************************
@@ -415,6 +479,45 @@ bool_t qrIsOperable(
 	const qr_o* r			/*!< [in] описание кольца */
 );
 
+/*
+*******************************************************************************
+Профилирование
+*******************************************************************************
+*/
+
+/*!	\brief Учет операции
+
+	Операция op (QR_PROF_XXX) учитывается в счетчиках кольца r
+	и в общих счетчиках.
+	\remark Функция вызывается из псевдонимов при сборке с макросом
+	BEE2_PROFILE_QR.
+	\remark Описание r не меняется: счетчики хранятся вне его.
+*/
+void qrProfCount(
+	const qr_o* r,			/*!< [in] описание кольца */
+	size_t op				/*!< [in] операция */
+);
+
+/*!	\brief Чтение счетчиков
+
+	В prof возвращаются счетчики операций в кольце r или, если r == 0,
+	общие счетчики.
+	\remark Без макроса BEE2_PROFILE_QR счетчики всегда нулевые.
+*/
+void qrProfGet(
+	qr_prof_t* prof,		/*!< [out] счетчики */
+	const qr_o* r			/*!< [in] описание кольца или 0 */
+);
+
+/*!	\brief Сброс счетчиков
+
+	Обнуляются счетчики операций в кольце r (кольцо удаляется
+	из таблицы счетчиков) или, если r == 0, общие счетчики.
+*/
+void qrProfReset(
+	const qr_o* r			/*!< [in] описание кольца или 0 */
+);
+
 /*
 *******************************************************************************
 Макрооперации в кольце
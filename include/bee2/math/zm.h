@@ -4,7 +4,7 @@
 \brief Quotient rings of integers modulo m
 \project bee2 [cryptographic library]
 \created 2013.09.14
-\version 2023.02.02
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -247,13 +247,13 @@ qr_sub_i, qr_neg_i идут прямые обращения к zzAddMod(), zzSub
 	(wwCmp(a, (r)->mod, (r)->n) < 0)
 
 #define zmAdd(c, a, b, r)\
-	zzAddMod(c, a, b, (r)->mod, (r)->n)
+	QR_PROF(r, QR_PROF_ADD, zzAddMod(c, a, b, (r)->mod, (r)->n))
 
 #define zmSub(c, a, b, r)\
-	zzSubMod(c, a, b, (r)->mod, (r)->n)
+	QR_PROF(r, QR_PROF_ADD, zzSubMod(c, a, b, (r)->mod, (r)->n))
 
 #define zmNeg(b, a, r)\
-	zzNegMod(b, a, (r)->mod, (r)->n)
+	QR_PROF(r, QR_PROF_ADD, zzNegMod(b, a, (r)->mod, (r)->n))
 
 #ifdef __cplusplus
 } /* extern "C" */
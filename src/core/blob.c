@@ -4,7 +4,7 @@
 \brief Blobs
 \project bee2 [cryptographic library]
 \created 2012.04.01
-\version 2023.03.23
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -12,18 +12,32 @@
 
 #include "bee2/core/blob.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/mt.h"
+#include "bee2/core/perf.h"
 #include "bee2/core/util.h"
 
+#if defined(OS_UNIX) && !defined(BLOB_NO_POOL)
+	#include <sys/mman.h>
+	#ifndef MAP_ANONYMOUS
+		#define MAP_ANONYMOUS MAP_ANON
+	#endif
+	#define BLOB_POOL
+#elif defined(OS_WIN) && !defined(BLOB_NO_POOL)
+	#include <windows.h>
+	#define BLOB_POOL
+#endif
+
 /*
 *******************************************************************************
 Блоб: реализация
 
-В куче выделяется память под указатель ptr. Память выделяется страницами.
-
-Первые sizeof(size_t) октетов по адресу ptr --- размер блоба,
-следующие октеты --- собственно блоб.
+Под блоб выделяется память по указателю ptr. Первые sizeof(size_t) октетов
+по адресу ptr --- размер блоба, следующие октеты --- собственно блоб.
 
-\todo Обеспечить защиту памяти блоба от утечек.
+Память выделяется страницами. Если требуется не более 2^{BLOB_CLASS_COUNT - 1}
+страниц, то число страниц округляется вверх до степени двойки
+(размерный класс) и память берется из пула (см. ниже). Иначе память
+выделяется в куче.
 
 \todo Полноценная проверка корректности блоба.
 *******************************************************************************
@@ -32,14 +46,16 @@
 // память для блобов выделяется страницами
 #define BLOB_PAGE_SIZE 1024
 
+// число размерных классов (блоки от 1 до 64 страниц)
+#define BLOB_CLASS_COUNT 7
+
+// максимальный размер блоба
+#define BLOB_SIZE_MAX (SIZE_MAX - sizeof(size_t) - BLOB_PAGE_SIZE)
+
 // требуется страниц
 #define blobPageCount(size)\
 	(((size) + sizeof(size_t) + BLOB_PAGE_SIZE - 1) / BLOB_PAGE_SIZE)
 
-// требуется памяти на страницах
-#define blobActualSize(size)\
-	(blobPageCount(size) * BLOB_PAGE_SIZE)
-
 // heap-указатель для блоба
 #define blobPtrOf(blob) ((size_t*)blob - 1)
 
@@ -52,16 +68,478 @@
 // блоб для heap-указателя
 #define blobValueOf(ptr) ((blob_t)((size_t*)ptr + 1))
 
+// размерный класс (BLOB_CLASS_COUNT, если класса нет)
+static size_t blobClassOf(size_t size)
+{
+	size_t pages = blobPageCount(size);
+	size_t c;
+	for (c = 0; c < BLOB_CLASS_COUNT && (SIZE_1 << c) < pages; ++c);
+	return c;
+}
+
+// требуется памяти на страницах
+static size_t blobActualSize(size_t size)
+{
+	size_t c = blobClassOf(size);
+	if (c < BLOB_CLASS_COUNT)
+		return BLOB_PAGE_SIZE << c;
+	return blobPageCount(size) * BLOB_PAGE_SIZE;
+}
+
+/*
+*******************************************************************************
+Счетчики
+
+Счетчики count, size, hits, misses меняются атомарно, счетчики pooled,
+locked -- под защитой мьютекса пула. Снимок статистики не атомарен.
+*******************************************************************************
+*/
+
+static blob_stat_t _stat[1];	/*< статистика */
+
+static void blobStatAdd(size_t* ctr, size_t delta)
+{
+	size_t t;
+	do
+		t = *ctr;
+	while (mtAtomicCmpSwap(ctr, t, t + delta) != t);
+}
+
+static void blobStatSub(size_t* ctr, size_t delta)
+{
+	size_t t;
+	do
+		t = *ctr;
+	while (mtAtomicCmpSwap(ctr, t, t - delta) != t);
+}
+
+/*
+*******************************************************************************
+Пул
+
+Блоки одного размерного класса нарезаются из слябов -- фрагментов
+памяти размера BLOB_SLAB_SIZE, которые запрашиваются у ОС по мере
+необходимости. При получении сляба делается попытка закрепить его
+в оперативной памяти (mlock(), VirtualLock()), чтобы содержимое блобов
+не попадало в файл подкачки. Неудачное закрепление не считается ошибкой,
+но отражается в статистике (поле locked). Во время работы слябы не
+возвращаются ОС, поэтому объем пула ограничен пиковым потреблением.
+
+Освобожденные блоки очищаются и попадают в кэш текущего потока. В кэше
+хранится не более BLOB_CACHE_MAX блоков каждого класса. Излишки, а также
+блоки потока, который завершает работу, переносятся в общие списки
+свободных блоков. Если кэш потока пуст, то из общего списка в него
+переносится сразу несколько блоков. Обращения к общим спискам защищены
+мьютексом.
+
+Кэш потока хранится в слоте TLS (pthread_key_t, FLS в Windows),
+деструктор слота возвращает блоки кэша в общие списки.
+
+При первом выделении блока из пула с помощью utilOnExit() регистрируется
+функция blobPoolClose(). При завершении процесса она возвращает блоки
+кэша текущего потока в общие списки, освобождает слот TLS и переводит
+пул в режим закрытия: кэши потоков больше не используются. Как только
+все блоки оказываются в общих списках (т.е. закрыты все блобы пула,
+в том числе те, которые закрываются после blobPoolClose()), слябы
+возвращаются ОС, мьютекс освобождается, а новые блобы выделяются
+в куче. Если какие-то блобы пула так и не закрыты, то слябы остаются
+за процессом до его завершения.
+
+После fork() в дочернем процессе работает только поток, вызвавший fork().
+Чтобы общие списки не остались заблокированными другим потоком, мьютекс
+захватывается перед fork() и освобождается после (pthread_atfork()).
+Блоки из кэшей других потоков родителя в дочернем процессе теряются,
+а закрепление слябов не наследуется (поле locked обнуляется). Потерянные
+блоки не позволяют вернуть слябы ОС при завершении дочернего процесса.
+
+Если пул не удалось инициализировать или платформа не поддерживается
+(или определен макрос BLOB_NO_POOL), то блоки выделяются в куче.
+*******************************************************************************
+*/
+
+#ifdef BLOB_POOL
+
+// размер сляба
+#define BLOB_SLAB_SIZE (256 * 1024)
+
+// максимальное число блоков класса в кэше потока
+#define BLOB_CACHE_MAX 8
+
+typedef struct
+{
+	void* head[BLOB_CLASS_COUNT];	/*< списки свободных блоков */
+	size_t count[BLOB_CLASS_COUNT];	/*< длины списков */
+} blob_cache_st;
+
+typedef struct blob_slab_st
+{
+	void* slab;						/*< сляб */
+	struct blob_slab_st* next;		/*< следующий сляб */
+} blob_slab_st;
+
+static size_t _once;			/*< триггер однократности */
+static bool_t _inited;			/*< пул инициализирован? */
+static bool_t _closing;			/*< пул закрывается? */
+static size_t _registered;		/*< blobPoolClose() зарегистрирована? */
+static mt_mtx_t _mtx[1];		/*< мьютекс общих списков */
+static blob_cache_st _pool[1];	/*< общие списки */
+static blob_slab_st* _slabs;	/*< список слябов */
+#ifdef OS_WIN
+static DWORD _key;				/*< слот кэша потока */
+#else
+static pthread_key_t _key;		/*< слот кэша потока */
+#endif
+
+// взять блок из списка
+#define blobListPop(list, c)\
+	((list)->count[c]--, (list)->head[c] = *(void**)((list)->head[c]))
+
+// добавить блок в список
+#define blobListPush(list, c, block)\
+	(*(void**)(block) = (list)->head[c], (list)->head[c] = (block),\
+		(list)->count[c]++)
+
+static void blobCacheFlush(blob_cache_st* cache, size_t keep)
+{
+	size_t c;
+	void* block;
+	mtMtxLock(_mtx);
+	for (c = 0; c < BLOB_CLASS_COUNT; ++c)
+		while (cache->count[c] > keep)
+		{
+			block = cache->head[c];
+			blobListPop(cache, c);
+			blobListPush(_pool, c, block);
+		}
+	mtMtxUnlock(_mtx);
+}
+
+static void blobCacheClose(void* cache)
+{
+	if (cache)
+	{
+		blobCacheFlush((blob_cache_st*)cache, 0);
+		memFree(cache);
+	}
+}
+
+#ifdef OS_WIN
+
+static VOID WINAPI blobCacheCloseWin(PVOID cache)
+{
+	blobCacheClose(cache);
+}
+
+static bool_t blobKeyCreate()
+{
+	_key = FlsAlloc(blobCacheCloseWin);
+	return _key != FLS_OUT_OF_INDEXES;
+}
+
+#define blobKeyGet() ((blob_cache_st*)FlsGetValue(_key))
+#define blobKeySet(cache) (FlsSetValue(_key, cache) != 0)
+#define blobKeyDelete() FlsFree(_key)
+
+static void* blobSlabAlloc()
+{
+	return VirtualAlloc(0, BLOB_SLAB_SIZE, MEM_COMMIT | MEM_RESERVE,
+		PAGE_READWRITE);
+}
+
+static void blobSlabFree(void* slab)
+{
+	VirtualFree(slab, 0, MEM_RELEASE);
+}
+
+static bool_t blobSlabLock(void* slab)
+{
+	return VirtualLock(slab, BLOB_SLAB_SIZE) != 0;
+}
+
+#else
+
+static bool_t blobKeyCreate()
+{
+	return pthread_key_create(&_key, blobCacheClose) == 0;
+}
+
+#define blobKeyGet() ((blob_cache_st*)pthread_getspecific(_key))
+#define blobKeySet(cache) (pthread_setspecific(_key, cache) == 0)
+#define blobKeyDelete() pthread_key_delete(_key)
+
+static void* blobSlabAlloc()
+{
+	void* slab = mmap(0, BLOB_SLAB_SIZE, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (slab == MAP_FAILED)
+		return 0;
+#ifdef MADV_DONTDUMP
+	madvise(slab, BLOB_SLAB_SIZE, MADV_DONTDUMP);
+#endif
+	return slab;
+}
+
+static void blobSlabFree(void* slab)
+{
+	munmap(slab, BLOB_SLAB_SIZE);
+}
+
+static bool_t blobSlabLock(void* slab)
+{
+	return mlock(slab, BLOB_SLAB_SIZE) == 0;
+}
+
+static void blobForkPrepare()
+{
+	if (_inited)
+		mtMtxLock(_mtx);
+}
+
+static void blobForkParent()
+{
+	if (_inited)
+		mtMtxUnlock(_mtx);
+}
+
+static void blobForkChild()
+{
+	if (_inited)
+	{
+		_stat->locked = 0;
+		mtMtxUnlock(_mtx);
+	}
+}
+
+#endif // OS_WIN
+
+static void blobPoolInit()
+{
+	ASSERT(!_inited);
+	if (!mtMtxCreate(_mtx))
+		return;
+	if (!blobKeyCreate())
+	{
+		mtMtxClose(_mtx);
+		return;
+	}
+#ifndef OS_WIN
+	if (pthread_atfork(blobForkPrepare, blobForkParent, blobForkChild) != 0)
+	{
+		blobKeyDelete();
+		mtMtxClose(_mtx);
+		return;
+	}
+#endif
+	_inited = TRUE;
+}
+
+static bool_t blobPoolIsReady()
+{
+	return mtCallOnce(&_once, blobPoolInit) && _inited;
+}
+
+static blob_cache_st* blobCacheGet(bool_t create)
+{
+	blob_cache_st* cache;
+	if (_closing)
+		return 0;
+	cache = blobKeyGet();
+	if (!cache && create)
+	{
+		cache = (blob_cache_st*)memAlloc(sizeof(blob_cache_st));
+		if (!cache)
+			return 0;
+		memSetZero(cache, sizeof(blob_cache_st));
+		if (!blobKeySet(cache))
+		{
+			memFree(cache);
+			return 0;
+		}
+	}
+	return cache;
+}
+
+// нарезать новый сляб на блоки класса c (мьютекс заблокирован)
+static bool_t blobSlabCarve(size_t c)
+{
+	const size_t block_size = BLOB_PAGE_SIZE << c;
+	octet* slab;
+	size_t pos;
+	blob_slab_st* node;
+	ASSERT(c < BLOB_CLASS_COUNT);
+	ASSERT(BLOB_SLAB_SIZE % block_size == 0);
+	if (!(node = (blob_slab_st*)memAlloc(sizeof(blob_slab_st))))
+		return FALSE;
+	if (!(slab = (octet*)blobSlabAlloc()))
+	{
+		memFree(node);
+		return FALSE;
+	}
+	node->slab = slab, node->next = _slabs, _slabs = node;
+	_stat->pooled += BLOB_SLAB_SIZE;
+	if (blobSlabLock(slab))
+		_stat->locked += BLOB_SLAB_SIZE;
+	for (pos = BLOB_SLAB_SIZE; pos; )
+	{
+		pos -= block_size;
+		blobListPush(_pool, c, slab + pos);
+	}
+	return TRUE;
+}
+
+// все блоки в общих списках? (мьютекс заблокирован)
+static bool_t blobPoolIsFree()
+{
+	size_t free = 0;
+	size_t c;
+	for (c = 0; c < BLOB_CLASS_COUNT; ++c)
+		free += _pool->count[c] * (BLOB_PAGE_SIZE << c);
+	return free == _stat->pooled;
+}
+
+// вернуть слябы ОС и закрыть пул (мьютекс заблокирован, блоки свободны)
+static void blobPoolRelease()
+{
+	blob_slab_st* node;
+	ASSERT(_closing && blobPoolIsFree());
+	while ((node = _slabs) != 0)
+	{
+		_slabs = node->next;
+		blobSlabFree(node->slab);
+		memFree(node);
+	}
+	memSetZero(_pool, sizeof(blob_cache_st));
+	_stat->pooled = _stat->locked = 0;
+	_inited = FALSE;
+	mtMtxUnlock(_mtx);
+	mtMtxClose(_mtx);
+}
+
+static void blobPoolClose()
+{
+	blob_cache_st* cache;
+	ASSERT(_inited && !_closing);
+	// вернуть блоки кэша текущего потока (слот TLS будет освобожден)
+	if ((cache = blobKeyGet()) != 0)
+		blobCacheClose(cache);
+	// перейти в режим закрытия
+	mtMtxLock(_mtx);
+	_closing = TRUE;
+	mtMtxUnlock(_mtx);
+	blobKeyDelete();
+	// закрыть пул, если все блоки свободны
+	mtMtxLock(_mtx);
+	if (blobPoolIsFree())
+		blobPoolRelease();
+	else
+		mtMtxUnlock(_mtx);
+}
+
+static void* blobPoolAlloc(size_t c)
+{
+	blob_cache_st* cache;
+	void* block;
+	bool_t hit;
+	// зарегистрировать закрытие пула
+	if (mtAtomicCmpSwap(&_registered, 0, 1) == 0)
+		utilOnExit(blobPoolClose);
+	cache = blobCacheGet(TRUE);
+	// взять блок из кэша потока
+	if (cache && cache->count[c])
+	{
+		block = cache->head[c];
+		blobListPop(cache, c);
+		mtAtomicIncr(&_stat->hits);
+		return block;
+	}
+	// взять блок из общего списка и пополнить кэш
+	mtMtxLock(_mtx);
+	hit = _pool->count[c] != 0;
+	if (!hit && !blobSlabCarve(c))
+	{
+		mtMtxUnlock(_mtx);
+		return 0;
+	}
+	block = _pool->head[c];
+	blobListPop(_pool, c);
+	while (cache && cache->count[c] < BLOB_CACHE_MAX / 2 && _pool->count[c])
+	{
+		void* t = _pool->head[c];
+		blobListPop(_pool, c);
+		blobListPush(cache, c, t);
+	}
+	mtMtxUnlock(_mtx);
+	mtAtomicIncr(hit ? &_stat->hits : &_stat->misses);
+	return block;
+}
+
+static void blobPoolFree(void* block, size_t c)
+{
+	blob_cache_st* cache = blobCacheGet(FALSE);
+	// вернуть блок в кэш потока
+	if (cache && cache->count[c] < BLOB_CACHE_MAX)
+	{
+		blobListPush(cache, c, block);
+		return;
+	}
+	// вернуть блок и излишки кэша в общий список
+	mtMtxLock(_mtx);
+	blobListPush(_pool, c, block);
+	while (cache && cache->count[c] > BLOB_CACHE_MAX / 2)
+	{
+		void* t = cache->head[c];
+		blobListPop(cache, c);
+		blobListPush(_pool, c, t);
+	}
+	// последний блок закрывающегося пула?
+	if (_closing && blobPoolIsFree())
+		blobPoolRelease();
+	else
+		mtMtxUnlock(_mtx);
+}
+
+#else
+
+#define blobPoolIsReady() FALSE
+#define blobPoolAlloc(c) ((void*)0)
+#define blobPoolFree(block, c)
+
+#endif // BLOB_POOL
+
+// блоб размера size размещается в пуле?
+#define blobIsPooled(size)\
+	(blobClassOf(size) < BLOB_CLASS_COUNT && blobPoolIsReady())
+
+/*
+*******************************************************************************
+Управление блобами
+*******************************************************************************
+*/
+
 blob_t blobCreate(size_t size)
 {
 	size_t* ptr;
-	if (size == 0)
-		return 0;
-	ptr = (size_t*)memAlloc(blobActualSize(size));
+	PERF_PROBE1(blob_create_entry, size);
+	if (size == 0 || size > BLOB_SIZE_MAX)
+		ptr = 0;
+	else if (blobIsPooled(size))
+		ptr = (size_t*)blobPoolAlloc(blobClassOf(size));
+	else
+	{
+		ptr = (size_t*)memAlloc(blobActualSize(size));
+		if (ptr)
+			mtAtomicIncr(&_stat->misses);
+	}
 	if (ptr == 0)
+	{
+		PERF_PROBE1(blob_create_return, 0);
 		return 0;
+	}
 	*ptr = size;
 	memSetZero(blobValueOf(ptr), size);
+	mtAtomicIncr(&_stat->count);
+	blobStatAdd(&_stat->size, size);
+	PERF_PROBE1(blob_create_return, blobValueOf(ptr));
 	return blobValueOf(ptr);
 }
 
@@ -79,11 +557,23 @@ void blobWipe(blob_t blob)
 
 void blobClose(blob_t blob)
 {
+	size_t size;
 	ASSERT(blobIsValid(blob));
 	if (blob)
 	{
-		memWipe(blobPtrOf(blob), blobActualSizeOf(blob));
-		memFree(blobPtrOf(blob));
+		size = blobSizeOf(blob);
+		mtAtomicDecr(&_stat->count);
+		blobStatSub(&_stat->size, size);
+		if (blobIsPooled(size))
+		{
+			memWipe(blobPtrOf(blob), sizeof(size_t) + size);
+			blobPoolFree(blobPtrOf(blob), blobClassOf(size));
+		}
+		else
+		{
+			memWipe(blobPtrOf(blob), blobActualSize(size));
+			memFree(blobPtrOf(blob));
+		}
 	}
 }
 
@@ -91,6 +581,7 @@ blob_t blobResize(blob_t blob, size_t size)
 {
 	size_t old_size;
 	size_t* ptr;
+	blob_t dest;
 	// pre
 	ASSERT(blobIsValid(blob));
 	// создать блоб
@@ -102,21 +593,45 @@ blob_t blobResize(blob_t blob, size_t size)
 		blobClose(blob);
 		return 0;
 	}
+	if (size > BLOB_SIZE_MAX)
+		return 0;
 	// сохранить размер
 	old_size = blobSizeOf(blob);
-	// перераспределить память?
 	ptr = blobPtrOf(blob);
-	if (blobActualSizeOf(blob) != blobActualSize(size))
+	// перераспределить память?
+	if (blobActualSize(old_size) != blobActualSize(size))
 	{
-		ptr = (size_t*)memRealloc(ptr, blobActualSize(size));
-		if (ptr == 0)
-			return 0;
+		// блобы в куче: перераспределить
+		if (!blobIsPooled(old_size) && !blobIsPooled(size))
+		{
+			ptr = (size_t*)memRealloc(ptr, blobActualSize(size));
+			if (ptr == 0)
+				return 0;
+		}
+		// иначе: создать новый блоб и перенести данные
+		else
+		{
+			dest = blobCreate(size);
+			if (dest == 0)
+				return 0;
+			memCopy(dest, blob, MIN2(old_size, size));
+			blobClose(blob);
+			return dest;
+		}
 	}
 	// настроить и возвратить блоб
 	*ptr = size;
 	blob = blobValueOf(ptr);
 	if (size > old_size)
+	{
 		memSetZero((octet*)blob + old_size, size - old_size);
+		blobStatAdd(&_stat->size, size - old_size);
+	}
+	else if (size < old_size)
+	{
+		memWipe((octet*)blob + size, old_size - size);
+		blobStatSub(&_stat->size, old_size - size);
+	}
 	return blob;
 }
 
@@ -153,3 +668,24 @@ int blobCmp(const blob_t blob1, const blob_t blob2)
 		return blobSize(blob1) < blobSize(blob2) ? - 1 : 1;
 	return memCmp(blob1, blob2, blobSize(blob1));
 }
+
+/*
+*******************************************************************************
+Статистика
+*******************************************************************************
+*/
+
+void blobStat(blob_stat_t* stat)
+{
+	ASSERT(memIsValid(stat, sizeof(blob_stat_t)));
+#ifdef BLOB_POOL
+	if (blobPoolIsReady())
+	{
+		mtMtxLock(_mtx);
+		memCopy(stat, _stat, sizeof(blob_stat_t));
+		mtMtxUnlock(_mtx);
+		return;
+	}
+#endif
+	memCopy(stat, _stat, sizeof(blob_stat_t));
+}
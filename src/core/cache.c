@@ -0,0 +1,256 @@
+/*
+*******************************************************************************
+\file cache.c
+\brief Caches of digests
+\project bee2 [cryptographic library]
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "bee2/core/blob.h"
+#include "bee2/core/cache.h"
+#include "bee2/core/err.h"
+#include "bee2/core/mem.h"
+#include "bee2/core/mt.h"
+#include "bee2/core/util.h"
+
+/*
+*******************************************************************************
+Список кэшей
+
+Кэши, для которых создан мьютекс, объединяются в список _caches. Список
+защищается мьютексом _mtx, который создается однократно (с помощью
+mtCallOnce()). При завершении работы (с помощью utilOnExit()) кэши
+списка выключаются, их мьютексы закрываются.
+
+Признак создания мьютекса кэша (поле state) устанавливается и читается
+атомарно: мьютекс создается до того, как признак станет виден другим
+потокам.
+*******************************************************************************
+*/
+
+static size_t _once;			/*< триггер однократности */
+static mt_mtx_t _mtx[1];		/*< мьютекс списка */
+static bool_t _inited;			/*< мьютекс списка создан? */
+static cache_t* _caches;		/*< список кэшей */
+
+static bool_t cacheIsReady(cache_t* cache)
+{
+	return mtAtomicCmpSwap(&cache->state, 0, 0) != 0;
+}
+
+static void cacheDestroy()
+{
+	cache_t* cache;
+	mtMtxLock(_mtx);
+	for (cache = _caches; cache; cache = cache->link)
+	{
+		cacheStop(cache);
+		mtAtomicCmpSwap(&cache->state, 1, 0);
+		mtMtxClose(cache->mtx);
+	}
+	_caches = 0;
+	mtMtxUnlock(_mtx);
+	mtMtxClose(_mtx);
+	_inited = FALSE;
+}
+
+static void cacheInit()
+{
+	ASSERT(!_inited);
+	if (!mtMtxCreate(_mtx))
+		return;
+	if (!utilOnExit(cacheDestroy))
+	{
+		mtMtxClose(_mtx);
+		return;
+	}
+	_inited = TRUE;
+}
+
+/*
+*******************************************************************************
+Хэш-таблица
+
+Позиция таблицы содержит номер элемента, увеличенный на 1, или 0, если
+позиция пуста. Функция cacheLookup() возвращает позицию, в которой
+находится хэш-значение, или первую пустую позицию на пути его поиска.
+
+При удалении элемента применяется обратный сдвиг: элементы, которые
+следуют за освободившейся позицией и не могут быть найдены после ее
+освобождения, переносятся в нее. Отметки удаленных позиций не нужны,
+длины цепочек пробирования не растут.
+*******************************************************************************
+*/
+
+static size_t cacheHome(const cache_t* cache, const octet digest[32])
+{
+	size_t w;
+	memCopy(&w, digest, O_PER_S);
+	return w & cache->mask;
+}
+
+static size_t cacheLookup(const cache_t* cache, const octet digest[32])
+{
+	size_t pos = cacheHome(cache, digest);
+	for (; cache->table[pos]; pos = (pos + 1) & cache->mask)
+		if (memEq(cache->digests + 32 * (cache->table[pos] - 1), digest, 32))
+			break;
+	return pos;
+}
+
+static void cacheRemove(cache_t* cache, size_t pos)
+{
+	size_t next = pos;
+	size_t home;
+	ASSERT(cache->table[pos]);
+	cache->table[pos] = 0;
+	while (cache->table[next = (next + 1) & cache->mask])
+	{
+		home = cacheHome(cache,
+			cache->digests + 32 * (cache->table[next] - 1));
+		// home вне циклического интервала (pos, next]?
+		if (((next - home) & cache->mask) >= ((next - pos) & cache->mask))
+		{
+			cache->table[pos] = cache->table[next];
+			cache->table[next] = 0;
+			pos = next;
+		}
+	}
+}
+
+/*
+*******************************************************************************
+Управление кэшем
+*******************************************************************************
+*/
+
+err_t cacheStart(cache_t* cache, size_t capacity)
+{
+	octet* digests;
+	size_t mask;
+	ASSERT(memIsValid(cache, sizeof(cache_t)));
+	// входной контроль
+	if (capacity == 0 || capacity > CACHE_MAX)
+		return ERR_BAD_INPUT;
+	// создать мьютекс кэша
+	if (!mtCallOnce(&_once, cacheInit) || !_inited)
+		return ERR_SYS;
+	mtMtxLock(_mtx);
+	if (!cacheIsReady(cache))
+	{
+		if (!mtMtxCreate(cache->mtx))
+		{
+			mtMtxUnlock(_mtx);
+			return ERR_SYS;
+		}
+		cache->link = _caches, _caches = cache;
+		mtAtomicCmpSwap(&cache->state, 0, 1);
+	}
+	mtMtxUnlock(_mtx);
+	// создать элементы и таблицу
+	for (mask = 1; mask < 2 * capacity; mask <<= 1);
+	digests = (octet*)blobCreate(32 * capacity + 4 * mask);
+	if (!digests)
+		return ERR_OUTOFMEMORY;
+	mtMtxLock(cache->mtx);
+	blobClose(cache->digests);
+	cache->digests = digests, cache->capacity = capacity;
+	cache->table = (u32*)(digests + 32 * capacity), cache->mask = mask - 1;
+	cache->count = cache->next = cache->hits = cache->misses = 0;
+	mtMtxUnlock(cache->mtx);
+	return ERR_OK;
+}
+
+bool_t cacheIsOn(cache_t* cache)
+{
+	bool_t on;
+	ASSERT(memIsValid(cache, sizeof(cache_t)));
+	if (!cacheIsReady(cache))
+		return FALSE;
+	mtMtxLock(cache->mtx);
+	on = cache->capacity != 0;
+	mtMtxUnlock(cache->mtx);
+	return on;
+}
+
+bool_t cacheFind(cache_t* cache, const octet digest[32])
+{
+	bool_t found = FALSE;
+	ASSERT(memIsValid(cache, sizeof(cache_t)));
+	ASSERT(memIsValid(digest, 32));
+	if (!cacheIsReady(cache))
+		return FALSE;
+	mtMtxLock(cache->mtx);
+	if (cache->capacity)
+	{
+		if (found = cache->table[cacheLookup(cache, digest)] != 0)
+			++cache->hits;
+		else
+			++cache->misses;
+	}
+	mtMtxUnlock(cache->mtx);
+	return found;
+}
+
+void cacheAdd(cache_t* cache, const octet digest[32])
+{
+	size_t pos;
+	ASSERT(memIsValid(cache, sizeof(cache_t)));
+	ASSERT(memIsValid(digest, 32));
+	if (!cacheIsReady(cache))
+		return;
+	mtMtxLock(cache->mtx);
+	if (cache->capacity && !cache->table[pos = cacheLookup(cache, digest)])
+	{
+		// вытеснить самый старый элемент
+		if (cache->count == cache->capacity)
+		{
+			cacheRemove(cache, cacheLookup(cache,
+				cache->digests + 32 * cache->next));
+			pos = cacheLookup(cache, digest);
+		}
+		else
+			++cache->count;
+		// добавить элемент
+		memCopy(cache->digests + 32 * cache->next, digest, 32);
+		cache->table[pos] = (u32)(cache->next + 1);
+		cache->next = (cache->next + 1) % cache->capacity;
+	}
+	mtMtxUnlock(cache->mtx);
+}
+
+void cacheStat(cache_t* cache, size_t* hits, size_t* misses)
+{
+	ASSERT(memIsValid(cache, sizeof(cache_t)));
+	ASSERT(memIsNullOrValid(hits, O_PER_S));
+	ASSERT(memIsNullOrValid(misses, O_PER_S));
+	if (hits)
+		*hits = 0;
+	if (misses)
+		*misses = 0;
+	if (!cacheIsReady(cache))
+		return;
+	mtMtxLock(cache->mtx);
+	if (hits)
+		*hits = cache->hits;
+	if (misses)
+		*misses = cache->misses;
+	mtMtxUnlock(cache->mtx);
+}
+
+void cacheStop(cache_t* cache)
+{
+	ASSERT(memIsValid(cache, sizeof(cache_t)));
+	if (!cacheIsReady(cache))
+		return;
+	mtMtxLock(cache->mtx);
+	blobClose(cache->digests);
+	cache->digests = 0, cache->table = 0;
+	cache->mask = cache->capacity = 0;
+	cache->count = cache->next = cache->hits = cache->misses = 0;
+	mtMtxUnlock(cache->mtx);
+}
@@ -4,7 +4,7 @@
 \brief Multithreading
 \project bee2 [cryptographic library]
 \created 2014.10.10
-\version 2023.04.13
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -113,6 +113,98 @@ void mtMtxClose(mt_mtx_t* mtx)
 
 #endif // OS
 
+/*
+*******************************************************************************
+Условные переменные
+*******************************************************************************
+*/
+
+#ifdef OS_WIN
+
+bool_t mtCondCreate(mt_cond_t* cv)
+{
+	ASSERT(memIsValid(cv, sizeof(mt_cond_t)));
+	InitializeConditionVariable(cv);
+	return TRUE;
+}
+
+void mtCondWait(mt_cond_t* cv, mt_mtx_t* mtx)
+{
+	ASSERT(mtMtxIsValid(mtx));
+	SleepConditionVariableCS(cv, mtx, INFINITE);
+}
+
+void mtCondSignal(mt_cond_t* cv)
+{
+	WakeConditionVariable(cv);
+}
+
+void mtCondBroadcast(mt_cond_t* cv)
+{
+	WakeAllConditionVariable(cv);
+}
+
+void mtCondClose(mt_cond_t* cv)
+{
+	ASSERT(memIsValid(cv, sizeof(mt_cond_t)));
+}
+
+#elif defined OS_UNIX
+
+bool_t mtCondCreate(mt_cond_t* cv)
+{
+	ASSERT(memIsValid(cv, sizeof(mt_cond_t)));
+	return pthread_cond_init(cv, 0) == 0;
+}
+
+void mtCondWait(mt_cond_t* cv, mt_mtx_t* mtx)
+{
+	ASSERT(mtMtxIsValid(mtx));
+	pthread_cond_wait(cv, mtx);
+}
+
+void mtCondSignal(mt_cond_t* cv)
+{
+	pthread_cond_signal(cv);
+}
+
+void mtCondBroadcast(mt_cond_t* cv)
+{
+	pthread_cond_broadcast(cv);
+}
+
+void mtCondClose(mt_cond_t* cv)
+{
+	pthread_cond_destroy(cv);
+}
+
+#else
+
+bool_t mtCondCreate(mt_cond_t* cv)
+{
+	ASSERT(memIsValid(cv, sizeof(mt_cond_t)));
+	return TRUE;
+}
+
+void mtCondWait(mt_cond_t* cv, mt_mtx_t* mtx)
+{
+	ASSERT(mtMtxIsValid(mtx));
+}
+
+void mtCondSignal(mt_cond_t* cv)
+{
+}
+
+void mtCondBroadcast(mt_cond_t* cv)
+{
+}
+
+void mtCondClose(mt_cond_t* cv)
+{
+}
+
+#endif // OS
+
 /*
 *******************************************************************************
 Потоки
@@ -121,9 +213,19 @@ void mtMtxClose(mt_mtx_t* mtx)
 функции CRYPTO_THREAD_run_once() из OpenSSL 1.1.1. Другие варианты реализации
 могут быть основаны на функциях InitOnceExecuteOnce() (WinAPI) и pthread_once()
 (<pthread.h>).
+
+Функция потока, переданная в mtThrdCreate(), вызывается через обертку
+mtThrdMain(), которая согласует сигнатуру с сигнатурой функции потока
+конкретной ОС. Функция и ее аргумент передаются обертке через кучу.
 *******************************************************************************
 */
 
+typedef struct
+{
+	void (*fn)(void*);	/*< функция потока */
+	void* arg;			/*< аргумент функции */
+} mt_thrd_st;
+
 #ifdef OS_WIN
 
 void mtSleep(u32 ms)
@@ -131,6 +233,37 @@ void mtSleep(u32 ms)
 	Sleep(ms);
 }
 
+static DWORD WINAPI mtThrdMain(LPVOID arg)
+{
+	mt_thrd_st st = *(mt_thrd_st*)arg;
+	memFree(arg);
+	st.fn(st.arg);
+	return 0;
+}
+
+bool_t mtThrdCreate(mt_thrd_t* thrd, void (*fn)(void*), void* arg)
+{
+	mt_thrd_st* st;
+	ASSERT(memIsValid(thrd, sizeof(mt_thrd_t)));
+	if (!(st = (mt_thrd_st*)memAlloc(sizeof(mt_thrd_st))))
+		return FALSE;
+	st->fn = fn, st->arg = arg;
+	*thrd = CreateThread(0, 0, mtThrdMain, st, 0, 0);
+	if (!*thrd)
+	{
+		memFree(st);
+		return FALSE;
+	}
+	return TRUE;
+}
+
+void mtThrdJoin(mt_thrd_t* thrd)
+{
+	ASSERT(memIsValid(thrd, sizeof(mt_thrd_t)));
+	WaitForSingleObject(*thrd, INFINITE);
+	CloseHandle(*thrd);
+}
+
 #elif defined OS_UNIX
 
 #include <time.h>
@@ -144,12 +277,52 @@ void mtSleep(u32 ms)
 	nanosleep(&ts, 0);
 }
 
+static void* mtThrdMain(void* arg)
+{
+	mt_thrd_st st = *(mt_thrd_st*)arg;
+	memFree(arg);
+	st.fn(st.arg);
+	return 0;
+}
+
+bool_t mtThrdCreate(mt_thrd_t* thrd, void (*fn)(void*), void* arg)
+{
+	mt_thrd_st* st;
+	ASSERT(memIsValid(thrd, sizeof(mt_thrd_t)));
+	if (!(st = (mt_thrd_st*)memAlloc(sizeof(mt_thrd_st))))
+		return FALSE;
+	st->fn = fn, st->arg = arg;
+	if (pthread_create(thrd, 0, mtThrdMain, st) != 0)
+	{
+		memFree(st);
+		return FALSE;
+	}
+	return TRUE;
+}
+
+void mtThrdJoin(mt_thrd_t* thrd)
+{
+	ASSERT(memIsValid(thrd, sizeof(mt_thrd_t)));
+	pthread_join(*thrd, 0);
+}
+
 #else
 
 void mtSleep(u32 ms)
 {
 }
 
+bool_t mtThrdCreate(mt_thrd_t* thrd, void (*fn)(void*), void* arg)
+{
+	ASSERT(memIsValid(thrd, sizeof(mt_thrd_t)));
+	return FALSE;
+}
+
+void mtThrdJoin(mt_thrd_t* thrd)
+{
+	ASSERT(memIsValid(thrd, sizeof(mt_thrd_t)));
+}
+
 #endif // OS
 
 bool_t mtCallOnce(size_t* once, void (*fn)())
@@ -160,8 +333,9 @@ bool_t mtCallOnce(size_t* once, void (*fn)())
 		// удается захватить триггер?...
 		if ((t = mtAtomicCmpSwap(once, 0, SIZE_MAX)) == 0)
 		{
-			// ... да, обработать захват
-			fn(), *once = 1;
+			// ... да, обработать захват (атомарно, чтобы результаты fn()
+			// стали видны до того, как будет прочитан триггер)
+			fn(), mtAtomicCmpSwap(once, SIZE_MAX, 1);
 			break;
 		}
 	// ... нет, ожидаем обработки захвата в другом потоке
@@ -309,3 +483,356 @@ size_t mtAtomicCmpSwap(size_t* ctr, size_t cmp, size_t swap)
 }
 
 #endif // OS
+
+/*
+*******************************************************************************
+Число процессоров
+*******************************************************************************
+*/
+
+#ifdef OS_WIN
+
+size_t mtCPUCount()
+{
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors ? (size_t)info.dwNumberOfProcessors : 1;
+}
+
+#elif defined OS_UNIX
+
+#include <unistd.h>
+
+size_t mtCPUCount()
+{
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (size_t)count : 1;
+}
+
+#else
+
+size_t mtCPUCount()
+{
+	return 1;
+}
+
+#endif // OS
+
+/*
+*******************************************************************************
+Пул потоков
+
+Дек исполнителя -- кольцевой буфер указателей на задачи, защищенный
+мьютексом. Задачи добавляются в конец tail, исполнитель-владелец берет
+задачи с конца tail, другие потоки крадут задачи с начала head. Индексы
+head и tail монотонно возрастают, позиция в буфере -- индекс по модулю
+емкости cap. При заполнении буфер удваивается.
+
+Счетчик queued -- число задач в деках. Счетчик увеличивается до
+добавления задачи в дек и уменьшается после изъятия задачи. Поэтому
+при queued == 0 деки пусты.
+
+Потоки, которым нечего делать, засыпают на условной переменной cv,
+увеличив предварительно счетчик sleepers. После добавления задачи
+или завершения задачи проверяется sleepers и, если есть спящие потоки,
+то они пробуждаются. Все изменения счетчиков выполняются атомарными операциями
+с полным барьером памяти, поэтому пробуждение не теряется: либо
+спящий поток увидит новое значение queued (done) до засыпания, либо
+будящий поток увидит ненулевой sleepers.
+*******************************************************************************
+*/
+
+typedef struct
+{
+	mt_mtx_t mtx[1];		/*< мьютекс */
+	mt_task_t** buf;		/*< кольцевой буфер */
+	size_t cap;				/*< емкость буфера */
+	size_t head;			/*< начало (кража) */
+	size_t tail;			/*< конец (добавление и изъятие владельцем) */
+} mt_deque_st;
+
+typedef struct
+{
+	mt_pool_t* pool;		/*< пул */
+	size_t index;			/*< номер исполнителя */
+} mt_worker_st;
+
+struct mt_pool_st
+{
+	size_t workers;							/*< число исполнителей */
+	size_t next;							/*< счетчик распределения */
+	size_t queued;							/*< число задач в деках */
+	size_t sleepers;						/*< число спящих потоков */
+	bool_t stop;							/*< признак остановки */
+	mt_mtx_t mtx[1];						/*< мьютекс для cv и stop */
+	mt_cond_t cv[1];						/*< условная переменная */
+	mt_deque_st deques[MT_POOL_MAX];		/*< деки исполнителей */
+	mt_worker_st args[MT_POOL_MAX];			/*< аргументы исполнителей */
+	mt_thrd_t thrds[MT_POOL_MAX];			/*< исполнители */
+};
+
+#define mtAtomicLoad(ctr) mtAtomicCmpSwap(ctr, 0, 0)
+
+static bool_t mtDequePush(mt_deque_st* dq, mt_task_t* task)
+{
+	mtMtxLock(dq->mtx);
+	// расширить буфер
+	if (dq->tail - dq->head == dq->cap)
+	{
+		size_t cap = dq->cap ? 2 * dq->cap : 16;
+		size_t i;
+		mt_task_t** buf = (mt_task_t**)memAlloc(cap * sizeof(mt_task_t*));
+		if (!buf)
+		{
+			mtMtxUnlock(dq->mtx);
+			return FALSE;
+		}
+		for (i = 0; i < dq->cap; ++i)
+			buf[i] = dq->buf[(dq->head + i) % dq->cap];
+		memFree(dq->buf);
+		dq->buf = buf, dq->head = 0, dq->tail = dq->cap, dq->cap = cap;
+	}
+	// добавить задачу
+	dq->buf[dq->tail++ % dq->cap] = task;
+	mtMtxUnlock(dq->mtx);
+	return TRUE;
+}
+
+static mt_task_t* mtDequeTake(mt_deque_st* dq, bool_t steal)
+{
+	mt_task_t* task = 0;
+	mtMtxLock(dq->mtx);
+	if (dq->head != dq->tail)
+		task = steal ? dq->buf[dq->head++ % dq->cap] :
+			dq->buf[--dq->tail % dq->cap];
+	mtMtxUnlock(dq->mtx);
+	return task;
+}
+
+// взять задачу: сначала из своего дека (self < workers), затем из чужих
+static mt_task_t* mtPoolTake(mt_pool_t* pool, size_t self)
+{
+	mt_task_t* task = 0;
+	size_t start, i;
+	if (mtAtomicLoad(&pool->queued) == 0)
+		return 0;
+	if (self < pool->workers)
+		task = mtDequeTake(pool->deques + self, FALSE), start = self + 1;
+	else
+		start = mtAtomicLoad(&pool->next);
+	for (i = 0; !task && i < pool->workers; ++i)
+		task = mtDequeTake(pool->deques + (start + i) % pool->workers, TRUE);
+	if (task)
+		mtAtomicDecr(&pool->queued);
+	return task;
+}
+
+static void mtPoolWake(mt_pool_t* pool)
+{
+	if (mtAtomicLoad(&pool->sleepers))
+	{
+		mtMtxLock(pool->mtx);
+		mtCondBroadcast(pool->cv);
+		mtMtxUnlock(pool->mtx);
+	}
+}
+
+static void mtPoolRun(mt_pool_t* pool, mt_task_t* task)
+{
+	task->fn(task->arg);
+	mtAtomicIncr(&task->done);
+	mtPoolWake(pool);
+}
+
+static void mtPoolWorker(void* arg)
+{
+	mt_pool_t* pool = ((mt_worker_st*)arg)->pool;
+	size_t self = ((mt_worker_st*)arg)->index;
+	mt_task_t* task;
+	bool_t stop;
+	while (1)
+	{
+		// выполнить задачу
+		if ((task = mtPoolTake(pool, self)))
+		{
+			mtPoolRun(pool, task);
+			continue;
+		}
+		// ждать новых задач
+		mtMtxLock(pool->mtx);
+		mtAtomicIncr(&pool->sleepers);
+		while (!mtAtomicLoad(&pool->queued) && !pool->stop)
+			mtCondWait(pool->cv, pool->mtx);
+		mtAtomicDecr(&pool->sleepers);
+		stop = pool->stop && !mtAtomicLoad(&pool->queued);
+		mtMtxUnlock(pool->mtx);
+		if (stop)
+			break;
+	}
+}
+
+mt_pool_t* mtPoolCreate(size_t workers)
+{
+	mt_pool_t* pool;
+	size_t i;
+	// подготовить пул
+	if (workers == 0)
+		workers = mtCPUCount();
+	if (workers > MT_POOL_MAX)
+		workers = MT_POOL_MAX;
+	pool = (mt_pool_t*)memAlloc(sizeof(mt_pool_t));
+	if (!pool)
+		return 0;
+	memSetZero(pool, sizeof(mt_pool_t));
+	if (!mtMtxCreate(pool->mtx))
+	{
+		memFree(pool);
+		return 0;
+	}
+	if (!mtCondCreate(pool->cv))
+	{
+		mtMtxClose(pool->mtx);
+		memFree(pool);
+		return 0;
+	}
+	// создать деки
+	for (i = 0; i < workers; ++i)
+		if (!mtMtxCreate(pool->deques[i].mtx))
+			break;
+	workers = i;
+	// запустить исполнителей
+	for (i = 0; i < workers; ++i)
+	{
+		pool->args[i].pool = pool, pool->args[i].index = i;
+		if (!mtThrdCreate(pool->thrds + i, mtPoolWorker, pool->args + i))
+			break;
+	}
+	for (pool->workers = i; i < workers; ++i)
+		mtMtxClose(pool->deques[i].mtx);
+	return pool;
+}
+
+size_t mtPoolWorkers(const mt_pool_t* pool)
+{
+	ASSERT(memIsValid(pool, sizeof(mt_pool_t)));
+	return pool->workers;
+}
+
+void mtPoolSubmit(mt_pool_t* pool, mt_task_t* task, void (*fn)(void*),
+	void* arg)
+{
+	size_t i;
+	ASSERT(memIsValid(pool, sizeof(mt_pool_t)));
+	ASSERT(memIsValid(task, sizeof(mt_task_t)));
+	task->fn = fn, task->arg = arg, task->done = 0;
+	// добавить задачу в дек
+	if (pool->workers)
+	{
+		i = (mtAtomicIncr(&pool->next) - 1) % pool->workers;
+		mtAtomicIncr(&pool->queued);
+		if (mtDequePush(pool->deques + i, task))
+		{
+			mtPoolWake(pool);
+			return;
+		}
+		mtAtomicDecr(&pool->queued);
+	}
+	// выполнить задачу немедленно
+	fn(arg);
+	task->done = 1;
+}
+
+void mtPoolWait(mt_pool_t* pool, mt_task_t* task)
+{
+	mt_task_t* t;
+	ASSERT(memIsValid(pool, sizeof(mt_pool_t)));
+	ASSERT(memIsValid(task, sizeof(mt_task_t)));
+	while (!mtAtomicLoad(&task->done))
+	{
+		// выполнить другую задачу
+		if ((t = mtPoolTake(pool, SIZE_MAX)))
+		{
+			mtPoolRun(pool, t);
+			continue;
+		}
+		// ждать завершения или новых задач
+		mtMtxLock(pool->mtx);
+		mtAtomicIncr(&pool->sleepers);
+		while (!mtAtomicLoad(&task->done) && !mtAtomicLoad(&pool->queued))
+			mtCondWait(pool->cv, pool->mtx);
+		mtAtomicDecr(&pool->sleepers);
+		mtMtxUnlock(pool->mtx);
+	}
+}
+
+typedef struct
+{
+	mt_task_t task[1];		/*< задача */
+	size_t offset;			/*< начало фрагмента */
+	size_t len;				/*< длина фрагмента */
+	void (*fn)(size_t, size_t, void*);	/*< функция обработки */
+	void* arg;				/*< аргумент fn() */
+} mt_pool_for_st;
+
+static void mtPoolForTask(void* arg)
+{
+	mt_pool_for_st* st = (mt_pool_for_st*)arg;
+	st->fn(st->offset, st->len, st->arg);
+}
+
+void mtPoolFor(mt_pool_t* pool, size_t count, size_t grain,
+	void (*fn)(size_t, size_t, void*), void* arg)
+{
+	mt_pool_for_st* st;
+	size_t len, n, i;
+	ASSERT(memIsValid(pool, sizeof(mt_pool_t)));
+	ASSERT(grain > 0);
+	if (count == 0)
+		return;
+	// длина фрагмента: примерно 4 фрагмента на исполнителя
+	len = count / (4 * pool->workers + 1);
+	len = (len / grain + 1) * grain;
+	n = count / len + (count % len != 0);
+	// один фрагмент?
+	if (n == 1 || !(st = (mt_pool_for_st*)memAlloc(n * sizeof(*st))))
+	{
+		fn(0, count, arg);
+		return;
+	}
+	// передать фрагменты в пул (последний обработать самостоятельно)
+	for (i = 0; i < n; ++i)
+	{
+		st[i].offset = i * len;
+		st[i].len = i + 1 < n ? len : count - i * len;
+		st[i].fn = fn, st[i].arg = arg;
+		if (i + 1 < n)
+			mtPoolSubmit(pool, st[i].task, mtPoolForTask, st + i);
+	}
+	mtPoolForTask(st + n - 1);
+	// дождаться завершения
+	for (i = 0; i + 1 < n; ++i)
+		mtPoolWait(pool, st[i].task);
+	memFree(st);
+}
+
+void mtPoolClose(mt_pool_t* pool)
+{
+	size_t i;
+	ASSERT(memIsValid(pool, sizeof(mt_pool_t)));
+	// остановить исполнителей
+	mtMtxLock(pool->mtx);
+	pool->stop = TRUE;
+	mtCondBroadcast(pool->cv);
+	mtMtxUnlock(pool->mtx);
+	for (i = 0; i < pool->workers; ++i)
+		mtThrdJoin(pool->thrds + i);
+	// освободить ресурсы
+	for (i = 0; i < pool->workers; ++i)
+	{
+		mtMtxClose(pool->deques[i].mtx);
+		memFree(pool->deques[i].buf);
+	}
+	mtCondClose(pool->cv);
+	mtMtxClose(pool->mtx);
+	memFree(pool);
+}
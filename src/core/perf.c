@@ -0,0 +1,134 @@
+/*
+*******************************************************************************
+\file perf.c
+\brief Performance counters
+\project bee2 [cryptographic library]
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "bee2/core/err.h"
+#include "bee2/core/mem.h"
+#include "bee2/core/mt.h"
+#include "bee2/core/perf.h"
+#include "bee2/core/util.h"
+
+/*
+*******************************************************************************
+Счетчики
+
+Счетчики читаются с помощью mtAtomicCmpSwap(ctr, 0, 0), увеличиваются
+с помощью mtAtomicIncr() или в цикле mtAtomicCmpSwap().
+*******************************************************************************
+*/
+
+static perf_stat_t _stats[PERF_COUNT];
+
+static const char* const _names[PERF_COUNT] =
+{
+	"belt-hash",
+	"belt-dwp-wrap",
+	"belt-che-wrap",
+	"belt-kwp-wrap",
+	"belt-pbkdf2",
+	"bash-hash",
+	"bign-sign",
+	"bign-verify",
+	"bake-bmqv",
+	"bake-bsts",
+	"bake-bpace",
+	"rng",
+};
+
+static size_t perfLoad(size_t* ctr)
+{
+	return mtAtomicCmpSwap(ctr, 0, 0);
+}
+
+static void perfAtomicAdd(size_t* ctr, size_t val)
+{
+	size_t t;
+	do
+		t = perfLoad(ctr);
+	while (mtAtomicCmpSwap(ctr, t, t + val) != t);
+}
+
+static void perfAtomicClear(size_t* ctr)
+{
+	size_t t;
+	do
+		t = perfLoad(ctr);
+	while (mtAtomicCmpSwap(ctr, t, 0) != t);
+}
+
+/*
+*******************************************************************************
+Управление
+*******************************************************************************
+*/
+
+bool_t perfIsEnabled()
+{
+#ifdef BEE2_PERF
+	return TRUE;
+#else
+	return FALSE;
+#endif
+}
+
+const char* perfName(size_t id)
+{
+	return id < PERF_COUNT ? _names[id] : 0;
+}
+
+void perfAdd(size_t id, err_t code, size_t octets, tm_ticks_t ticks)
+{
+	perf_stat_t* stat;
+	tm_ticks_t t;
+	size_t pos;
+	ASSERT(id < PERF_COUNT);
+	stat = _stats + id;
+	// ячейка гистограммы
+	for (t = ticks, pos = 0; t > 1 && pos < PERF_HIST_SIZE - 1; ++pos)
+		t >>= 1;
+	// учесть вызов
+	mtAtomicIncr(&stat->calls);
+	if (code != ERR_OK)
+		mtAtomicIncr(&stat->errors);
+	else if (octets)
+		perfAtomicAdd(&stat->octets, octets);
+	perfAtomicAdd(&stat->ticks, (size_t)ticks);
+	mtAtomicIncr(stat->hist + pos);
+}
+
+void perfSnapshot(perf_stat_t stats[PERF_COUNT])
+{
+	size_t id, pos;
+	ASSERT(memIsValid(stats, sizeof(perf_stat_t) * PERF_COUNT));
+	for (id = 0; id < PERF_COUNT; ++id)
+	{
+		stats[id].calls = perfLoad(&_stats[id].calls);
+		stats[id].errors = perfLoad(&_stats[id].errors);
+		stats[id].octets = perfLoad(&_stats[id].octets);
+		stats[id].ticks = perfLoad(&_stats[id].ticks);
+		for (pos = 0; pos < PERF_HIST_SIZE; ++pos)
+			stats[id].hist[pos] = perfLoad(_stats[id].hist + pos);
+	}
+}
+
+void perfReset()
+{
+	size_t id, pos;
+	for (id = 0; id < PERF_COUNT; ++id)
+	{
+		perfAtomicClear(&_stats[id].calls);
+		perfAtomicClear(&_stats[id].errors);
+		perfAtomicClear(&_stats[id].octets);
+		perfAtomicClear(&_stats[id].ticks);
+		for (pos = 0; pos < PERF_HIST_SIZE; ++pos)
+			perfAtomicClear(_stats[id].hist + pos);
+	}
+}
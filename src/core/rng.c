@@ -4,7 +4,7 @@
 \brief Entropy sources and random number generators
 \project bee2 [cryptographic library]
 \created 2014.10.13
-\version 2023.12.19
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -15,12 +15,14 @@
 #include "bee2/core/mem.h"
 #include "bee2/core/mt.h"
 #include "bee2/core/obj.h"
+#include "bee2/core/perf.h"
 #include "bee2/core/str.h"
 #include "bee2/core/tm.h"
 #include "bee2/core/rng.h"
 #include "bee2/core/u32.h"
 #include "bee2/core/util.h"
 #include "bee2/core/word.h"
+#include "bee2/crypto/bash.h"
 #include "bee2/crypto/belt.h"
 #include "bee2/crypto/brng.h"
 #include "bee2/math/ww.h"
@@ -662,13 +664,24 @@ err_t rngESHealth()
 не обязательно будет вызвана позже rngClose(). Например, rngClose()
 может вызываться в другом зарегистрированном деструкторе, который следует
 за rngDestroy().
+
+\remark Механизм генерации (engine) выбирается при создании состояния
+и не меняется до его уничтожения. Механизм bash-prg запускается в ключевом
+режиме с уровнем стойкости 128 и емкостью 1: ключом выступает хэш-значение
+энтропийных данных, а при каждом выполнении команды squeeze вырабатывается
+до 168 октетов выходных данных.
 *******************************************************************************
 */
 
+#define RNG_BRNG_CTR	0		/*< механизм brng-ctr */
+#define RNG_BASH_PRG	1		/*< механизм bash-prg */
+
 typedef struct 
 {
+	size_t engine;				/*< механизм */
 	octet block[32];			/*< дополнительные данные brngCTR */
-	octet alg_state[];			/*< [MAX(beltHash_keep(), brngCTR_keep())] */
+	octet alg_state[];			/*< [MAX(beltHash_keep(), brngCTR_keep(),
+									bashPrg_keep())] */
 } rng_state_st;
 
 static size_t _once;			/*< триггер однократности */
@@ -679,7 +692,8 @@ static rng_state_st* _state;	/*< состояние */
 
 size_t rngCreate_keep()
 {
-	return sizeof(rng_state_st) + MAX2(beltHash_keep(), brngCTR_keep());
+	return sizeof(rng_state_st) + 
+		utilMax(3, beltHash_keep(), brngCTR_keep(), bashPrg_keep());
 }
 
 static void rngDestroy()
@@ -707,10 +721,45 @@ static void rngInit()
 	_inited = TRUE;
 }
 
-err_t rngCreate(read_i source, void* source_state)
+static size_t rngEngineFromName(const char* engine)
+{
+	if (!engine || strEq(engine, "brng-ctr"))
+		return RNG_BRNG_CTR;
+	if (strEq(engine, "bash-prg"))
+		return RNG_BASH_PRG;
+	return SIZE_MAX;
+}
+
+static void rngAlgStart(rng_state_st* state)
+{
+	if (state->engine == RNG_BASH_PRG)
+		bashPrgStart(state->alg_state, 128, 1, 0, 0, state->block, 32);
+	else
+		brngCTRStart(state->alg_state, state->block, 0);
+	memWipe(state->block, 32);
+}
+
+static void rngAlgStepR(void* buf, size_t count, rng_state_st* state)
+{
+	if (state->engine == RNG_BASH_PRG)
+	{
+		bashPrgSqueeze(buf, count, state->alg_state);
+		bashPrgRatchet(state->alg_state);
+	}
+	else
+		brngCTRStepR(buf, count, state->alg_state);
+}
+
+err_t rngCreate2(read_i source, void* source_state, const char* engine)
 {
 	const char* sources[] = { "trng", "trng2", "sys", "timer" };
 	size_t read, count, pos;
+	size_t e;
+	// проверить механизм
+	if (engine && !strIsValid(engine))
+		return ERR_BAD_INPUT;
+	if ((e = rngEngineFromName(engine)) == SIZE_MAX)
+		return ERR_BAD_PARAMS;
 	// инициализировать однократно
 	if (!mtCallOnce(&_once, rngInit) || !_inited)
 		return ERR_FILE_CREATE;
@@ -719,9 +768,23 @@ err_t rngCreate(read_i source, void* source_state)
 	// состояние уже создано?
 	if (_ctr)
 	{
+		// механизм не может быть изменен
+		if (engine && e != _state->engine)
+		{
+			mtMtxUnlock(_mtx);
+			return ERR_BAD_PARAMS;
+		}
 		// учесть дополнительный источник
 		if (source && source(&read, _state->block, 32, source_state) == ERR_OK)
-			brngCTRStepR(_state->block, 32, _state->alg_state);
+		{
+			if (_state->engine == RNG_BASH_PRG)
+			{
+				bashPrgAbsorb(_state->block, read, _state->alg_state);
+				memWipe(_state->block, 32);
+			}
+			else
+				brngCTRStepR(_state->block, 32, _state->alg_state);
+		}
 		// увеличить счетчик обращений и завершить
 		++_ctr;
 		mtMtxUnlock(_mtx);
@@ -734,6 +797,7 @@ err_t rngCreate(read_i source, void* source_state)
 		mtMtxUnlock(_mtx);
 		return ERR_OUTOFMEMORY;
 	}
+	_state->engine = e;
 	// опрос источников случайности
 	count = 0;
 	beltHashStart(_state->alg_state);
@@ -754,21 +818,37 @@ err_t rngCreate(read_i source, void* source_state)
 		mtMtxUnlock(_mtx);
 		return ERR_NOT_ENOUGH_ENTROPY;
 	}
-	// создать brngCTR
+	// создать brngCTR / bashPrg
 	beltHashStepG(_state->block, _state->alg_state);
-	brngCTRStart(_state->alg_state, _state->block, 0);
-	memWipe(_state->block, 32);
+	rngAlgStart(_state);
 	// завершить
 	_ctr = 1;
 	mtMtxUnlock(_mtx);
 	return ERR_OK;
 }
 
+err_t rngCreate(read_i source, void* source_state)
+{
+	return rngCreate2(source, source_state, 0);
+}
+
 static bool_t rngIsValid_internal()
 {
 	return _ctr && _state && blobIsValid(_state);
 }
 
+const char* rngEngine()
+{
+	const char* engine = 0;
+	if (!_inited)
+		return 0;
+	mtMtxLock(_mtx);
+	if (rngIsValid_internal())
+		engine = _state->engine == RNG_BASH_PRG ? "bash-prg" : "brng-ctr";
+	mtMtxUnlock(_mtx);
+	return engine;
+}
+
 bool_t rngIsValid()
 {
 	bool_t b;
@@ -809,19 +889,25 @@ mtSleep(0).
 void rngStepR2(void* buf, size_t count, void* state)
 {
 	ASSERT(_inited);
+	PERF_PROBE1(rng_lock, count);
 	mtMtxLock(_mtx);
+	PERF_PROBE1(rng_locked, count);
 	ASSERT(rngIsValid_internal());
-	brngCTRStepR(buf, count, _state->alg_state);
+	rngAlgStepR(buf, count, _state);
 	mtMtxUnlock(_mtx);
+	PERF_PROBE1(rng_unlock, count);
 }
 
 void rngStepR(void* buf, size_t count, void* state)
 {
 	const char* sources[] = {"trng", "trng2", "sys", "sys2", "timer"};
 	size_t read, r, pos;
+	tm_ticks_t ticks = PERF_START();
 	// блокировать мьютекс
 	ASSERT(_inited);
+	PERF_PROBE1(rng_lock, count);
 	mtMtxLock(_mtx);
+	PERF_PROBE1(rng_locked, count);
 	// опросить источники
 	read = pos = 0;
 	while (read < count && pos < COUNT_OF(sources))
@@ -834,9 +920,18 @@ void rngStepR(void* buf, size_t count, void* state)
 	read = r = pos = 0;
 	// генерация
 	ASSERT(rngIsValid_internal());
-	brngCTRStepR(buf, count, _state->alg_state);
+	if (_state->engine == RNG_BASH_PRG)
+	{
+		bashPrgAbsorb(buf, count, _state->alg_state);
+		bashPrgSqueeze(buf, count, _state->alg_state);
+		bashPrgRatchet(_state->alg_state);
+	}
+	else
+		brngCTRStepR(buf, count, _state->alg_state);
 	// снять блокировку
 	mtMtxUnlock(_mtx);
+	PERF_PROBE1(rng_unlock, count);
+	PERF_STOP(PERF_RNG, ERR_OK, count, ticks);
 }
 
 void rngRekey()
@@ -844,12 +939,16 @@ void rngRekey()
 	// блокировать мьютекс
 	ASSERT(_inited);
 	mtMtxLock(_mtx);
-	// сгенерировать новый ключ
 	ASSERT(rngIsValid_internal());
-	brngCTRStepR(_state->block, 32, _state->alg_state);
-	// пересоздать brngCTR
-	brngCTRStart(_state->alg_state, _state->block, 0);
-	memWipe(_state->block, 32);
+	// bashPrg: необратимо изменить состояние
+	if (_state->engine == RNG_BASH_PRG)
+		bashPrgRatchet(_state->alg_state);
+	// brngCTR: сгенерировать новый ключ и пересоздать brngCTR
+	else
+	{
+		brngCTRStepR(_state->block, 32, _state->alg_state);
+		rngAlgStart(_state);
+	}
 	// снять блокировку
 	mtMtxUnlock(_mtx);
 }
@@ -4,7 +4,7 @@
 \brief Utilities
 \project bee2 [cryptographic library]
 \created 2012.05.10
-\version 2021.05.18
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -18,6 +18,7 @@
 #include "bee2/core/blob.h"
 #include "bee2/core/mem.h"
 #include "bee2/core/mt.h"
+#include "bee2/core/str.h"
 #include "bee2/core/tm.h"
 #include "bee2/core/util.h"
 
@@ -270,3 +271,110 @@ u32 utilNonce32()
 	// еще?
 	return state;
 }
+
+/*
+*******************************************************************************
+Возможности процессора
+
+Возможности x86 определяются по регистрам, которые возвращает инструкция
+cpuid:
+-	cpuid(1).edx[26] -- SSE2;
+-	cpuid(1).ecx[1] -- PCLMULQDQ;
+-	cpuid(1).ecx[27] -- OSXSAVE (ОС управляет расширенными регистрами);
+-	cpuid(7).ebx[5] -- AVX2;
+-	cpuid(7).ebx[16] -- AVX512F.
+
+Для AVX2 и AVX512F дополнительно проверяется, что ОС сохраняет расширенные
+регистры: в XCR0 (читается инструкцией xgetbv) должны быть установлены
+биты 1, 2 (XMM, YMM) и, для AVX512F, биты 5, 6, 7 (opmask, ZMM).
+
+\remark Опрос выполняется однократно, его результат сохраняется 
+в битовой маске _cpu_flags.
+*******************************************************************************
+*/
+
+#define UTIL_CPU_SSE2		1
+#define UTIL_CPU_AVX2		2
+#define UTIL_CPU_AVX512F	4
+#define UTIL_CPU_PCLMUL		8
+#define UTIL_CPU_NEON		16
+
+#if (_MSC_VER >= 1600) && (defined(_M_IX86) || defined(_M_X64))
+
+#include <intrin.h>
+#include <immintrin.h>
+
+#define UTIL_CPUID
+#define utilCPUID(info, id) __cpuidex((int*)info, id, 0)
+#define utilXGETBV() ((u32)_xgetbv(0))
+
+#elif (defined(__GNUC__) || defined(__clang__)) && \
+  (defined(__i386__) || defined(__x86_64__))
+
+#include <cpuid.h>
+
+#define UTIL_CPUID
+#define utilCPUID(info, id) \
+	__cpuid_count(id, 0, info[0], info[1], info[2], info[3])
+
+static u32 utilXGETBV()
+{
+	u32 a, d;
+	__asm__ __volatile__ ("xgetbv" : "=a" (a), "=d" (d) : "c" (0));
+	return a;
+}
+
+#endif
+
+static size_t _cpu_once;			/*< триггер однократности */
+static size_t _cpu_flags;			/*< возможности процессора */
+
+static void utilCPUInit()
+{
+	size_t flags = 0;
+#if defined(UTIL_CPUID)
+	u32 info[4];
+	u32 max_id, ecx1, xcr0 = 0;
+	utilCPUID(info, 0);
+	max_id = info[0];
+	if (max_id >= 1)
+	{
+		utilCPUID(info, 1);
+		ecx1 = info[2];
+		if (info[3] & 0x04000000)
+			flags |= UTIL_CPU_SSE2;
+		if (ecx1 & 0x00000002)
+			flags |= UTIL_CPU_PCLMUL;
+		if (ecx1 & 0x08000000)
+			xcr0 = utilXGETBV();
+		if (max_id >= 7 && (xcr0 & 0x06) == 0x06)
+		{
+			utilCPUID(info, 7);
+			if (info[1] & 0x00000020)
+				flags |= UTIL_CPU_AVX2;
+			if ((info[1] & 0x00010000) && (xcr0 & 0xE0) == 0xE0)
+				flags |= UTIL_CPU_AVX512F;
+		}
+	}
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+	flags |= UTIL_CPU_NEON;
+#endif
+	_cpu_flags = flags;
+}
+
+bool_t utilCPUHas(const char* feature)
+{
+	ASSERT(strIsValid(feature));
+	mtCallOnce(&_cpu_once, utilCPUInit);
+	if (strEq(feature, "sse2"))
+		return (_cpu_flags & UTIL_CPU_SSE2) != 0;
+	else if (strEq(feature, "avx2"))
+		return (_cpu_flags & UTIL_CPU_AVX2) != 0;
+	else if (strEq(feature, "avx512f"))
+		return (_cpu_flags & UTIL_CPU_AVX512F) != 0;
+	else if (strEq(feature, "pclmul"))
+		return (_cpu_flags & UTIL_CPU_PCLMUL) != 0;
+	else if (strEq(feature, "neon"))
+		return (_cpu_flags & UTIL_CPU_NEON) != 0;
+	return FALSE;
+}
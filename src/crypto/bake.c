@@ -4,7 +4,7 @@
 \brief STB 34.101.66 (bake): authenticated key establishment (AKE) protocols
 \project bee2 [cryptographic library]
 \created 2014.04.14
-\version 2023.09.19
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -14,6 +14,7 @@
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
 #include "bee2/core/obj.h"
+#include "bee2/core/perf.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/bake.h"
 #include "bee2/crypto/belt.h"
@@ -35,20 +36,22 @@
 *******************************************************************************
 */
 
-err_t bakeKDF(octet key[32], const octet secret[], size_t secret_len, 
-	const octet iv[], size_t iv_len, size_t num)
+size_t bakeKDF_keep()
 {
-	void* state;
+	return utilMax(2, beltHash_keep(), beltKRP_keep() + 16);
+}
+
+err_t bakeKDF_ws(octet key[32], const octet secret[], size_t secret_len, 
+	const octet iv[], size_t iv_len, size_t num, void* workspace)
+{
+	void* state = workspace;
 	octet* block;
 	// проверить входные данные
 	if (!memIsValid(secret, secret_len) ||
 		!memIsValid(iv, iv_len) ||
-		!memIsValid(key, 32))
+		!memIsValid(key, 32) ||
+		!memIsValid(workspace, bakeKDF_keep()))
 		return ERR_BAD_INPUT;
-	// создать состояние
-	state = blobCreate(utilMax(2, beltHash_keep(), beltKRP_keep() + 16));
-	if (state == 0)
-		return ERR_OUTOFMEMORY;
 	block = (octet*)state + beltKRP_keep();
 	// key <- beltHash(secret || iv)
 	beltHashStart(state);
@@ -65,9 +68,23 @@ err_t bakeKDF(octet key[32], const octet secret[], size_t secret_len,
 #endif
 	memSetZero(block + sizeof(size_t), 16 - sizeof(size_t));
 	beltKRPStepG(key, 32, block, state);
+	return ERR_OK;
+}
+
+err_t bakeKDF(octet key[32], const octet secret[], size_t secret_len, 
+	const octet iv[], size_t iv_len, size_t num)
+{
+	err_t code;
+	void* state;
+	// создать состояние
+	state = blobCreate(bakeKDF_keep());
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// построить ключ
+	code = bakeKDF_ws(key, secret, secret_len, iv, iv_len, num, state);
 	// завершить
 	blobClose(state);
-	return ERR_OK;
+	return code;
 }
 
 /*
@@ -250,7 +267,7 @@ static size_t bakeBMQVStart_deep(size_t n, size_t f_deep, size_t ec_d,
 			ecpIsOnA_deep(n, f_deep));
 }
 
-err_t bakeBMQVStep2(octet out[], void* state)
+static err_t bakeBMQVStep2_internal(octet out[], void* state)
 {
 	bake_bmqv_o* s = (bake_bmqv_o*)state;
 	size_t n, no;
@@ -283,6 +300,17 @@ err_t bakeBMQVStep2(octet out[], void* state)
 	return ERR_OK;
 }
 
+err_t bakeBMQVStep2(octet out[], void* state)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE2(bake_step_entry, PERF_BAKE_BMQV, '2');
+	code = bakeBMQVStep2_internal(out, state);
+	PERF_PROBE3(bake_step_return, PERF_BAKE_BMQV, '2', code);
+	PERF_STOP(PERF_BAKE_BMQV, code, 0, ticks);
+	return code;
+}
+
 static size_t bakeBMQVStep2_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
@@ -292,8 +320,8 @@ static size_t bakeBMQVStep2_deep(size_t n, size_t f_deep, size_t ec_d,
 			ecMulA_deep(n, ec_d, ec_deep, n));
 }
 
-err_t bakeBMQVStep3(octet out[], const octet in[], const bake_cert* certb,
-	void* state)
+static err_t bakeBMQVStep3_internal(octet out[], const octet in[],
+	const bake_cert* certb, void* state)
 {
 	err_t code;
 	bake_bmqv_o* s = (bake_bmqv_o*)state;
@@ -410,6 +438,18 @@ err_t bakeBMQVStep3(octet out[], const octet in[], const bake_cert* certb,
 	return ERR_OK;
 }
 
+err_t bakeBMQVStep3(octet out[], const octet in[], const bake_cert* certb,
+	void* state)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE2(bake_step_entry, PERF_BAKE_BMQV, '3');
+	code = bakeBMQVStep3_internal(out, in, certb, state);
+	PERF_PROBE3(bake_step_return, PERF_BAKE_BMQV, '3', code);
+	PERF_STOP(PERF_BAKE_BMQV, code, 0, ticks);
+	return code;
+}
+
 static size_t bakeBMQVStep3_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
@@ -426,8 +466,8 @@ static size_t bakeBMQVStep3_deep(size_t n, size_t f_deep, size_t ec_d,
 			beltMAC_keep());
 }
 
-err_t bakeBMQVStep4(octet out[], const octet in[], const bake_cert* certa,
-	void* state)
+static err_t bakeBMQVStep4_internal(octet out[], const octet in[],
+	const bake_cert* certa, void* state)
 {
 	err_t code;
 	bake_bmqv_o* s = (bake_bmqv_o*)state;
@@ -538,6 +578,18 @@ err_t bakeBMQVStep4(octet out[], const octet in[], const bake_cert* certa,
 	return ERR_OK;
 }
 
+err_t bakeBMQVStep4(octet out[], const octet in[], const bake_cert* certa,
+	void* state)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE2(bake_step_entry, PERF_BAKE_BMQV, '4');
+	code = bakeBMQVStep4_internal(out, in, certa, state);
+	PERF_PROBE3(bake_step_return, PERF_BAKE_BMQV, '4', code);
+	PERF_STOP(PERF_BAKE_BMQV, code, 0, ticks);
+	return code;
+}
+
 static size_t bakeBMQVStep4_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
@@ -554,7 +606,7 @@ static size_t bakeBMQVStep4_deep(size_t n, size_t f_deep, size_t ec_d,
 			beltMAC_keep());
 }
 
-err_t bakeBMQVStep5(const octet in[8], void* state)
+static err_t bakeBMQVStep5_internal(const octet in[8], void* state)
 {
 	bake_bmqv_o* s = (bake_bmqv_o*)state;
 	// стек
@@ -580,13 +632,24 @@ err_t bakeBMQVStep5(const octet in[8], void* state)
 	return ERR_OK;
 }
 
+err_t bakeBMQVStep5(const octet in[8], void* state)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE2(bake_step_entry, PERF_BAKE_BMQV, '5');
+	code = bakeBMQVStep5_internal(in, state);
+	PERF_PROBE3(bake_step_return, PERF_BAKE_BMQV, '5', code);
+	PERF_STOP(PERF_BAKE_BMQV, code, 0, ticks);
+	return code;
+}
+
 static size_t bakeBMQVStep5_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
 	return 16 + beltMAC_keep();
 }
 
-err_t bakeBMQVStepG(octet key[32], void* state)
+static err_t bakeBMQVStepG_internal(octet key[32], void* state)
 {
 	bake_bmqv_o* s = (bake_bmqv_o*)state;
 	// проверить входные данные
@@ -599,6 +662,17 @@ err_t bakeBMQVStepG(octet key[32], void* state)
 	return ERR_OK;
 }
 
+err_t bakeBMQVStepG(octet key[32], void* state)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE2(bake_step_entry, PERF_BAKE_BMQV, 'G');
+	code = bakeBMQVStepG_internal(key, state);
+	PERF_PROBE3(bake_step_return, PERF_BAKE_BMQV, 'G', code);
+	PERF_STOP(PERF_BAKE_BMQV, code, 0, ticks);
+	return code;
+}
+
 static size_t bakeBMQV_deep(size_t n, size_t f_deep, size_t ec_d, 
 	size_t ec_deep)
 {
@@ -819,7 +893,7 @@ static size_t bakeBSTSStart_deep(size_t n, size_t f_deep, size_t ec_d,
 			ecpIsOnA_deep(n, f_deep));
 }
 
-err_t bakeBSTSStep2(octet out[], void* state)
+static err_t bakeBSTSStep2_internal(octet out[], void* state)
 {
 	bake_bsts_o* s = (bake_bsts_o*)state;
 	size_t n, no;
@@ -847,6 +921,17 @@ err_t bakeBSTSStep2(octet out[], void* state)
 	return ERR_OK;
 }
 
+err_t bakeBSTSStep2(octet out[], void* state)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE2(bake_step_entry, PERF_BAKE_BSTS, '2');
+	code = bakeBSTSStep2_internal(out, state);
+	PERF_PROBE3(bake_step_return, PERF_BAKE_BSTS, '2', code);
+	PERF_STOP(PERF_BAKE_BSTS, code, 0, ticks);
+	return code;
+}
+
 static size_t bakeBSTSStep2_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
@@ -855,7 +940,7 @@ static size_t bakeBSTSStep2_deep(size_t n, size_t f_deep, size_t ec_d,
 			ecMulA_deep(n, ec_d, ec_deep, n));
 }
 
-err_t bakeBSTSStep3(octet out[], const octet in[], void* state)
+static err_t bakeBSTSStep3_internal(octet out[], const octet in[], void* state)
 {
 	bake_bsts_o* s = (bake_bsts_o*)state;
 	size_t n, no;
@@ -951,6 +1036,17 @@ err_t bakeBSTSStep3(octet out[], const octet in[], void* state)
 	return ERR_OK;
 }
 
+err_t bakeBSTSStep3(octet out[], const octet in[], void* state)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE2(bake_step_entry, PERF_BAKE_BSTS, '3');
+	code = bakeBSTSStep3_internal(out, in, state);
+	PERF_PROBE3(bake_step_return, PERF_BAKE_BSTS, '3', code);
+	PERF_STOP(PERF_BAKE_BSTS, code, 0, ticks);
+	return code;
+}
+
 static size_t bakeBSTSStep3_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
@@ -967,8 +1063,8 @@ static size_t bakeBSTSStep3_deep(size_t n, size_t f_deep, size_t ec_d,
 			beltMAC_keep());
 }
 
-err_t bakeBSTSStep4(octet out[], const octet in[], size_t in_len,
-	bake_certval_i vala, void* state)
+static err_t bakeBSTSStep4_internal(octet out[], const octet in[],
+	size_t in_len, bake_certval_i vala, void* state)
 {
 	err_t code;
 	bake_bsts_o* s = (bake_bsts_o*)state;
@@ -1095,6 +1191,18 @@ err_t bakeBSTSStep4(octet out[], const octet in[], size_t in_len,
 	return ERR_OK;
 }
 
+err_t bakeBSTSStep4(octet out[], const octet in[], size_t in_len,
+	bake_certval_i vala, void* state)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE2(bake_step_entry, PERF_BAKE_BSTS, '4');
+	code = bakeBSTSStep4_internal(out, in, in_len, vala, state);
+	PERF_PROBE3(bake_step_return, PERF_BAKE_BSTS, '4', code);
+	PERF_STOP(PERF_BAKE_BSTS, code, 0, ticks);
+	return code;
+}
+
 static size_t bakeBSTSStep4_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
@@ -1112,8 +1220,8 @@ static size_t bakeBSTSStep4_deep(size_t n, size_t f_deep, size_t ec_d,
 			beltMAC_keep());
 }
 
-err_t bakeBSTSStep5(const octet in[], size_t in_len, bake_certval_i valb,
-	void* state)
+static err_t bakeBSTSStep5_internal(const octet in[], size_t in_len,
+	bake_certval_i valb, void* state)
 {
 	err_t code;
 	bake_bsts_o* s = (bake_bsts_o*)state;
@@ -1180,6 +1288,18 @@ err_t bakeBSTSStep5(const octet in[], size_t in_len, bake_certval_i valb,
 	return ERR_OK;
 }
 
+err_t bakeBSTSStep5(const octet in[], size_t in_len, bake_certval_i valb,
+	void* state)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE2(bake_step_entry, PERF_BAKE_BSTS, '5');
+	code = bakeBSTSStep5_internal(in, in_len, valb, state);
+	PERF_PROBE3(bake_step_return, PERF_BAKE_BSTS, '5', code);
+	PERF_STOP(PERF_BAKE_BSTS, code, 0, ticks);
+	return code;
+}
+
 static size_t bakeBSTSStep5_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
@@ -1192,7 +1312,7 @@ static size_t bakeBSTSStep5_deep(size_t n, size_t f_deep, size_t ec_d,
 			ecAddMulA_deep(n, ec_d, ec_deep, 2, n, n / 2 + 1));
 }
 
-err_t bakeBSTSStepG(octet key[32], void* state)
+static err_t bakeBSTSStepG_internal(octet key[32], void* state)
 {
 	bake_bsts_o* s = (bake_bsts_o*)state;
 	// проверить входные данные
@@ -1205,6 +1325,17 @@ err_t bakeBSTSStepG(octet key[32], void* state)
 	return ERR_OK;
 }
 
+err_t bakeBSTSStepG(octet key[32], void* state)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE2(bake_step_entry, PERF_BAKE_BSTS, 'G');
+	code = bakeBSTSStepG_internal(key, state);
+	PERF_PROBE3(bake_step_return, PERF_BAKE_BSTS, 'G', code);
+	PERF_STOP(PERF_BAKE_BSTS, code, 0, ticks);
+	return code;
+}
+
 static size_t bakeBSTS_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
@@ -1478,7 +1609,7 @@ static size_t bakeBPACEStart_deep(size_t n, size_t f_deep, size_t ec_d,
 	return beltHash_keep();
 }
 
-err_t bakeBPACEStep2(octet out[], void* state)
+static err_t bakeBPACEStep2_internal(octet out[], void* state)
 {
 	bake_bpace_o* s = (bake_bpace_o*)state;
 	size_t no;
@@ -1502,13 +1633,25 @@ err_t bakeBPACEStep2(octet out[], void* state)
 	return ERR_OK;
 }
 
+err_t bakeBPACEStep2(octet out[], void* state)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE2(bake_step_entry, PERF_BAKE_BPACE, '2');
+	code = bakeBPACEStep2_internal(out, state);
+	PERF_PROBE3(bake_step_return, PERF_BAKE_BPACE, '2', code);
+	PERF_STOP(PERF_BAKE_BPACE, code, 0, ticks);
+	return code;
+}
+
 static size_t bakeBPACEStep2_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
 	return beltECB_keep();
 }
 
-err_t bakeBPACEStep3(octet out[], const octet in[], void* state)
+static err_t bakeBPACEStep3_internal(octet out[], const octet in[],
+	void* state)
 {
 	bake_bpace_o* s = (bake_bpace_o*)state;
 	size_t n, no;
@@ -1554,6 +1697,17 @@ err_t bakeBPACEStep3(octet out[], const octet in[], void* state)
 	return ERR_OK;
 }
 
+err_t bakeBPACEStep3(octet out[], const octet in[], void* state)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE2(bake_step_entry, PERF_BAKE_BPACE, '3');
+	code = bakeBPACEStep3_internal(out, in, state);
+	PERF_PROBE3(bake_step_return, PERF_BAKE_BPACE, '3', code);
+	PERF_STOP(PERF_BAKE_BPACE, code, 0, ticks);
+	return code;
+}
+
 static size_t bakeBPACEStep3_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
@@ -1565,7 +1719,8 @@ static size_t bakeBPACEStep3_deep(size_t n, size_t f_deep, size_t ec_d,
 			f_deep);
 }
 
-err_t bakeBPACEStep4(octet out[], const octet in[], void* state)
+static err_t bakeBPACEStep4_internal(octet out[], const octet in[],
+	void* state)
 {
 	bake_bpace_o* s = (bake_bpace_o*)state;
 	size_t n, no;
@@ -1653,6 +1808,17 @@ err_t bakeBPACEStep4(octet out[], const octet in[], void* state)
 	return ERR_OK;
 }
 
+err_t bakeBPACEStep4(octet out[], const octet in[], void* state)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE2(bake_step_entry, PERF_BAKE_BPACE, '4');
+	code = bakeBPACEStep4_internal(out, in, state);
+	PERF_PROBE3(bake_step_return, PERF_BAKE_BPACE, '4', code);
+	PERF_STOP(PERF_BAKE_BPACE, code, 0, ticks);
+	return code;
+}
+
 static size_t bakeBPACEStep4_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
@@ -1667,7 +1833,8 @@ static size_t bakeBPACEStep4_deep(size_t n, size_t f_deep, size_t ec_d,
 			beltMAC_keep());
 }
 
-err_t bakeBPACEStep5(octet out[], const octet in[], void* state)
+static err_t bakeBPACEStep5_internal(octet out[], const octet in[],
+	void* state)
 {
 	bake_bpace_o* s = (bake_bpace_o*)state;
 	size_t n, no;
@@ -1746,6 +1913,17 @@ err_t bakeBPACEStep5(octet out[], const octet in[], void* state)
 	return ERR_OK;
 }
 
+err_t bakeBPACEStep5(octet out[], const octet in[], void* state)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE2(bake_step_entry, PERF_BAKE_BPACE, '5');
+	code = bakeBPACEStep5_internal(out, in, state);
+	PERF_PROBE3(bake_step_return, PERF_BAKE_BPACE, '5', code);
+	PERF_STOP(PERF_BAKE_BPACE, code, 0, ticks);
+	return code;
+}
+
 static size_t bakeBPACEStep5_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
@@ -1758,7 +1936,7 @@ static size_t bakeBPACEStep5_deep(size_t n, size_t f_deep, size_t ec_d,
 			beltMAC_keep());
 }
 
-err_t bakeBPACEStep6(const octet in[8], void* state)
+static err_t bakeBPACEStep6_internal(const octet in[8], void* state)
 {
 	bake_bpace_o* s = (bake_bpace_o*)state;
 	// стек
@@ -1784,13 +1962,24 @@ err_t bakeBPACEStep6(const octet in[8], void* state)
 	return ERR_OK;
 }
 
+err_t bakeBPACEStep6(const octet in[8], void* state)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE2(bake_step_entry, PERF_BAKE_BPACE, '6');
+	code = bakeBPACEStep6_internal(in, state);
+	PERF_PROBE3(bake_step_return, PERF_BAKE_BPACE, '6', code);
+	PERF_STOP(PERF_BAKE_BPACE, code, 0, ticks);
+	return code;
+}
+
 static size_t bakeBPACEStep6_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
 	return 16 + beltMAC_keep();
 }
 
-err_t bakeBPACEStepG(octet key[32], void* state)
+static err_t bakeBPACEStepG_internal(octet key[32], void* state)
 {
 	bake_bpace_o* s = (bake_bpace_o*)state;
 	// проверить входные данные
@@ -1803,6 +1992,17 @@ err_t bakeBPACEStepG(octet key[32], void* state)
 	return ERR_OK;
 }
 
+err_t bakeBPACEStepG(octet key[32], void* state)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE2(bake_step_entry, PERF_BAKE_BPACE, 'G');
+	code = bakeBPACEStepG_internal(key, state);
+	PERF_PROBE3(bake_step_return, PERF_BAKE_BPACE, 'G', code);
+	PERF_STOP(PERF_BAKE_BPACE, code, 0, ticks);
+	return code;
+}
+
 static size_t bakeBPACE_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
@@ -4,7 +4,7 @@
 \brief STB 34.101.77 (bash): bash-f
 \project bee2 [cryptographic library]
 \created 2019.06.25
-\version 2021.03.25
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -23,22 +23,248 @@
 	#define __SSE2__
 #endif
 
+/*
+*******************************************************************************
+Выбор реализации во время выполнения (BASH_DISPATCH)
+
+В библиотеку включаются реализации BASH_64 (bash_f64.c), BASH_AVX2
+(bash_favx2.c) и BASH_AVX512 (bash_favx512.c). Последние два модуля
+компилируются отдельно, с флагами, разрешающими соответствующие инструкции.
+Реализация BASH_SSE2 не включается: на платформе x64 она уступает BASH_64.
+
+Реализация выбирается по возможностям процессора (см. utilCPUHas())
+при первом обращении к bashF(), bashPlatform() или многобуферным функциям.
+Выбор выполняется однократно, с помощью mtCallOnce(). Далее bashF()
+вызывает выбранную реализацию через указатель _bash_f.
+
+Указатель _bash_f публикуется один раз: он записывается в bashFSelect()
+и больше не изменяется. Функция bashF() обращается к mtCallOnce(), только
+пока указатель нулевой. Поток, который видит ненулевой указатель, видит
+окончательное значение (запись указателя машинным словом не разрывается)
+и сразу вызывает выбранную реализацию. Поэтому накладные расходы bashF()
+сводятся к чтению указателя и косвенному вызову. Каждая функция проверяет
+и затем использует одну и ту же переменную, поэтому порядок записи
+переменных в bashFSelect() не важен.
+
+Для совместимости сохраняется строка bash_platform. В режиме BASH_DISPATCH
+она содержит "BASH_DISPATCH", имя выбранной платформы возвращает
+bashPlatform().
+
+Одновременно выбираются реализации многобуферной sponge-функции:
+bashFx4() и bashFx8() вызывают выбранные реализации через указатели
+_bash_fx4 и _bash_fx8.
+
+Схема может использоваться и в других модулях, в которых имеются
+реализации, оптимизированные для расширенных наборов инструкций.
+*******************************************************************************
+*/
+
+#if defined(BASH_DISPATCH)
+
+#include "bee2/core/mt.h"
+#include "bee2/core/util.h"
+#include "bee2/crypto/bash.h"
+#include "bash_lcl.h"
+
+void bashF64(octet block[192], void* stack);
+size_t bashF64_deep();
+
+#define bashF bashF64
+#define bashF_deep bashF64_deep
+#include "bash_f64.c"
+#undef bashF
+#undef bashF_deep
+
+void bashFAVX2(octet block[192], void* stack);
+size_t bashFAVX2_deep();
+void bashFAVX512(octet block[192], void* stack);
+size_t bashFAVX512_deep();
+
+typedef void (*bash_f_i)(octet block[192], void* stack);
+typedef void (*bash_fx_i)(octet* blocks[], void* stack);
+
+const char bash_platform[] = "BASH_DISPATCH";
+
+static size_t _once;					/*< триггер однократности */
+static bash_f_i _bash_f;				/*< выбор для bashF() */
+static const char* _platform;			/*< имя выбранной платформы */
+static bash_fx_i _bash_fx4;				/*< выбор для bashFx4() */
+static bash_fx_i _bash_fx8;				/*< выбор для bashFx8() */
+static size_t _lanes;					/*< выбор для bashFxLanes() */
+
+static void bashFx4Seq(octet* blocks[4], void* stack)
+{
+	bashF(blocks[0], stack);
+	bashF(blocks[1], stack);
+	bashF(blocks[2], stack);
+	bashF(blocks[3], stack);
+}
+
+static void bashFx4AVX2_(octet* blocks[4], void* stack)
+{
+	bashFx4AVX2(blocks);
+}
+
+static void bashFx8Seq(octet* blocks[8], void* stack)
+{
+	bashFx4(blocks, stack);
+	bashFx4(blocks + 4, stack);
+}
+
+static void bashFx8AVX512_(octet* blocks[8], void* stack)
+{
+	bashFx8AVX512(blocks);
+}
+
+static void bashFSelect()
+{
+	if (utilCPUHas("avx512f"))
+	{
+		_bash_f = bashFAVX512, _platform = "BASH_AVX512";
+		_bash_fx4 = bashFx4Seq, _bash_fx8 = bashFx8AVX512_, _lanes = 8;
+	}
+	else if (utilCPUHas("avx2"))
+	{
+		_bash_f = bashFAVX2, _platform = "BASH_AVX2";
+		_bash_fx4 = bashFx4AVX2_, _bash_fx8 = bashFx8Seq, _lanes = 4;
+	}
+	else
+	{
+		_bash_f = bashF64, _platform = "BASH_64";
+		_bash_fx4 = bashFx4Seq, _bash_fx8 = bashFx8Seq, _lanes = 1;
+	}
+}
+
+void bashF(octet block[192], void* stack)
+{
+	if (!_bash_f)
+		mtCallOnce(&_once, bashFSelect);
+	_bash_f(block, stack);
+}
+
+size_t bashF_deep()
+{
+	return utilMax(3, bashF64_deep(), bashFAVX2_deep(), bashFAVX512_deep());
+}
+
+const char* bashPlatform()
+{
+	if (!_platform)
+		mtCallOnce(&_once, bashFSelect);
+	return _platform;
+}
+
+void bashFx4(octet* blocks[4], void* stack)
+{
+	if (!_bash_fx4)
+		mtCallOnce(&_once, bashFSelect);
+	_bash_fx4(blocks, stack);
+}
+
+void bashFx8(octet* blocks[8], void* stack)
+{
+	if (!_bash_fx8)
+		mtCallOnce(&_once, bashFSelect);
+	_bash_fx8(blocks, stack);
+}
+
+size_t bashFxLanes()
+{
+	if (!_lanes)
+		mtCallOnce(&_once, bashFSelect);
+	return _lanes;
+}
+
+/*
+*******************************************************************************
+Выбор реализации при компиляции
+*******************************************************************************
+*/
+
+#else
+
 #if defined(__AVX512F__) && defined(BASH_AVX512)
 	#include "bash_favx512.c"
-	const char bash_platform[] = "BASH_AVX512";
+	#define BASH_PLATFORM_NAME "BASH_AVX512"
 #elif defined(__AVX2__) && defined(BASH_AVX2)
 	#include "bash_favx2.c"
-	const char bash_platform[] = "BASH_AVX2";
+	#define BASH_PLATFORM_NAME "BASH_AVX2"
 #elif defined(__SSE2__) && defined(BASH_SSE2)
 	#include "bash_fsse2.c"
-	const char bash_platform[] = "BASH_SSE2";
+	#define BASH_PLATFORM_NAME "BASH_SSE2"
 #elif defined(__ARM_NEON__) && defined(BASH_NEON)
 	#include "bash_fneon.c"
-	const char bash_platform[] = "BASH_NEON";
+	#define BASH_PLATFORM_NAME "BASH_NEON"
 #elif !defined(U64_SUPPORT) || defined(BASH_32)
 	#include "bash_f32.c"
-	const char bash_platform[] = "BASH_32";
+	#define BASH_PLATFORM_NAME "BASH_32"
 #else
 	#include "bash_f64.c"
-	const char bash_platform[] = "BASH_64";
+	#define BASH_PLATFORM_NAME "BASH_64"
+#endif
+
+#include "bash_lcl.h"
+
+const char bash_platform[] = BASH_PLATFORM_NAME;
+
+const char* bashPlatform()
+{
+	return BASH_PLATFORM_NAME;
+}
+
+#if defined(__AVX512F__) && (OCTET_ORDER == LITTLE_ENDIAN)
+	#define BASH_FX_LANES 8
+#elif defined(__AVX2__) && (OCTET_ORDER == LITTLE_ENDIAN)
+	#define BASH_FX_LANES 4
+#else
+	#define BASH_FX_LANES 1
+#endif
+
+void bashFx4(octet* blocks[4], void* stack)
+{
+#if (BASH_FX_LANES == 4)
+	bashFx4AVX2(blocks);
+#else
+	bashF(blocks[0], stack);
+	bashF(blocks[1], stack);
+	bashF(blocks[2], stack);
+	bashF(blocks[3], stack);
+#endif
+}
+
+void bashFx8(octet* blocks[8], void* stack)
+{
+#if (BASH_FX_LANES == 8)
+	bashFx8AVX512(blocks);
+#else
+	bashFx4(blocks, stack);
+	bashFx4(blocks + 4, stack);
 #endif
+}
+
+size_t bashFxLanes()
+{
+	return BASH_FX_LANES;
+}
+
+#endif
+
+/*
+*******************************************************************************
+Многобуферная bash-f
+
+Функции bashFx4(), bashFx8() определены выше: они вызывают реализации
+из bash_fxavx2.c, bash_fxavx512.c, если те доступны, и последовательно
+обрабатывают состояния в противном случае. Если векторные регистры
+вмещают 8 состояний, то 4 состояния выгоднее обрабатывать последовательно
+с помощью bashF(), оптимизированной для той же платформы.
+
+Отдельной реализации для двух состояний нет (см. bash_lcl.h).
+*******************************************************************************
+*/
+
+void bashFx2(octet* blocks[2], void* stack)
+{
+	bashF(blocks[0], stack);
+	bashF(blocks[1], stack);
+}
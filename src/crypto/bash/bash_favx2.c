@@ -4,12 +4,21 @@
 \brief STB 34.101.77 (bash): bash-f optimized for AVX2
 \project bee2 [cryptographic library]
 \created 2019.04.03
-\version 2021.03.26
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
+#include "bee2/defs.h"
+
+// в режиме BASH_DISPATCH реализация выбирается в bash_f.c
+#ifdef BASH_DISPATCH
+	#define bashF bashFAVX2
+	#define bashF_deep bashFAVX2_deep
+	#define bashF2 bashF2AVX2
+#endif
+
 #ifndef __AVX2__
 	#error "The compiler does not support AVX2 intrinsics"
 #endif
@@ -5,12 +5,21 @@
 \remark AVX512 is interpreted here only as AVX512F
 \project bee2 [cryptographic library]
 \created 2019.04.03
-\version 2021.03.25
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
+#include "bee2/defs.h"
+
+// в режиме BASH_DISPATCH реализация выбирается в bash_f.c
+#ifdef BASH_DISPATCH
+	#define bashF bashFAVX512
+	#define bashF_deep bashFAVX512_deep
+	#define bashF2 bashF2AVX512
+#endif
+
 /*
 *******************************************************************************
 Архитектура AVX512 интерпретируется как AVX512F
@@ -0,0 +1,108 @@
+/*
+*******************************************************************************
+\file bash_fxavx2.c
+\brief STB 34.101.77 (bash): multi-buffer bash-f optimized for AVX2
+\project bee2 [cryptographic library]
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "bee2/defs.h"
+
+#if defined(__AVX2__) && (OCTET_ORDER == LITTLE_ENDIAN)
+
+#include <immintrin.h>
+
+#include "bee2/core/mem.h"
+#include "bee2/core/util.h"
+#include "bash_lcl.h"
+
+/*
+*******************************************************************************
+Векторные операции
+
+4 состояния обрабатываются в дорожках 256-разрядных слов. В AVX2 нет 
+инструкций циклического сдвига и "ornot", они выражаются через сдвиги
+и "andnot".
+*******************************************************************************
+*/
+
+#define VXOR(a, b) _mm256_xor_si256(a, b)
+#define VOR(a, b) _mm256_or_si256(a, b)
+#define VAND(a, b) _mm256_and_si256(a, b)
+#define VORN(a, b) _mm256_xor_si256(_mm256_andnot_si256(a, b), ones)
+#define VROT(a, m)\
+	((m) == 8 ? _mm256_shuffle_epi8(a, rot8) :\
+	(m) == 56 ? _mm256_shuffle_epi8(a, rot56) :\
+	_mm256_or_si256(_mm256_slli_epi64(a, m), _mm256_srli_epi64(a, 64 - m)))
+#define VC(c) _mm256_set1_epi64x((long long)(c))
+
+/*
+*******************************************************************************
+Транспонирование
+
+Четверки слов, расположенные в строках матрицы 4 x 4, переносятся 
+в столбцы. Преобразование используется и при загрузке, и при выгрузке
+состояний.
+*******************************************************************************
+*/
+
+static void bashFxTr4(__m256i w[4])
+{
+	__m256i t0, t1, t2, t3;
+	t0 = _mm256_unpacklo_epi64(w[0], w[1]);
+	t1 = _mm256_unpackhi_epi64(w[0], w[1]);
+	t2 = _mm256_unpacklo_epi64(w[2], w[3]);
+	t3 = _mm256_unpackhi_epi64(w[2], w[3]);
+	w[0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+	w[1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+	w[2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+	w[3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+}
+
+/*
+*******************************************************************************
+Bash-f x4
+*******************************************************************************
+*/
+
+void bashFx4AVX2(octet* blocks[4])
+{
+	__m256i s[24];
+	__m256i t0, t1, t2;
+	const __m256i ones = _mm256_set1_epi64x(-1);
+	const __m256i rot8 = _mm256_set_epi64x(0x0E0D0C0B0A09080Full,
+		0x0605040302010007ull, 0x0E0D0C0B0A09080Full, 0x0605040302010007ull);
+	const __m256i rot56 = _mm256_set_epi64x(0x080F0E0D0C0B0A09ull,
+		0x0007060504030201ull, 0x080F0E0D0C0B0A09ull, 0x0007060504030201ull);
+	size_t i, j;
+	// загрузить состояния
+	for (i = 0; i < 24; i += 4)
+	{
+		for (j = 0; j < 4; ++j)
+		{
+			ASSERT(memIsValid(blocks[j], 192));
+			s[i + j] = _mm256_loadu_si256((const __m256i*)(blocks[j] + 8 * i));
+		}
+		bashFxTr4(s + i);
+	}
+	// преобразовать
+	bashFxF0(s, t0, t1, t2);
+	// выгрузить состояния
+	for (i = 0; i < 24; i += 4)
+	{
+		bashFxTr4(s + i);
+		for (j = 0; j < 4; ++j)
+			_mm256_storeu_si256((__m256i*)(blocks[j] + 8 * i), s[i + j]);
+	}
+	// очистить
+	for (i = 0; i < 24; ++i)
+		s[i] = _mm256_setzero_si256();
+	t0 = t1 = t2 = _mm256_setzero_si256();
+	_mm256_zeroall();
+}
+
+#endif
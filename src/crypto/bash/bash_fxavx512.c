@@ -0,0 +1,115 @@
+/*
+*******************************************************************************
+\file bash_fxavx512.c
+\brief STB 34.101.77 (bash): multi-buffer bash-f optimized for AVX512
+\remark AVX512 is interpreted here only as AVX512F
+\project bee2 [cryptographic library]
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "bee2/defs.h"
+
+#if defined(__AVX512F__) && (OCTET_ORDER == LITTLE_ENDIAN)
+
+#include <immintrin.h>
+
+#include "bee2/core/mem.h"
+#include "bee2/core/util.h"
+#include "bash_lcl.h"
+
+/*
+*******************************************************************************
+Векторные операции
+
+8 состояний обрабатываются в дорожках 512-разрядных слов. Для "ornot"
+используется инструкция тернарной логики с константой 0xF3:
+A | ~B = ternarylogic(A, B, B, 0xF3).
+*******************************************************************************
+*/
+
+#define VXOR(a, b) _mm512_xor_si512(a, b)
+#define VOR(a, b) _mm512_or_si512(a, b)
+#define VAND(a, b) _mm512_and_si512(a, b)
+#define VORN(a, b) _mm512_ternarylogic_epi64(a, b, b, 0xF3)
+#define VROT(a, m) _mm512_rol_epi64(a, m)
+#define VC(c) _mm512_set1_epi64((long long)(c))
+
+/*
+*******************************************************************************
+Транспонирование
+
+Восьмерки слов, расположенные в строках матрицы 8 x 8, переносятся
+в столбцы: сначала переставляются слова внутри 128-разрядных четвертей,
+затем сами четверти.
+*******************************************************************************
+*/
+
+static void bashFxTr8(__m512i w[8])
+{
+	__m512i t[8];
+	__m512i u[8];
+	size_t i;
+	for (i = 0; i < 8; i += 2)
+	{
+		t[i] = _mm512_unpacklo_epi64(w[i], w[i + 1]);
+		t[i + 1] = _mm512_unpackhi_epi64(w[i], w[i + 1]);
+	}
+	for (i = 0; i < 8; i += 4)
+	{
+		u[i] = _mm512_shuffle_i64x2(t[i], t[i + 2], 0x88);
+		u[i + 1] = _mm512_shuffle_i64x2(t[i], t[i + 2], 0xDD);
+		u[i + 2] = _mm512_shuffle_i64x2(t[i + 1], t[i + 3], 0x88);
+		u[i + 3] = _mm512_shuffle_i64x2(t[i + 1], t[i + 3], 0xDD);
+	}
+	w[0] = _mm512_shuffle_i64x2(u[0], u[4], 0x88);
+	w[4] = _mm512_shuffle_i64x2(u[0], u[4], 0xDD);
+	w[2] = _mm512_shuffle_i64x2(u[1], u[5], 0x88);
+	w[6] = _mm512_shuffle_i64x2(u[1], u[5], 0xDD);
+	w[1] = _mm512_shuffle_i64x2(u[2], u[6], 0x88);
+	w[5] = _mm512_shuffle_i64x2(u[2], u[6], 0xDD);
+	w[3] = _mm512_shuffle_i64x2(u[3], u[7], 0x88);
+	w[7] = _mm512_shuffle_i64x2(u[3], u[7], 0xDD);
+}
+
+/*
+*******************************************************************************
+Bash-f x8
+*******************************************************************************
+*/
+
+void bashFx8AVX512(octet* blocks[8])
+{
+	__m512i s[24];
+	__m512i t0, t1, t2;
+	size_t i, j;
+	// загрузить состояния
+	for (i = 0; i < 24; i += 8)
+	{
+		for (j = 0; j < 8; ++j)
+		{
+			ASSERT(memIsValid(blocks[j], 192));
+			s[i + j] = _mm512_loadu_si512(blocks[j] + 8 * i);
+		}
+		bashFxTr8(s + i);
+	}
+	// преобразовать
+	bashFxF0(s, t0, t1, t2);
+	// выгрузить состояния
+	for (i = 0; i < 24; i += 8)
+	{
+		bashFxTr8(s + i);
+		for (j = 0; j < 8; ++j)
+			_mm512_storeu_si512(blocks[j] + 8 * i, s[i + j]);
+	}
+	// очистить
+	for (i = 0; i < 24; ++i)
+		s[i] = _mm512_setzero_si512();
+	t0 = t1 = t2 = _mm512_setzero_si512();
+	_mm256_zeroall();
+}
+
+#endif
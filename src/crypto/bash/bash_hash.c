@@ -4,7 +4,7 @@
 \brief STB 34.101.77 (bash): hashing algorithms
 \project bee2 [cryptographic library]
 \created 2014.07.15
-\version 2021.02.03
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -13,8 +13,10 @@
 #include "bee2/core/blob.h"
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/perf.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/bash.h"
+#include "bash_lcl.h"
 
 /*
 *******************************************************************************
@@ -49,33 +51,48 @@ void bashHashStart(void* state, size_t l)
 	st->pos = 0;
 }
 
-void bashHashStepH(const void* buf, size_t count, void* state)
+void bashHashStepHV(const iov_t iov[], size_t iov_count, void* state)
 {
 	bash_hash_st* st = (bash_hash_st*)state;
-	ASSERT(memIsDisjoint2(st, bashHash_keep(), buf, count));
-	// не накопился полный буфер?
-	if (count < st->buf_len - st->pos)
-	{
-		memCopy(st->s + st->pos, buf, count);
-		st->pos += count;
-		return;
-	}
-	// новый полный буфер
-	memCopy(st->s + st->pos, buf, st->buf_len - st->pos);
-	buf = (const octet*)buf + st->buf_len - st->pos;
-	count -= st->buf_len - st->pos;
-	bashF(st->s, st->stack);
-	// цикл по полным блокам
-	while (count >= st->buf_len)
+	const octet* buf;
+	size_t count;
+	ASSERT(memIsValid(iov, sizeof(iov_t) * iov_count));
+	// цикл по фрагментам
+	for (; iov_count--; ++iov)
 	{
-		memCopy(st->s, buf, st->buf_len);
-		buf = (const octet*)buf + st->buf_len;
-		count -= st->buf_len;
+		buf = (const octet*)iov->buf, count = iov->count;
+		ASSERT(memIsDisjoint2(st, bashHash_keep(), buf, count));
+		// не накопился полный буфер?
+		if (count < st->buf_len - st->pos)
+		{
+			memCopy(st->s + st->pos, buf, count);
+			st->pos += count;
+			continue;
+		}
+		// новый полный буфер
+		memCopy(st->s + st->pos, buf, st->buf_len - st->pos);
+		buf += st->buf_len - st->pos;
+		count -= st->buf_len - st->pos;
 		bashF(st->s, st->stack);
+		// цикл по полным блокам фрагмента
+		while (count >= st->buf_len)
+		{
+			memCopy(st->s, buf, st->buf_len);
+			buf += st->buf_len;
+			count -= st->buf_len;
+			bashF(st->s, st->stack);
+		}
+		// неполный блок?
+		if (st->pos = count)
+			memCopy(st->s, buf, count);
 	}
-	// неполный блок?
-	if (st->pos = count)
-		memCopy(st->s, buf, count);
+}
+
+void bashHashStepH(const void* buf, size_t count, void* state)
+{
+	iov_t iov[1];
+	iov->buf = (void*)buf, iov->count = count;
+	bashHashStepHV(iov, 1, state);
 }
 
 static void bashHashStepG_internal(size_t hash_len, void* state)
@@ -115,7 +132,8 @@ bool_t bashHashStepV(const octet hash[], size_t hash_len, void* state)
 	return memEq(hash, st->s1, hash_len);
 }
 
-err_t bashHash(octet hash[], size_t l, const void* src, size_t count)
+static err_t bashHash_internal(octet hash[], size_t l, const void* src,
+	size_t count)
 {
 	void* state;
 	// проверить входные данные
@@ -135,3 +153,192 @@ err_t bashHash(octet hash[], size_t l, const void* src, size_t count)
 	blobClose(state);
 	return ERR_OK;
 }
+
+err_t bashHash(octet hash[], size_t l, const void* src, size_t count)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	code = bashHash_internal(hash, l, src, count);
+	PERF_STOP(PERF_BASH_HASH, code, count, ticks);
+	return code;
+}
+
+/*
+*******************************************************************************
+Многобуферное хэширование
+
+Сообщения распределяются по дорожкам многобуферной sponge-функции. 
+В каждой дорожке ведется собственное хэш-состояние s[k]. На каждом шаге 
+в состояния активных дорожек загружаются очередные блоки сообщений, после
+чего все состояния одновременно преобразуются с помощью bashFx8() 
+или bashFx4(). Дорожка, в которой обработан последний (дополненный) блок
+сообщения, выгружает хэш-значение и получает следующее сообщение.
+
+Если активных дорожек меньше, чем размерность вызываемой функции bashFxN(),
+то преобразуются и состояния неактивных дорожек (результат не используется).
+Если же активных дорожек не больше 4, а векторные регистры вмещают 8 
+состояний (или векторные регистры не используются), то состояния
+активных дорожек обрабатываются последовательно с помощью bashF().
+Указатели на состояния активных дорожек предшествуют в blocks указателям
+на состояния неактивных дорожек.
+
+Загрузка блоков и дополнение последнего блока повторяют bashHashStepH()
+и bashHashStepG(). Поэтому bashHashMulti() и bashHash() дают одинаковые
+хэш-значения.
+*******************************************************************************
+*/
+
+typedef struct {
+	octet s[8][192];	/*< состояния дорожек */
+	octet* blocks[8];	/*< указатели на состояния */
+	size_t idx[8];		/*< номер сообщения в дорожке (n -- нет сообщения) */
+	size_t pos[8];		/*< позиция в сообщении */
+	bool_t last[8];		/*< загружен последний блок? */
+	octet stack[];		/*< [bashF_deep()] стек bashF */
+} bash_hash_multi_st;
+
+static void bashHashMultiStart(bash_hash_multi_st* st, size_t k, size_t l)
+{
+	memSetZero(st->s[k], 192);
+	st->s[k][192 - 8] = (octet)(l / 4);
+	st->pos[k] = 0;
+	st->last[k] = FALSE;
+}
+
+err_t bashHashMulti(octet hash[], size_t l, const void* const src[],
+	const size_t count[], size_t n)
+{
+	bash_hash_multi_st* st;
+	size_t lanes, buf_len, next, active, k, i;
+	// проверить входные данные
+	if (l == 0 || l % 16 != 0 || l > 256)
+		return ERR_BAD_PARAMS;
+	if (!memIsValid(src, n * sizeof(const void*)) ||
+		!memIsValid(count, n * sizeof(size_t)) ||
+		!memIsValid(hash, n * (l / 4)))
+		return ERR_BAD_INPUT;
+	for (i = 0; i < n; ++i)
+		if (!memIsValid(src[i], count[i]))
+			return ERR_BAD_INPUT;
+	// создать состояние
+	st = (bash_hash_multi_st*)blobCreate(
+		sizeof(bash_hash_multi_st) + bashF_deep());
+	if (st == 0)
+		return ERR_OUTOFMEMORY;
+	// распределить первые сообщения
+	lanes = MAX2(bashFxLanes(), 4);
+	buf_len = 192 - l / 2;
+	for (k = 0, next = 0; k < lanes; ++k)
+	{
+		bashHashMultiStart(st, k, l);
+		st->idx[k] = next < n ? next++ : n;
+	}
+	// обработать сообщения
+	while (1)
+	{
+		// загрузить блоки
+		for (k = active = 0; k < lanes; ++k)
+		{
+			const octet* buf;
+			size_t rest;
+			if (st->idx[k] == n)
+				continue;
+			buf = (const octet*)src[st->idx[k]] + st->pos[k];
+			rest = count[st->idx[k]] - st->pos[k];
+			// полный блок
+			if (rest >= buf_len)
+			{
+				memCopy(st->s[k], buf, buf_len);
+				st->pos[k] += buf_len;
+			}
+			// последний блок
+			else
+			{
+				memCopy(st->s[k], buf, rest);
+				memSetZero(st->s[k] + rest, buf_len - rest);
+				st->s[k][rest] = 0x40;
+				st->last[k] = TRUE;
+			}
+			st->blocks[active++] = st->s[k];
+		}
+		if (active == 0)
+			break;
+		// дополнить список состояниями неактивных дорожек
+		for (k = 0, i = active; k < lanes; ++k)
+			if (st->idx[k] == n)
+				st->blocks[i++] = st->s[k];
+		// преобразовать состояния
+		if (active > 4)
+			bashFx8(st->blocks, st->stack);
+		else if (active > 1 && bashFxLanes() == 4)
+			bashFx4(st->blocks, st->stack);
+		else
+			for (i = 0; i < active; ++i)
+				bashF(st->blocks[i], st->stack);
+		// выгрузить хэш-значения и распределить следующие сообщения
+		for (k = 0; k < lanes; ++k)
+			if (st->idx[k] < n && st->last[k])
+			{
+				memCopy(hash + st->idx[k] * (l / 4), st->s[k], l / 4);
+				bashHashMultiStart(st, k, l);
+				st->idx[k] = next < n ? next++ : n;
+			}
+	}
+	// завершить
+	blobClose(st);
+	return ERR_OK;
+}
+
+/*
+*******************************************************************************
+Сохранение состояния
+
+Формат: заголовок (см. crypto_lcl.h) || [192]s || <buf_len>_8 || <pos>_8.
+
+\remark Длина буфера buf_len = 192 - l / 2 кратна 8 и лежит в диапазоне
+[64, 184]. Октеты s[pos..buf_len) не используются и сохраняются нулевыми.
+*******************************************************************************
+*/
+
+#define BASH_HASH_STATE_LEN (4 + 192 + 1 + 1)
+
+err_t bashHashStateEnc(octet buf[], size_t* count, const void* state)
+{
+	const bash_hash_st* st = (const bash_hash_st*)state;
+	if (!memIsValid(count, O_PER_S) ||
+		!memIsNullOrValid(buf, *count) ||
+		!memIsValid(state, bashHash_keep()))
+		return ERR_BAD_INPUT;
+	if (buf)
+	{
+		if (*count < BASH_HASH_STATE_LEN)
+			return ERR_OUTOFMEMORY;
+		ASSERT(st->pos < st->buf_len && st->buf_len <= 184);
+		cryptoStateHdrEnc(buf, BASH_STATE_HASH, BASH_HASH_STATE_LEN);
+		memCopy(buf + 4, st->s, st->pos);
+		memSetZero(buf + 4 + st->pos, st->buf_len - st->pos);
+		memCopy(buf + 4 + st->buf_len, st->s + st->buf_len, 
+			192 - st->buf_len);
+		buf[196] = (octet)st->buf_len;
+		buf[197] = (octet)st->pos;
+	}
+	*count = BASH_HASH_STATE_LEN;
+	return ERR_OK;
+}
+
+err_t bashHashStateDec(void* state, const octet buf[], size_t count)
+{
+	bash_hash_st* st = (bash_hash_st*)state;
+	if (!memIsValid(state, bashHash_keep()) || !memIsValid(buf, count))
+		return ERR_BAD_INPUT;
+	if (count != BASH_HASH_STATE_LEN ||
+		!cryptoStateHdrIsValid(buf, BASH_STATE_HASH, BASH_HASH_STATE_LEN) ||
+		buf[196] % 8 || buf[196] < 64 || buf[196] > 184 || 
+		buf[197] >= buf[196] || 
+		!memIsZero(buf + 4 + buf[197], buf[196] - buf[197]))
+		return ERR_BAD_FORMAT;
+	memCopy(st->s, buf + 4, 192);
+	st->buf_len = buf[196];
+	st->pos = buf[197];
+	return ERR_OK;
+}
@@ -0,0 +1,143 @@
+/*
+*******************************************************************************
+\file bash_lcl.h
+\brief STB 34.101.77 (bash): local definitions
+\project bee2 [cryptographic library]
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#ifndef __BASH_LCL_H
+#define __BASH_LCL_H
+
+#include "bee2/defs.h"
+#include "../crypto_lcl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+*******************************************************************************
+Многобуферная bash-f
+
+Несколько (n) состояний bash-f преобразуются одновременно: i-е слово
+состояния номер j размещается в j-й дорожке вектора s[i], i = 0, 1,..., 23.
+Макрос bashFxF0 выполняет 24 такта bash-f над массивом векторов s.
+Структура тактов повторяет реализацию из bash_f64.c, перестановка P
+реализуется за счет перенумерации векторов и не требует инструкций.
+
+Перед включением заголовочного файла должны быть определены макросы,
+задающие векторные операции:
+-	VXOR(a, b) -- a ^ b;
+-	VOR(a, b) -- a | b;
+-	VAND(a, b) -- a & b;
+-	VORN(a, b) -- a | ~b;
+-	VROT(a, m) -- RotHi(a, m) в каждой дорожке;
+-	VC(c) -- c в каждой дорожке.
+*******************************************************************************
+*/
+
+#define bashFxS(w0, w1, w2, m1, n1, m2, n2, t0, t1, t2)\
+	t2 = VROT(w0, m1);\
+	w0 = VXOR(w0, VXOR(w1, w2));\
+	t1 = VXOR(w1, VROT(w0, n1));\
+	w1 = VXOR(t1, t2);\
+	w2 = VXOR(w2, VXOR(VROT(w2, m2), VROT(t1, n2)));\
+	t1 = VOR(w0, w2);\
+	t2 = VAND(w0, w1);\
+	t0 = VORN(w1, w2);\
+	w0 = VXOR(w0, t0);\
+	w1 = VXOR(w1, t1);\
+	w2 = VXOR(w2, t2)
+
+#define bashFxP0(x) x
+
+#define bashFxP1(x)\
+	((x < 8) ? 8 + (x + 2 * (x & 1) + 7) % 8 :\
+		((x < 16) ? 8 + (x ^ 1) : (5 * x + 6) % 8))
+
+#define bashFxP2(x) bashFxP1(bashFxP1(x))
+
+#define bashFxP3(x)\
+	(8 * (x / 8) + ( x % 8 + 4) % 8)
+
+#define bashFxP4(x) bashFxP1(bashFxP3(x))
+#define bashFxP5(x) bashFxP2(bashFxP3(x))
+
+#define bashFxR(s, p, p_next, c, t0, t1, t2)\
+	bashFxS(s[p( 0)], s[p( 8)], s[p(16)],  8, 53, 14,  1, t0, t1, t2);\
+	bashFxS(s[p( 1)], s[p( 9)], s[p(17)], 56, 51, 34,  7, t0, t1, t2);\
+	bashFxS(s[p( 2)], s[p(10)], s[p(18)],  8, 37, 46, 49, t0, t1, t2);\
+	bashFxS(s[p( 3)], s[p(11)], s[p(19)], 56,  3,  2, 23, t0, t1, t2);\
+	bashFxS(s[p( 4)], s[p(12)], s[p(20)],  8, 21, 14, 33, t0, t1, t2);\
+	bashFxS(s[p( 5)], s[p(13)], s[p(21)], 56, 19, 34, 39, t0, t1, t2);\
+	bashFxS(s[p( 6)], s[p(14)], s[p(22)],  8,  5, 46, 17, t0, t1, t2);\
+	bashFxS(s[p( 7)], s[p(15)], s[p(23)], 56, 35,  2, 55, t0, t1, t2);\
+	s[p_next(23)] = VXOR(s[p_next(23)], VC(c))
+
+#define bashFxF0(s, t0, t1, t2)\
+	bashFxR(s, bashFxP0, bashFxP1, 0x3BF5080AC8BA94B1ull, t0, t1, t2);\
+	bashFxR(s, bashFxP1, bashFxP2, 0xC1D1659C1BBD92F6ull, t0, t1, t2);\
+	bashFxR(s, bashFxP2, bashFxP3, 0x60E8B2CE0DDEC97Bull, t0, t1, t2);\
+	bashFxR(s, bashFxP3, bashFxP4, 0xEC5FB8FE790FBC13ull, t0, t1, t2);\
+	bashFxR(s, bashFxP4, bashFxP5, 0xAA043DE6436706A7ull, t0, t1, t2);\
+	bashFxR(s, bashFxP5, bashFxP0, 0x8929FF6A5E535BFDull, t0, t1, t2);\
+	bashFxR(s, bashFxP0, bashFxP1, 0x98BF1E2C50C97550ull, t0, t1, t2);\
+	bashFxR(s, bashFxP1, bashFxP2, 0x4C5F8F162864BAA8ull, t0, t1, t2);\
+	bashFxR(s, bashFxP2, bashFxP3, 0x262FC78B14325D54ull, t0, t1, t2);\
+	bashFxR(s, bashFxP3, bashFxP4, 0x1317E3C58A192EAAull, t0, t1, t2);\
+	bashFxR(s, bashFxP4, bashFxP5, 0x098BF1E2C50C9755ull, t0, t1, t2);\
+	bashFxR(s, bashFxP5, bashFxP0, 0xD8EE19681D669304ull, t0, t1, t2);\
+	bashFxR(s, bashFxP0, bashFxP1, 0x6C770CB40EB34982ull, t0, t1, t2);\
+	bashFxR(s, bashFxP1, bashFxP2, 0x363B865A0759A4C1ull, t0, t1, t2);\
+	bashFxR(s, bashFxP2, bashFxP3, 0xC73622B47C4C0ACEull, t0, t1, t2);\
+	bashFxR(s, bashFxP3, bashFxP4, 0x639B115A3E260567ull, t0, t1, t2);\
+	bashFxR(s, bashFxP4, bashFxP5, 0xEDE6693460F3DA1Dull, t0, t1, t2);\
+	bashFxR(s, bashFxP5, bashFxP0, 0xAAD8D5034F9935A0ull, t0, t1, t2);\
+	bashFxR(s, bashFxP0, bashFxP1, 0x556C6A81A7CC9AD0ull, t0, t1, t2);\
+	bashFxR(s, bashFxP1, bashFxP2, 0x2AB63540D3E64D68ull, t0, t1, t2);\
+	bashFxR(s, bashFxP2, bashFxP3, 0x155B1AA069F326B4ull, t0, t1, t2);\
+	bashFxR(s, bashFxP3, bashFxP4, 0x0AAD8D5034F9935Aull, t0, t1, t2);\
+	bashFxR(s, bashFxP4, bashFxP5, 0x0556C6A81A7CC9ADull, t0, t1, t2);\
+	bashFxR(s, bashFxP5, bashFxP0, 0xDE8082CD72DEBC78ull, t0, t1, t2)
+
+/*
+*******************************************************************************
+Реализации многобуферной bash-f
+
+Реализации bashFx4AVX2(), bashFx8AVX512() размещаются в модулях 
+bash_fxavx2.c, bash_fxavx512.c и присутствуют в библиотеке, только если 
+соответствующие модули скомпилированы с поддержкой нужных инструкций. 
+Выбор между реализациями выполняется в bash_f.c.
+
+\remark Реализация для двух состояний на SSE2 (128-разрядные дорожки) 
+проигрывает двум последовательным вызовам bashF() уже на платформе BASH_64:
+в SSE2 нет инструкций циклического сдвига.
+*******************************************************************************
+*/
+
+void bashFx4AVX2(octet* blocks[4]);
+void bashFx8AVX512(octet* blocks[8]);
+
+/*
+*******************************************************************************
+Сохранение состояний
+
+Сохраненное состояние начинается с заголовка (см. crypto_lcl.h). Состояние 
+bash-f сохраняется как строка октетов, в которой слова следуют младшими 
+октетами вперед (так состояние хранится в памяти на всех платформах).
+*******************************************************************************
+*/
+
+#define BASH_STATE_HASH		0x21	/* bash-hash */
+#define BASH_STATE_PRG		0x22	/* bash-prg */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __BASH_LCL_H */
@@ -4,16 +4,18 @@
 \brief STB 34.101.77 (bash): programmable algorithms
 \project bee2 [cryptographic library]
 \created 2018.10.30
-\version 2023.04.07
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
 #include "bee2/core/blob.h"
+#include "bee2/core/err.h"
 #include "bee2/core/mem.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/bash.h"
+#include "bash_lcl.h"
 
 /*
 *******************************************************************************
@@ -180,33 +182,48 @@ void bashPrgAbsorbStart(void* state)
 	bashPrgCommit(BASH_PRG_DATA, state);
 }
 
-void bashPrgAbsorbStep(const void* buf, size_t count, void* state)
+void bashPrgAbsorbStepV(const iov_t iov[], size_t iov_count, void* state)
 {
 	bash_prg_st* st = (bash_prg_st*)state;
-	ASSERT(memIsDisjoint2(st, bashPrg_keep(), buf, count));
-	// не накопился полный буфер?
-	if (count < st->buf_len - st->pos)
-	{
-		memXor2(st->s + st->pos, buf, count);
-		st->pos += count;
-		return;
-	}
-	// новый полный буфер
-	memXor2(st->s + st->pos, buf, st->buf_len - st->pos);
-	buf = (const octet*)buf + st->buf_len - st->pos;
-	count -= st->buf_len - st->pos;
-	bashF(st->s, st->stack);
-	// цикл по полным блокам
-	while (count >= st->buf_len)
+	const octet* buf;
+	size_t count;
+	ASSERT(memIsValid(iov, sizeof(iov_t) * iov_count));
+	// цикл по фрагментам
+	for (; iov_count--; ++iov)
 	{
-		memXor2(st->s, buf, st->buf_len);
-		buf = (const octet*)buf + st->buf_len;
-		count -= st->buf_len;
+		buf = (const octet*)iov->buf, count = iov->count;
+		ASSERT(memIsDisjoint2(st, bashPrg_keep(), buf, count));
+		// не накопился полный буфер?
+		if (count < st->buf_len - st->pos)
+		{
+			memXor2(st->s + st->pos, buf, count);
+			st->pos += count;
+			continue;
+		}
+		// новый полный буфер
+		memXor2(st->s + st->pos, buf, st->buf_len - st->pos);
+		buf += st->buf_len - st->pos;
+		count -= st->buf_len - st->pos;
 		bashF(st->s, st->stack);
+		// цикл по полным блокам фрагмента
+		while (count >= st->buf_len)
+		{
+			memXor2(st->s, buf, st->buf_len);
+			buf += st->buf_len;
+			count -= st->buf_len;
+			bashF(st->s, st->stack);
+		}
+		// неполный блок?
+		if (st->pos = count)
+			memXor2(st->s, buf, count);
 	}
-	// неполный блок?
-	if (st->pos = count)
-		memXor2(st->s, buf, count);
+}
+
+void bashPrgAbsorbStep(const void* buf, size_t count, void* state)
+{
+	iov_t iov[1];
+	iov->buf = (void*)buf, iov->count = count;
+	bashPrgAbsorbStepV(iov, 1, state);
 }
 
 void bashPrgAbsorb(const void* buf, size_t count, void* state)
@@ -273,41 +290,56 @@ void bashPrgEncrStart(void* state)
 	bashPrgCommit(BASH_PRG_TEXT, state);
 }
 
-void bashPrgEncrStep(void* buf, size_t count, void* state)
+void bashPrgEncrStepV(const iov_t iov[], size_t iov_count, void* state)
 {
 	bash_prg_st* st = (bash_prg_st*)state;
-	ASSERT(memIsDisjoint2(st, bashPrg_keep(), buf, count));
-	// остатка буфера достаточно?
-	if (count < st->buf_len - st->pos)
-	{
-		memXor2(st->s + st->pos, buf, count);
-		memCopy(buf, st->s + st->pos, count);
-		st->pos += count;
-		return;
-	}
-	// новый буфер
-	memXor2(st->s + st->pos, buf, st->buf_len - st->pos);
-	memCopy(buf, st->s + st->pos, st->buf_len - st->pos);
-	buf = (octet*)buf + st->buf_len - st->pos;
-	count -= st->buf_len - st->pos;
-	bashF(st->s, st->stack);
-	// цикл по полным блокам
-	while (count >= st->buf_len)
+	octet* buf;
+	size_t count;
+	ASSERT(memIsValid(iov, sizeof(iov_t) * iov_count));
+	// цикл по фрагментам
+	for (; iov_count--; ++iov)
 	{
-		memXor2(st->s, buf, st->buf_len);
-		memCopy(buf, st->s, st->buf_len);
-		buf = (octet*)buf + st->buf_len;
-		count -= st->buf_len;
+		buf = (octet*)iov->buf, count = iov->count;
+		ASSERT(memIsDisjoint2(st, bashPrg_keep(), buf, count));
+		// остатка буфера достаточно?
+		if (count < st->buf_len - st->pos)
+		{
+			memXor2(st->s + st->pos, buf, count);
+			memCopy(buf, st->s + st->pos, count);
+			st->pos += count;
+			continue;
+		}
+		// новый буфер
+		memXor2(st->s + st->pos, buf, st->buf_len - st->pos);
+		memCopy(buf, st->s + st->pos, st->buf_len - st->pos);
+		buf += st->buf_len - st->pos;
+		count -= st->buf_len - st->pos;
 		bashF(st->s, st->stack);
-	}
-	// неполный блок
-	if (st->pos = count)
-	{
-		memXor2(st->s, buf, count);
-		memCopy(buf, st->s, count);
+		// цикл по полным блокам фрагмента
+		while (count >= st->buf_len)
+		{
+			memXor2(st->s, buf, st->buf_len);
+			memCopy(buf, st->s, st->buf_len);
+			buf += st->buf_len;
+			count -= st->buf_len;
+			bashF(st->s, st->stack);
+		}
+		// неполный блок
+		if (st->pos = count)
+		{
+			memXor2(st->s, buf, count);
+			memCopy(buf, st->s, count);
+		}
 	}
 }
 
+void bashPrgEncrStep(void* buf, size_t count, void* state)
+{
+	iov_t iov[1];
+	iov->buf = buf, iov->count = count;
+	bashPrgEncrStepV(iov, 1, state);
+}
+
 void bashPrgEncr(void* buf, size_t count, void* state)
 {
 	bashPrgEncrStart(state);
@@ -326,41 +358,56 @@ void bashPrgDecrStart(void* state)
 	bashPrgCommit(BASH_PRG_TEXT, state);
 }
 
-void bashPrgDecrStep(void* buf, size_t count, void* state)
+void bashPrgDecrStepV(const iov_t iov[], size_t iov_count, void* state)
 {
 	bash_prg_st* st = (bash_prg_st*)state;
-	ASSERT(memIsDisjoint2(st, bashPrg_keep(), buf, count));
-	// остатка буфера достаточно?
-	if (count < st->buf_len - st->pos)
-	{
-		memXor2(buf, st->s + st->pos, count);
-		memXor2(st->s + st->pos, buf, count);
-		st->pos += count;
-		return;
-	}
-	// новый буфер
-	memXor2(buf, st->s + st->pos, st->buf_len - st->pos);
-	memXor2(st->s + st->pos, buf, st->buf_len - st->pos);
-	buf = (octet*)buf + st->buf_len - st->pos;
-	count -= st->buf_len - st->pos;
-	bashF(st->s, st->stack);
-	// цикл по полным блокам
-	while (count >= st->buf_len)
+	octet* buf;
+	size_t count;
+	ASSERT(memIsValid(iov, sizeof(iov_t) * iov_count));
+	// цикл по фрагментам
+	for (; iov_count--; ++iov)
 	{
-		memXor2(buf, st->s, st->buf_len);
-		memXor2(st->s, buf, st->buf_len);
-		buf = (octet*)buf + st->buf_len;
-		count -= st->buf_len;
+		buf = (octet*)iov->buf, count = iov->count;
+		ASSERT(memIsDisjoint2(st, bashPrg_keep(), buf, count));
+		// остатка буфера достаточно?
+		if (count < st->buf_len - st->pos)
+		{
+			memXor2(buf, st->s + st->pos, count);
+			memXor2(st->s + st->pos, buf, count);
+			st->pos += count;
+			continue;
+		}
+		// новый буфер
+		memXor2(buf, st->s + st->pos, st->buf_len - st->pos);
+		memXor2(st->s + st->pos, buf, st->buf_len - st->pos);
+		buf += st->buf_len - st->pos;
+		count -= st->buf_len - st->pos;
 		bashF(st->s, st->stack);
-	}
-	// неполный блок
-	if (st->pos = count)
-	{
-		memXor2(buf, st->s, count);
-		memXor2(st->s, buf, count);
+		// цикл по полным блокам фрагмента
+		while (count >= st->buf_len)
+		{
+			memXor2(buf, st->s, st->buf_len);
+			memXor2(st->s, buf, st->buf_len);
+			buf += st->buf_len;
+			count -= st->buf_len;
+			bashF(st->s, st->stack);
+		}
+		// неполный блок
+		if (st->pos = count)
+		{
+			memXor2(buf, st->s, count);
+			memXor2(st->s, buf, count);
+		}
 	}
 }
 
+void bashPrgDecrStep(void* buf, size_t count, void* state)
+{
+	iov_t iov[1];
+	iov->buf = buf, iov->count = count;
+	bashPrgDecrStepV(iov, 1, state);
+}
+
 void bashPrgDecr(void* buf, size_t count, void* state)
 {
 	bashPrgDecrStart(state);
@@ -384,3 +431,62 @@ void bashPrgRatchet(void* state)
 	// необратимо изменить
 	memXor2(st->s, st->t, 192);
 }
+
+/*
+*******************************************************************************
+Сохранение состояния
+
+Формат: заголовок (см. crypto_lcl.h) || [192]s || <l / 8>_8 || <d>_8 || 
+<buf_len>_8 || <pos>_8.
+
+\remark При восстановлении проверяется, что длина буфера buf_len 
+соответствует параметрам l, d в ключевом или бесключевом режиме (см. таблицу
+в начале модуля).
+*******************************************************************************
+*/
+
+#define BASH_PRG_STATE_LEN (4 + 192 + 4)
+
+err_t bashPrgStateEnc(octet buf[], size_t* count, const void* state)
+{
+	const bash_prg_st* st = (const bash_prg_st*)state;
+	if (!memIsValid(count, O_PER_S) ||
+		!memIsNullOrValid(buf, *count) ||
+		!memIsValid(state, bashPrg_keep()))
+		return ERR_BAD_INPUT;
+	if (buf)
+	{
+		if (*count < BASH_PRG_STATE_LEN)
+			return ERR_OUTOFMEMORY;
+		ASSERT(st->pos < st->buf_len);
+		cryptoStateHdrEnc(buf, BASH_STATE_PRG, BASH_PRG_STATE_LEN);
+		memCopy(buf + 4, st->s, 192);
+		buf[196] = (octet)(st->l / 8);
+		buf[197] = (octet)st->d;
+		buf[198] = (octet)st->buf_len;
+		buf[199] = (octet)st->pos;
+	}
+	*count = BASH_PRG_STATE_LEN;
+	return ERR_OK;
+}
+
+err_t bashPrgStateDec(void* state, const octet buf[], size_t count)
+{
+	bash_prg_st* st = (bash_prg_st*)state;
+	size_t l, d;
+	if (!memIsValid(state, bashPrg_keep()) || !memIsValid(buf, count))
+		return ERR_BAD_INPUT;
+	if (count != BASH_PRG_STATE_LEN ||
+		!cryptoStateHdrIsValid(buf, BASH_STATE_PRG, BASH_PRG_STATE_LEN))
+		return ERR_BAD_FORMAT;
+	l = (size_t)buf[196] * 8, d = buf[197];
+	if (l != 128 && l != 192 && l != 256 || d != 1 && d != 2 ||
+		buf[198] != 192 - l * (2 + d) / 16 && buf[198] != 192 - d * l / 4 ||
+		buf[199] >= buf[198])
+		return ERR_BAD_FORMAT;
+	memCopy(st->s, buf + 4, 192);
+	st->l = l, st->d = d;
+	st->buf_len = buf[198];
+	st->pos = buf[199];
+	return ERR_OK;
+}
@@ -4,7 +4,7 @@
 \brief STB 34.101.60 (bels): secret sharing algorithms
 \project bee2 [cryptographic library]
 \created 2013.05.14
-\version 2021.04.15
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -311,12 +311,20 @@ static void belsGenkStepR(void* buf, size_t count, void* state)
 *******************************************************************************
 */
 
-err_t belsShare(octet si[], size_t count, size_t threshold, size_t len, 
+size_t belsShare_keep(size_t threshold, size_t len)
+{
+	const size_t n = W_OF_O(len);
+	return O_OF_W(2 * threshold * n + 1) + 
+		utilMax(2, 
+			ppMul_deep(threshold * n - n, n),
+			ppMod_deep(threshold * n, n + 1));
+}
+
+err_t belsShare_ws(octet si[], size_t count, size_t threshold, size_t len, 
 	const octet s[], const octet m0[], const octet mi[], 
-	gen_i rng, void* rng_state)
+	gen_i rng, void* rng_state, void* workspace)
 {
 	size_t n, i;
-	void* state;
 	word* f;
 	word* k;
 	word* c;
@@ -328,19 +336,13 @@ err_t belsShare(octet si[], size_t count, size_t threshold, size_t len,
 	if ((len != 16 && len != 24 && len != 32) || 
 		threshold == 0 || count < threshold ||
 		!memIsValid(s, len) || !memIsValid(m0, len) || 
-		!memIsValid(mi, len * count) || !memIsValid(si, count * len))
+		!memIsValid(mi, len * count) || !memIsValid(si, count * len) ||
+		!memIsValid(workspace, belsShare_keep(threshold, len)))
 		return ERR_BAD_INPUT;
 	EXPECT(belsValM(m0, len) == ERR_OK);
-	// создать состояние
+	// раскладка рабочей памяти
 	n = W_OF_O(len);
-	state = blobCreate(O_OF_W(2 * threshold * n + 1) + 
-		utilMax(2, 
-			ppMul_deep(threshold * n - n, n),
-			ppMod_deep(threshold * n, n + 1)));
-	if (state == 0)
-		return ERR_OUTOFMEMORY;
-	// раскладка состояния
-	f = (word*)state;
+	f = (word*)workspace;
 	k = f + n + 1;
 	c = k + threshold * n - n;
 	stack = c + threshold * n;
@@ -364,11 +366,33 @@ err_t belsShare(octet si[], size_t count, size_t threshold, size_t len,
 		ppMod(f, c, threshold * n, f, n + 1, stack);
 		wwTo(si + i * len, len, f);
 	}
-	// завершение
-	blobClose(state);
 	return ERR_OK;
 }
 
+err_t belsShare(octet si[], size_t count, size_t threshold, size_t len, 
+	const octet s[], const octet m0[], const octet mi[], 
+	gen_i rng, void* rng_state)
+{
+	err_t code;
+	void* state;
+	// проверить генератор
+	if (rng == 0)
+		return ERR_BAD_RNG;
+	// проверить входные данные
+	if ((len != 16 && len != 24 && len != 32) || threshold == 0)
+		return ERR_BAD_INPUT;
+	// создать состояние
+	state = blobCreate(belsShare_keep(threshold, len));
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// разделить секрет
+	code = belsShare_ws(si, count, threshold, len, s, m0, mi, rng, rng_state,
+		state);
+	// завершить
+	blobClose(state);
+	return code;
+}
+
 err_t belsShare2(octet si[], size_t count, size_t threshold, size_t len,
 	const octet s[], gen_i rng, void* rng_state)
 {
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): CHE (Ctr-Hash-Encrypt) authenticated encryption
 \project bee2 [cryptographic library]
 \created 2020.03.20
-\version 2020.07.31
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -13,6 +13,7 @@
 #include "bee2/core/blob.h"
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/perf.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/belt.h"
 #include "bee2/math/ww.h"
@@ -252,11 +253,10 @@ bool_t beltCHEStepV(const octet mac[8], void* state)
 	return memEq(mac, st->t1, 8);
 }
 
-err_t beltCHEWrap(void* dest, octet mac[8], const void* src1, size_t count1,
-	const void* src2, size_t count2, const octet key[], size_t len,
-	const octet iv[16])
+static err_t beltCHEWrap_internal(void* dest, octet mac[8], const void* src1,
+	size_t count1, const void* src2, size_t count2, const octet key[],
+	size_t len, const octet iv[16], void* workspace)
 {
-	void* state;
 	// проверить входные данные
 	if (len != 16 && len != 24 && len != 32 ||
 		!memIsValid(src1, count1) ||
@@ -264,29 +264,53 @@ err_t beltCHEWrap(void* dest, octet mac[8], const void* src1, size_t count1,
 		!memIsValid(key, len) ||
 		!memIsValid(iv, 16) ||
 		!memIsValid(dest, count1) ||
-		!memIsValid(mac, 8))
+		!memIsValid(mac, 8) ||
+		!memIsValid(workspace, beltCHE_keep()))
 		return ERR_BAD_INPUT;
+	// установить защиту (I перед E из-за разрешенного пересечения src2 и dest)
+	beltCHEStart(workspace, key, len, iv);
+	beltCHEStepI(src2, count2, workspace);
+	memMove(dest, src1, count1);
+	beltCHEStepE(dest, count1, workspace);
+	beltCHEStepA(dest, count1, workspace);
+	beltCHEStepG(mac, workspace);
+	return ERR_OK;
+}
+
+err_t beltCHEWrap_ws(void* dest, octet mac[8], const void* src1, size_t count1,
+	const void* src2, size_t count2, const octet key[], size_t len,
+	const octet iv[16], void* workspace)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	code = beltCHEWrap_internal(dest, mac, src1, count1, src2, count2, key,
+		len, iv, workspace);
+	PERF_STOP(PERF_BELT_CHE_WRAP, code, count1 + count2, ticks);
+	return code;
+}
+
+err_t beltCHEWrap(void* dest, octet mac[8], const void* src1, size_t count1,
+	const void* src2, size_t count2, const octet key[], size_t len,
+	const octet iv[16])
+{
+	err_t code;
+	void* state;
 	// создать состояние
 	state = blobCreate(beltCHE_keep());
 	if (state == 0)
 		return ERR_OUTOFMEMORY;
-	// установить защиту (I перед E из-за разрешенного пересечения src2 и dest)
-	beltCHEStart(state, key, len, iv);
-	beltCHEStepI(src2, count2, state);
-	memMove(dest, src1, count1);
-	beltCHEStepE(dest, count1, state);
-	beltCHEStepA(dest, count1, state);
-	beltCHEStepG(mac, state);
+	// установить защиту
+	code = beltCHEWrap_ws(dest, mac, src1, count1, src2, count2, key, len, iv,
+		state);
 	// завершить
 	blobClose(state);
-	return ERR_OK;
+	return code;
 }
 
-err_t beltCHEUnwrap(void* dest, const void* src1, size_t count1,
+err_t beltCHEUnwrap_ws(void* dest, const void* src1, size_t count1,
 	const void* src2, size_t count2, const octet mac[8], const octet key[],
-	size_t len, const octet iv[16])
+	size_t len, const octet iv[16], void* workspace)
 {
-	void* state;
 	// проверить входные данные
 	if (len != 16 && len != 24 && len != 32 ||
 		!memIsValid(src1, count1) ||
@@ -294,24 +318,34 @@ err_t beltCHEUnwrap(void* dest, const void* src1, size_t count1,
 		!memIsValid(mac, 8) ||
 		!memIsValid(key, len) ||
 		!memIsValid(iv, 16) ||
-		!memIsValid(dest, count1))
+		!memIsValid(dest, count1) ||
+		!memIsValid(workspace, beltCHE_keep()))
 		return ERR_BAD_INPUT;
+	// снять защиту
+	beltCHEStart(workspace, key, len, iv);
+	beltCHEStepI(src2, count2, workspace);
+	beltCHEStepA(src1, count1, workspace);
+	if (!beltCHEStepV(mac, workspace))
+		return ERR_BAD_MAC;
+	memMove(dest, src1, count1);
+	beltCHEStepD(dest, count1, workspace);
+	return ERR_OK;
+}
+
+err_t beltCHEUnwrap(void* dest, const void* src1, size_t count1,
+	const void* src2, size_t count2, const octet mac[8], const octet key[],
+	size_t len, const octet iv[16])
+{
+	err_t code;
+	void* state;
 	// создать состояние
-	state = blobCreate(beltDWP_keep());
+	state = blobCreate(beltCHE_keep());
 	if (state == 0)
 		return ERR_OUTOFMEMORY;
 	// снять защиту
-	beltCHEStart(state, key, len, iv);
-	beltCHEStepI(src2, count2, state);
-	beltCHEStepA(src1, count1, state);
-	if (!beltCHEStepV(mac, state))
-	{
-		blobClose(state);
-		return ERR_BAD_MAC;
-	}
-	memMove(dest, src1, count1);
-	beltCHEStepD(dest, count1, state);
+	code = beltCHEUnwrap_ws(dest, src1, count1, src2, count2, mac, key, len,
+		iv, state);
 	// завершить
 	blobClose(state);
-	return ERR_OK;
+	return code;
 }
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): CTR encryption
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2020.03.24
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -46,71 +46,96 @@ void beltCTRStart(void* state, const octet key[], size_t len,
 	st->reserved = 0;
 }
 
-void beltCTRStepE(void* buf, size_t count, void* state)
+void beltCTRStepEV(const iov_t iov[], size_t iov_count, void* state)
 {
 	belt_ctr_st* st = (belt_ctr_st*)state;
-	ASSERT(memIsDisjoint2(buf, count, state, beltCTR_keep()));
-	// есть резерв гаммы?
-	if (st->reserved)
+	octet* buf;
+	size_t count;
+	ASSERT(memIsValid(iov, sizeof(iov_t) * iov_count));
+	// цикл по фрагментам
+	for (; iov_count--; ++iov)
 	{
-		if (st->reserved >= count)
+		buf = (octet*)iov->buf, count = iov->count;
+		ASSERT(memIsDisjoint2(buf, count, state, beltCTR_keep()));
+		// есть резерв гаммы?
+		if (st->reserved)
 		{
-			memXor2(buf, st->block + 16 - st->reserved, count);
-			st->reserved -= count;
-			return;
+			if (st->reserved >= count)
+			{
+				memXor2(buf, st->block + 16 - st->reserved, count);
+				st->reserved -= count;
+				continue;
+			}
+			memXor2(buf, st->block + 16 - st->reserved, st->reserved);
+			count -= st->reserved;
+			buf += st->reserved;
+			st->reserved = 0;
 		}
-		memXor2(buf, st->block + 16 - st->reserved, st->reserved);
-		count -= st->reserved;
-		buf = (octet*)buf + st->reserved;
-		st->reserved = 0;
-	}
-	// цикл по полным блокам
-	while (count >= 16)
-	{
-		beltBlockIncU32(st->ctr);
-		beltBlockCopy(st->block, st->ctr);
-		beltBlockEncr2((u32*)st->block, st->key);
+		// цикл по полным блокам фрагмента
+		while (count >= 16)
+		{
+			beltBlockIncU32(st->ctr);
+			beltBlockCopy(st->block, st->ctr);
+			beltBlockEncr2((u32*)st->block, st->key);
 #if (OCTET_ORDER == BIG_ENDIAN)
-		beltBlockRevU32(st->block);
+			beltBlockRevU32(st->block);
 #endif
-		beltBlockXor2(buf, st->block);
-		buf = (octet*)buf + 16;
-		count -= 16;
-	}
-	// неполный блок?
-	if (count)
-	{
-		beltBlockIncU32(st->ctr);
-		beltBlockCopy(st->block, st->ctr);
-		beltBlockEncr2((u32*)st->block, st->key);
+			beltBlockXor2(buf, st->block);
+			buf += 16;
+			count -= 16;
+		}
+		// неполный блок?
+		if (count)
+		{
+			beltBlockIncU32(st->ctr);
+			beltBlockCopy(st->block, st->ctr);
+			beltBlockEncr2((u32*)st->block, st->key);
 #if (OCTET_ORDER == BIG_ENDIAN)
-		beltBlockRevU32(st->block);
+			beltBlockRevU32(st->block);
 #endif
-		memXor2(buf, st->block, count);
-		st->reserved = 16 - count;
+			memXor2(buf, st->block, count);
+			st->reserved = 16 - count;
+		}
 	}
 }
 
-err_t beltCTR(void* dest, const void* src, size_t count,
-	const octet key[], size_t len, const octet iv[16])
+void beltCTRStepE(void* buf, size_t count, void* state)
+{
+	iov_t iov[1];
+	iov->buf = buf, iov->count = count;
+	beltCTRStepEV(iov, 1, state);
+}
+
+err_t beltCTR_ws(void* dest, const void* src, size_t count,
+	const octet key[], size_t len, const octet iv[16], void* workspace)
 {
-	void* state;
 	// проверить входные данные
 	if (len != 16 && len != 24 && len != 32 ||
 		!memIsValid(src, count) ||
 		!memIsValid(key, len) ||
 		!memIsValid(iv, 16) ||
-		!memIsValid(dest, count))
+		!memIsValid(dest, count) ||
+		!memIsValid(workspace, beltCTR_keep()))
 		return ERR_BAD_INPUT;
+	// зашифровать
+	beltCTRStart(workspace, key, len, iv);
+	memMove(dest, src, count);
+	beltCTRStepE(dest, count, workspace);
+	return ERR_OK;
+}
+
+err_t beltCTR(void* dest, const void* src, size_t count,
+	const octet key[], size_t len, const octet iv[16])
+{
+	err_t code;
+	void* state;
 	// создать состояние
 	state = blobCreate(beltCTR_keep());
 	if (state == 0)
 		return ERR_OUTOFMEMORY;
-	// зашифровать
-	beltCTRStart(state, key, len, iv);
-	memMove(dest, src, count);
-	beltCTRStepE(dest, count, state);
+	// зашифровать / расшифровать
+	code = beltCTR_ws(dest, src, count, key, len, iv, state);
 	// завершить
 	blobClose(state);
-	return ERR_OK;
+	return code;
 }
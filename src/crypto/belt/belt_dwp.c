@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): DWP (datawrap = data encryption + authentication)
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2020.03.24
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -13,6 +13,7 @@
 #include "bee2/core/blob.h"
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/perf.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/belt.h"
 #include "bee2/math/ww.h"
@@ -66,6 +67,11 @@ void beltDWPStepE(void* buf, size_t count, void* state)
 	beltCTRStepE(buf, count, state);
 }
 
+void beltDWPStepEV(const iov_t iov[], size_t iov_count, void* state)
+{
+	beltCTRStepEV(iov, iov_count, state);
+}
+
 void beltDWPStepI(const void* buf, size_t count, void* state)
 {
 	belt_dwp_st* st = (belt_dwp_st*)state;
@@ -110,58 +116,73 @@ void beltDWPStepI(const void* buf, size_t count, void* state)
 		memCopy(st->block, buf, st->filled = count);
 }
 
-void beltDWPStepA(const void* buf, size_t count, void* state)
+void beltDWPStepAV(const iov_t iov[], size_t iov_count, void* state)
 {
 	belt_dwp_st* st = (belt_dwp_st*)state;
-	ASSERT(memIsDisjoint2(buf, count, state, beltDWP_keep()));
-	// первый непустой фрагмент критических данных?
-	// есть необработанные открытые данные?
-	if (count && beltHalfBlockIsZero(st->len + W_OF_B(64)) && st->filled)
+	const octet* buf;
+	size_t count;
+	ASSERT(memIsValid(iov, sizeof(iov_t) * iov_count));
+	// цикл по фрагментам
+	for (; iov_count--; ++iov)
 	{
-		memSetZero(st->block + st->filled, 16 - st->filled);
+		buf = (const octet*)iov->buf, count = iov->count;
+		ASSERT(memIsDisjoint2(buf, count, state, beltDWP_keep()));
+		// первый непустой фрагмент критических данных?
+		// есть необработанные открытые данные?
+		if (count && beltHalfBlockIsZero(st->len + W_OF_B(64)) && st->filled)
+		{
+			memSetZero(st->block + st->filled, 16 - st->filled);
 #if (OCTET_ORDER == BIG_ENDIAN)
-		beltBlockRevW(st->block);
+			beltBlockRevW(st->block);
 #endif
-		beltBlockXor2(st->t, st->block);
-		beltPolyMul(st->t, st->t, st->r, st->stack);
-		st->filled = 0;
-	}
-	// обновить длину
-	beltHalfBlockAddBitSizeW(st->len + W_OF_B(64), count);
-	// есть накопленные данные?
-	if (st->filled)
-	{
-		if (count < 16 - st->filled)
-		{
-			memCopy(st->block + st->filled, buf, count);
-			st->filled += count;
-			return;
+			beltBlockXor2(st->t, st->block);
+			beltPolyMul(st->t, st->t, st->r, st->stack);
+			st->filled = 0;
 		}
-		memCopy(st->block + st->filled, buf, 16 - st->filled);
-		count -= 16 - st->filled;
-		buf = (const octet*)buf + 16 - st->filled;
+		// обновить длину
+		beltHalfBlockAddBitSizeW(st->len + W_OF_B(64), count);
+		// есть накопленные данные?
+		if (st->filled)
+		{
+			if (count < 16 - st->filled)
+			{
+				memCopy(st->block + st->filled, buf, count);
+				st->filled += count;
+				continue;
+			}
+			memCopy(st->block + st->filled, buf, 16 - st->filled);
+			count -= 16 - st->filled;
+			buf += 16 - st->filled;
 #if (OCTET_ORDER == BIG_ENDIAN)
-		beltBlockRevW(st->block);
+			beltBlockRevW(st->block);
 #endif
-		beltBlockXor2(st->t, st->block);
-		beltPolyMul(st->t, st->t, st->r, st->stack);
-		st->filled = 0;
-	}
-	// цикл по полным блокам
-	while (count >= 16)
-	{
-		beltBlockCopy(st->block, buf);
+			beltBlockXor2(st->t, st->block);
+			beltPolyMul(st->t, st->t, st->r, st->stack);
+			st->filled = 0;
+		}
+		// цикл по полным блокам фрагмента
+		while (count >= 16)
+		{
+			beltBlockCopy(st->block, buf);
 #if (OCTET_ORDER == BIG_ENDIAN)
-		beltBlockRevW(st->block);
+			beltBlockRevW(st->block);
 #endif
-		beltBlockXor2(st->t, st->block);
-		beltPolyMul(st->t, st->t, st->r, st->stack);
-		buf = (const octet*)buf + 16;
-		count -= 16;
+			beltBlockXor2(st->t, st->block);
+			beltPolyMul(st->t, st->t, st->r, st->stack);
+			buf += 16;
+			count -= 16;
+		}
+		// неполный блок?
+		if (count)
+			memCopy(st->block, buf, st->filled = count);
 	}
-	// неполный блок?
-	if (count)
-		memCopy(st->block, buf, st->filled = count);
+}
+
+void beltDWPStepA(const void* buf, size_t count, void* state)
+{
+	iov_t iov[1];
+	iov->buf = (void*)buf, iov->count = count;
+	beltDWPStepAV(iov, 1, state);
 }
 
 void beltDWPStepD(void* buf, size_t count, void* state)
@@ -169,6 +190,11 @@ void beltDWPStepD(void* buf, size_t count, void* state)
 	beltCTRStepD(buf, count, state);
 }
 
+void beltDWPStepDV(const iov_t iov[], size_t iov_count, void* state)
+{
+	beltCTRStepEV(iov, iov_count, state);
+}
+
 static void beltDWPStepG_internal(void* state)
 {
 	belt_dwp_st* st = (belt_dwp_st*)state;
@@ -208,11 +234,10 @@ bool_t beltDWPStepV(const octet mac[8], void* state)
 	return memEq(mac, st->t1, 8);
 }
 
-err_t beltDWPWrap(void* dest, octet mac[8], const void* src1, size_t count1,
-	const void* src2, size_t count2, const octet key[], size_t len,
-	const octet iv[16])
+static err_t beltDWPWrap_internal(void* dest, octet mac[8], const void* src1,
+	size_t count1, const void* src2, size_t count2, const octet key[],
+	size_t len, const octet iv[16], void* workspace)
 {
-	void* state;
 	// проверить входные данные
 	if (len != 16 && len != 24 && len != 32 ||
 		!memIsValid(src1, count1) ||
@@ -220,29 +245,53 @@ err_t beltDWPWrap(void* dest, octet mac[8], const void* src1, size_t count1,
 		!memIsValid(key, len) ||
 		!memIsValid(iv, 16) ||
 		!memIsValid(dest, count1) ||
-		!memIsValid(mac, 8))
+		!memIsValid(mac, 8) ||
+		!memIsValid(workspace, beltDWP_keep()))
 		return ERR_BAD_INPUT;
+	// установить защиту (I перед E из-за разрешенного пересечения src2 и dest)
+	beltDWPStart(workspace, key, len, iv);
+	beltDWPStepI(src2, count2, workspace);
+	memMove(dest, src1, count1);
+	beltDWPStepE(dest, count1, workspace);
+	beltDWPStepA(dest, count1, workspace);
+	beltDWPStepG(mac, workspace);
+	return ERR_OK;
+}
+
+err_t beltDWPWrap_ws(void* dest, octet mac[8], const void* src1, size_t count1,
+	const void* src2, size_t count2, const octet key[], size_t len,
+	const octet iv[16], void* workspace)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	code = beltDWPWrap_internal(dest, mac, src1, count1, src2, count2, key,
+		len, iv, workspace);
+	PERF_STOP(PERF_BELT_DWP_WRAP, code, count1 + count2, ticks);
+	return code;
+}
+
+err_t beltDWPWrap(void* dest, octet mac[8], const void* src1, size_t count1,
+	const void* src2, size_t count2, const octet key[], size_t len,
+	const octet iv[16])
+{
+	err_t code;
+	void* state;
 	// создать состояние
 	state = blobCreate(beltDWP_keep());
 	if (state == 0)
 		return ERR_OUTOFMEMORY;
-	// установить защиту (I перед E из-за разрешенного пересечения src2 и dest)
-	beltDWPStart(state, key, len, iv);
-	beltDWPStepI(src2, count2, state);
-	memMove(dest, src1, count1);
-	beltDWPStepE(dest, count1, state);
-	beltDWPStepA(dest, count1, state);
-	beltDWPStepG(mac, state);
+	// установить защиту
+	code = beltDWPWrap_ws(dest, mac, src1, count1, src2, count2, key, len, iv,
+		state);
 	// завершить
 	blobClose(state);
-	return ERR_OK;
+	return code;
 }
 
-err_t beltDWPUnwrap(void* dest, const void* src1, size_t count1,
+err_t beltDWPUnwrap_ws(void* dest, const void* src1, size_t count1,
 	const void* src2, size_t count2, const octet mac[8], const octet key[],
-	size_t len, const octet iv[16])
+	size_t len, const octet iv[16], void* workspace)
 {
-	void* state;
 	// проверить входные данные
 	if (len != 16 && len != 24 && len != 32 ||
 		!memIsValid(src1, count1) ||
@@ -250,24 +299,34 @@ err_t beltDWPUnwrap(void* dest, const void* src1, size_t count1,
 		!memIsValid(mac, 8) ||
 		!memIsValid(key, len) ||
 		!memIsValid(iv, 16) ||
-		!memIsValid(dest, count1))
+		!memIsValid(dest, count1) ||
+		!memIsValid(workspace, beltDWP_keep()))
 		return ERR_BAD_INPUT;
+	// снять защиту
+	beltDWPStart(workspace, key, len, iv);
+	beltDWPStepI(src2, count2, workspace);
+	beltDWPStepA(src1, count1, workspace);
+	if (!beltDWPStepV(mac, workspace))
+		return ERR_BAD_MAC;
+	memMove(dest, src1, count1);
+	beltDWPStepD(dest, count1, workspace);
+	return ERR_OK;
+}
+
+err_t beltDWPUnwrap(void* dest, const void* src1, size_t count1,
+	const void* src2, size_t count2, const octet mac[8], const octet key[],
+	size_t len, const octet iv[16])
+{
+	err_t code;
+	void* state;
 	// создать состояние
 	state = blobCreate(beltDWP_keep());
 	if (state == 0)
 		return ERR_OUTOFMEMORY;
 	// снять защиту
-	beltDWPStart(state, key, len, iv);
-	beltDWPStepI(src2, count2, state);
-	beltDWPStepA(src1, count1, state);
-	if (!beltDWPStepV(mac, state))
-	{
-		blobClose(state);
-		return ERR_BAD_MAC;
-	}
-	memMove(dest, src1, count1);
-	beltDWPStepD(dest, count1, state);
+	code = beltDWPUnwrap_ws(dest, src1, count1, src2, count2, mac, key, len,
+		iv, state);
 	// завершить
 	blobClose(state);
-	return ERR_OK;
+	return code;
 }
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): hashing
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2022.07.18
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -13,6 +13,7 @@
 #include "bee2/core/blob.h"
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/perf.h"
 #include "bee2/core/u32.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/belt.h"
@@ -53,47 +54,76 @@ void beltHashStart(void* state)
 	st->filled = 0;
 }
 
-void beltHashStepH(const void* buf, size_t count, void* state)
+static size_t beltHashStepHV_internal(const iov_t iov[], size_t iov_count,
+	void* state)
 {
 	belt_hash_st* st = (belt_hash_st*)state;
-	ASSERT(memIsDisjoint2(buf, count, state, beltHash_keep()));
-	// обновить длину
-	beltBlockAddBitSizeU32(st->ls, count);
-	// есть накопленные данные?
-	if (st->filled)
+	const octet* buf;
+	size_t count;
+	size_t total = 0;
+	// цикл по фрагментам
+	for (; iov_count--; ++iov)
 	{
-		if (count < 32 - st->filled)
+		buf = (const octet*)iov->buf, count = iov->count;
+		ASSERT(memIsDisjoint2(buf, count, state, beltHash_keep()));
+		total += count;
+		// обновить длину
+		beltBlockAddBitSizeU32(st->ls, count);
+		// есть накопленные данные?
+		if (st->filled)
 		{
-			memCopy(st->block + st->filled, buf, count);
-			st->filled += count;
-			return;
-		}
-		memCopy(st->block + st->filled, buf, 32 - st->filled);
-		count -= 32 - st->filled;
-		buf = (const octet*)buf + (32 - st->filled);
+			if (count < 32 - st->filled)
+			{
+				memCopy(st->block + st->filled, buf, count);
+				st->filled += count;
+				continue;
+			}
+			memCopy(st->block + st->filled, buf, 32 - st->filled);
+			count -= 32 - st->filled;
+			buf += 32 - st->filled;
 #if (OCTET_ORDER == BIG_ENDIAN)
-		beltBlockRevU32(st->block);
-		beltBlockRevU32(st->block + 16);
+			beltBlockRevU32(st->block);
+			beltBlockRevU32(st->block + 16);
 #endif
-		beltCompr2(st->ls + 4, st->h, (u32*)st->block, st->stack);
-		st->filled = 0;
-	}
-	// цикл по полным блокам
-	while (count >= 32)
-	{
-		beltBlockCopy(st->block, buf);
-		beltBlockCopy(st->block + 16, (const octet*)buf + 16);
+			beltCompr2(st->ls + 4, st->h, (u32*)st->block, st->stack);
+			st->filled = 0;
+		}
+		// цикл по полным блокам фрагмента
+		while (count >= 32)
+		{
+			beltBlockCopy(st->block, buf);
+			beltBlockCopy(st->block + 16, buf + 16);
 #if (OCTET_ORDER == BIG_ENDIAN)
-		beltBlockRevU32(st->block);
-		beltBlockRevU32(st->block + 16);
+			beltBlockRevU32(st->block);
+			beltBlockRevU32(st->block + 16);
 #endif
-		beltCompr2(st->ls + 4, st->h, (u32*)st->block, st->stack);
-		buf = (const octet*)buf + 32;
-		count -= 32;
+			beltCompr2(st->ls + 4, st->h, (u32*)st->block, st->stack);
+			buf += 32;
+			count -= 32;
+		}
+		// неполный блок?
+		if (count)
+			memCopy(st->block, buf, st->filled = count);
 	}
-	// неполный блок?
-	if (count)
-		memCopy(st->block, buf, st->filled = count);
+	return total;
+}
+
+void beltHashStepH(const void* buf, size_t count, void* state)
+{
+	iov_t iov[1];
+	tm_ticks_t ticks = PERF_START();
+	iov->buf = (void*)buf, iov->count = count;
+	beltHashStepHV_internal(iov, 1, state);
+	PERF_STOP(PERF_BELT_HASH, ERR_OK, count, ticks);
+}
+
+void beltHashStepHV(const iov_t iov[], size_t iov_count, void* state)
+{
+	size_t count;
+	tm_ticks_t ticks = PERF_START();
+	ASSERT(memIsValid(iov, sizeof(iov_t) * iov_count));
+	count = beltHashStepHV_internal(iov, iov_count, state);
+	PERF_STOP(PERF_BELT_HASH, ERR_OK, count, ticks);
 }
 
 static void beltHashStepG_internal(void* state)
@@ -167,21 +197,81 @@ bool_t beltHashStepV2(const octet hash[], size_t hash_len, void* state)
 	return memEq(hash, st->h1, hash_len);
 }
 
-err_t beltHash(octet hash[32], const void* src, size_t count)
+err_t beltHash_ws(octet hash[32], const void* src, size_t count,
+	void* workspace)
 {
-	void* state;
 	// проверить входные данные
-	if (!memIsValid(src, count) || !memIsValid(hash, 32))
+	if (!memIsValid(src, count) || !memIsValid(hash, 32) ||
+		!memIsValid(workspace, beltHash_keep()))
 		return ERR_BAD_INPUT;
+	// вычислить хэш-значение
+	beltHashStart(workspace);
+	beltHashStepH(src, count, workspace);
+	beltHashStepG(hash, workspace);
+	return ERR_OK;
+}
+
+err_t beltHash(octet hash[32], const void* src, size_t count)
+{
+	err_t code;
+	void* state;
 	// создать состояние
 	state = blobCreate(beltHash_keep());
 	if (state == 0)
 		return ERR_OUTOFMEMORY;
-	// вычислить хэш-значение
-	beltHashStart(state);
-	beltHashStepH(src, count, state);
-	beltHashStepG(hash, state);
+	// хэшировать
+	code = beltHash_ws(hash, src, count, state);
 	// завершить
 	blobClose(state);
+	return code;
+}
+
+/*
+*******************************************************************************
+Сохранение состояния
+
+Формат: заголовок (см. crypto_lcl.h) || [32]ls || [32]h || [32]block ||
+<filled>_8.
+*******************************************************************************
+*/
+
+#define BELT_HASH_STATE_LEN (4 + 32 + 32 + 32 + 1)
+
+err_t beltHashStateEnc(octet buf[], size_t* count, const void* state)
+{
+	const belt_hash_st* st = (const belt_hash_st*)state;
+	if (!memIsValid(count, O_PER_S) ||
+		!memIsNullOrValid(buf, *count) ||
+		!memIsValid(state, beltHash_keep()))
+		return ERR_BAD_INPUT;
+	if (buf)
+	{
+		if (*count < BELT_HASH_STATE_LEN)
+			return ERR_OUTOFMEMORY;
+		ASSERT(st->filled < 32);
+		cryptoStateHdrEnc(buf, BELT_STATE_HASH, BELT_HASH_STATE_LEN);
+		u32To(buf + 4, 32, st->ls);
+		u32To(buf + 36, 32, st->h);
+		memCopy(buf + 68, st->block, st->filled);
+		memSetZero(buf + 68 + st->filled, 32 - st->filled);
+		buf[100] = (octet)st->filled;
+	}
+	*count = BELT_HASH_STATE_LEN;
+	return ERR_OK;
+}
+
+err_t beltHashStateDec(void* state, const octet buf[], size_t count)
+{
+	belt_hash_st* st = (belt_hash_st*)state;
+	if (!memIsValid(state, beltHash_keep()) || !memIsValid(buf, count))
+		return ERR_BAD_INPUT;
+	if (count != BELT_HASH_STATE_LEN ||
+		!cryptoStateHdrIsValid(buf, BELT_STATE_HASH, BELT_HASH_STATE_LEN) ||
+		buf[100] >= 32 || !memIsZero(buf + 68 + buf[100], 32 - buf[100]))
+		return ERR_BAD_FORMAT;
+	u32From(st->ls, buf + 4, 32);
+	u32From(st->h, buf + 36, 32);
+	memCopy(st->block, buf + 68, 32);
+	st->filled = buf[100];
 	return ERR_OK;
 }
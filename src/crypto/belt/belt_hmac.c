@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): HMAC message authentication
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2022.07.18
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -255,3 +255,57 @@ err_t beltHMAC(octet mac[32], const void* src, size_t count,
 	blobClose(state);
 	return ERR_OK;
 }
+
+/*
+*******************************************************************************
+Сохранение состояния
+
+Формат: заголовок (см. crypto_lcl.h) || [32]ls_in || [32]h_in || [32]ls_out ||
+[32]h_out || [32]block || <filled>_8.
+*******************************************************************************
+*/
+
+#define BELT_HMAC_STATE_LEN (4 + 32 + 32 + 32 + 32 + 32 + 1)
+
+err_t beltHMACStateEnc(octet buf[], size_t* count, const void* state)
+{
+	const belt_hmac_st* st = (const belt_hmac_st*)state;
+	if (!memIsValid(count, O_PER_S) ||
+		!memIsNullOrValid(buf, *count) ||
+		!memIsValid(state, beltHMAC_keep()))
+		return ERR_BAD_INPUT;
+	if (buf)
+	{
+		if (*count < BELT_HMAC_STATE_LEN)
+			return ERR_OUTOFMEMORY;
+		ASSERT(st->filled < 32);
+		cryptoStateHdrEnc(buf, BELT_STATE_HMAC, BELT_HMAC_STATE_LEN);
+		u32To(buf + 4, 32, st->ls_in);
+		u32To(buf + 36, 32, st->h_in);
+		u32To(buf + 68, 32, st->ls_out);
+		u32To(buf + 100, 32, st->h_out);
+		memCopy(buf + 132, st->block, st->filled);
+		memSetZero(buf + 132 + st->filled, 32 - st->filled);
+		buf[164] = (octet)st->filled;
+	}
+	*count = BELT_HMAC_STATE_LEN;
+	return ERR_OK;
+}
+
+err_t beltHMACStateDec(void* state, const octet buf[], size_t count)
+{
+	belt_hmac_st* st = (belt_hmac_st*)state;
+	if (!memIsValid(state, beltHMAC_keep()) || !memIsValid(buf, count))
+		return ERR_BAD_INPUT;
+	if (count != BELT_HMAC_STATE_LEN ||
+		!cryptoStateHdrIsValid(buf, BELT_STATE_HMAC, BELT_HMAC_STATE_LEN) ||
+		buf[164] >= 32 || !memIsZero(buf + 132 + buf[164], 32 - buf[164]))
+		return ERR_BAD_FORMAT;
+	u32From(st->ls_in, buf + 4, 32);
+	u32From(st->h_in, buf + 36, 32);
+	u32From(st->ls_out, buf + 68, 32);
+	u32From(st->h_out, buf + 100, 32);
+	memCopy(st->block, buf + 132, 32);
+	st->filled = buf[164];
+	return ERR_OK;
+}
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): KWP (keywrap = key encryption + authentication)
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2019.06.26
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -13,6 +13,7 @@
 #include "bee2/core/blob.h"
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/perf.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/belt.h"
 #include "belt_lcl.h"
@@ -23,8 +24,8 @@
 *******************************************************************************
 */
 
-err_t beltKWPWrap(octet dest[], const octet src[], size_t count,
-	const octet header[16], const octet key[], size_t len)
+static err_t beltKWPWrap_internal(octet dest[], const octet src[],
+	size_t count, const octet header[16], const octet key[], size_t len)
 {
 	void* state;
 	// проверить входные данные
@@ -53,6 +54,16 @@ err_t beltKWPWrap(octet dest[], const octet src[], size_t count,
 	return ERR_OK;
 }
 
+err_t beltKWPWrap(octet dest[], const octet src[], size_t count,
+	const octet header[16], const octet key[], size_t len)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	code = beltKWPWrap_internal(dest, src, count, header, key, len);
+	PERF_STOP(PERF_BELT_KWP_WRAP, code, count, ticks);
+	return code;
+}
+
 err_t beltKWPUnwrap(octet dest[], const octet src[], size_t count,
 	const octet header[16], const octet key[], size_t len)
 {
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): local definitions
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2020.03.20
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -15,6 +15,7 @@
 
 #include "bee2/core/word.h"
 #include "bee2/core/u32.h"
+#include "../crypto_lcl.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -232,8 +233,21 @@ void beltHalfBlockAddBitSizeW(word block[W_OF_B(64)], size_t count);
 void beltPolyMul(word c[], const word a[], const word b[], void* stack);
 size_t beltPolyMul_deep();
 void beltBlockMulC(u32 block[4]);
+void beltCTRStepEV(const iov_t iov[], size_t iov_count, void* state);
 
+/*
+*******************************************************************************
+Сохранение состояний
+
+Сохраненное состояние начинается с заголовка (см. crypto_lcl.h). Переменные 
+типа u32 сохраняются функцией u32To(), то есть младшими октетами вперед,
+независимо от платформы.
+*******************************************************************************
+*/
 
+#define BELT_STATE_HASH		0x11	/* belt-hash */
+#define BELT_STATE_MAC		0x12	/* belt-mac */
+#define BELT_STATE_HMAC		0x13	/* belt-hmac */
 
 #ifdef __cplusplus
 } /* extern "C" */
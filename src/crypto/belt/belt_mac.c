@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): MAC (message authentication)
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2020.03.24
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -55,49 +55,64 @@ void beltMACStart(void* state, const octet key[], size_t len)
 	st->filled = 0;
 }
 
-void beltMACStepA(const void* buf, size_t count, void* state)
+void beltMACStepAV(const iov_t iov[], size_t iov_count, void* state)
 {
 	belt_mac_st* st = (belt_mac_st*)state;
-	ASSERT(memIsDisjoint2(buf, count, state, beltMAC_keep()));
-	// накопить полный блок
-	if (st->filled < 16)
+	const octet* buf;
+	size_t count;
+	ASSERT(memIsValid(iov, sizeof(iov_t) * iov_count));
+	// цикл по фрагментам
+	for (; iov_count--; ++iov)
 	{
-		if (count <= 16 - st->filled)
+		buf = (const octet*)iov->buf, count = iov->count;
+		ASSERT(memIsDisjoint2(buf, count, state, beltMAC_keep()));
+		// накопить полный блок
+		if (st->filled < 16)
 		{
-			memCopy(st->block + st->filled, buf, count);
-			st->filled += count;
-			return;
+			if (count <= 16 - st->filled)
+			{
+				memCopy(st->block + st->filled, buf, count);
+				st->filled += count;
+				continue;
+			}
+			memCopy(st->block + st->filled, buf, 16 - st->filled);
+			count -= 16 - st->filled;
+			buf += 16 - st->filled;
+			st->filled = 16;
 		}
-		memCopy(st->block + st->filled, buf, 16 - st->filled);
-		count -= 16 - st->filled;
-		buf = (const octet*)buf + 16 - st->filled;
-		st->filled = 16;
-	}
-	// цикл по полным блокам
-	while (count >= 16)
-	{
+		// цикл по полным блокам фрагмента
+		while (count >= 16)
+		{
 #if (OCTET_ORDER == BIG_ENDIAN)
-		beltBlockRevU32(st->block);
+			beltBlockRevU32(st->block);
 #endif
-		beltBlockXor2(st->s, st->block);
-		beltBlockEncr2(st->s, st->key);
-		beltBlockCopy(st->block, buf);
-		buf = (const octet*)buf + 16;
-		count -= 16;
-	}
-	// неполный блок?
-	if (count)
-	{
+			beltBlockXor2(st->s, st->block);
+			beltBlockEncr2(st->s, st->key);
+			beltBlockCopy(st->block, buf);
+			buf += 16;
+			count -= 16;
+		}
+		// неполный блок?
+		if (count)
+		{
 #if (OCTET_ORDER == BIG_ENDIAN)
-		beltBlockRevU32(st->block);
+			beltBlockRevU32(st->block);
 #endif
-		beltBlockXor2(st->s, st->block);
-		beltBlockEncr2(st->s, st->key);
-		memCopy(st->block, buf, count);
-		st->filled = count;
+			beltBlockXor2(st->s, st->block);
+			beltBlockEncr2(st->s, st->key);
+			memCopy(st->block, buf, count);
+			st->filled = count;
+		}
 	}
 }
 
+void beltMACStepA(const void* buf, size_t count, void* state)
+{
+	iov_t iov[1];
+	iov->buf = (void*)buf, iov->count = count;
+	beltMACStepAV(iov, 1, state);
+}
+
 static void beltMACStepG_internal(void* state)
 {
 	belt_mac_st* st = (belt_mac_st*)state;
@@ -179,25 +194,87 @@ bool_t beltMACStepV2(const octet mac[], size_t mac_len, void* state)
 	return memEq(mac, st->mac, mac_len);
 }
 
-err_t beltMAC(octet mac[8], const void* src, size_t count,
-	const octet key[], size_t len)
+err_t beltMAC_ws(octet mac[8], const void* src, size_t count,
+	const octet key[], size_t len, void* workspace)
 {
-	void* state;
 	// проверить входные данные
 	if (len != 16 && len != 24 && len != 32 ||
 		!memIsValid(src, count) ||
 		!memIsValid(key, len) ||
-		!memIsValid(mac, 8))
+		!memIsValid(mac, 8) ||
+		!memIsValid(workspace, beltMAC_keep()))
 		return ERR_BAD_INPUT;
+	// выработать имитовставку
+	beltMACStart(workspace, key, len);
+	beltMACStepA(src, count, workspace);
+	beltMACStepG(mac, workspace);
+	return ERR_OK;
+}
+
+err_t beltMAC(octet mac[8], const void* src, size_t count,
+	const octet key[], size_t len)
+{
+	err_t code;
+	void* state;
 	// создать состояние
 	state = blobCreate(beltMAC_keep());
 	if (state == 0)
 		return ERR_OUTOFMEMORY;
 	// выработать имитовставку
-	beltMACStart(state, key, len);
-	beltMACStepA(src, count, state);
-	beltMACStepG(mac, state);
+	code = beltMAC_ws(mac, src, count, key, len, state);
 	// завершить
 	blobClose(state);
+	return code;
+}
+
+/*
+*******************************************************************************
+Сохранение состояния
+
+Формат: заголовок (см. crypto_lcl.h) || [32]key || [16]s || [16]r ||
+[16]block || <filled>_8.
+*******************************************************************************
+*/
+
+#define BELT_MAC_STATE_LEN (4 + 32 + 16 + 16 + 16 + 1)
+
+err_t beltMACStateEnc(octet buf[], size_t* count, const void* state)
+{
+	const belt_mac_st* st = (const belt_mac_st*)state;
+	if (!memIsValid(count, O_PER_S) ||
+		!memIsNullOrValid(buf, *count) ||
+		!memIsValid(state, beltMAC_keep()))
+		return ERR_BAD_INPUT;
+	if (buf)
+	{
+		if (*count < BELT_MAC_STATE_LEN)
+			return ERR_OUTOFMEMORY;
+		ASSERT(st->filled <= 16);
+		cryptoStateHdrEnc(buf, BELT_STATE_MAC, BELT_MAC_STATE_LEN);
+		u32To(buf + 4, 32, st->key);
+		u32To(buf + 36, 16, st->s);
+		u32To(buf + 52, 16, st->r);
+		memCopy(buf + 68, st->block, st->filled);
+		memSetZero(buf + 68 + st->filled, 16 - st->filled);
+		buf[84] = (octet)st->filled;
+	}
+	*count = BELT_MAC_STATE_LEN;
+	return ERR_OK;
+}
+
+err_t beltMACStateDec(void* state, const octet buf[], size_t count)
+{
+	belt_mac_st* st = (belt_mac_st*)state;
+	if (!memIsValid(state, beltMAC_keep()) || !memIsValid(buf, count))
+		return ERR_BAD_INPUT;
+	if (count != BELT_MAC_STATE_LEN ||
+		!cryptoStateHdrIsValid(buf, BELT_STATE_MAC, BELT_MAC_STATE_LEN) ||
+		buf[84] > 16 || !memIsZero(buf + 68 + buf[84], 16 - buf[84]))
+		return ERR_BAD_FORMAT;
+	u32From(st->key, buf + 4, 32);
+	u32From(st->s, buf + 36, 16);
+	u32From(st->r, buf + 52, 16);
+	memCopy(st->block, buf + 68, 16);
+	st->filled = buf[84];
 	return ERR_OK;
 }
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): PBKDF (password-based key derivation)
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2017.09.28
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -13,6 +13,7 @@
 #include "bee2/core/blob.h"
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/perf.h"
 #include "bee2/crypto/belt.h"
 
 /*
@@ -21,8 +22,8 @@
 *******************************************************************************
 */
 
-err_t beltPBKDF2(octet key[32], const octet pwd[], size_t pwd_len,
-	size_t iter, const octet salt[], size_t salt_len)
+static err_t beltPBKDF2_internal(octet key[32], const octet pwd[],
+	size_t pwd_len, size_t iter, const octet salt[], size_t salt_len)
 {
 	void* state;
 	octet* t;
@@ -56,3 +57,15 @@ err_t beltPBKDF2(octet key[32], const octet pwd[], size_t pwd_len,
 	blobClose(state);
 	return ERR_OK;
 }
+
+err_t beltPBKDF2(octet key[32], const octet pwd[], size_t pwd_len,
+	size_t iter, const octet salt[], size_t salt_len)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE1(belt_pbkdf2_entry, iter);
+	code = beltPBKDF2_internal(key, pwd, pwd_len, iter, salt, salt_len);
+	PERF_PROBE1(belt_pbkdf2_return, code);
+	PERF_STOP(PERF_BELT_PBKDF2, code, pwd_len, ticks);
+	return code;
+}
@@ -4,7 +4,7 @@
 \brief STB 34.101.45 (bign): identity-based signature
 \project bee2 [cryptographic library]
 \created 2012.04.27
-\version 2023.09.20
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -222,7 +222,7 @@ err_t bignIdSign(octet id_sig[], const bign_params* params,
 		return ERR_BAD_RNG;
 	}
 	// V <- k G
-	if (!ecMulA(V, ec->base, ec, k, n, stack))
+	if (!bignMulBase(V, params, ec, k, n, stack))
 	{
 		blobClose(state);
 		return ERR_BAD_PARAMS;
@@ -353,7 +353,7 @@ err_t bignIdSign2(octet id_sig[], const bign_params* params,
 		}
 	}
 	// V <- k G
-	if (!ecMulA(V, ec->base, ec, k, n, stack))
+	if (!bignMulBase(V, params, ec, k, n, stack))
 	{
 		blobClose(state);
 		return ERR_BAD_PARAMS;
@@ -4,7 +4,7 @@
 \brief STB 34.101.45 (bign): key transport
 \project bee2 [cryptographic library]
 \created 2012.04.27
-\version 2023.09.20
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -107,7 +107,7 @@ err_t bignKeyWrap(octet token[], const bign_params* params, const octet key[],
 	// theta <- <R>_{256}
 	qrTo(theta, ecX(R), ec->f, stack);
 	// R <- k G
-	if (!ecMulA(R, ec->base, ec, k, n, stack))
+	if (!bignMulBase(R, params, ec, k, n, stack))
 	{
 		blobClose(state);
 		return ERR_BAD_PARAMS;
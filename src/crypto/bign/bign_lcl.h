@@ -4,7 +4,7 @@
 \brief STB 34.101.45 (bign): local declarations
 \project bee2 [cryptographic library]
 \created 2014.04.03
-\version 2023.09.25
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -93,6 +93,26 @@ err_t bignStart(
 	const bign_params* params	/*!< [in] долговременные параметры */
 );
 
+/*!	\brief Кратная базовой точки
+
+	Определяется аффинная точка [2 * ec->f->n]b, которая является
+	[m]d-кратной базовой точки ec->base кривой ec, построенной
+	по долговременным параметрам params. Если к уровню params->l
+	подключены предвычисления для params (см. bignPreAttach())
+	и m == ec->f->n, то используется функция ecMulPreA(), в противном
+	случае -- ecMulA().
+	\return Как в функции ecMulA().
+	\deep{stack} ecMulA_deep(ec->f->n, ec->d, ec->deep, m).
+*/
+bool_t bignMulBase(
+	word b[],					/*!< [out] кратная точка */
+	const bign_params* params,	/*!< [in] долговременные параметры */
+	const ec_o* ec,				/*!< [in] описание кривой */
+	const word d[],				/*!< [in] кратность */
+	size_t m,					/*!< [in] длина d в машинных словах */
+	void* stack					/*!< [in] вспомогательная память */
+);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -4,7 +4,7 @@
 \brief STB 34.101.45 (bign): miscellaneous (OIDs, keys, DH)
 \project bee2 [cryptographic library]
 \created 2012.04.27
-\version 2023.09.22
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -109,7 +109,7 @@ err_t bignKeypairGen(octet privkey[], octet pubkey[],
 		return ERR_BAD_RNG;
 	}
 	// Q <- d G
-	if (ecMulA(Q, ec->base, ec, d, n, stack))
+	if (bignMulBase(Q, params, ec, d, n, stack))
 	{
 		// выгрузить ключи
 		wwTo(privkey, no, d);
@@ -183,7 +183,7 @@ err_t bignKeypairVal(const bign_params* params, const octet privkey[],
 		return ERR_BAD_PRIVKEY;
 	}
 	// Q <- d G
-	if (ecMulA(Q, ec->base, ec, d, n, stack))
+	if (bignMulBase(Q, params, ec, d, n, stack))
 	{
 		// Q == pubkey?
 		wwTo(Q, 2 * no, Q);
@@ -310,7 +310,7 @@ err_t bignPubkeyCalc(octet pubkey[], const bign_params* params,
 		return ERR_BAD_PRIVKEY;
 	}
 	// Q <- d G
-	if (ecMulA(Q, ec->base, ec, d, n, stack))
+	if (bignMulBase(Q, params, ec, d, n, stack))
 	{
 		// выгрузить открытый ключ
 		qrTo(pubkey, ecX(Q), ec->f, stack);
@@ -338,13 +338,18 @@ static size_t bignDH_deep(size_t n, size_t f_deep, size_t ec_d,
 			ecMulA_deep(n, ec_d, ec_deep, n));
 }
 
-err_t bignDH(octet key[], const bign_params* params, const octet privkey[],
-	const octet pubkey[], size_t key_len)
+size_t bignDH_keep(size_t l)
+{
+	return bignStart_keep(l, bignDH_deep);
+}
+
+err_t bignDH_ws(octet key[], const bign_params* params,
+	const octet privkey[], const octet pubkey[], size_t key_len,
+	void* workspace)
 {
 	err_t code;
 	size_t no, n;
 	// состояние
-	void* state;
 	ec_o* ec;				/* описание эллиптической кривой */
 	word* d;				/* [n] личный ключ */
 	word* Q;				/* [2n] открытый ключ */
@@ -354,31 +359,24 @@ err_t bignDH(octet key[], const bign_params* params, const octet privkey[],
 		return ERR_BAD_INPUT;
 	if (!bignIsOperable(params))
 		return ERR_BAD_PARAMS;
-	// создать состояние
-	state = blobCreate(bignStart_keep(params->l, bignDH_deep));
-	if (state == 0)
-		return ERR_OUTOFMEMORY;
+	// проверить workspace
+	if (!memIsValid(workspace, bignDH_keep(params->l)))
+		return ERR_BAD_INPUT;
 	// старт
-	code = bignStart(state, params);
-	ERR_CALL_HANDLE(code, blobClose(state));
-	ec = (ec_o*)state;
+	code = bignStart(workspace, params);
+	ERR_CALL_CHECK(code);
+	ec = (ec_o*)workspace;
 	// размерности
 	no  = ec->f->no;
 	n = ec->f->n;
 	// проверить длину key
 	if (key_len > 2 * no)
-	{
-		blobClose(state);
 		return ERR_BAD_SHAREDKEY;
-	}
 	// проверить входные указатели
 	if (!memIsValid(privkey, no) || 
 		!memIsValid(pubkey, 2 * no) ||
 		!memIsValid(key, key_len))
-	{
-		blobClose(state);
 		return ERR_BAD_INPUT;
-	}
 	// раскладка состояния
 	d = objEnd(ec, word);
 	Q = d + n;
@@ -386,30 +384,41 @@ err_t bignDH(octet key[], const bign_params* params, const octet privkey[],
 	// загрузить d
 	wwFrom(d, privkey, no);
 	if (wwIsZero(d, n) || wwCmp(d, ec->order, n) >= 0)
-	{
-		blobClose(state);
 		return ERR_BAD_PRIVKEY;
-	}
 	// загрузить Q
 	if (!qrFrom(ecX(Q), pubkey, ec->f, stack) ||
 		!qrFrom(ecY(Q, n), pubkey + no, ec->f, stack) ||
 		!ecpIsOnA(Q, ec, stack))
-	{
-		blobClose(state);
 		return ERR_BAD_PUBKEY;
-	}
 	// Q <- d Q
-	if (ecMulA(Q, Q, ec, d, n, stack))
-	{
-		// выгрузить общий ключ
-		qrTo((octet*)Q, ecX(Q), ec->f, stack);
-		if (key_len > no)
-			qrTo((octet*)Q + no, ecY(Q, n), ec->f, stack);
-		memCopy(key, Q, key_len);
-	}
-	else
-		code = ERR_BAD_PARAMS;
-	// завершение
+	if (!ecMulA(Q, Q, ec, d, n, stack))
+		return ERR_BAD_PARAMS;
+	// выгрузить общий ключ
+	qrTo((octet*)Q, ecX(Q), ec->f, stack);
+	if (key_len > no)
+		qrTo((octet*)Q + no, ecY(Q, n), ec->f, stack);
+	memCopy(key, Q, key_len);
+	// все нормально
+	return ERR_OK;
+}
+
+err_t bignDH(octet key[], const bign_params* params, const octet privkey[],
+	const octet pubkey[], size_t key_len)
+{
+	err_t code;
+	void* state;
+	// проверить params
+	if (!memIsValid(params, sizeof(bign_params)))
+		return ERR_BAD_INPUT;
+	if (!bignIsOperable(params))
+		return ERR_BAD_PARAMS;
+	// создать состояние
+	state = blobCreate(bignDH_keep(params->l));
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// построить общий ключ
+	code = bignDH_ws(key, params, privkey, pubkey, key_len, state);
+	// завершить
 	blobClose(state);
 	return code;
 }
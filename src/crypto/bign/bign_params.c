@@ -4,16 +4,18 @@
 \brief STB 34.101.45 (bign): public parameters
 \project bee2 [cryptographic library]
 \created 2012.04.27
-\version 2024.02.28
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
 #include "bee2/core/blob.h"
+#include "bee2/core/cache.h"
 #include "bee2/core/der.h"
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/mt.h"
 #include "bee2/core/str.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/belt.h"
@@ -279,7 +281,7 @@ static size_t bignParamsVal_deep(size_t n, size_t f_deep, size_t ec_d,
 			ecHasOrderA_deep(n, ec_d, ec_deep, n));
 }
 
-err_t bignParamsVal(const bign_params* params)
+static err_t bignParamsVal_internal(const bign_params* params)
 {
 	err_t code;
 	size_t no, n;
@@ -290,11 +292,8 @@ err_t bignParamsVal(const bign_params* params)
 	octet* seed;			/* [8] копия seed */
 	word* B;				/* [W_OF_B(512)] переменная B */
 	void* stack;
-	// проверить params
-	if (!memIsValid(params, sizeof(bign_params)))
-		return ERR_BAD_INPUT;
-	if (!bignIsOperable(params))
-		return ERR_BAD_PARAMS;
+	// pre
+	ASSERT(bignIsOperable(params));
 	// создать состояние
 	state = blobCreate(bignStart_keep(params->l, bignParamsVal_deep));
 	if (state == 0)
@@ -355,6 +354,83 @@ err_t bignParamsVal(const bign_params* params)
 	return code;
 }
 
+/*
+*******************************************************************************
+Кэш проверенных параметров
+
+В кэше хранятся хэш-значения belt-hash параметров, которые успешно прошли
+проверку в bignParamsVal(). Хэшируются октеты p, a, b, q, yG, которые
+используются на уровне стойкости l, и seed.
+
+Кэш _cache (см. cache.h) включается однократно (с помощью mtCallOnce()),
+при включении в него заносятся хэш-значения стандартных параметров.
+Если включить кэш не удалось, то он не используется.
+*******************************************************************************
+*/
+
+#define BIGN_PARAMS_CACHE_SIZE 16
+
+static size_t _once;			/*< триггер однократности */
+static cache_t _cache[1];		/*< кэш */
+
+static err_t bignParamsHash(octet hash[32], const bign_params* params)
+{
+	const size_t no = O_OF_B(2 * params->l);
+	void* state;
+	ASSERT(bignIsOperable(params));
+	state = blobCreate(beltHash_keep());
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	beltHashStart(state);
+	beltHashStepH(params->p, no, state);
+	beltHashStepH(params->a, no, state);
+	beltHashStepH(params->b, no, state);
+	beltHashStepH(params->q, no, state);
+	beltHashStepH(params->yG, no, state);
+	beltHashStepH(params->seed, 8, state);
+	beltHashStepG(hash, state);
+	blobClose(state);
+	return ERR_OK;
+}
+
+static void bignParamsCacheInit()
+{
+	const char* names[] = {
+		_curve128v1_name, _curve192v1_name, _curve256v1_name };
+	bign_params params[1];
+	octet hash[32];
+	size_t pos;
+	if (cacheStart(_cache, BIGN_PARAMS_CACHE_SIZE) != ERR_OK)
+		return;
+	// стандартные параметры
+	for (pos = 0; pos < COUNT_OF(names); ++pos)
+		if (bignParamsStd(params, names[pos]) == ERR_OK &&
+			bignParamsHash(hash, params) == ERR_OK)
+			cacheAdd(_cache, hash);
+}
+
+err_t bignParamsVal(const bign_params* params)
+{
+	err_t code;
+	octet hash[32];
+	// проверить params
+	if (!memIsValid(params, sizeof(bign_params)))
+		return ERR_BAD_INPUT;
+	if (!bignIsOperable(params))
+		return ERR_BAD_PARAMS;
+	// параметры уже проверялись?
+	code = bignParamsHash(hash, params);
+	ERR_CALL_CHECK(code);
+	mtCallOnce(&_once, bignParamsCacheInit);
+	if (cacheFind(_cache, hash))
+		return ERR_OK;
+	// проверить и запомнить
+	code = bignParamsVal_internal(params);
+	if (code == ERR_OK)
+		cacheAdd(_cache, hash);
+	return code;
+}
+
 /*
 *******************************************************************************
 Генерация параметров
@@ -0,0 +1,300 @@
+/*
+*******************************************************************************
+\file bign_pre.c
+\brief STB 34.101.45 (bign): precomputations
+\project bee2 [cryptographic library]
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "bee2/core/blob.h"
+#include "bee2/core/err.h"
+#include "bee2/core/mem.h"
+#include "bee2/core/util.h"
+#include "bee2/crypto/belt.h"
+#include "bee2/crypto/bign.h"
+#include "bee2/math/ecp.h"
+#include "bee2/math/ww.h"
+#include "bign_lcl.h"
+
+/*
+*******************************************************************************
+Заголовок предвычислений
+
+Смещения полей заголовка заданы константами BIGN_PRE_XXX. Хэш-значение
+долговременных параметров рассчитывается по тем же октетам параметров,
+которые контролирует bignIsOperable().
+*******************************************************************************
+*/
+
+#define BIGN_PRE_VERSION	1
+#define BIGN_PRE_MARKER		0x01020304
+
+#define BIGN_PRE_MAGIC		0
+#define BIGN_PRE_VER		8
+#define BIGN_PRE_ORDER		12
+#define BIGN_PRE_WSIZE		16
+#define BIGN_PRE_L			20
+#define BIGN_PRE_W			24
+#define BIGN_PRE_RESERVED	28
+#define BIGN_PRE_PARAMS		32
+
+static const octet _magic[8] = "bee2pre";
+
+static u32 bignPreGet(const octet pre[], size_t pos)
+{
+	u32 val;
+	memCopy(&val, pre + pos, 4);
+	return val;
+}
+
+static void bignPreSet(octet pre[], size_t pos, u32 val)
+{
+	memCopy(pre + pos, &val, 4);
+}
+
+static void bignPreParamsHash(octet hash[32], const bign_params* params,
+	void* state)
+{
+	const size_t no = O_OF_B(2 * params->l);
+	beltHashStart(state);
+	beltHashStepH(params->p, no, state);
+	beltHashStepH(params->a, no, state);
+	beltHashStepH(params->b, no, state);
+	beltHashStepH(params->q, no, state);
+	beltHashStepH(params->yG, no, state);
+	beltHashStepG(hash, state);
+}
+
+static size_t bignPreSize(size_t l, size_t w)
+{
+	const size_t n = W_OF_B(2 * l);
+	return BIGN_PRE_HDR + ecPreA_keep(n, w, n) + 32;
+}
+
+/*
+*******************************************************************************
+Построение предвычислений
+*******************************************************************************
+*/
+
+static size_t bignPreCreate_deep(size_t n, size_t f_deep, size_t ec_d,
+	size_t ec_deep)
+{
+	return utilMax(2,
+		beltHash_keep(),
+		ecPreA_deep(n, ec_d, ec_deep));
+}
+
+err_t bignPreCreate(octet pre[], size_t* count, const bign_params* params,
+	size_t w)
+{
+	err_t code;
+	size_t n;
+	void* state;
+	ec_o* ec;
+	void* stack;
+	// проверить входные данные
+	if (!memIsValid(params, sizeof(bign_params)) ||
+		!memIsValid(count, sizeof(size_t)))
+		return ERR_BAD_INPUT;
+	if (!bignIsOperable(params))
+		return ERR_BAD_PARAMS;
+	if (w < 1 || w > 8)
+		return ERR_BAD_INPUT;
+	// определить длину
+	if (pre == 0)
+	{
+		*count = bignPreSize(params->l, w);
+		return ERR_OK;
+	}
+	if (!memIsValid(pre, bignPreSize(params->l, w)))
+		return ERR_BAD_INPUT;
+	*count = bignPreSize(params->l, w);
+	// создать состояние
+	n = W_OF_B(2 * params->l);
+	state = blobCreate(bignStart_keep(params->l, bignPreCreate_deep) +
+		ecPreA_keep(n, w, n));
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// старт
+	code = bignStart(state, params);
+	ERR_CALL_HANDLE(code, blobClose(state));
+	ec = (ec_o*)state;
+	stack = objEnd(ec, octet) + ecPreA_keep(n, w, n);
+	// построить таблицу
+	if (!ecPreA(objEnd(ec, word), ec->base, ec, w, n, stack))
+	{
+		blobClose(state);
+		return ERR_BAD_PARAMS;
+	}
+	// заголовок
+	memSetZero(pre, BIGN_PRE_HDR);
+	memCopy(pre + BIGN_PRE_MAGIC, _magic, 8);
+	bignPreSet(pre, BIGN_PRE_VER, BIGN_PRE_VERSION);
+	bignPreSet(pre, BIGN_PRE_ORDER, BIGN_PRE_MARKER);
+	bignPreSet(pre, BIGN_PRE_WSIZE, B_PER_W);
+	bignPreSet(pre, BIGN_PRE_L, (u32)params->l);
+	bignPreSet(pre, BIGN_PRE_W, (u32)w);
+	bignPreParamsHash(pre + BIGN_PRE_PARAMS, params, stack);
+	// таблица и контрольная сумма
+	memCopy(pre + BIGN_PRE_HDR, objEnd(ec, octet), ecPreA_keep(n, w, n));
+	code = beltHash(pre + *count - 32, pre, *count - 32);
+	// завершить
+	blobClose(state);
+	return code;
+}
+
+/*
+*******************************************************************************
+Проверка предвычислений
+
+После проверки контрольной суммы дополнительно проверяется, что первая
+точка таблицы совпадает с базовой точкой во внутреннем представлении.
+Тем самым обнаруживается несовместимость представлений элементов поля
+(например, при построении предвычислений другой версией библиотеки).
+
+Затем проверяется, что все точки таблицы лежат на кривой. Контрольная
+сумма не защищает от намеренной подмены: ее может пересчитать тот, кто
+подменил таблицу. Проверка принадлежности кривой исключает точки
+вне группы (в том числе точки на кривых с другими коэффициентами),
+но не то, что точки являются нужными кратными базовой точки.
+*******************************************************************************
+*/
+
+static size_t bignPreVal_deep(size_t n, size_t f_deep, size_t ec_d,
+	size_t ec_deep)
+{
+	return 32 +
+		utilMax(2,
+			beltHash_keep(),
+			ecpIsOnA_deep(n, f_deep));
+}
+
+err_t bignPreVal(const bign_params* params, const octet pre[], size_t count)
+{
+	err_t code;
+	size_t w, n, points, pos;
+	void* state;
+	ec_o* ec;
+	const word* table;
+	octet* hash;
+	void* stack;
+	// проверить входные данные
+	if (!memIsValid(params, sizeof(bign_params)) ||
+		!memIsValid(pre, count))
+		return ERR_BAD_INPUT;
+	if (!bignIsOperable(params))
+		return ERR_BAD_PARAMS;
+	if ((size_t)(pre + BIGN_PRE_HDR) % O_PER_W)
+		return ERR_BAD_INPUT;
+	// проверить заголовок
+	if (count < BIGN_PRE_HDR + 32 ||
+		!memEq(pre + BIGN_PRE_MAGIC, _magic, 8) ||
+		bignPreGet(pre, BIGN_PRE_VER) != BIGN_PRE_VERSION ||
+		bignPreGet(pre, BIGN_PRE_ORDER) != BIGN_PRE_MARKER ||
+		bignPreGet(pre, BIGN_PRE_WSIZE) != B_PER_W ||
+		bignPreGet(pre, BIGN_PRE_RESERVED) != 0)
+		return ERR_BAD_FORMAT;
+	w = bignPreGet(pre, BIGN_PRE_W);
+	if (w < 1 || w > 8 || count != bignPreSize(params->l, w))
+		return ERR_BAD_FORMAT;
+	if (bignPreGet(pre, BIGN_PRE_L) != params->l)
+		return ERR_BAD_PARAMS;
+	// создать состояние
+	state = blobCreate(bignStart_keep(params->l, bignPreVal_deep));
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// старт
+	code = bignStart(state, params);
+	ERR_CALL_HANDLE(code, blobClose(state));
+	ec = (ec_o*)state;
+	hash = objEnd(ec, octet);
+	stack = hash + 32;
+	// проверить параметры
+	bignPreParamsHash(hash, params, stack);
+	if (!memEq(hash, pre + BIGN_PRE_PARAMS, 32))
+		code = ERR_BAD_PARAMS;
+	// проверить контрольную сумму
+	else if (beltHash(hash, pre, count - 32) != ERR_OK ||
+		!memEq(hash, pre + count - 32, 32))
+		code = ERR_BAD_HASH;
+	// проверить представление
+	else if (!wwEq((const word*)(pre + BIGN_PRE_HDR), ec->base,
+		2 * ec->f->n))
+		code = ERR_BAD_FORMAT;
+	// проверить точки таблицы
+	else
+	{
+		n = ec->f->n;
+		table = (const word*)(pre + BIGN_PRE_HDR);
+		points = ecPreA_keep(n, w, n) / O_OF_W(2 * n);
+		for (pos = 0; pos < points; ++pos, table += 2 * n)
+			if (!ecpIsOnA(table, ec, stack))
+			{
+				code = ERR_BAD_POINT;
+				break;
+			}
+	}
+	// завершить
+	blobClose(state);
+	return code;
+}
+
+/*
+*******************************************************************************
+Подключение предвычислений
+
+Подключенные предвычисления хранятся в ячейках _pre[0] (l == 128),
+_pre[1] (l == 192), _pre[2] (l == 256).
+*******************************************************************************
+*/
+
+static struct
+{
+	bign_params params;		/*!< долговременные параметры */
+	const word* table;		/*!< таблица ecPreA() */
+	size_t w;				/*!< ширина окна */
+} _pre[3];
+
+#define bignPrePos(l) ((l) / 64 - 2)
+
+err_t bignPreAttach(const bign_params* params, const octet pre[],
+	size_t count)
+{
+	err_t code;
+	size_t pos;
+	// проверить входные данные
+	if (!memIsValid(params, sizeof(bign_params)))
+		return ERR_BAD_INPUT;
+	if (!bignIsOperable(params))
+		return ERR_BAD_PARAMS;
+	pos = bignPrePos(params->l);
+	// отключить
+	_pre[pos].table = 0;
+	if (pre == 0)
+		return ERR_OK;
+	// проверить
+	code = bignPreVal(params, pre, count);
+	ERR_CALL_CHECK(code);
+	// подключить
+	memCopy(&_pre[pos].params, params, sizeof(bign_params));
+	_pre[pos].w = bignPreGet(pre, BIGN_PRE_W);
+	_pre[pos].table = (const word*)(pre + BIGN_PRE_HDR);
+	return ERR_OK;
+}
+
+bool_t bignMulBase(word b[], const bign_params* params, const ec_o* ec,
+	const word d[], size_t m, void* stack)
+{
+	size_t pos;
+	ASSERT(bignIsOperable(params));
+	pos = bignPrePos(params->l);
+	if (_pre[pos].table && m == ec->f->n &&
+		memEq(&_pre[pos].params, params, sizeof(bign_params)))
+		return ecMulPreA(b, _pre[pos].table, _pre[pos].w, ec, d, m, stack);
+	return ecMulA(b, ec->base, ec, d, m, stack);
+}
@@ -4,7 +4,7 @@
 \brief STB 34.101.45 (bign): digital signature
 \project bee2 [cryptographic library]
 \created 2012.04.27
-\version 2023.09.20
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -14,6 +14,7 @@
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
 #include "bee2/core/oid.h"
+#include "bee2/core/perf.h"
 #include "bee2/core/str.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/belt.h"
@@ -40,14 +41,18 @@ static size_t bignSign_deep(size_t n, size_t f_deep, size_t ec_d,
 			zzMod_deep(n + n / 2 + 1, n));
 }
 
-err_t bignSign(octet sig[], const bign_params* params, const octet oid_der[],
-	size_t oid_len, const octet hash[], const octet privkey[], gen_i rng, 
-	void* rng_state)
+size_t bignSign_keep(size_t l)
+{
+	return bignStart_keep(l, bignSign_deep);
+}
+
+static err_t bignSign_internal(octet sig[], const bign_params* params,
+	const octet oid_der[], size_t oid_len, const octet hash[],
+	const octet privkey[], gen_i rng, void* rng_state, void* workspace)
 {
 	err_t code;
 	size_t no, n;
 	// состояние (буферы могут пересекаться)
-	void* state;			
 	ec_o* ec;				/* описание эллиптической кривой */
 	word* d;				/* [n] личный ключ */
 	word* k;				/* [n] одноразовый личный ключ */
@@ -66,14 +71,13 @@ err_t bignSign(octet sig[], const bign_params* params, const octet oid_der[],
 	// проверить rng
 	if (rng == 0)
 		return ERR_BAD_RNG;
-	// создать состояние
-	state = blobCreate(bignStart_keep(params->l, bignSign_deep));
-	if (state == 0)
-		return ERR_OUTOFMEMORY;
+	// проверить workspace
+	if (!memIsValid(workspace, bignSign_keep(params->l)))
+		return ERR_BAD_INPUT;
 	// старт
-	code = bignStart(state, params);
-	ERR_CALL_HANDLE(code, blobClose(state));
-	ec = (ec_o*)state;
+	code = bignStart(workspace, params);
+	ERR_CALL_CHECK(code);
+	ec = (ec_o*)workspace;
 	// размерности
 	no  = ec->f->no;
 	n = ec->f->n;
@@ -83,10 +87,7 @@ err_t bignSign(octet sig[], const bign_params* params, const octet oid_der[],
 		!memIsValid(privkey, no) ||
 		!memIsValid(sig, no + no / 2) ||
 		!memIsDisjoint2(hash, no, sig, no + no / 2))
-	{
-		blobClose(state);
 		return ERR_BAD_INPUT;
-	}
 	// раскладка состояния
 	d = s1 = objEnd(ec, word);
 	k = d + n;
@@ -96,22 +97,13 @@ err_t bignSign(octet sig[], const bign_params* params, const octet oid_der[],
 	// загрузить d
 	wwFrom(d, privkey, no);
 	if (wwIsZero(d, n) || wwCmp(d, ec->order, n) >= 0)
-	{
-		blobClose(state);
 		return ERR_BAD_PRIVKEY;
-	}
 	// сгенерировать k с помощью rng
 	if (!zzRandNZMod(k, ec->order, n, rng, rng_state))
-	{
-		blobClose(state);
 		return ERR_BAD_RNG;
-	}
 	// R <- k G
-	if (!ecMulA(R, ec->base, ec, k, n, stack))
-	{
-		blobClose(state);
+	if (!bignMulBase(R, params, ec, k, n, stack))
 		return ERR_BAD_PARAMS;
-	}
 	qrTo((octet*)R, ecX(R), ec->f, stack);
 	// s0 <- belt-hash(oid || R || H) mod 2^l
 	beltHashStart(stack);
@@ -132,10 +124,46 @@ err_t bignSign(octet sig[], const bign_params* params, const octet oid_der[],
 	// выгрузить s1
 	wwTo(sig + no / 2, no, s1);
 	// все нормально
-	blobClose(state);
 	return ERR_OK;
 }
 
+err_t bignSign_ws(octet sig[], const bign_params* params,
+	const octet oid_der[], size_t oid_len, const octet hash[],
+	const octet privkey[], gen_i rng, void* rng_state, void* workspace)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE(bign_sign_entry);
+	code = bignSign_internal(sig, params, oid_der, oid_len, hash, privkey,
+		rng, rng_state, workspace);
+	PERF_PROBE1(bign_sign_return, code);
+	PERF_STOP(PERF_BIGN_SIGN, code, 0, ticks);
+	return code;
+}
+
+err_t bignSign(octet sig[], const bign_params* params, const octet oid_der[],
+	size_t oid_len, const octet hash[], const octet privkey[], gen_i rng, 
+	void* rng_state)
+{
+	err_t code;
+	void* state;
+	// проверить params
+	if (!memIsValid(params, sizeof(bign_params)))
+		return ERR_BAD_INPUT;
+	if (!bignIsOperable(params))
+		return ERR_BAD_PARAMS;
+	// создать состояние
+	state = blobCreate(bignSign_keep(params->l));
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// выработать подпись
+	code = bignSign_ws(sig, params, oid_der, oid_len, hash, privkey, rng,
+		rng_state, state);
+	// завершить
+	blobClose(state);
+	return code;
+}
+
 static size_t bignSign2_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
@@ -149,14 +177,18 @@ static size_t bignSign2_deep(size_t n, size_t f_deep, size_t ec_d,
 			zzMod_deep(n + n / 2 + 1, n));
 }
 
-err_t bignSign2(octet sig[], const bign_params* params, const octet oid_der[],
-	size_t oid_len, const octet hash[], const octet privkey[], const void* t, 
-	size_t t_len)
+size_t bignSign2_keep(size_t l)
+{
+	return bignStart_keep(l, bignSign2_deep);
+}
+
+static err_t bignSign2_internal(octet sig[], const bign_params* params,
+	const octet oid_der[], size_t oid_len, const octet hash[],
+	const octet privkey[], const void* t, size_t t_len, void* workspace)
 {
 	err_t code;
 	size_t no, n;
 	// состояние (буферы могут пересекаться)
-	void* state;
 	ec_o* ec;				/* описание эллиптической кривой */
 	word* d;				/* [n] личный ключ */
 	word* k;				/* [n] одноразовый личный ключ */
@@ -176,14 +208,13 @@ err_t bignSign2(octet sig[], const bign_params* params, const octet oid_der[],
 	// проверить t
 	if (!memIsNullOrValid(t, t_len))
 		return ERR_BAD_INPUT;
-	// создать состояние
-	state = blobCreate(bignStart_keep(params->l, bignSign2_deep));
-	if (state == 0)
-		return ERR_OUTOFMEMORY;
+	// проверить workspace
+	if (!memIsValid(workspace, bignSign2_keep(params->l)))
+		return ERR_BAD_INPUT;
 	// старт
-	code = bignStart(state, params);
-	ERR_CALL_HANDLE(code, blobClose(state));
-	ec = (ec_o*)state;
+	code = bignStart(workspace, params);
+	ERR_CALL_CHECK(code);
+	ec = (ec_o*)workspace;
 	// размерности
 	no  = ec->f->no;
 	n = ec->f->n;
@@ -193,10 +224,7 @@ err_t bignSign2(octet sig[], const bign_params* params, const octet oid_der[],
 		!memIsValid(privkey, no) ||
 		!memIsValid(sig, no + no / 2) ||
 		!memIsDisjoint2(hash, no, sig, no + no / 2))
-	{
-		blobClose(state);
 		return ERR_BAD_INPUT;
-	}
 	// раскладка состояния
 	d = s1 = objEnd(ec, word);
 	k = d + n;
@@ -207,10 +235,7 @@ err_t bignSign2(octet sig[], const bign_params* params, const octet oid_der[],
 	// загрузить d
 	wwFrom(d, privkey, no);
 	if (wwIsZero(d, n) || wwCmp(d, ec->order, n) >= 0)
-	{
-		blobClose(state);
 		return ERR_BAD_PRIVKEY;
-	}
 	// хэшировать oid
 	beltHashStart(hash_state);
 	beltHashStepH(oid_der, oid_len, hash_state);
@@ -237,11 +262,8 @@ err_t bignSign2(octet sig[], const bign_params* params, const octet oid_der[],
 		}
 	}
 	// R <- k G
-	if (!ecMulA(R, ec->base, ec, k, n, stack))
-	{
-		blobClose(state);
+	if (!bignMulBase(R, params, ec, k, n, stack))
 		return ERR_BAD_PARAMS;
-	}
 	qrTo((octet*)R, ecX(R), ec->f, stack);
 	// s0 <- belt-hash(oid || R || H) mod 2^l
 	beltHashStepH(R, no, hash_state);
@@ -260,10 +282,46 @@ err_t bignSign2(octet sig[], const bign_params* params, const octet oid_der[],
 	// выгрузить s1
 	wwTo(sig + no / 2, no, s1);
 	// все нормально
-	blobClose(state);
 	return ERR_OK;
 }
 
+err_t bignSign2_ws(octet sig[], const bign_params* params,
+	const octet oid_der[], size_t oid_len, const octet hash[],
+	const octet privkey[], const void* t, size_t t_len, void* workspace)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE(bign_sign_entry);
+	code = bignSign2_internal(sig, params, oid_der, oid_len, hash, privkey,
+		t, t_len, workspace);
+	PERF_PROBE1(bign_sign_return, code);
+	PERF_STOP(PERF_BIGN_SIGN, code, 0, ticks);
+	return code;
+}
+
+err_t bignSign2(octet sig[], const bign_params* params, const octet oid_der[],
+	size_t oid_len, const octet hash[], const octet privkey[], const void* t, 
+	size_t t_len)
+{
+	err_t code;
+	void* state;
+	// проверить params
+	if (!memIsValid(params, sizeof(bign_params)))
+		return ERR_BAD_INPUT;
+	if (!bignIsOperable(params))
+		return ERR_BAD_PARAMS;
+	// создать состояние
+	state = blobCreate(bignSign2_keep(params->l));
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// выработать подпись
+	code = bignSign2_ws(sig, params, oid_der, oid_len, hash, privkey, t,
+		t_len, state);
+	// завершить
+	blobClose(state);
+	return code;
+}
+
 /*
 *******************************************************************************
 Проверка ЭЦП
@@ -279,13 +337,18 @@ static size_t bignVerify_deep(size_t n, size_t f_deep, size_t ec_d,
 			ecAddMulA_deep(n, ec_d, ec_deep, 2, n, n / 2 + 1));
 }
 
-err_t bignVerify(const bign_params* params, const octet oid_der[],
-	size_t oid_len, const octet hash[], const octet sig[], const octet pubkey[])
+size_t bignVerify_keep(size_t l)
+{
+	return bignStart_keep(l, bignVerify_deep);
+}
+
+static err_t bignVerify_internal(const bign_params* params,
+	const octet oid_der[], size_t oid_len, const octet hash[],
+	const octet sig[], const octet pubkey[], void* workspace)
 {
 	err_t code;
 	size_t no, n;
 	// состояние (буферы могут пересекаться)
-	void* state;
 	ec_o* ec;			/* описание эллиптической кривой */	
 	word* Q;			/* [2n] открытый ключ */
 	word* R;			/* [2n] точка R */
@@ -301,14 +364,13 @@ err_t bignVerify(const bign_params* params, const octet oid_der[],
 	// проверить oid_der
 	if (oid_len == SIZE_MAX || oidFromDER(0, oid_der, oid_len)  == SIZE_MAX)
 		return ERR_BAD_OID;
-	// создать состояние
-	state = blobCreate(bignStart_keep(params->l, bignVerify_deep));
-	if (state == 0)
-		return ERR_OUTOFMEMORY;
+	// проверить workspace
+	if (!memIsValid(workspace, bignVerify_keep(params->l)))
+		return ERR_BAD_INPUT;
 	// старт
-	code = bignStart(state, params);
-	ERR_CALL_HANDLE(code, blobClose(state));
-	ec = (ec_o*)state;
+	code = bignStart(workspace, params);
+	ERR_CALL_CHECK(code);
+	ec = (ec_o*)workspace;
 	// размерности
 	no  = ec->f->no;
 	n = ec->f->n;
@@ -317,10 +379,7 @@ err_t bignVerify(const bign_params* params, const octet oid_der[],
 	if (!memIsValid(hash, no) ||
 		!memIsValid(sig, no + no / 2) ||
 		!memIsValid(pubkey, 2 * no))
-	{
-		blobClose(state);
 		return ERR_BAD_INPUT;
-	}
 	// раскладка состояния
 	Q = R = objEnd(ec, word);
 	H = s0 = Q + 2 * n;
@@ -329,17 +388,11 @@ err_t bignVerify(const bign_params* params, const octet oid_der[],
 	// загрузить Q
 	if (!qrFrom(ecX(Q), pubkey, ec->f, stack) ||
 		!qrFrom(ecY(Q, n), pubkey + no, ec->f, stack))
-	{
-		blobClose(state);
 		return ERR_BAD_PUBKEY;
-	}
 	// загрузить и проверить s1
 	wwFrom(s1, sig + no / 2, no);
 	if (wwCmp(s1, ec->order, n) >= 0)
-	{
-		blobClose(state);
 		return ERR_BAD_SIG;
-	}
 	// s1 <- (s1 + H) mod q
 	wwFrom(H, hash, no);
 	if (wwCmp(H, ec->order, n) >= 0)
@@ -354,10 +407,7 @@ err_t bignVerify(const bign_params* params, const octet oid_der[],
 	s0[n / 2] = 1;
 	// R <- s1 G + (s0 + 2^l) Q
 	if (!ecAddMulA(R, ec, stack, 2, ec->base, s1, n, Q, s0, n / 2 + 1))
-	{
-		blobClose(state);
 		return ERR_BAD_SIG;
-	}
 	qrTo((octet*)R, ecX(R), ec->f, stack);
 	// s0 == belt-hash(oid || R || H) mod 2^l?
 	beltHashStart(stack);
@@ -365,7 +415,40 @@ err_t bignVerify(const bign_params* params, const octet oid_der[],
 	beltHashStepH(R, no, stack);
 	beltHashStepH(hash, no, stack);
 	code = beltHashStepV2(sig, no / 2, stack) ? ERR_OK : ERR_BAD_SIG;
-	// завершение
+	return code;
+}
+
+err_t bignVerify_ws(const bign_params* params, const octet oid_der[],
+	size_t oid_len, const octet hash[], const octet sig[], const octet pubkey[],
+	void* workspace)
+{
+	err_t code;
+	tm_ticks_t ticks = PERF_START();
+	PERF_PROBE(bign_verify_entry);
+	code = bignVerify_internal(params, oid_der, oid_len, hash, sig, pubkey,
+		workspace);
+	PERF_PROBE1(bign_verify_return, code);
+	PERF_STOP(PERF_BIGN_VERIFY, code, 0, ticks);
+	return code;
+}
+
+err_t bignVerify(const bign_params* params, const octet oid_der[],
+	size_t oid_len, const octet hash[], const octet sig[], const octet pubkey[])
+{
+	err_t code;
+	void* state;
+	// проверить params
+	if (!memIsValid(params, sizeof(bign_params)))
+		return ERR_BAD_INPUT;
+	if (!bignIsOperable(params))
+		return ERR_BAD_PARAMS;
+	// создать состояние
+	state = blobCreate(bignVerify_keep(params->l));
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// проверить подпись
+	code = bignVerify_ws(params, oid_der, oid_len, hash, sig, pubkey, state);
+	// завершить
 	blobClose(state);
 	return code;
 }
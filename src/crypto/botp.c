@@ -4,7 +4,7 @@
 \brief STB 34.101.47/botp: OTP algorithms
 \project bee2 [cryptographic library]
 \created 2015.11.02
-\version 2020.03.24
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -205,27 +205,35 @@ err_t botpHOTPRand(char* otp, size_t digit, const octet key[], size_t key_len,
 	return ERR_OK;
 }
 
-err_t botpHOTPVerify(const char* otp, const octet key[], size_t key_len, 
-	const octet ctr[8])
+err_t botpHOTPVerify_ws(const char* otp, const octet key[], size_t key_len, 
+	const octet ctr[8], void* workspace)
 {
-	void* state;
-	bool_t success;
 	// проверить входные данные
 	if (!strIsValid(otp) || strLen(otp) < 6 || strLen(otp) > 8)
 		return ERR_BAD_PWD;
-	if (!memIsValid(key, key_len) || !memIsValid(ctr, 8))
+	if (!memIsValid(key, key_len) || !memIsValid(ctr, 8) ||
+		!memIsValid(workspace, botpHOTP_keep()))
 		return ERR_BAD_INPUT;
+	// проверить пароль
+	botpHOTPStart(workspace, strLen(otp), key, key_len);
+	botpHOTPStepS(workspace, ctr);
+	return botpHOTPStepV(otp, workspace) ? ERR_OK : ERR_BAD_PWD;
+}
+
+err_t botpHOTPVerify(const char* otp, const octet key[], size_t key_len, 
+	const octet ctr[8])
+{
+	err_t code;
+	void* state;
 	// создать состояние
 	state = blobCreate(botpHOTP_keep());
 	if (state == 0)
 		return ERR_OUTOFMEMORY;
 	// проверить пароль
-	botpHOTPStart(state, strLen(otp), key, key_len);
-	botpHOTPStepS(state, ctr);
-	success = botpHOTPStepV(otp, state);
+	code = botpHOTPVerify_ws(otp, key, key_len, ctr, state);
 	// завершить
 	blobClose(state);
-	return success ? ERR_OK : ERR_BAD_PWD;
+	return code;
 }
 
 /*
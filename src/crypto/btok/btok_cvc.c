@@ -4,13 +4,14 @@
 \brief STB 34.101.79 (btok): CV certificates
 \project bee2 [cryptographic library]
 \created 2022.07.04
-\version 2023.12.19
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
 #include "bee2/core/blob.h"
+#include "bee2/core/cache.h"
 #include "bee2/core/err.h"
 #include "bee2/core/der.h"
 #include "bee2/core/mem.h"
@@ -620,12 +621,75 @@ size_t btokCVCLen(const octet der[], size_t count)
 	return derDec2(0, 0, der, count, 0x7F21);
 }
 
+/*
+*******************************************************************************
+Кэш проверенных подписей
+
+Кэш _cache (см. cache.h) хранит хэш-значения сертификатов и открытых
+ключей издателей, на которых успешно проверены подписи сертификатов.
+*******************************************************************************
+*/
+
+static cache_t _cache[1];		/*< кэш */
+
+err_t btokCVCCacheStart(size_t capacity)
+{
+	return cacheStart(_cache, capacity);
+}
+
+void btokCVCCacheStat(size_t* hits, size_t* misses)
+{
+	cacheStat(_cache, hits, misses);
+}
+
+void btokCVCCacheStop()
+{
+	cacheStop(_cache);
+}
+
 /*
 *******************************************************************************
 Проверка CV-сертификата
+
+Подпись сертификата проверяется в функции btokCVCUnwrapCached(). Если кэш
+включен и в нем есть хэш-значение сертификата и открытого ключа издателя,
+то сертификат разбирается без проверки подписи. Иначе сертификат
+разбирается с проверкой подписи и в случае успеха хэш-значение
+размещается в кэше.
 *******************************************************************************
 */
 
+static err_t btokCVCUnwrapCached(btok_cvc_t* cvc, const octet cert[],
+	size_t cert_len, const octet pubkey[], size_t pubkey_len)
+{
+	err_t code;
+	void* state;
+	octet digest[32];
+	// кэш выключен?
+	if (!cacheIsOn(_cache))
+		return btokCVCUnwrap(cvc, cert, cert_len, pubkey, pubkey_len);
+	// хэшировать сертификат и ключ
+	if (!memIsValid(cert, cert_len) || !memIsValid(pubkey, pubkey_len))
+		return ERR_BAD_INPUT;
+	state = blobCreate(beltHash_keep());
+	if (!state)
+		return ERR_OUTOFMEMORY;
+	beltHashStart(state);
+	beltHashStepH(cert, cert_len, state);
+	beltHashStepH(pubkey, pubkey_len, state);
+	beltHashStepG(digest, state);
+	blobClose(state);
+	// подпись уже проверялась?
+	if (cacheFind(_cache, digest))
+		return btokCVCUnwrap(cvc, cert, cert_len, 0, 0);
+	// проверить подпись
+	code = btokCVCUnwrap(cvc, cert, cert_len, pubkey, pubkey_len);
+	ERR_CALL_CHECK(code);
+	// сохранить результат в кэше
+	cacheAdd(_cache, digest);
+	return code;
+}
+
 err_t btokCVCVal(const octet cert[], size_t cert_len, 
 	const octet certa[], size_t certa_len, const octet* date)
 {
@@ -645,7 +709,8 @@ err_t btokCVCVal(const octet cert[], size_t cert_len,
 	// разобрать сертификаты
 	code = btokCVCUnwrap(cvca, certa, certa_len, 0, 0);
 	ERR_CALL_HANDLE(code, blobClose(stack));
-	code = btokCVCUnwrap(cvc, cert, cert_len, cvca->pubkey, cvca->pubkey_len);
+	code = btokCVCUnwrapCached(cvc, cert, cert_len, cvca->pubkey,
+		cvca->pubkey_len);
 	ERR_CALL_HANDLE(code, blobClose(stack));
 	// проверить соответствие
 	code = btokCVCCheck2(cvc, cvca);
@@ -682,7 +747,8 @@ err_t btokCVCVal2(btok_cvc_t* cvc, const octet cert[], size_t cert_len,
 		cvc = (btok_cvc_t*)stack;
 	}
 	// разобрать сертификат
-	code = btokCVCUnwrap(cvc, cert, cert_len, cvca->pubkey, cvca->pubkey_len);
+	code = btokCVCUnwrapCached(cvc, cert, cert_len, cvca->pubkey,
+		cvca->pubkey_len);
 	ERR_CALL_HANDLE(code, blobClose(stack));
 	// проверить соответствие
 	code = btokCVCCheck2(cvc, cvca);
@@ -0,0 +1,47 @@
+/*
+*******************************************************************************
+\file crypto_lcl.h
+\brief Cryptographic algorithms: common local definitions
+\project bee2 [cryptographic library]
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#ifndef __CRYPTO_LCL_H
+#define __CRYPTO_LCL_H
+
+#include "bee2/defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+*******************************************************************************
+Заголовки сохраненных состояний
+
+Сохраненное состояние начинается с заголовка из 4 октетов: номер версии
+формата (1), код алгоритма, длина сохраненного состояния (вместе
+с заголовком) как двухоктетное число (младший октет первым).
+
+Коды алгоритмов определяются в локальных заголовочных файлах модулей:
+0x1X -- belt (belt_lcl.h), 0x2X -- bash (bash_lcl.h).
+*******************************************************************************
+*/
+
+#define cryptoStateHdrEnc(buf, code, len)\
+	((buf)[0] = 1, (buf)[1] = (code),\
+		(buf)[2] = (octet)(len), (buf)[3] = (octet)((len) >> 8))
+
+#define cryptoStateHdrIsValid(buf, code, len)\
+	((buf)[0] == 1 && (buf)[1] == (code) &&\
+		(buf)[2] == (octet)(len) && (buf)[3] == (octet)((len) >> 8))
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __CRYPTO_LCL_H */
@@ -4,17 +4,20 @@
 \brief DSTU 4145-2002 (Ukraine): digital signature algorithms
 \project bee2 [cryptographic library]
 \created 2012.04.27
-\version 2023.09.22
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
 #include "bee2/core/blob.h"
+#include "bee2/core/cache.h"
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/mt.h"
 #include "bee2/core/str.h"
 #include "bee2/core/util.h"
+#include "bee2/crypto/belt.h"
 #include "bee2/crypto/dstu.h"
 #include "bee2/math/ec2.h"
 #include "bee2/math/gf2.h"
@@ -547,7 +550,7 @@ static size_t dstuParamsVal_deep(size_t n, size_t f_deep, size_t ec_d,
 			ecHasOrderA_deep(n, ec_d, ec_deep, n));
 }
 
-err_t dstuParamsVal(const dstu_params* params)
+static err_t dstuParamsVal_internal(const dstu_params* params)
 {
 	err_t code;
 	// состояние
@@ -569,6 +572,81 @@ err_t dstuParamsVal(const dstu_params* params)
 	return code;
 }
 
+/*
+*******************************************************************************
+Кэш проверенных параметров
+
+В кэше хранятся хэш-значения belt-hash параметров, которые успешно прошли
+проверку в dstuParamsVal(). Хэшируются все поля параметров (поля
+по отдельности, чтобы не захватывать выравнивающие октеты структуры).
+
+Кэш _cache (см. cache.h) включается однократно (с помощью mtCallOnce()),
+при включении в него заносится хэш-значение параметров кривой
+curve163pb. Для остальных стандартных кривых базовая точка не определена
+и выбирается пользователем (см. dstuPointGen()). Если включить кэш
+не удалось, то он не используется.
+
+Некорректный указатель params, как и в dstuEcCreate(), приводит к ошибке
+ERR_BAD_PARAMS.
+*******************************************************************************
+*/
+
+#define DSTU_PARAMS_CACHE_SIZE 16
+
+static size_t _once;			/*< триггер однократности */
+static cache_t _cache[1];		/*< кэш */
+
+static err_t dstuParamsHash(octet hash[32], const dstu_params* params)
+{
+	void* state;
+	ASSERT(memIsValid(params, sizeof(dstu_params)));
+	state = blobCreate(beltHash_keep());
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	beltHashStart(state);
+	beltHashStepH(params->p, sizeof(params->p), state);
+	beltHashStepH(&params->A, sizeof(params->A), state);
+	beltHashStepH(params->B, sizeof(params->B), state);
+	beltHashStepH(params->n, sizeof(params->n), state);
+	beltHashStepH(&params->c, sizeof(params->c), state);
+	beltHashStepH(params->P, sizeof(params->P), state);
+	beltHashStepG(hash, state);
+	blobClose(state);
+	return ERR_OK;
+}
+
+static void dstuParamsCacheInit()
+{
+	dstu_params params[1];
+	octet hash[32];
+	if (cacheStart(_cache, DSTU_PARAMS_CACHE_SIZE) != ERR_OK)
+		return;
+	// стандартные параметры
+	if (dstuParamsStd(params, _curve163pb_name) == ERR_OK &&
+		dstuParamsHash(hash, params) == ERR_OK)
+		cacheAdd(_cache, hash);
+}
+
+err_t dstuParamsVal(const dstu_params* params)
+{
+	err_t code;
+	octet hash[32];
+	// проверить params (как в dstuEcCreate())
+	if (!memIsValid(params, sizeof(dstu_params)))
+		return ERR_BAD_PARAMS;
+	// параметры уже проверялись?
+	code = dstuParamsHash(hash, params);
+	ERR_CALL_CHECK(code);
+	mtCallOnce(&_once, dstuParamsCacheInit);
+	if (cacheFind(_cache, hash))
+		return ERR_OK;
+	// проверить и запомнить
+	code = dstuParamsVal_internal(params);
+	if (code == ERR_OK)
+		cacheAdd(_cache, hash);
+	return code;
+}
+
 /*
 *******************************************************************************
 Управление точками
@@ -4,17 +4,20 @@
 \brief GOST R 34.10-94 (Russia): digital signature algorithms
 \project bee2 [cryptographic library]
 \created 2012.07.09
-\version 2023.11.08
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
 #include "bee2/core/blob.h"
+#include "bee2/core/cache.h"
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/mt.h"
 #include "bee2/core/str.h"
 #include "bee2/core/util.h"
+#include "bee2/crypto/belt.h"
 #include "bee2/crypto/g12s.h"
 #include "bee2/math/ecp.h"
 #include "bee2/math/gfp.h"
@@ -715,7 +718,7 @@ static size_t g12sParamsVal_deep(size_t n, size_t f_deep, size_t ec_d,
 			ecHasOrderA_deep(n, ec_d, ec_deep, n));
 }
 
-err_t g12sParamsVal(const g12s_params* params)
+static err_t g12sParamsVal_internal(const g12s_params* params)
 {
 	err_t code;
 	// состояние
@@ -738,6 +741,83 @@ err_t g12sParamsVal(const g12s_params* params)
 	return code;
 }
 
+/*
+*******************************************************************************
+Кэш проверенных параметров
+
+В кэше хранятся хэш-значения belt-hash параметров, которые успешно прошли
+проверку в g12sParamsVal(). Хэшируются все поля параметров (поля
+по отдельности, чтобы не захватывать выравнивающие октеты структуры).
+
+Кэш _cache (см. cache.h) включается однократно (с помощью mtCallOnce()),
+при включении в него заносятся хэш-значения стандартных параметров.
+Если включить кэш не удалось, то он не используется.
+*******************************************************************************
+*/
+
+#define G12S_PARAMS_CACHE_SIZE 16
+
+static size_t _once;			/*< триггер однократности */
+static cache_t _cache[1];		/*< кэш */
+
+static err_t g12sParamsHash(octet hash[32], const g12s_params* params)
+{
+	void* state;
+	ASSERT(memIsValid(params, sizeof(g12s_params)));
+	state = blobCreate(beltHash_keep());
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	beltHashStart(state);
+	beltHashStepH(&params->l, sizeof(params->l), state);
+	beltHashStepH(params->p, sizeof(params->p), state);
+	beltHashStepH(params->a, sizeof(params->a), state);
+	beltHashStepH(params->b, sizeof(params->b), state);
+	beltHashStepH(params->q, sizeof(params->q), state);
+	beltHashStepH(&params->n, sizeof(params->n), state);
+	beltHashStepH(params->xP, sizeof(params->xP), state);
+	beltHashStepH(params->yP, sizeof(params->yP), state);
+	beltHashStepG(hash, state);
+	blobClose(state);
+	return ERR_OK;
+}
+
+static void g12sParamsCacheInit()
+{
+	const char* names[] = {
+		_a1_name, _cryptoproA_name, _cryptoproB_name, _cryptoproC_name,
+		_cryptocom_name, _a2_name, _paramsetA512_name, _paramsetB512_name };
+	g12s_params params[1];
+	octet hash[32];
+	size_t pos;
+	if (cacheStart(_cache, G12S_PARAMS_CACHE_SIZE) != ERR_OK)
+		return;
+	// стандартные параметры
+	for (pos = 0; pos < COUNT_OF(names); ++pos)
+		if (g12sParamsStd(params, names[pos]) == ERR_OK &&
+			g12sParamsHash(hash, params) == ERR_OK)
+			cacheAdd(_cache, hash);
+}
+
+err_t g12sParamsVal(const g12s_params* params)
+{
+	err_t code;
+	octet hash[32];
+	// проверить params
+	if (!memIsValid(params, sizeof(g12s_params)))
+		return ERR_BAD_PARAMS;
+	// параметры уже проверялись?
+	code = g12sParamsHash(hash, params);
+	ERR_CALL_CHECK(code);
+	mtCallOnce(&_once, g12sParamsCacheInit);
+	if (cacheFind(_cache, hash))
+		return ERR_OK;
+	// проверить и запомнить
+	code = g12sParamsVal_internal(params);
+	if (code == ERR_OK)
+		cacheAdd(_cache, hash);
+	return code;
+}
+
 /*
 *******************************************************************************
 Управление ключами
@@ -0,0 +1,443 @@
+/*
+*******************************************************************************
+\file job.c
+\brief Asynchronous cryptographic jobs
+\project bee2 [cryptographic library]
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "bee2/core/blob.h"
+#include "bee2/core/err.h"
+#include "bee2/core/mem.h"
+#include "bee2/core/mt.h"
+#include "bee2/core/util.h"
+#include "bee2/crypto/belt.h"
+#include "bee2/crypto/bign.h"
+#include "bee2/crypto/job.h"
+#include "bign/bign_lcl.h"
+
+/*
+*******************************************************************************
+Обработчик
+
+Задания выполняются в пуле потоков pool (см. mtPoolCreate()). Очередь
+заданий -- односвязный список head -> ... -> tail, защищенный мьютексом
+mtx. Задания из очереди забирают исполнители -- задачи пула, которые
+описываются структурами job_runner_st. Исполнителей не больше, чем
+потоков пула (и не меньше одного). Потоки, которые ожидают завершения
+заданий, ждут на условной переменной done_cv.
+
+При формировании пакета просматриваются не более JOB_SCAN * batch
+первых заданий очереди. Тем самым ограничивается время, в течение
+которого мьютекс удерживается исполнителем.
+*******************************************************************************
+*/
+
+#define JOB_SCAN 4
+
+typedef struct
+{
+	mt_task_t task[1];						/*< задача пула */
+	job_engine_t* engine;					/*< обработчик */
+	void* ws;								/*< рабочая память */
+	bool_t busy;							/*< исполнитель работает? */
+	bool_t used;							/*< задача передавалась в пул? */
+} job_runner_st;
+
+struct job_engine_st
+{
+	mt_pool_t* pool;						/*< пул потоков */
+	size_t runners;							/*< число исполнителей */
+	size_t batch;							/*< размер пакета */
+	job_stat_t stat[1];						/*< статистика */
+	job_t* head;							/*< начало очереди */
+	job_t* tail;							/*< конец очереди */
+	mt_mtx_t mtx[1];						/*< мьютекс */
+	mt_cond_t done_cv[1];					/*< завершение заданий */
+	job_runner_st runner[MT_POOL_MAX];		/*< исполнители */
+};
+
+/*
+*******************************************************************************
+Выполнение заданий
+*******************************************************************************
+*/
+
+static bool_t jobIsBign(size_t type)
+{
+	return type == JOB_BIGN_SIGN || type == JOB_BIGN_VERIFY ||
+		type == JOB_BIGN_DH;
+}
+
+static size_t jobKeep(const job_t* job)
+{
+	switch (job->type)
+	{
+	case JOB_BIGN_SIGN:
+		return job->rng ? bignSign_keep(job->params->l) :
+			bignSign2_keep(job->params->l);
+	case JOB_BIGN_VERIFY:
+		return bignVerify_keep(job->params->l);
+	case JOB_BIGN_DH:
+		return bignDH_keep(job->params->l);
+	case JOB_BELT_DWP_WRAP:
+	case JOB_BELT_DWP_UNWRAP:
+		return beltDWP_keep();
+	default:
+		ASSERT(job->type == JOB_BELT_CHE_WRAP ||
+			job->type == JOB_BELT_CHE_UNWRAP);
+		return beltCHE_keep();
+	}
+}
+
+static err_t jobRun(job_t* job, void* ws)
+{
+	switch (job->type)
+	{
+	case JOB_BIGN_SIGN:
+		if (job->rng)
+			return bignSign_ws(job->sig, job->params, job->oid_der,
+				job->oid_len, job->hash, job->privkey, job->rng,
+				job->rng_state, ws);
+		return bignSign2_ws(job->sig, job->params, job->oid_der,
+			job->oid_len, job->hash, job->privkey, job->src1, job->count1, ws);
+	case JOB_BIGN_VERIFY:
+		return bignVerify_ws(job->params, job->oid_der, job->oid_len,
+			job->hash, job->sig, job->pubkey, ws);
+	case JOB_BIGN_DH:
+		return bignDH_ws(job->dest, job->params, job->privkey, job->pubkey,
+			job->key_len, ws);
+	case JOB_BELT_DWP_WRAP:
+		return beltDWPWrap_ws(job->dest, job->mac, job->src1, job->count1,
+			job->src2, job->count2, job->key, job->key_len, job->iv, ws);
+	case JOB_BELT_DWP_UNWRAP:
+		return beltDWPUnwrap_ws(job->dest, job->src1, job->count1,
+			job->src2, job->count2, job->mac, job->key, job->key_len,
+			job->iv, ws);
+	case JOB_BELT_CHE_WRAP:
+		return beltCHEWrap_ws(job->dest, job->mac, job->src1, job->count1,
+			job->src2, job->count2, job->key, job->key_len, job->iv, ws);
+	default:
+		ASSERT(job->type == JOB_BELT_CHE_UNWRAP);
+		return beltCHEUnwrap_ws(job->dest, job->src1, job->count1,
+			job->src2, job->count2, job->mac, job->key, job->key_len,
+			job->iv, ws);
+	}
+}
+
+/*
+*******************************************************************************
+Выполнение пакета
+
+Задания пакета выполняются в рабочей памяти ws, которая при необходимости
+расширяется. Функция возвращает (возможно, новый) дескриптор рабочей
+памяти.
+
+При завершении пакета задания сначала разделяются на две группы: с
+функцией обратного вызова и без нее. Задания второй группы отмечаются
+как завершенные под защитой мьютекса. После этого к ним нельзя
+обращаться: ожидающий поток может освободить память задания. Затем
+вызываются функции обратного вызова для заданий первой группы.
+*******************************************************************************
+*/
+
+static void* jobRunBatch(job_engine_t* engine, job_t* batch, void* ws)
+{
+	size_t keep = 0;
+	job_t* job;
+	job_t* next;
+	job_t* cbs = 0;
+	job_t* waits = 0;
+	void* ws1;
+	// настроить рабочую память
+	for (job = batch; job; job = job->next)
+		keep = MAX2(keep, jobKeep(job));
+	if (blobSize(ws) < keep && (ws1 = blobResize(ws, keep)))
+		ws = ws1;
+	// выполнить задания
+	for (job = batch; job; job = job->next)
+		job->code = blobSize(ws) < keep ? ERR_OUTOFMEMORY : jobRun(job, ws);
+	blobWipe(ws);
+	// разделить задания
+	for (job = batch; job; job = next)
+	{
+		next = job->next;
+		if (job->callback)
+			job->next = cbs, cbs = job;
+		else
+			job->next = waits, waits = job;
+	}
+	// отметить завершение
+	if (waits)
+	{
+		mtMtxLock(engine->mtx);
+		for (job = waits; job; job = next)
+		{
+			next = job->next;
+			mtAtomicIncr(&job->done);
+		}
+		mtCondBroadcast(engine->done_cv);
+		mtMtxUnlock(engine->mtx);
+	}
+	// вызвать функции обратного вызова
+	for (job = cbs; job; job = next)
+	{
+		next = job->next;
+		job->callback(job, job->arg);
+	}
+	return ws;
+}
+
+/*
+*******************************************************************************
+Формирование пакета
+
+Первое задание очереди включается в пакет всегда. Затем в пакет
+переносятся совместимые с ним задания очереди (в порядке следования).
+\pre Мьютекс engine->mtx заблокирован, очередь не пуста.
+*******************************************************************************
+*/
+
+static bool_t jobIsCompatible(const job_t* job1, const job_t* job2)
+{
+	return job1->type == job2->type && job1->params == job2->params;
+}
+
+static job_t* jobTake(job_engine_t* engine)
+{
+	job_t* batch;
+	job_t* last;
+	job_t* prev;
+	job_t* job;
+	size_t count;
+	size_t scan;
+	ASSERT(engine->head);
+	// первое задание
+	last = batch = engine->head;
+	engine->head = batch->next;
+	// совместимые задания
+	prev = 0, job = engine->head;
+	for (count = 1, scan = 0; job && count < engine->batch &&
+		scan < JOB_SCAN * engine->batch; ++scan)
+		if (jobIsCompatible(batch, job))
+		{
+			if (prev)
+				prev->next = job->next;
+			else
+				engine->head = job->next;
+			last = last->next = job;
+			job = job->next, ++count;
+		}
+		else
+			prev = job, job = job->next;
+	last->next = 0;
+	// восстановить конец очереди
+	if (job == 0)
+		engine->tail = prev;
+	// учесть пакет
+	engine->stat->jobs += count;
+	engine->stat->batches++;
+	return batch;
+}
+
+/*
+*******************************************************************************
+Исполнитель
+
+Исполнитель передается в пул, когда в очередь ставится задание, а все
+уже работающие исполнители заняты. Исполнитель забирает из очереди пакеты,
+пока она не опустеет, после чего освобождается (признак busy
+сбрасывается под защитой мьютекса, поэтому задание, поставленное
+в очередь после опустошения, будет обработано новым исполнителем).
+
+Исполнитель снова передается в пул, только когда он свободен (busy ==
+FALSE) и его задача завершена (пул установил признак завершения).
+Исполнитель, который сбросил busy, но еще не вышел из задачи, пропускается.
+Если других свободных исполнителей нет и нет занятых (которые забрали бы
+задание из очереди), то выход из задачи ожидается. Ожидание не выполняет
+задачи пула (в отличие от mtPoolWait()) и кратковременно: задача
+исполнителя завершается сразу после сброса busy.
+*******************************************************************************
+*/
+
+static bool_t jobRunnerIsDone(job_runner_st* runner)
+{
+	return !runner->used ||
+		mtAtomicCmpSwap(&runner->task->done, 0, 0) != 0;
+}
+
+static void jobRunner(void* arg)
+{
+	job_runner_st* runner = (job_runner_st*)arg;
+	job_engine_t* engine = runner->engine;
+	job_t* batch;
+	mtMtxLock(engine->mtx);
+	while (engine->head)
+	{
+		batch = jobTake(engine);
+		mtMtxUnlock(engine->mtx);
+		runner->ws = jobRunBatch(engine, batch, runner->ws);
+		mtMtxLock(engine->mtx);
+	}
+	runner->busy = FALSE;
+	mtMtxUnlock(engine->mtx);
+}
+
+/*
+*******************************************************************************
+Управление обработчиком
+*******************************************************************************
+*/
+
+job_engine_t* jobEngineCreate(size_t workers, size_t batch)
+{
+	job_engine_t* engine;
+	size_t i;
+	// подготовить параметры
+	if (batch == 0)
+		batch = JOB_BATCH_DEFAULT;
+	// создать обработчик
+	engine = (job_engine_t*)memAlloc(sizeof(job_engine_t));
+	if (engine == 0)
+		return 0;
+	memSetZero(engine, sizeof(job_engine_t));
+	engine->batch = batch;
+	if (!mtMtxCreate(engine->mtx))
+	{
+		memFree(engine);
+		return 0;
+	}
+	if (!mtCondCreate(engine->done_cv))
+	{
+		mtMtxClose(engine->mtx);
+		memFree(engine);
+		return 0;
+	}
+	// создать пул
+	if (!(engine->pool = mtPoolCreate(workers)))
+	{
+		mtCondClose(engine->done_cv);
+		mtMtxClose(engine->mtx);
+		memFree(engine);
+		return 0;
+	}
+	// подготовить исполнителей
+	engine->runners = MAX2(mtPoolWorkers(engine->pool), 1);
+	for (i = 0; i < engine->runners; ++i)
+		engine->runner[i].engine = engine;
+	return engine;
+}
+
+size_t jobEngineWorkers(const job_engine_t* engine)
+{
+	ASSERT(memIsValid(engine, sizeof(job_engine_t)));
+	return mtPoolWorkers(engine->pool);
+}
+
+void jobEngineStat(job_stat_t* stat, job_engine_t* engine)
+{
+	ASSERT(memIsValid(stat, sizeof(job_stat_t)));
+	ASSERT(memIsValid(engine, sizeof(job_engine_t)));
+	mtMtxLock(engine->mtx);
+	memCopy(stat, engine->stat, sizeof(job_stat_t));
+	mtMtxUnlock(engine->mtx);
+}
+
+err_t jobSubmit(job_engine_t* engine, job_t* job)
+{
+	job_runner_st* runner = 0;
+	job_runner_st* exiting = 0;
+	bool_t busy = FALSE;
+	size_t i;
+	ASSERT(memIsValid(engine, sizeof(job_engine_t)));
+	// проверить входные данные
+	if (!memIsValid(job, sizeof(job_t)) ||
+		job->type < JOB_BIGN_SIGN || job->type > JOB_BELT_CHE_UNWRAP)
+		return ERR_BAD_INPUT;
+	if (jobIsBign(job->type))
+	{
+		if (!memIsValid(job->params, sizeof(bign_params)))
+			return ERR_BAD_INPUT;
+		if (!bignIsOperable(job->params))
+			return ERR_BAD_PARAMS;
+	}
+	// подготовить служебные поля
+	job->done = 0;
+	job->next = 0;
+	// поставить в очередь и занять свободного исполнителя
+	mtMtxLock(engine->mtx);
+	if (engine->tail)
+		engine->tail->next = job;
+	else
+		engine->head = job;
+	engine->tail = job;
+	for (i = 0; i < engine->runners; ++i)
+		if (engine->runner[i].busy)
+			busy = TRUE;
+		else if (jobRunnerIsDone(engine->runner + i))
+		{
+			runner = engine->runner + i;
+			break;
+		}
+		else if (!exiting)
+			exiting = engine->runner + i;
+	// все исполнители выходят из задач?
+	if (!runner && !busy)
+	{
+		ASSERT(exiting);
+		runner = exiting;
+	}
+	if (runner)
+		runner->busy = TRUE;
+	mtMtxUnlock(engine->mtx);
+	// запустить исполнителя
+	if (runner)
+	{
+		while (!jobRunnerIsDone(runner))
+			mtSleep(0);
+		runner->used = TRUE;
+		mtPoolSubmit(engine->pool, runner->task, jobRunner, runner);
+	}
+	return ERR_OK;
+}
+
+bool_t jobIsDone(job_t* job)
+{
+	ASSERT(memIsValid(job, sizeof(job_t)));
+	ASSERT(job->callback == 0);
+	return mtAtomicCmpSwap(&job->done, 0, 0) != 0;
+}
+
+err_t jobWait(job_engine_t* engine, job_t* job)
+{
+	ASSERT(memIsValid(engine, sizeof(job_engine_t)));
+	ASSERT(memIsValid(job, sizeof(job_t)));
+	ASSERT(job->callback == 0);
+	mtMtxLock(engine->mtx);
+	while (!job->done)
+		mtCondWait(engine->done_cv, engine->mtx);
+	mtMtxUnlock(engine->mtx);
+	return job->code;
+}
+
+void jobEngineClose(job_engine_t* engine)
+{
+	size_t i;
+	ASSERT(memIsValid(engine, sizeof(job_engine_t)));
+	// дождаться исполнителей
+	for (i = 0; i < engine->runners; ++i)
+		if (engine->runner[i].used)
+			mtPoolWait(engine->pool, engine->runner[i].task);
+	ASSERT(engine->head == 0);
+	// освободить ресурсы
+	for (i = 0; i < engine->runners; ++i)
+		blobClose(engine->runner[i].ws);
+	mtPoolClose(engine->pool);
+	mtCondClose(engine->done_cv);
+	mtMtxClose(engine->mtx);
+	memFree(engine);
+}
@@ -4,7 +4,7 @@
 \brief Elliptic curves
 \project bee2 [cryptographic library]
 \created 2014.03.04
-\version 2015.11.09
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -12,6 +12,7 @@
 
 #include <stdarg.h>
 #include "bee2/core/mem.h"
+#include "bee2/core/perf.h"
 #include "bee2/core/stack.h"
 #include "bee2/core/util.h"
 #include "bee2/core/word.h"
@@ -175,12 +176,14 @@ bool_t ecMulA(word b[], const word a[], const ec_o* ec, const word d[],
 	register size_t naf_size;
 	register size_t i;
 	register word w;
+	bool_t ret;
 	// переменные в stack
 	word* naf;			/* NAF */
 	word* t;			/* вспомогательная точка */
 	word* pre;			/* pre[i] = (2i + 1)a (naf_count элементов) */
 	// pre
 	ASSERT(ecIsOperable(ec));
+	PERF_PROBE1(ec_mula_entry, m);
 	// раскладка stack
 	naf = (word*)stack;
 	t = naf + 2 * m + 1;
@@ -191,7 +194,10 @@ bool_t ecMulA(word b[], const word a[], const ec_o* ec, const word d[],
 	naf_size = wwNAF(naf, d, m, naf_width);
 	// d == O => b <- O
 	if (naf_size == 0)
+	{
+		PERF_PROBE1(ec_mula_return, FALSE);
 		return FALSE;
+	}
 	// pre[0] <- a
 	ecFromA(pre, a, ec, stack);
 	// расчет pre[i]: t <- 2a, pre[i] <- t + pre[i - 1]
@@ -232,7 +238,9 @@ bool_t ecMulA(word b[], const word a[], const ec_o* ec, const word d[],
 	w = 0;
 	i = 0;
 	// к аффинным координатам
-	return ecToA(b, t, ec, stack);
+	ret = ecToA(b, t, ec, stack);
+	PERF_PROBE1(ec_mula_return, ret);
+	return ret;
 }
 
 size_t ecMulA_deep(size_t n, size_t ec_d, size_t ec_deep, size_t m)
@@ -409,3 +417,110 @@ size_t ecAddMulA_deep(size_t n, size_t ec_d, size_t ec_deep, size_t k, ...)
 	ret += ec_deep;
 	return ret;
 }
+
+/*
+*******************************************************************************
+Кратные фиксированной точки
+
+Строки таблицы строятся последовательно. Перед построением i-й строки
+в проективной точке u находится 2^{w i} a. Точки строки рассчитываются
+как v <- v + u (сложение с аффинной точкой u, записанной первой в строке)
+и переводятся в аффинные координаты. Затем u удваивается w раз.
+
+При вычислении кратной точки окна кратности обрабатываются в порядке
+возрастания номеров: к накопленной проективной точке прибавляется
+аффинная точка таблицы, соответствующая значению окна.
+*******************************************************************************
+*/
+
+size_t ecPreA_keep(size_t n, size_t w, size_t m)
+{
+	ASSERT(1 <= w && w <= 8);
+	return O_OF_W(((B_OF_W(m) + w - 1) / w) * ((SIZE_1 << w) - 1) * 2 * n);
+}
+
+bool_t ecPreA(word pre[], const word a[], const ec_o* ec, size_t w,
+	size_t m, void* stack)
+{
+	const size_t n = ec->f->n;
+	const size_t k = (B_OF_W(m) + w - 1) / w;
+	const size_t c = (SIZE_1 << w) - 1;
+	size_t i, j;
+	// переменные в stack
+	word* u;			/* 2^{w i} a */
+	word* v;			/* j 2^{w i} a */
+	// pre
+	ASSERT(ecIsOperable(ec));
+	ASSERT(1 <= w && w <= 8);
+	ASSERT(wwIsValid(pre, ecPreA_keep(n, w, m) / O_PER_W));
+	// раскладка stack
+	u = (word*)stack;
+	v = u + ec->d * n;
+	stack = v + ec->d * n;
+	// u <- a
+	if (!ecFromA(u, a, ec, stack))
+		return FALSE;
+	// цикл по строкам
+	for (i = 0; i < k; ++i, pre += 2 * n * c)
+	{
+		// pre[i][0] <- u
+		if (!ecToA(pre, u, ec, stack))
+			return FALSE;
+		// pre[i][j] <- pre[i][j - 1] + u
+		wwCopy(v, u, ec->d * n);
+		for (j = 1; j < c; ++j)
+		{
+			ecAddA(v, v, pre, ec, stack);
+			if (!ecToA(pre + 2 * n * j, v, ec, stack))
+				return FALSE;
+		}
+		// u <- 2^w u
+		for (j = 0; j < w; ++j)
+			ecDbl(u, u, ec, stack);
+	}
+	// очистка
+	i = j = 0;
+	return TRUE;
+}
+
+size_t ecPreA_deep(size_t n, size_t ec_d, size_t ec_deep)
+{
+	return O_OF_W(2 * ec_d * n) + ec_deep;
+}
+
+bool_t ecMulPreA(word b[], const word pre[], size_t w, const ec_o* ec,
+	const word d[], size_t m, void* stack)
+{
+	const size_t n = ec->f->n;
+	const size_t c = (SIZE_1 << w) - 1;
+	register size_t pos;
+	register word j;
+	// переменные в stack
+	word* t;			/* накопленная точка */
+	// pre
+	ASSERT(ecIsOperable(ec));
+	ASSERT(1 <= w && w <= 8);
+	ASSERT(wwIsValid(pre, ecPreA_keep(n, w, m) / O_PER_W));
+	ASSERT(wwIsValid(d, m));
+	// раскладка stack
+	t = (word*)stack;
+	stack = t + ec->d * n;
+	// t <- O
+	wwSetZero(t, ec->d * n);
+	// цикл по окнам
+	for (pos = 0; pos < B_OF_W(m); pos += w, pre += 2 * n * c)
+	{
+		j = wwGetBits(d, pos, MIN2(w, B_OF_W(m) - pos));
+		if (j)
+			ecAddA(t, t, pre + 2 * n * (j - 1), ec, stack);
+	}
+	// очистка
+	pos = 0, j = 0;
+	// к аффинным координатам
+	return ecToA(b, t, ec, stack);
+}
+
+size_t ecMulPreA_deep(size_t n, size_t ec_d, size_t ec_deep)
+{
+	return O_OF_W(ec_d * n) + ec_deep;
+}
@@ -4,7 +4,7 @@
 \brief Binary fields
 \project bee2 [cryptographic library]
 \created 2012.04.17
-\version 2023.03.20
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -442,6 +442,9 @@ bool_t gf2Create(qr_o* f, const size_t p[4], void* stack)
 		f->hdr.keep = sizeof(qr_o) + O_OF_W(n1 + f->n) + sizeof(gf2_trinom_st);
 		f->hdr.p_count = 3;
 		f->hdr.o_count = 0;
+#ifdef BEE2_PROFILE_QR
+		qrProfReset(f);
+#endif
 		// глубина стека
 		if (t->bk == 0)
 			f->deep = utilMax(4,
@@ -513,6 +516,9 @@ bool_t gf2Create(qr_o* f, const size_t p[4], void* stack)
 			sizeof(gf2_pentanom_st);
 		f->hdr.p_count = 3;
 		f->hdr.o_count = 0;
+#ifdef BEE2_PROFILE_QR
+		qrProfReset(f);
+#endif
 		// глубина стека
 		f->deep = utilMax(4,
 			gf2MulPentanomial_deep(f->n),
@@ -4,7 +4,7 @@
 \brief Quotient rings
 \project bee2 [cryptographic library]
 \created 2013.09.14
-\version 2014.04.17
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -48,6 +48,100 @@ bool_t qrIsOperable(const qr_o* r)
 		r->div != 0;
 }
 
+/*
+*******************************************************************************
+Профилирование
+
+Счетчики колец хранятся в таблице _rings. Свободные ячейки таблицы
+содержат нулевые адреса колец. Если свободных ячеек нет, то новое кольцо
+занимает ячейку _next, которая затем сдвигается по кругу.
+*******************************************************************************
+*/
+
+static struct
+{
+	const qr_o* r;			/*< описание кольца */
+	qr_prof_t prof;			/*< счетчики */
+} _rings[QR_PROF_RINGS];
+static size_t _next;
+static qr_prof_t _prof;
+
+static qr_prof_t* qrProfFind(const qr_o* r, bool_t add)
+{
+	size_t i, pos = QR_PROF_RINGS;
+	ASSERT(r != 0);
+	for (i = 0; i < QR_PROF_RINGS; ++i)
+		if (_rings[i].r == r)
+			return &_rings[i].prof;
+		else if (_rings[i].r == 0 && pos == QR_PROF_RINGS)
+			pos = i;
+	if (!add)
+		return 0;
+	if (pos == QR_PROF_RINGS)
+		pos = _next, _next = (_next + 1) % QR_PROF_RINGS;
+	_rings[pos].r = r;
+	memSetZero(&_rings[pos].prof, sizeof(qr_prof_t));
+	return &_rings[pos].prof;
+}
+
+static void qrProfInc(qr_prof_t* prof, size_t op)
+{
+	switch (op)
+	{
+	case QR_PROF_ADD:
+		++prof->add;
+		break;
+	case QR_PROF_MUL:
+		++prof->mul;
+		break;
+	case QR_PROF_SQR:
+		++prof->sqr;
+		break;
+	case QR_PROF_INV:
+		++prof->inv;
+		break;
+	case QR_PROF_DIV:
+		++prof->div;
+		break;
+	}
+}
+
+void qrProfCount(const qr_o* r, size_t op)
+{
+	ASSERT(memIsValid(r, sizeof(qr_o)));
+	qrProfInc(qrProfFind(r, TRUE), op);
+	qrProfInc(&_prof, op);
+}
+
+void qrProfGet(qr_prof_t* prof, const qr_o* r)
+{
+	const qr_prof_t* p;
+	ASSERT(memIsValid(prof, sizeof(qr_prof_t)));
+	ASSERT(r == 0 || memIsValid(r, sizeof(qr_o)));
+	p = r ? qrProfFind(r, FALSE) : &_prof;
+	if (p)
+		memCopy(prof, p, sizeof(qr_prof_t));
+	else
+		memSetZero(prof, sizeof(qr_prof_t));
+}
+
+void qrProfReset(const qr_o* r)
+{
+	size_t i;
+	ASSERT(r == 0 || memIsValid(r, sizeof(qr_o)));
+	if (r == 0)
+	{
+		memSetZero(&_prof, sizeof(qr_prof_t));
+		return;
+	}
+	for (i = 0; i < QR_PROF_RINGS; ++i)
+		if (_rings[i].r == r)
+		{
+			_rings[i].r = 0;
+			memSetZero(&_rings[i].prof, sizeof(qr_prof_t));
+		}
+}
+
 /*
 *******************************************************************************
 Возведение в степень
@@ -4,7 +4,7 @@
 \brief Quotient rings of integers modulo m
 \project bee2 [cryptographic library]
 \created 2013.09.14
-\version 2016.07.04
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -160,6 +160,9 @@ void zmCreatePlain(qr_o* r, const octet mod[], size_t no, void* stack)
 	r->hdr.keep = sizeof(qr_o) + O_OF_W(2 * r->n);
 	r->hdr.p_count = 3;
 	r->hdr.o_count = 0;
+#ifdef BEE2_PROFILE_QR
+	qrProfReset(r);
+#endif
 }
 
 size_t zmCreatePlain_keep(size_t no)
@@ -261,6 +264,9 @@ void zmCreateCrand(qr_o* r, const octet mod[], size_t no, void* stack)
 	r->hdr.keep = sizeof(qr_o) + O_OF_W(2 * r->n);
 	r->hdr.p_count = 3;
 	r->hdr.o_count = 0;
+#ifdef BEE2_PROFILE_QR
+	qrProfReset(r);
+#endif
 }
 
 size_t zmCreateCrand_keep(size_t no)
@@ -360,6 +366,9 @@ void zmCreateBarr(qr_o* r, const octet mod[], size_t no, void* stack)
 	r->hdr.keep = sizeof(qr_o) + O_OF_W(3 * r->n + 2);
 	r->hdr.p_count = 3;
 	r->hdr.o_count = 0;
+#ifdef BEE2_PROFILE_QR
+	qrProfReset(r);
+#endif
 }
 
 size_t zmCreateBarr_keep(size_t no)
@@ -553,6 +562,9 @@ void zmCreateMont(qr_o* r, const octet mod[], size_t no, void* stack)
 	r->hdr.keep = sizeof(qr_o) + O_OF_W(2 * r->n + 1);
 	r->hdr.p_count = 3;
 	r->hdr.o_count = 0;
+#ifdef BEE2_PROFILE_QR
+	qrProfReset(r);
+#endif
 }
 
 size_t zmCreateMont_keep(size_t no)
@@ -789,6 +801,9 @@ void zmMontCreate(qr_o* r, const octet mod[], size_t no, size_t l, void* stack)
 	r->hdr.keep = sizeof(qr_o) + O_OF_W(2 * r->n) + sizeof(zm_mont_params_st);
 	r->hdr.p_count = 3;
 	r->hdr.o_count = 0;
+#ifdef BEE2_PROFILE_QR
+	qrProfReset(r);
+#endif
 }
 
 size_t zmMontCreate_keep(size_t no)
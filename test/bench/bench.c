@@ -0,0 +1,516 @@
+/*
+*******************************************************************************
+\file bench.c
+\brief Bee2 benchmarking
+\project bee2/test
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bee2/core/mem.h>
+#include <bee2/core/mt.h>
+#include <bee2/core/prng.h>
+#include <bee2/core/str.h>
+#include <bee2/core/tm.h>
+#include <bee2/core/util.h>
+#include "bench.h"
+
+/*
+*******************************************************************************
+Утилита benchbee2
+
+Для каждого замера, каждой длины сообщения (если замер от нее зависит)
+и каждого числа потоков T:
+1	в каждом из T потоков готовится собственный контекст;
+2	подбирается число iters выполнений операции, которое занимает
+	не менее sample миллисекунд (удвоением, в одном потоке);
+3	выполняется warmup пробных замеров (результаты отбрасываются);
+4	выполняется reps замеров. В каждом замере T потоков одновременно
+	выполняют по iters операций, измеряется общее время.
+
+По результатам замеров определяются медиана и 99-й процентиль времени
+выполнения одной операции в одном потоке (в наносекундах). По медиане
+определяются суммарная производительность (операций в секунду),
+скорость обработки данных (МБ/с) и число тактов таймера на октет (cpb).
+Два последних показателя рассчитываются только для замеров, которые
+зависят от длины сообщения.
+
+Многопоточные замеры выполняются в пуле из T исполнителей.
+*******************************************************************************
+*/
+
+#define BENCH_SIZES_MAX 32
+#define BENCH_SIZE_MAX ((size_t)1 << 24)
+#define BENCH_REPS_MAX 1000
+#define BENCH_ITERS_MAX ((size_t)1 << 30)
+#define BENCH_ALIGN(n) (((n) + 15) / 16 * 16)
+
+typedef enum
+{
+	bench_text,
+	bench_csv,
+	bench_json,
+} bench_fmt_t;
+
+typedef struct
+{
+	bench_fmt_t fmt;				/*< формат вывода */
+	size_t sizes[BENCH_SIZES_MAX];	/*< длины сообщений */
+	size_t sizes_count;				/*< число длин */
+	size_t threads[BENCH_SIZES_MAX];/*< числа потоков */
+	size_t threads_count;			/*< число вариантов потоков */
+	size_t reps;					/*< число замеров */
+	size_t warmup;					/*< число пробных замеров */
+	size_t sample;					/*< длительность замера (мс) */
+	const char* group;				/*< группа замеров */
+	bool_t list;					/*< только перечислить замеры */
+} bench_opts_t;
+
+typedef struct
+{
+	const bench_case_t* bc;			/*< замер */
+	bench_ctx_t ctx[1];				/*< контекст */
+	size_t iters;					/*< число операций */
+	void* mem;						/*< память контекста */
+} bench_thread_t;
+
+static const bench_case_t* const _suites[] =
+{
+	benchBelt, benchBash, benchBrng, benchBign, benchBake, benchBels,
+	benchMath,
+};
+
+/*
+*******************************************************************************
+Разбор командной строки
+*******************************************************************************
+*/
+
+static int benchUsage()
+{
+	printf(
+		"bee2/benchbee2: Bee2 benchmarks [v%s]\n"
+		"Usage:\n"
+		"  benchbee2 [-f text|csv|json] [-s sizes] [-t threads] [-r reps]\n"
+		"    [-w warmup] [-m ms] [-g group] [-l]\n"
+		"  options:\n"
+		"    -f -- output format (text)\n"
+		"    -s -- comma-separated message sizes (16,64,256,1024,8192,65536)\n"
+		"    -t -- comma-separated thread counts (1,<number of CPUs>)\n"
+		"    -r -- repetitions (21)\n"
+		"    -w -- warm-up repetitions (3)\n"
+		"    -m -- minimal duration of a repetition in ms (1)\n"
+		"    -g -- run only cases of the group "
+			"(belt|bash|brng|bign|bake|bels|math)\n"
+		"    -l -- list cases and exit\n",
+		utilVersion());
+	return -1;
+}
+
+static bool_t benchParseNum(size_t* val, const char** str)
+{
+	const char* s = *str;
+	*val = 0;
+	if (*s < '0' || *s > '9')
+		return FALSE;
+	for (; *s >= '0' && *s <= '9'; ++s)
+	{
+		if (*val > (SIZE_MAX - 9) / 10)
+			return FALSE;
+		*val = *val * 10 + (size_t)(*s - '0');
+	}
+	*str = s;
+	return TRUE;
+}
+
+static bool_t benchParseList(size_t vals[BENCH_SIZES_MAX], size_t* count,
+	const char* str, size_t min, size_t max)
+{
+	*count = 0;
+	while (1)
+	{
+		if (*count == BENCH_SIZES_MAX ||
+			!benchParseNum(vals + *count, &str) ||
+			vals[*count] < min || vals[*count] > max)
+			return FALSE;
+		++*count;
+		if (*str == 0)
+			return TRUE;
+		if (*str++ != ',')
+			return FALSE;
+	}
+}
+
+static bool_t benchParseVal(size_t* val, const char* str, size_t min,
+	size_t max)
+{
+	return benchParseNum(val, &str) && *str == 0 && *val >= min &&
+		*val <= max;
+}
+
+static bool_t benchParse(bench_opts_t* opts, int argc, char* argv[])
+{
+	static const size_t sizes[] = { 16, 64, 256, 1024, 8192, 65536 };
+	// значения по умолчанию
+	memSetZero(opts, sizeof(bench_opts_t));
+	opts->fmt = bench_text;
+	memCopy(opts->sizes, sizes, sizeof(sizes));
+	opts->sizes_count = COUNT_OF(sizes);
+	opts->threads[0] = 1;
+	opts->threads[1] = MIN2(mtCPUCount(), MT_POOL_MAX);
+	opts->threads_count = opts->threads[1] > 1 ? 2 : 1;
+	opts->reps = 21;
+	opts->warmup = 3;
+	opts->sample = 1;
+	// разобрать опции
+	for (--argc, ++argv; argc; --argc, ++argv)
+	{
+		if (strEq(argv[0], "-l"))
+		{
+			opts->list = TRUE;
+			continue;
+		}
+		if (argc < 2 || strLen(argv[0]) != 2 || argv[0][0] != '-')
+			return FALSE;
+		switch (argv[0][1])
+		{
+		case 'f':
+			if (strEq(argv[1], "text"))
+				opts->fmt = bench_text;
+			else if (strEq(argv[1], "csv"))
+				opts->fmt = bench_csv;
+			else if (strEq(argv[1], "json"))
+				opts->fmt = bench_json;
+			else
+				return FALSE;
+			break;
+		case 's':
+			if (!benchParseList(opts->sizes, &opts->sizes_count, argv[1],
+				1, BENCH_SIZE_MAX))
+				return FALSE;
+			break;
+		case 't':
+			if (!benchParseList(opts->threads, &opts->threads_count,
+				argv[1], 1, MT_POOL_MAX))
+				return FALSE;
+			break;
+		case 'r':
+			if (!benchParseVal(&opts->reps, argv[1], 1, BENCH_REPS_MAX))
+				return FALSE;
+			break;
+		case 'w':
+			if (!benchParseVal(&opts->warmup, argv[1], 0, BENCH_REPS_MAX))
+				return FALSE;
+			break;
+		case 'm':
+			if (!benchParseVal(&opts->sample, argv[1], 0, 60000))
+				return FALSE;
+			break;
+		case 'g':
+			opts->group = argv[1];
+			break;
+		default:
+			return FALSE;
+		}
+		--argc, ++argv;
+	}
+	return TRUE;
+}
+
+/*
+*******************************************************************************
+Контексты
+
+Память контекста: [keep()]state || [prngCOMBO_keep()]rng || [size]buf.
+Фрагменты выравниваются на границу 16 октетов.
+*******************************************************************************
+*/
+
+static bool_t benchThreadStart(bench_thread_t* th, const bench_case_t* bc,
+	size_t size, u32 seed)
+{
+	const size_t keep = BENCH_ALIGN(bc->keep ? bc->keep() : 0);
+	const size_t rng_keep = BENCH_ALIGN(prngCOMBO_keep());
+	memSetZero(th, sizeof(bench_thread_t));
+	th->bc = bc;
+	th->mem = memAlloc(keep + rng_keep + size);
+	if (!th->mem)
+		return FALSE;
+	memSetZero(th->mem, keep + rng_keep + size);
+	th->ctx->size = size;
+	th->ctx->state = th->mem;
+	th->ctx->rng = (octet*)th->mem + keep;
+	th->ctx->buf = (octet*)th->ctx->rng + rng_keep;
+	prngCOMBOStart(th->ctx->rng, seed);
+	prngCOMBOStepR(th->ctx->key, sizeof(th->ctx->key), th->ctx->rng);
+	prngCOMBOStepR(th->ctx->iv, sizeof(th->ctx->iv), th->ctx->rng);
+	prngCOMBOStepR(th->ctx->buf, size, th->ctx->rng);
+	return !bc->start || bc->start(th->ctx);
+}
+
+static void benchThreadClose(bench_thread_t* th)
+{
+	memFree(th->mem);
+	th->mem = 0;
+}
+
+static void benchThreadRun(void* arg)
+{
+	bench_thread_t* th = (bench_thread_t*)arg;
+	size_t i;
+	for (i = 0; i < th->iters; ++i)
+		th->bc->run(th->ctx);
+}
+
+/*
+*******************************************************************************
+Замеры
+*******************************************************************************
+*/
+
+static tm_ticks_t benchSample(mt_pool_t* pool, bench_thread_t* ths,
+	size_t count)
+{
+	mt_task_t tasks[MT_POOL_MAX];
+	tm_ticks_t ticks;
+	size_t i;
+	ticks = tmTicks();
+	if (count == 1)
+		benchThreadRun(ths);
+	else
+	{
+		for (i = 0; i < count; ++i)
+			mtPoolSubmit(pool, tasks + i, benchThreadRun, ths + i);
+		for (i = 0; i < count; ++i)
+			mtPoolWait(pool, tasks + i);
+	}
+	return tmTicks() - ticks;
+}
+
+static size_t benchCalibrate(bench_thread_t* th, tm_ticks_t target)
+{
+	for (th->iters = 1; th->iters < BENCH_ITERS_MAX; th->iters *= 2)
+		if (benchSample(0, th, 1) >= target)
+			break;
+	return th->iters;
+}
+
+static int benchCmp(const void* a, const void* b)
+{
+	const double x = *(const double*)a, y = *(const double*)b;
+	return x < y ? -1 : x > y ? 1 : 0;
+}
+
+/*
+*******************************************************************************
+Вывод
+*******************************************************************************
+*/
+
+typedef struct
+{
+	const bench_case_t* bc;			/*< замер */
+	size_t size;					/*< длина сообщения */
+	size_t threads;					/*< число потоков */
+	size_t iters;					/*< число операций в замере */
+	size_t reps;					/*< число замеров */
+	double median;					/*< медиана (нс/операцию) */
+	double p99;						/*< 99-й процентиль (нс/операцию) */
+	double ops;						/*< операций в секунду */
+	double mbps;					/*< МБ/с */
+	double cpb;						/*< тактов на октет */
+} bench_result_t;
+
+static void benchPrintHead(const bench_opts_t* opts, tm_ticks_t freq)
+{
+	if (opts->fmt == bench_json)
+		printf("{\n  \"version\": \"%s\",\n  \"freq\": %.0f,\n"
+			"  \"results\": [", utilVersion(), (double)freq);
+	else if (opts->fmt == bench_csv)
+		printf("group,name,size,threads,iters,reps,median_ns,p99_ns,"
+			"ops_per_sec,mb_per_sec,cpb\n");
+	else
+		printf("%-18s %6s %3s %10s %12s %12s %14s %10s %8s\n",
+			"name", "size", "thr", "iters", "median,ns", "p99,ns", "ops/s",
+			"MB/s", "cpb");
+}
+
+static void benchPrintResult(const bench_opts_t* opts,
+	const bench_result_t* r, bool_t first)
+{
+	if (opts->fmt == bench_json)
+	{
+		printf("%s\n    {\"group\": \"%s\", \"name\": \"%s\", \"size\": %u, "
+			"\"threads\": %u, \"iters\": %u, \"reps\": %u, "
+			"\"median_ns\": %.1f, \"p99_ns\": %.1f, \"ops_per_sec\": %.1f, ",
+			first ? "" : ",", r->bc->group, r->bc->name, (unsigned)r->size,
+			(unsigned)r->threads, (unsigned)r->iters, (unsigned)r->reps,
+			r->median, r->p99, r->ops);
+		if (r->bc->sized)
+			printf("\"mb_per_sec\": %.2f, \"cpb\": %.2f}", r->mbps, r->cpb);
+		else
+			printf("\"mb_per_sec\": null, \"cpb\": null}");
+	}
+	else if (opts->fmt == bench_csv)
+	{
+		printf("%s,%s,%u,%u,%u,%u,%.1f,%.1f,%.1f,", r->bc->group,
+			r->bc->name, (unsigned)r->size, (unsigned)r->threads,
+			(unsigned)r->iters, (unsigned)r->reps, r->median, r->p99, r->ops);
+		if (r->bc->sized)
+			printf("%.2f,%.2f\n", r->mbps, r->cpb);
+		else
+			printf(",\n");
+	}
+	else
+	{
+		printf("%-18s %6u %3u %10u %12.1f %12.1f %14.1f ", r->bc->name,
+			(unsigned)r->size, (unsigned)r->threads, (unsigned)r->iters,
+			r->median, r->p99, r->ops);
+		if (r->bc->sized)
+			printf("%10.2f %8.2f\n", r->mbps, r->cpb);
+		else
+			printf("%10s %8s\n", "-", "-");
+	}
+	fflush(stdout);
+}
+
+static void benchPrintTail(const bench_opts_t* opts)
+{
+	if (opts->fmt == bench_json)
+		printf("\n  ]\n}\n");
+}
+
+/*
+*******************************************************************************
+Выполнение замера
+
+Возвращается FALSE, если замер неприменим к длине сообщения size
+или не хватило памяти.
+*******************************************************************************
+*/
+
+static bool_t benchRun(bench_result_t* r, const bench_opts_t* opts,
+	mt_pool_t* pool, const bench_case_t* bc, size_t size, size_t threads,
+	tm_ticks_t freq)
+{
+	bench_thread_t ths[MT_POOL_MAX];
+	double* samples;
+	size_t i, started;
+	bool_t ok = TRUE;
+	// подготовить контексты
+	for (started = 0; ok && started < threads; ++started)
+		ok = benchThreadStart(ths + started, bc, size, (u32)(started + 1));
+	samples = ok ? (double*)memAlloc(opts->reps * sizeof(double)) : 0;
+	if (ok && samples)
+	{
+		// подобрать число операций
+		benchCalibrate(ths, (tm_ticks_t)((double)freq * opts->sample / 1000));
+		for (i = 1; i < threads; ++i)
+			ths[i].iters = ths->iters;
+		// пробные замеры
+		for (i = 0; i < opts->warmup; ++i)
+			benchSample(pool, ths, threads);
+		// замеры
+		for (i = 0; i < opts->reps; ++i)
+			samples[i] = (double)benchSample(pool, ths, threads) * 1e9 /
+				(double)freq / (double)ths->iters;
+		qsort(samples, opts->reps, sizeof(double), benchCmp);
+		// статистика
+		memSetZero(r, sizeof(bench_result_t));
+		r->bc = bc, r->size = size, r->threads = threads;
+		r->iters = ths->iters, r->reps = opts->reps;
+		r->median = opts->reps % 2 ? samples[opts->reps / 2] :
+			(samples[opts->reps / 2 - 1] + samples[opts->reps / 2]) / 2;
+		r->p99 = samples[(99 * opts->reps + 99) / 100 - 1];
+		if (r->median > 0)
+		{
+			r->ops = 1e9 * threads / r->median;
+			r->mbps = r->ops * size / 1e6;
+			r->cpb = r->median * (double)freq / 1e9 / size;
+		}
+	}
+	else
+		ok = FALSE;
+	// завершить
+	memFree(samples);
+	for (i = 0; i < started; ++i)
+		benchThreadClose(ths + i);
+	return ok;
+}
+
+/*
+*******************************************************************************
+Главная функция
+*******************************************************************************
+*/
+
+int main(int argc, char* argv[])
+{
+	bench_opts_t opts[1];
+	mt_pool_t* pools[BENCH_SIZES_MAX];
+	bench_result_t r[1];
+	const bench_case_t* bc;
+	tm_ticks_t freq;
+	bool_t first = TRUE;
+	size_t s, i, j, k;
+	int ret = 0;
+	// разобрать командную строку
+	if (!benchParse(opts, argc, argv))
+		return benchUsage();
+	// перечислить замеры
+	if (opts->list)
+	{
+		for (s = 0; s < COUNT_OF(_suites); ++s)
+			for (bc = _suites[s]; bc->name; ++bc)
+				if (!opts->group || strEq(opts->group, bc->group))
+					printf("%s %s%s\n", bc->group, bc->name,
+						bc->sized ? " (sized)" : "");
+		return 0;
+	}
+	// частота таймера
+	if ((freq = tmFreq()) == 0)
+	{
+		fprintf(stderr, "benchbee2: timer is not available\n");
+		return -1;
+	}
+	// создать пулы
+	for (j = 0; j < opts->threads_count; ++j)
+		if (opts->threads[j] == 1)
+			pools[j] = 0;
+		else if (!(pools[j] = mtPoolCreate(opts->threads[j])))
+		{
+			for (; j--;)
+				mtPoolClose(pools[j]);
+			fprintf(stderr, "benchbee2: insufficient memory\n");
+			return -1;
+		}
+	// выполнить замеры
+	benchPrintHead(opts, freq);
+	for (s = 0; s < COUNT_OF(_suites); ++s)
+		for (bc = _suites[s]; bc->name; ++bc)
+		{
+			if (opts->group && !strEq(opts->group, bc->group))
+				continue;
+			for (i = 0; i < (bc->sized ? opts->sizes_count : 1); ++i)
+				for (j = 0; j < opts->threads_count; ++j)
+				{
+					k = bc->sized ? opts->sizes[i] : 0;
+					if (!benchRun(r, opts, pools[j], bc, k, opts->threads[j],
+						freq))
+						continue;
+					benchPrintResult(opts, r, first);
+					first = FALSE;
+				}
+		}
+	benchPrintTail(opts);
+	// завершить
+	for (j = 0; j < opts->threads_count; ++j)
+		if (pools[j])
+			mtPoolClose(pools[j]);
+	return ret;
+}
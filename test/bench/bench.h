@@ -0,0 +1,86 @@
+/*
+*******************************************************************************
+\file bench.h
+\brief Benchmark suite
+\project bee2/test
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#ifndef __BEE2_BENCH_H
+#define __BEE2_BENCH_H
+
+#include <bee2/defs.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+*******************************************************************************
+Замеры
+
+Замер описывается структурой bench_case_t. Замер выполняется в контексте
+bench_ctx_t, который готовит утилита benchbee2: в контексте размещаются
+сообщение [size]buf (для замеров, зависящих от длины сообщения),
+псевдослучайные ключ и синхропосылка, буфер результата, состояние
+генератора prngCOMBO и состояние алгоритма [keep()]state.
+
+Функция start() готовит состояние алгоритма (например, разворачивает
+ключ или генерирует ключевую пару). Если замер неприменим к длине
+сообщения size, то start() возвращает FALSE. Функция run() выполняет
+одну операцию, время выполнения которой измеряется. Функции keep()
+и start() могут не задаваться (нулевые указатели).
+
+В каждом потоке используется собственный контекст.
+
+Наборы замеров задаются массивами, которые заканчиваются нулевым
+элементом (с нулевым полем name).
+*******************************************************************************
+*/
+
+/*!	\brief Контекст замера */
+typedef struct
+{
+	size_t size;			/*!< длина сообщения */
+	octet* buf;				/*!< сообщение */
+	void* state;			/*!< состояние алгоритма */
+	void* rng;				/*!< состояние prngCOMBO */
+	octet key[64];			/*!< ключ */
+	octet iv[32];			/*!< синхропосылка */
+	octet out[256];			/*!< результат */
+} bench_ctx_t;
+
+/*!	\brief Замер */
+typedef struct
+{
+	const char* group;		/*!< группа замеров */
+	const char* name;		/*!< имя замера */
+	bool_t sized;			/*!< зависит от длины сообщения? */
+	size_t (*keep)();		/*!< длина состояния алгоритма */
+	bool_t (*start)(bench_ctx_t* ctx);	/*!< подготовка состояния */
+	void (*run)(bench_ctx_t* ctx);		/*!< выполнение операции */
+} bench_case_t;
+
+/*
+*******************************************************************************
+Наборы замеров
+*******************************************************************************
+*/
+
+extern const bench_case_t benchBelt[];
+extern const bench_case_t benchBash[];
+extern const bench_case_t benchBrng[];
+extern const bench_case_t benchBign[];
+extern const bench_case_t benchBake[];
+extern const bench_case_t benchBels[];
+extern const bench_case_t benchMath[];
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __BEE2_BENCH_H */
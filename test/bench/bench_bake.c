@@ -0,0 +1,252 @@
+/*
+*******************************************************************************
+\file bench_bake.c
+\brief Benchmarks for STB 34.101.66 (bake)
+\project bee2/test
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include <bee2/core/err.h>
+#include <bee2/core/mem.h>
+#include <bee2/core/prng.h>
+#include <bee2/core/util.h>
+#include <bee2/crypto/bake.h>
+#include "bench.h"
+
+/*
+*******************************************************************************
+Состояние
+
+Одна операция -- полное выполнение протокола обеими сторонами
+с подтверждением ключа (kca = kcb = TRUE). Сообщения передаются через
+буферы памяти. Сертификат стороны -- это ее открытый ключ.
+
+При подготовке протокол выполняется один раз и проверяется, что стороны
+построили одинаковые ключи.
+*******************************************************************************
+*/
+
+typedef struct
+{
+	bign_params params[1];		/*< долговременные параметры */
+	bake_settings settings[1];	/*< настройки */
+	octet da[64];				/*< личный ключ стороны A */
+	octet db[64];				/*< личный ключ стороны B */
+	octet qa[128];				/*< открытый ключ стороны A */
+	octet qb[128];				/*< открытый ключ стороны B */
+	bake_cert certa[1];			/*< сертификат стороны A */
+	bake_cert certb[1];			/*< сертификат стороны B */
+	octet keya[32];				/*< ключ стороны A */
+	octet keyb[32];				/*< ключ стороны B */
+	octet msg[4][512];			/*< сообщения */
+	void* statea;				/*< состояние стороны A */
+	void* stateb;				/*< состояние стороны B */
+} bench_bake_st;
+
+static size_t benchBake_keep()
+{
+	return sizeof(bench_bake_st) + 2 * utilMax(3,
+		bakeBMQV_keep(256), bakeBSTS_keep(256), bakeBPACE_keep(256));
+}
+
+static err_t benchBakeCertVal(octet* pubkey, const bign_params* params,
+	const octet* data, size_t len)
+{
+	if (len != params->l / 2)
+		return ERR_BAD_CERT;
+	if (pubkey)
+		memCopy(pubkey, data, len);
+	return ERR_OK;
+}
+
+static bool_t benchBakeStart(bench_ctx_t* ctx, const char* curve)
+{
+	bench_bake_st* st = (bench_bake_st*)ctx->state;
+	st->statea = st + 1;
+	st->stateb = (octet*)st->statea + (benchBake_keep() -
+		sizeof(bench_bake_st)) / 2;
+	if (bignParamsStd(st->params, curve) != ERR_OK ||
+		bignKeypairGen(st->da, st->qa, st->params, prngCOMBOStepR,
+			ctx->rng) != ERR_OK ||
+		bignKeypairGen(st->db, st->qb, st->params, prngCOMBOStepR,
+			ctx->rng) != ERR_OK)
+		return FALSE;
+	st->certa->data = st->qa, st->certb->data = st->qb;
+	st->certa->len = st->certb->len = st->params->l / 2;
+	st->certa->val = st->certb->val = benchBakeCertVal;
+	memSetZero(st->settings, sizeof(bake_settings));
+	st->settings->kca = st->settings->kcb = TRUE;
+	st->settings->rng = prngCOMBOStepR;
+	st->settings->rng_state = ctx->rng;
+	return TRUE;
+}
+
+/*
+*******************************************************************************
+Протоколы
+*******************************************************************************
+*/
+
+static err_t benchBakeBMQVRun(bench_bake_st* st)
+{
+	err_t code;
+	code = bakeBMQVStart(st->statea, st->params, st->settings, st->da,
+		st->certa);
+	ERR_CALL_CHECK(code);
+	code = bakeBMQVStart(st->stateb, st->params, st->settings, st->db,
+		st->certb);
+	ERR_CALL_CHECK(code);
+	code = bakeBMQVStep2(st->msg[0], st->stateb);
+	ERR_CALL_CHECK(code);
+	code = bakeBMQVStep3(st->msg[1], st->msg[0], st->certb, st->statea);
+	ERR_CALL_CHECK(code);
+	code = bakeBMQVStep4(st->msg[2], st->msg[1], st->certa, st->stateb);
+	ERR_CALL_CHECK(code);
+	code = bakeBMQVStep5(st->msg[2], st->statea);
+	ERR_CALL_CHECK(code);
+	code = bakeBMQVStepG(st->keya, st->statea);
+	ERR_CALL_CHECK(code);
+	code = bakeBMQVStepG(st->keyb, st->stateb);
+	ERR_CALL_CHECK(code);
+	return memEq(st->keya, st->keyb, 32) ? ERR_OK : ERR_BAD_LOGIC;
+}
+
+static err_t benchBakeBSTSRun(bench_bake_st* st)
+{
+	err_t code;
+	const size_t l = st->params->l;
+	code = bakeBSTSStart(st->statea, st->params, st->settings, st->da,
+		st->certa);
+	ERR_CALL_CHECK(code);
+	code = bakeBSTSStart(st->stateb, st->params, st->settings, st->db,
+		st->certb);
+	ERR_CALL_CHECK(code);
+	code = bakeBSTSStep2(st->msg[0], st->stateb);
+	ERR_CALL_CHECK(code);
+	code = bakeBSTSStep3(st->msg[1], st->msg[0], st->statea);
+	ERR_CALL_CHECK(code);
+	code = bakeBSTSStep4(st->msg[2], st->msg[1],
+		3 * l / 4 + st->certa->len + 8, benchBakeCertVal, st->stateb);
+	ERR_CALL_CHECK(code);
+	code = bakeBSTSStep5(st->msg[2], l / 4 + st->certb->len + 8,
+		benchBakeCertVal, st->statea);
+	ERR_CALL_CHECK(code);
+	code = bakeBSTSStepG(st->keya, st->statea);
+	ERR_CALL_CHECK(code);
+	code = bakeBSTSStepG(st->keyb, st->stateb);
+	ERR_CALL_CHECK(code);
+	return memEq(st->keya, st->keyb, 32) ? ERR_OK : ERR_BAD_LOGIC;
+}
+
+static err_t benchBakeBPACERun(bench_bake_st* st)
+{
+	err_t code;
+	const octet pwd[] = { '8', '8', '7', '3' };
+	code = bakeBPACEStart(st->statea, st->params, st->settings, pwd,
+		sizeof(pwd));
+	ERR_CALL_CHECK(code);
+	code = bakeBPACEStart(st->stateb, st->params, st->settings, pwd,
+		sizeof(pwd));
+	ERR_CALL_CHECK(code);
+	code = bakeBPACEStep2(st->msg[0], st->stateb);
+	ERR_CALL_CHECK(code);
+	code = bakeBPACEStep3(st->msg[1], st->msg[0], st->statea);
+	ERR_CALL_CHECK(code);
+	code = bakeBPACEStep4(st->msg[2], st->msg[1], st->stateb);
+	ERR_CALL_CHECK(code);
+	code = bakeBPACEStep5(st->msg[3], st->msg[2], st->statea);
+	ERR_CALL_CHECK(code);
+	code = bakeBPACEStep6(st->msg[3], st->stateb);
+	ERR_CALL_CHECK(code);
+	code = bakeBPACEStepG(st->keya, st->statea);
+	ERR_CALL_CHECK(code);
+	code = bakeBPACEStepG(st->keyb, st->stateb);
+	ERR_CALL_CHECK(code);
+	return memEq(st->keya, st->keyb, 32) ? ERR_OK : ERR_BAD_LOGIC;
+}
+
+/*
+*******************************************************************************
+Замеры
+*******************************************************************************
+*/
+
+static bool_t benchBakeStart128(bench_ctx_t* ctx)
+{
+	return benchBakeStart(ctx, "1.2.112.0.2.0.34.101.45.3.1");
+}
+
+static bool_t benchBakeStart192(bench_ctx_t* ctx)
+{
+	return benchBakeStart(ctx, "1.2.112.0.2.0.34.101.45.3.2");
+}
+
+static bool_t benchBakeStart256(bench_ctx_t* ctx)
+{
+	return benchBakeStart(ctx, "1.2.112.0.2.0.34.101.45.3.3");
+}
+
+#define BENCH_BAKE_CASE(proto, l)\
+static bool_t benchBake##proto##l##Start(bench_ctx_t* ctx)\
+{\
+	return benchBakeStart##l(ctx) &&\
+		benchBake##proto##Run((bench_bake_st*)ctx->state) == ERR_OK;\
+}
+
+BENCH_BAKE_CASE(BMQV, 128)
+BENCH_BAKE_CASE(BMQV, 192)
+BENCH_BAKE_CASE(BMQV, 256)
+BENCH_BAKE_CASE(BSTS, 128)
+BENCH_BAKE_CASE(BSTS, 192)
+BENCH_BAKE_CASE(BSTS, 256)
+BENCH_BAKE_CASE(BPACE, 128)
+BENCH_BAKE_CASE(BPACE, 192)
+BENCH_BAKE_CASE(BPACE, 256)
+
+static void benchBakeBMQV(bench_ctx_t* ctx)
+{
+	benchBakeBMQVRun((bench_bake_st*)ctx->state);
+}
+
+static void benchBakeBSTS(bench_ctx_t* ctx)
+{
+	benchBakeBSTSRun((bench_bake_st*)ctx->state);
+}
+
+static void benchBakeBPACE(bench_ctx_t* ctx)
+{
+	benchBakeBPACERun((bench_bake_st*)ctx->state);
+}
+
+/*
+*******************************************************************************
+Набор замеров
+*******************************************************************************
+*/
+
+const bench_case_t benchBake[] =
+{
+	{ "bake", "bake-bmqv128", FALSE, benchBake_keep, benchBakeBMQV128Start,
+		benchBakeBMQV },
+	{ "bake", "bake-bmqv192", FALSE, benchBake_keep, benchBakeBMQV192Start,
+		benchBakeBMQV },
+	{ "bake", "bake-bmqv256", FALSE, benchBake_keep, benchBakeBMQV256Start,
+		benchBakeBMQV },
+	{ "bake", "bake-bsts128", FALSE, benchBake_keep, benchBakeBSTS128Start,
+		benchBakeBSTS },
+	{ "bake", "bake-bsts192", FALSE, benchBake_keep, benchBakeBSTS192Start,
+		benchBakeBSTS },
+	{ "bake", "bake-bsts256", FALSE, benchBake_keep, benchBakeBSTS256Start,
+		benchBakeBSTS },
+	{ "bake", "bake-bpace128", FALSE, benchBake_keep, benchBakeBPACE128Start,
+		benchBakeBPACE },
+	{ "bake", "bake-bpace192", FALSE, benchBake_keep, benchBakeBPACE192Start,
+		benchBakeBPACE },
+	{ "bake", "bake-bpace256", FALSE, benchBake_keep, benchBakeBPACE256Start,
+		benchBakeBPACE },
+	{ 0 }
+};
@@ -0,0 +1,96 @@
+/*
+*******************************************************************************
+\file bench_bash.c
+\brief Benchmarks for STB 34.101.77 (bash)
+\project bee2/test
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include <bee2/crypto/bash.h>
+#include "bench.h"
+
+/*
+*******************************************************************************
+Хэширование
+
+Каждая операция обрабатывает сообщение целиком: от Start до StepG.
+*******************************************************************************
+*/
+
+static void benchBashHash128(bench_ctx_t* ctx)
+{
+	bashHashStart(ctx->state, 128);
+	bashHashStepH(ctx->buf, ctx->size, ctx->state);
+	bashHashStepG(ctx->out, 32, ctx->state);
+}
+
+static void benchBashHash192(bench_ctx_t* ctx)
+{
+	bashHashStart(ctx->state, 192);
+	bashHashStepH(ctx->buf, ctx->size, ctx->state);
+	bashHashStepG(ctx->out, 48, ctx->state);
+}
+
+static void benchBashHash256(bench_ctx_t* ctx)
+{
+	bashHashStart(ctx->state, 256);
+	bashHashStepH(ctx->buf, ctx->size, ctx->state);
+	bashHashStepG(ctx->out, 64, ctx->state);
+}
+
+/*
+*******************************************************************************
+Программируемые алгоритмы
+
+Автомат в ключевом режиме (l = 256, d = 1) зашифровывает сообщение
+на месте.
+*******************************************************************************
+*/
+
+static bool_t benchBashPrgStart(bench_ctx_t* ctx)
+{
+	bashPrgStart(ctx->state, 256, 1, ctx->iv, 16, ctx->key, 32);
+	return TRUE;
+}
+
+static void benchBashPrgEncr(bench_ctx_t* ctx)
+{
+	bashPrgEncr(ctx->buf, ctx->size, ctx->state);
+}
+
+/*
+*******************************************************************************
+Шаговая функция
+*******************************************************************************
+*/
+
+static size_t benchBashF_keep()
+{
+	return 192 + bashF_deep();
+}
+
+static void benchBashF(bench_ctx_t* ctx)
+{
+	bashF((octet*)ctx->state, (octet*)ctx->state + 192);
+}
+
+/*
+*******************************************************************************
+Набор замеров
+*******************************************************************************
+*/
+
+const bench_case_t benchBash[] =
+{
+	{ "bash", "bash-hash128", TRUE, bashHash_keep, 0, benchBashHash128 },
+	{ "bash", "bash-hash192", TRUE, bashHash_keep, 0, benchBashHash192 },
+	{ "bash", "bash-hash256", TRUE, bashHash_keep, 0, benchBashHash256 },
+	{ "bash", "bash-prg-encr", TRUE, bashPrg_keep, benchBashPrgStart,
+		benchBashPrgEncr },
+	{ "bash", "bash-f", FALSE, benchBashF_keep, 0, benchBashF },
+	{ 0 }
+};
@@ -0,0 +1,100 @@
+/*
+*******************************************************************************
+\file bench_bels.c
+\brief Benchmarks for STB 34.101.60 (bels)
+\project bee2/test
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include <bee2/core/prng.h>
+#include <bee2/crypto/bels.h>
+#include "bench.h"
+
+/*
+*******************************************************************************
+Состояние
+
+Секрет (ключ контекста) разделяется на 5 частичных секретов с порогом 3.
+Восстановление выполняется по первым 3 частичным секретам. Используются
+стандартные открытые ключи.
+*******************************************************************************
+*/
+
+typedef struct
+{
+	size_t len;					/*!< длина секрета */
+	octet si[5 * 33];			/*!< частичные секреты */
+} bench_bels_st;
+
+static size_t benchBels_keep()
+{
+	return sizeof(bench_bels_st);
+}
+
+static bool_t benchBelsStart(bench_ctx_t* ctx, size_t len)
+{
+	bench_bels_st* st = (bench_bels_st*)ctx->state;
+	st->len = len;
+	return belsShare2(st->si, 5, 3, len, ctx->key, prngCOMBOStepR,
+		ctx->rng) == ERR_OK;
+}
+
+static bool_t benchBels16Start(bench_ctx_t* ctx)
+{
+	return benchBelsStart(ctx, 16);
+}
+
+static bool_t benchBels24Start(bench_ctx_t* ctx)
+{
+	return benchBelsStart(ctx, 24);
+}
+
+static bool_t benchBels32Start(bench_ctx_t* ctx)
+{
+	return benchBelsStart(ctx, 32);
+}
+
+/*
+*******************************************************************************
+Операции
+*******************************************************************************
+*/
+
+static void benchBelsShare(bench_ctx_t* ctx)
+{
+	bench_bels_st* st = (bench_bels_st*)ctx->state;
+	belsShare2(st->si, 5, 3, st->len, ctx->key, prngCOMBOStepR, ctx->rng);
+}
+
+static void benchBelsRecover(bench_ctx_t* ctx)
+{
+	bench_bels_st* st = (bench_bels_st*)ctx->state;
+	belsRecover2(ctx->out, 3, st->len, st->si);
+}
+
+/*
+*******************************************************************************
+Набор замеров
+*******************************************************************************
+*/
+
+const bench_case_t benchBels[] =
+{
+	{ "bels", "bels128-share", FALSE, benchBels_keep, benchBels16Start,
+		benchBelsShare },
+	{ "bels", "bels128-recover", FALSE, benchBels_keep, benchBels16Start,
+		benchBelsRecover },
+	{ "bels", "bels192-share", FALSE, benchBels_keep, benchBels24Start,
+		benchBelsShare },
+	{ "bels", "bels192-recover", FALSE, benchBels_keep, benchBels24Start,
+		benchBelsRecover },
+	{ "bels", "bels256-share", FALSE, benchBels_keep, benchBels32Start,
+		benchBelsShare },
+	{ "bels", "bels256-recover", FALSE, benchBels_keep, benchBels32Start,
+		benchBelsRecover },
+	{ 0 }
+};
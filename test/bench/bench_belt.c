@@ -0,0 +1,185 @@
+/*
+*******************************************************************************
+\file bench_belt.c
+\brief Benchmarks for STB 34.101.31 (belt)
+\project bee2/test
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include <bee2/crypto/belt.h>
+#include "bench.h"
+
+/*
+*******************************************************************************
+Режимы шифрования
+
+Зашифрование выполняется на месте, поэтому сообщение меняется от операции
+к операции. Режимы BDE и SDE применимы только к сообщениям, длина которых
+кратна 16. Кроме этого, в режиме SDE длина сообщения должна быть не меньше 32.
+*******************************************************************************
+*/
+
+static bool_t benchBeltECBStart(bench_ctx_t* ctx)
+{
+	if (ctx->size < 16)
+		return FALSE;
+	beltECBStart(ctx->state, ctx->key, 32);
+	return TRUE;
+}
+
+static void benchBeltECB(bench_ctx_t* ctx)
+{
+	beltECBStepE(ctx->buf, ctx->size, ctx->state);
+}
+
+static bool_t benchBeltCBCStart(bench_ctx_t* ctx)
+{
+	if (ctx->size < 16)
+		return FALSE;
+	beltCBCStart(ctx->state, ctx->key, 32, ctx->iv);
+	return TRUE;
+}
+
+static void benchBeltCBC(bench_ctx_t* ctx)
+{
+	beltCBCStepE(ctx->buf, ctx->size, ctx->state);
+}
+
+static bool_t benchBeltCFBStart(bench_ctx_t* ctx)
+{
+	beltCFBStart(ctx->state, ctx->key, 32, ctx->iv);
+	return TRUE;
+}
+
+static void benchBeltCFB(bench_ctx_t* ctx)
+{
+	beltCFBStepE(ctx->buf, ctx->size, ctx->state);
+}
+
+static bool_t benchBeltCTRStart(bench_ctx_t* ctx)
+{
+	beltCTRStart(ctx->state, ctx->key, 32, ctx->iv);
+	return TRUE;
+}
+
+static void benchBeltCTR(bench_ctx_t* ctx)
+{
+	beltCTRStepE(ctx->buf, ctx->size, ctx->state);
+}
+
+static bool_t benchBeltBDEStart(bench_ctx_t* ctx)
+{
+	if (ctx->size < 16 || ctx->size % 16)
+		return FALSE;
+	beltBDEStart(ctx->state, ctx->key, 32, ctx->iv);
+	return TRUE;
+}
+
+static void benchBeltBDE(bench_ctx_t* ctx)
+{
+	beltBDEStepE(ctx->buf, ctx->size, ctx->state);
+}
+
+static bool_t benchBeltSDEStart(bench_ctx_t* ctx)
+{
+	if (ctx->size < 32 || ctx->size % 16)
+		return FALSE;
+	beltSDEStart(ctx->state, ctx->key, 32);
+	return TRUE;
+}
+
+static void benchBeltSDE(bench_ctx_t* ctx)
+{
+	beltSDEStepE(ctx->buf, ctx->size, ctx->iv, ctx->state);
+}
+
+/*
+*******************************************************************************
+Имитозащита и хэширование
+
+Каждая операция обрабатывает сообщение целиком: от Start до StepG.
+*******************************************************************************
+*/
+
+static void benchBeltMAC(bench_ctx_t* ctx)
+{
+	beltMACStart(ctx->state, ctx->key, 32);
+	beltMACStepA(ctx->buf, ctx->size, ctx->state);
+	beltMACStepG(ctx->out, ctx->state);
+}
+
+static void benchBeltDWP(bench_ctx_t* ctx)
+{
+	beltDWPStart(ctx->state, ctx->key, 32, ctx->iv);
+	beltDWPStepE(ctx->buf, ctx->size, ctx->state);
+	beltDWPStepA(ctx->buf, ctx->size, ctx->state);
+	beltDWPStepG(ctx->out, ctx->state);
+}
+
+static void benchBeltCHE(bench_ctx_t* ctx)
+{
+	beltCHEStart(ctx->state, ctx->key, 32, ctx->iv);
+	beltCHEStepE(ctx->buf, ctx->size, ctx->state);
+	beltCHEStepA(ctx->buf, ctx->size, ctx->state);
+	beltCHEStepG(ctx->out, ctx->state);
+}
+
+static void benchBeltHash(bench_ctx_t* ctx)
+{
+	beltHashStart(ctx->state);
+	beltHashStepH(ctx->buf, ctx->size, ctx->state);
+	beltHashStepG(ctx->out, ctx->state);
+}
+
+static void benchBeltHMAC(bench_ctx_t* ctx)
+{
+	beltHMACStart(ctx->state, ctx->key, 32);
+	beltHMACStepA(ctx->buf, ctx->size, ctx->state);
+	beltHMACStepG(ctx->out, ctx->state);
+}
+
+/*
+*******************************************************************************
+Построение ключа по паролю
+
+Используется рекомендуемое число итераций (10000).
+*******************************************************************************
+*/
+
+static void benchBeltPBKDF2(bench_ctx_t* ctx)
+{
+	beltPBKDF2(ctx->out, ctx->key, 8, 10000, ctx->iv, 8);
+}
+
+/*
+*******************************************************************************
+Набор замеров
+*******************************************************************************
+*/
+
+const bench_case_t benchBelt[] =
+{
+	{ "belt", "belt-ecb", TRUE, beltECB_keep, benchBeltECBStart,
+		benchBeltECB },
+	{ "belt", "belt-cbc", TRUE, beltCBC_keep, benchBeltCBCStart,
+		benchBeltCBC },
+	{ "belt", "belt-cfb", TRUE, beltCFB_keep, benchBeltCFBStart,
+		benchBeltCFB },
+	{ "belt", "belt-ctr", TRUE, beltCTR_keep, benchBeltCTRStart,
+		benchBeltCTR },
+	{ "belt", "belt-mac", TRUE, beltMAC_keep, 0, benchBeltMAC },
+	{ "belt", "belt-dwp", TRUE, beltDWP_keep, 0, benchBeltDWP },
+	{ "belt", "belt-che", TRUE, beltCHE_keep, 0, benchBeltCHE },
+	{ "belt", "belt-hash", TRUE, beltHash_keep, 0, benchBeltHash },
+	{ "belt", "belt-bde", TRUE, beltBDE_keep, benchBeltBDEStart,
+		benchBeltBDE },
+	{ "belt", "belt-sde", TRUE, beltSDE_keep, benchBeltSDEStart,
+		benchBeltSDE },
+	{ "belt", "belt-hmac", TRUE, beltHMAC_keep, 0, benchBeltHMAC },
+	{ "belt", "belt-pbkdf2", FALSE, 0, 0, benchBeltPBKDF2 },
+	{ 0 }
+};
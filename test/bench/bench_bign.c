@@ -0,0 +1,155 @@
+/*
+*******************************************************************************
+\file bench_bign.c
+\brief Benchmarks for STB 34.101.45 (bign)
+\project bee2/test
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include <bee2/core/prng.h>
+#include <bee2/crypto/bign.h>
+#include "bench.h"
+
+/*
+*******************************************************************************
+Состояние
+
+Для каждой стандартной кривой (уровни 128, 192, 256) генерируется ключевая
+пара и вырабатывается подпись псевдослучайного хэш-значения. Общий ключ
+строится на собственном открытом ключе.
+*******************************************************************************
+*/
+
+typedef struct
+{
+	bign_params params[1];	/*< долговременные параметры */
+	octet oid_der[16];		/*< идентификатор хэш-алгоритма */
+	size_t oid_len;			/*< длина oid_der */
+	octet privkey[64];		/*< личный ключ */
+	octet pubkey[128];		/*< открытый ключ */
+	octet hash[64];			/*< хэш-значение */
+	octet sig[96];			/*< подпись */
+} bench_bign_st;
+
+static size_t benchBign_keep()
+{
+	return sizeof(bench_bign_st);
+}
+
+static bool_t benchBignStart(bench_ctx_t* ctx, const char* curve,
+	const char* hash)
+{
+	bench_bign_st* st = (bench_bign_st*)ctx->state;
+	st->oid_len = sizeof(st->oid_der);
+	if (bignParamsStd(st->params, curve) != ERR_OK ||
+		bignOidToDER(st->oid_der, &st->oid_len, hash) != ERR_OK ||
+		bignKeypairGen(st->privkey, st->pubkey, st->params,
+			prngCOMBOStepR, ctx->rng) != ERR_OK)
+		return FALSE;
+	prngCOMBOStepR(st->hash, st->params->l / 4, ctx->rng);
+	return bignSign2(st->sig, st->params, st->oid_der, st->oid_len,
+		st->hash, st->privkey, 0, 0) == ERR_OK;
+}
+
+static bool_t benchBign128Start(bench_ctx_t* ctx)
+{
+	return benchBignStart(ctx, "1.2.112.0.2.0.34.101.45.3.1",
+		"1.2.112.0.2.0.34.101.31.81");
+}
+
+static bool_t benchBign192Start(bench_ctx_t* ctx)
+{
+	return benchBignStart(ctx, "1.2.112.0.2.0.34.101.45.3.2",
+		"1.2.112.0.2.0.34.101.77.12");
+}
+
+static bool_t benchBign256Start(bench_ctx_t* ctx)
+{
+	return benchBignStart(ctx, "1.2.112.0.2.0.34.101.45.3.3",
+		"1.2.112.0.2.0.34.101.77.13");
+}
+
+/*
+*******************************************************************************
+Операции
+*******************************************************************************
+*/
+
+static void benchBignKeygen(bench_ctx_t* ctx)
+{
+	bench_bign_st* st = (bench_bign_st*)ctx->state;
+	bignKeypairGen(ctx->out, ctx->out + 64, st->params, prngCOMBOStepR,
+		ctx->rng);
+}
+
+static void benchBignSign(bench_ctx_t* ctx)
+{
+	bench_bign_st* st = (bench_bign_st*)ctx->state;
+	bignSign(ctx->out, st->params, st->oid_der, st->oid_len, st->hash,
+		st->privkey, prngCOMBOStepR, ctx->rng);
+}
+
+static void benchBignSign2(bench_ctx_t* ctx)
+{
+	bench_bign_st* st = (bench_bign_st*)ctx->state;
+	bignSign2(ctx->out, st->params, st->oid_der, st->oid_len, st->hash,
+		st->privkey, 0, 0);
+}
+
+static void benchBignVerify(bench_ctx_t* ctx)
+{
+	bench_bign_st* st = (bench_bign_st*)ctx->state;
+	bignVerify(st->params, st->oid_der, st->oid_len, st->hash, st->sig,
+		st->pubkey);
+}
+
+static void benchBignDH(bench_ctx_t* ctx)
+{
+	bench_bign_st* st = (bench_bign_st*)ctx->state;
+	bignDH(ctx->out, st->params, st->privkey, st->pubkey, 32);
+}
+
+/*
+*******************************************************************************
+Набор замеров
+*******************************************************************************
+*/
+
+const bench_case_t benchBign[] =
+{
+	{ "bign", "bign128-keygen", FALSE, benchBign_keep, benchBign128Start,
+		benchBignKeygen },
+	{ "bign", "bign128-sign", FALSE, benchBign_keep, benchBign128Start,
+		benchBignSign },
+	{ "bign", "bign128-sign2", FALSE, benchBign_keep, benchBign128Start,
+		benchBignSign2 },
+	{ "bign", "bign128-verify", FALSE, benchBign_keep, benchBign128Start,
+		benchBignVerify },
+	{ "bign", "bign128-dh", FALSE, benchBign_keep, benchBign128Start,
+		benchBignDH },
+	{ "bign", "bign192-keygen", FALSE, benchBign_keep, benchBign192Start,
+		benchBignKeygen },
+	{ "bign", "bign192-sign", FALSE, benchBign_keep, benchBign192Start,
+		benchBignSign },
+	{ "bign", "bign192-sign2", FALSE, benchBign_keep, benchBign192Start,
+		benchBignSign2 },
+	{ "bign", "bign192-verify", FALSE, benchBign_keep, benchBign192Start,
+		benchBignVerify },
+	{ "bign", "bign192-dh", FALSE, benchBign_keep, benchBign192Start,
+		benchBignDH },
+	{ "bign", "bign256-keygen", FALSE, benchBign_keep, benchBign256Start,
+		benchBignKeygen },
+	{ "bign", "bign256-sign", FALSE, benchBign_keep, benchBign256Start,
+		benchBignSign },
+	{ "bign", "bign256-sign2", FALSE, benchBign_keep, benchBign256Start,
+		benchBignSign2 },
+	{ "bign", "bign256-verify", FALSE, benchBign_keep, benchBign256Start,
+		benchBignVerify },
+	{ "bign", "bign256-dh", FALSE, benchBign_keep, benchBign256Start,
+		benchBignDH },
+	{ 0 }
+};
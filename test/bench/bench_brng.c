@@ -0,0 +1,60 @@
+/*
+*******************************************************************************
+\file bench_brng.c
+\brief Benchmarks for STB 34.101.47 (brng)
+\project bee2/test
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include <bee2/crypto/brng.h>
+#include "bench.h"
+
+/*
+*******************************************************************************
+Генерация
+
+Каждая операция генерирует size октетов продолжающейся
+псевдослучайной последовательности.
+*******************************************************************************
+*/
+
+static bool_t benchBrngCTRStart(bench_ctx_t* ctx)
+{
+	brngCTRStart(ctx->state, ctx->key, ctx->iv);
+	return TRUE;
+}
+
+static void benchBrngCTR(bench_ctx_t* ctx)
+{
+	brngCTRStepR(ctx->buf, ctx->size, ctx->state);
+}
+
+static bool_t benchBrngHMACStart(bench_ctx_t* ctx)
+{
+	brngHMACStart(ctx->state, ctx->key, 32, ctx->iv, 32);
+	return TRUE;
+}
+
+static void benchBrngHMAC(bench_ctx_t* ctx)
+{
+	brngHMACStepR(ctx->buf, ctx->size, ctx->state);
+}
+
+/*
+*******************************************************************************
+Набор замеров
+*******************************************************************************
+*/
+
+const bench_case_t benchBrng[] =
+{
+	{ "brng", "brng-ctr", TRUE, brngCTR_keep, benchBrngCTRStart,
+		benchBrngCTR },
+	{ "brng", "brng-hmac", TRUE, brngHMAC_keep, benchBrngHMACStart,
+		benchBrngHMAC },
+	{ 0 }
+};
@@ -0,0 +1,168 @@
+/*
+*******************************************************************************
+\file bench_math.c
+\brief Benchmarks for big integers and binary polynomials
+\project bee2/test
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include <bee2/core/prng.h>
+#include <bee2/core/util.h>
+#include <bee2/core/word.h>
+#include <bee2/math/pp.h>
+#include <bee2/math/zz.h>
+#include "bench.h"
+
+/*
+*******************************************************************************
+Состояние
+
+Операнды имеют фиксированные длины 256, 512 и 1024 битов (размер
+сообщения не используется). Операнды [2n]a, [n]b и модуль [n]mod
+генерируются случайно. В модуле устанавливаются старший и младший биты,
+в младших n словах a и в b сбрасываются старшие биты. Поэтому a < mod,
+b < mod (для многочленов -- степени a и b меньше степени mod), а модуль
+нечетен.
+
+Вспомогательная память stack рассчитана на самую длинную операцию
+наибольшей длины.
+*******************************************************************************
+*/
+
+#define BENCH_MATH_N W_OF_B(1024)
+
+typedef struct
+{
+	size_t n;					/*!< длина операндов в словах */
+	word a[2 * BENCH_MATH_N];	/*!< первый операнд */
+	word b[BENCH_MATH_N];		/*!< второй операнд */
+	word mod[BENCH_MATH_N];		/*!< модуль */
+	word c[2 * BENCH_MATH_N];	/*!< результат */
+	word stack[1];				/*!< вспомогательная память */
+} bench_math_st;
+
+static size_t benchMath_keep()
+{
+	const size_t n = BENCH_MATH_N;
+	return sizeof(bench_math_st) + utilMax(8,
+		zzMul_deep(n, n), zzSqr_deep(n), zzMod_deep(2 * n, n),
+		zzMulMod_deep(n), zzInvMod_deep(n),
+		ppMul_deep(n, n), ppMod_deep(2 * n, n), ppMulMod_deep(n));
+}
+
+static bool_t benchMathStart(bench_ctx_t* ctx, size_t n)
+{
+	bench_math_st* st = (bench_math_st*)ctx->state;
+	st->n = n;
+	prngCOMBOStepR(st->a, O_OF_W(2 * n), ctx->rng);
+	prngCOMBOStepR(st->b, O_OF_W(n), ctx->rng);
+	prngCOMBOStepR(st->mod, O_OF_W(n), ctx->rng);
+	st->a[n - 1] &= ~WORD_BIT_HI, st->b[n - 1] &= ~WORD_BIT_HI;
+	st->mod[n - 1] |= WORD_BIT_HI, st->mod[0] |= 1;
+	return TRUE;
+}
+
+static bool_t benchMath256Start(bench_ctx_t* ctx)
+{
+	return benchMathStart(ctx, W_OF_B(256));
+}
+
+static bool_t benchMath512Start(bench_ctx_t* ctx)
+{
+	return benchMathStart(ctx, W_OF_B(512));
+}
+
+static bool_t benchMath1024Start(bench_ctx_t* ctx)
+{
+	return benchMathStart(ctx, W_OF_B(1024));
+}
+
+/*
+*******************************************************************************
+Операции
+*******************************************************************************
+*/
+
+static void benchZzMul(bench_ctx_t* ctx)
+{
+	bench_math_st* st = (bench_math_st*)ctx->state;
+	zzMul(st->c, st->a, st->n, st->b, st->n, st->stack);
+}
+
+static void benchZzSqr(bench_ctx_t* ctx)
+{
+	bench_math_st* st = (bench_math_st*)ctx->state;
+	zzSqr(st->c, st->a, st->n, st->stack);
+}
+
+static void benchZzMod(bench_ctx_t* ctx)
+{
+	bench_math_st* st = (bench_math_st*)ctx->state;
+	zzMod(st->c, st->a, 2 * st->n, st->mod, st->n, st->stack);
+}
+
+static void benchZzMulMod(bench_ctx_t* ctx)
+{
+	bench_math_st* st = (bench_math_st*)ctx->state;
+	zzMulMod(st->c, st->a, st->b, st->mod, st->n, st->stack);
+}
+
+static void benchZzInvMod(bench_ctx_t* ctx)
+{
+	bench_math_st* st = (bench_math_st*)ctx->state;
+	zzInvMod(st->c, st->a, st->mod, st->n, st->stack);
+}
+
+static void benchPpMul(bench_ctx_t* ctx)
+{
+	bench_math_st* st = (bench_math_st*)ctx->state;
+	ppMul(st->c, st->a, st->n, st->b, st->n, st->stack);
+}
+
+static void benchPpMod(bench_ctx_t* ctx)
+{
+	bench_math_st* st = (bench_math_st*)ctx->state;
+	ppMod(st->c, st->a, 2 * st->n, st->mod, st->n, st->stack);
+}
+
+static void benchPpMulMod(bench_ctx_t* ctx)
+{
+	bench_math_st* st = (bench_math_st*)ctx->state;
+	ppMulMod(st->c, st->a, st->b, st->mod, st->n, st->stack);
+}
+
+/*
+*******************************************************************************
+Набор замеров
+*******************************************************************************
+*/
+
+#define BENCH_MATH_CASES(l)\
+	{ "math", "zz-mul" #l, FALSE, benchMath_keep, benchMath##l##Start,\
+		benchZzMul },\
+	{ "math", "zz-sqr" #l, FALSE, benchMath_keep, benchMath##l##Start,\
+		benchZzSqr },\
+	{ "math", "zz-mod" #l, FALSE, benchMath_keep, benchMath##l##Start,\
+		benchZzMod },\
+	{ "math", "zz-mulmod" #l, FALSE, benchMath_keep, benchMath##l##Start,\
+		benchZzMulMod },\
+	{ "math", "zz-invmod" #l, FALSE, benchMath_keep, benchMath##l##Start,\
+		benchZzInvMod },\
+	{ "math", "pp-mul" #l, FALSE, benchMath_keep, benchMath##l##Start,\
+		benchPpMul },\
+	{ "math", "pp-mod" #l, FALSE, benchMath_keep, benchMath##l##Start,\
+		benchPpMod },\
+	{ "math", "pp-mulmod" #l, FALSE, benchMath_keep, benchMath##l##Start,\
+		benchPpMulMod }
+
+const bench_case_t benchMath[] =
+{
+	BENCH_MATH_CASES(256),
+	BENCH_MATH_CASES(512),
+	BENCH_MATH_CASES(1024),
+	{ 0 }
+};
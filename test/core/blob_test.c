@@ -4,7 +4,7 @@
 \brief Tests for blob functions
 \project bee2/test
 \created 2023.03.21
-\version 2023.03.23
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -12,6 +12,39 @@
 
 #include <bee2/core/blob.h>
 #include <bee2/core/mem.h>
+#include <bee2/core/mt.h>
+#include <bee2/core/util.h>
+
+/*
+*******************************************************************************
+Потоки
+
+Каждый поток многократно создает и закрывает блобы разных размеров.
+*******************************************************************************
+*/
+
+static void blobTestThrd(void* arg)
+{
+	blob_t b[16];
+	size_t i, j;
+	bool_t* ok = (bool_t*)arg;
+	for (i = 0; i < 100; ++i)
+	{
+		for (j = 0; j < COUNT_OF(b); ++j)
+		{
+			b[j] = blobCreate(100 + 997 * j * i % 70000);
+			if (b[j])
+				memSet(b[j], (octet)j, blobSize(b[j]));
+			else
+				*ok = FALSE;
+		}
+		for (j = 0; j < COUNT_OF(b); ++j)
+			if (b[j] && !memIsRep(b[j], blobSize(b[j]), (octet)j))
+				*ok = FALSE;
+		for (j = 0; j < COUNT_OF(b); ++j)
+			blobClose(b[j]);
+	}
+}
 
 /*
 *******************************************************************************
@@ -23,6 +56,11 @@ bool_t blobTest()
 {
 	blob_t b1 = 0;
 	blob_t b2 = 0;
+	blob_stat_t stat[1];
+	blob_stat_t stat1[1];
+	mt_thrd_t thrds[4];
+	bool_t oks[4];
+	size_t i, count;
 	// create / resize
 	b1 = blobCreate(123);		
 	b2 = blobResize(b2, 120);
@@ -58,5 +96,76 @@ bool_t blobTest()
 	blobWipe(b2);
 	blobClose(b2);
 	blobClose(b1);
+	// resize [смена размерного класса / переход в кучу и обратно]
+	b1 = blobCreate(100);
+	if (!b1)
+		return FALSE;
+	memSet(b1, 0x36, 100);
+	b1 = blobResize(b2 = b1, 5000);
+	if (!b1 || !memIsRep(b1, 100, 0x36) || !memIsZero((octet*)b1 + 100, 4900))
+	{
+		blobClose(b1 ? b1 : b2);
+		return FALSE;
+	}
+	b1 = blobResize(b2 = b1, 100000);
+	if (!b1 || !memIsRep(b1, 100, 0x36) || blobSize(b1) != 100000)
+	{
+		blobClose(b1 ? b1 : b2);
+		return FALSE;
+	}
+	b1 = blobResize(b2 = b1, 50);
+	if (!b1 || !memIsRep(b1, 50, 0x36) || blobSize(b1) != 50)
+	{
+		blobClose(b1 ? b1 : b2);
+		return FALSE;
+	}
+	blobClose(b1);
+	// статистика
+	blobStat(stat);
+	b1 = blobCreate(200);
+	b2 = blobCreate(300);
+	if (!b1 || !b2)
+	{
+		blobClose(b2), blobClose(b1);
+		return FALSE;
+	}
+	blobStat(stat1);
+	if (stat1->count != stat->count + 2 ||
+		stat1->size != stat->size + 500 ||
+		stat1->hits + stat1->misses != stat->hits + stat->misses + 2)
+	{
+		blobClose(b2), blobClose(b1);
+		return FALSE;
+	}
+	blobClose(b2), blobClose(b1);
+	blobStat(stat1);
+	if (stat1->count != stat->count || stat1->size != stat->size)
+		return FALSE;
+	// пул: повторное выделение без обращения к ОС
+	if (stat1->pooled)
+	{
+		b1 = blobCreate(200);
+		blobStat(stat);
+		blobClose(b1);
+		if (!b1 || stat->hits != stat1->hits + 1 ||
+			stat->pooled != stat1->pooled)
+			return FALSE;
+	}
+	// потоки
+	blobStat(stat);
+	for (count = 0; count < COUNT_OF(thrds); ++count)
+	{
+		oks[count] = TRUE;
+		if (!mtThrdCreate(thrds + count, blobTestThrd, oks + count))
+			break;
+	}
+	for (i = 0; i < count; ++i)
+		mtThrdJoin(thrds + i);
+	for (i = 0; i < count; ++i)
+		if (!oks[i])
+			return FALSE;
+	blobStat(stat1);
+	if (stat1->count != stat->count || stat1->size != stat->size)
+		return FALSE;
 	return TRUE;
 }
@@ -0,0 +1,92 @@
+/*
+*******************************************************************************
+\file cache_test.c
+\brief Tests for caches of digests
+\project bee2/test
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include <bee2/core/cache.h>
+#include <bee2/core/err.h>
+#include <bee2/core/mem.h>
+
+/*
+*******************************************************************************
+Тестирование
+*******************************************************************************
+*/
+
+static cache_t _cache[1];
+
+bool_t cacheTest()
+{
+	octet digest[3][32];
+	size_t hits, misses;
+	size_t i;
+	// выключенный кэш
+	memSetZero(digest, sizeof(digest));
+	digest[0][0] = 1, digest[1][0] = 2, digest[2][0] = 3;
+	cacheAdd(_cache, digest[0]);
+	cacheStat(_cache, &hits, &misses);
+	if (cacheIsOn(_cache) ||
+		cacheFind(_cache, digest[0]) ||
+		hits != 0 || misses != 0 ||
+		cacheStart(_cache, 0) != ERR_BAD_INPUT ||
+		cacheStart(_cache, CACHE_MAX + 1) != ERR_BAD_INPUT)
+		return FALSE;
+	// вытеснение
+	if (cacheStart(_cache, 2) != ERR_OK || !cacheIsOn(_cache))
+		return FALSE;
+	cacheAdd(_cache, digest[0]);
+	cacheAdd(_cache, digest[0]);
+	cacheAdd(_cache, digest[1]);
+	if (!cacheFind(_cache, digest[0]) ||
+		!cacheFind(_cache, digest[1]) ||
+		cacheFind(_cache, digest[2]))
+		return FALSE;
+	cacheAdd(_cache, digest[2]);
+	cacheStat(_cache, &hits, &misses);
+	if (cacheFind(_cache, digest[0]) ||
+		!cacheFind(_cache, digest[1]) ||
+		!cacheFind(_cache, digest[2]) ||
+		hits != 2 || misses != 1)
+		return FALSE;
+	// длинные цепочки пробирования: первые слова совпадают в группах
+	if (cacheStart(_cache, 100) != ERR_OK)
+		return FALSE;
+	for (i = 0; i < 300; ++i)
+	{
+		memSetZero(digest[2], 32);
+		digest[2][0] = (octet)(i % 7), digest[2][8] = (octet)i;
+		digest[2][9] = (octet)(i >> 8);
+		cacheAdd(_cache, digest[2]);
+	}
+	for (i = 0; i < 300; ++i)
+	{
+		memSetZero(digest[2], 32);
+		digest[2][0] = (octet)(i % 7), digest[2][8] = (octet)i;
+		digest[2][9] = (octet)(i >> 8);
+		if (cacheFind(_cache, digest[2]) != (i >= 200))
+			return FALSE;
+	}
+	// перезапуск
+	if (cacheStart(_cache, 1) != ERR_OK ||
+		cacheFind(_cache, digest[1]))
+		return FALSE;
+	cacheStat(_cache, &hits, 0);
+	if (hits != 0)
+		return FALSE;
+	// выключение
+	cacheStop(_cache);
+	cacheStat(_cache, &hits, &misses);
+	if (cacheIsOn(_cache) ||
+		cacheFind(_cache, digest[2]) ||
+		hits != 0 || misses != 0)
+		return FALSE;
+	// все нормально
+	return TRUE;
+}
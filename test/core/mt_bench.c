@@ -0,0 +1,91 @@
+/*
+*******************************************************************************
+\file mt_bench.c
+\brief Benchmarks for multithreading
+\project bee2/test
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include <stdio.h>
+#include <bee2/core/mem.h>
+#include <bee2/core/mt.h>
+#include <bee2/core/tm.h>
+#include <bee2/core/util.h>
+#include <bee2/crypto/belt.h>
+
+/*
+*******************************************************************************
+Замер производительности
+
+Оцениваются накладные расходы на передачу и ожидание пустой задачи
+и скорость параллельного шифрования буфера в режиме CTR (каждый фрагмент
+шифруется на своей синхропосылке).
+*******************************************************************************
+*/
+
+static void mtBenchNop(void* arg)
+{
+}
+
+static void mtBenchCTR(size_t offset, size_t len, void* arg)
+{
+	octet state[256];
+	octet iv[16];
+	ASSERT(beltCTR_keep() <= sizeof(state));
+	memSetZero(iv, 16);
+	memCopy(iv, &offset, sizeof(offset));
+	beltCTRStart(state, beltH(), 32, iv);
+	beltCTRStepE((octet*)arg + offset, len, state);
+}
+
+bool_t mtBench()
+{
+	const size_t reps = 10000;
+	const size_t size = 1 << 22;
+	size_t workers[2];
+	mt_pool_t* pool;
+	mt_task_t task[1];
+	octet* buf;
+	size_t pos, i;
+	tm_ticks_t ticks;
+	// подготовить буфер
+	if (!(buf = (octet*)memAlloc(size)))
+		return FALSE;
+	memSetZero(buf, size);
+	// пробежать конфигурации пула
+	workers[0] = 1, workers[1] = mtCPUCount();
+	for (pos = 0; pos < COUNT_OF(workers); ++pos)
+	{
+		if (pos && workers[pos] == workers[0])
+			break;
+		if (!(pool = mtPoolCreate(workers[pos])))
+		{
+			memFree(buf);
+			return FALSE;
+		}
+		// накладные расходы на задачу
+		for (i = 0, ticks = tmTicks(); i < reps; ++i)
+		{
+			mtPoolSubmit(pool, task, mtBenchNop, 0);
+			mtPoolWait(pool, task);
+		}
+		ticks = tmTicks() - ticks;
+		printf("mtBench::task[%u workers]: %6u cycles / task\n",
+			(unsigned)mtPoolWorkers(pool), (unsigned)(ticks / reps));
+		// параллельное шифрование
+		for (i = 0, ticks = tmTicks(); i < 8; ++i)
+			mtPoolFor(pool, size, 4096, mtBenchCTR, buf);
+		ticks = tmTicks() - ticks;
+		printf("mtBench::for[%u workers]: %3u cpb [%6u kBytes/sec]\n",
+			(unsigned)mtPoolWorkers(pool),
+			(unsigned)(ticks / size / 8),
+			(unsigned)tmSpeed(8 * size / 1024, ticks));
+		mtPoolClose(pool);
+	}
+	memFree(buf);
+	return TRUE;
+}
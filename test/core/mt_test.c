@@ -4,13 +4,15 @@
 \brief Tests for multithreading
 \project bee2/test
 \created 2021.05.15
-\version 2021.05.18
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
+#include <bee2/core/mem.h>
 #include <bee2/core/mt.h>
+#include <bee2/core/util.h>
 
 /*
 *******************************************************************************
@@ -25,6 +27,95 @@ void init()
 	_inited = TRUE;
 }
 
+static void mtTestThrd(void* arg)
+{
+	size_t i;
+	for (i = 0; i < 1000; ++i)
+		mtAtomicIncr((size_t*)arg);
+}
+
+static void mtTestTask(void* arg)
+{
+	mtAtomicIncr((size_t*)arg);
+}
+
+typedef struct
+{
+	mt_pool_t* pool;		/*< пул */
+	size_t* ctr;			/*< счетчик */
+} mt_test_nested_st;
+
+static void mtTestNested(void* arg)
+{
+	mt_test_nested_st* st = (mt_test_nested_st*)arg;
+	mt_task_t tasks[8];
+	size_t i;
+	for (i = 0; i < COUNT_OF(tasks); ++i)
+		mtPoolSubmit(st->pool, tasks + i, mtTestTask, st->ctr);
+	for (i = 0; i < COUNT_OF(tasks); ++i)
+		mtPoolWait(st->pool, tasks + i);
+}
+
+static void mtTestFor(size_t offset, size_t len, void* arg)
+{
+	octet* buf = (octet*)arg;
+	for (; len--; ++offset)
+		buf[offset] += (octet)(offset + 1);
+}
+
+static bool_t mtTestPool(size_t workers)
+{
+	mt_pool_t* pool;
+	mt_task_t tasks[100];
+	mt_test_nested_st nested[1];
+	size_t ctr[1] = { SIZE_0 };
+	octet buf[10000];
+	size_t i;
+	// создать пул
+	if (!(pool = mtPoolCreate(workers)))
+		return FALSE;
+	if (workers && mtPoolWorkers(pool) > workers)
+	{
+		mtPoolClose(pool);
+		return FALSE;
+	}
+	// задачи
+	for (i = 0; i < COUNT_OF(tasks); ++i)
+		mtPoolSubmit(pool, tasks + i, mtTestTask, ctr);
+	for (i = 0; i < COUNT_OF(tasks); ++i)
+		mtPoolWait(pool, tasks + i);
+	if (*ctr != COUNT_OF(tasks))
+	{
+		mtPoolClose(pool);
+		return FALSE;
+	}
+	// вложенные задачи
+	nested->pool = pool, nested->ctr = ctr, *ctr = 0;
+	for (i = 0; i < 10; ++i)
+		mtPoolSubmit(pool, tasks + i, mtTestNested, nested);
+	for (i = 0; i < 10; ++i)
+		mtPoolWait(pool, tasks + i);
+	if (*ctr != 10 * 8)
+	{
+		mtPoolClose(pool);
+		return FALSE;
+	}
+	// параллельная обработка диапазона
+	memSetZero(buf, sizeof(buf));
+	mtPoolFor(pool, sizeof(buf), 16, mtTestFor, buf);
+	mtPoolFor(pool, 0, 16, mtTestFor, buf);
+	mtPoolFor(pool, 7, 1, mtTestFor, buf);
+	for (i = 0; i < sizeof(buf); ++i)
+		if (buf[i] != (octet)((i + 1) * (i < 7 ? 2 : 1)))
+		{
+			mtPoolClose(pool);
+			return FALSE;
+		}
+	// закрыть пул
+	mtPoolClose(pool);
+	return TRUE;
+}
+
 bool_t mtTest()
 {
 	mt_mtx_t mtx[1];
@@ -46,6 +137,21 @@ bool_t mtTest()
 		return FALSE;
 	if (!mtCallOnce(&_once, init) || !_inited)
 		return FALSE;
+	// потоки
+	{
+		mt_thrd_t thrd[4];
+		size_t i, n;
+		for (n = 0; n < 4 && mtThrdCreate(thrd + n, mtTestThrd, ctr); ++n);
+		mtTestThrd(ctr);
+		for (i = 0; i < n; ++i)
+			mtThrdJoin(thrd + i);
+		if (*ctr != 1000 * (n + 1))
+			return FALSE;
+	}
+	// пул потоков
+	if (mtCPUCount() == 0 ||
+		!mtTestPool(1) || !mtTestPool(4) || !mtTestPool(0))
+		return FALSE;
 	// все нормально
 	return TRUE;
 }
@@ -0,0 +1,92 @@
+/*
+*******************************************************************************
+\file perf_test.c
+\brief Tests for performance counters
+\project bee2/test
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include <bee2/core/err.h>
+#include <bee2/core/mem.h>
+#include <bee2/core/perf.h>
+#include <bee2/core/str.h>
+#include <bee2/crypto/bash.h>
+#include <bee2/crypto/belt.h>
+
+/*
+*******************************************************************************
+Тестирование
+*******************************************************************************
+*/
+
+bool_t perfTest()
+{
+	perf_stat_t stats[PERF_COUNT];
+	octet state[1024];
+	octet buf[64];
+	octet hash[32];
+	size_t id;
+	// имена
+	for (id = 0; id < PERF_COUNT; ++id)
+		if (!strIsValid(perfName(id)))
+			return FALSE;
+	if (perfName(PERF_COUNT) != 0 ||
+		!strEq(perfName(PERF_BELT_HASH), "belt-hash") ||
+		!strEq(perfName(PERF_RNG), "rng"))
+		return FALSE;
+	// прямой учет
+	perfReset();
+	perfAdd(PERF_BIGN_SIGN, ERR_OK, 0, 1);
+	perfAdd(PERF_BIGN_SIGN, ERR_OK, 10, 5);
+	perfAdd(PERF_BIGN_SIGN, ERR_OK, 20, 1000);
+	perfAdd(PERF_BIGN_SIGN, ERR_BAD_RNG, 40, 2);
+	perfSnapshot(stats);
+	if (stats[PERF_BIGN_SIGN].calls != 4 ||
+		stats[PERF_BIGN_SIGN].errors != 1 ||
+		stats[PERF_BIGN_SIGN].octets != 30 ||
+		stats[PERF_BIGN_SIGN].ticks != 1008 ||
+		stats[PERF_BIGN_SIGN].hist[0] != 1 ||
+		stats[PERF_BIGN_SIGN].hist[1] != 1 ||
+		stats[PERF_BIGN_SIGN].hist[2] != 1 ||
+		stats[PERF_BIGN_SIGN].hist[9] != 1 ||
+		stats[PERF_BIGN_VERIFY].calls != 0)
+		return FALSE;
+	perfReset();
+	perfSnapshot(stats);
+	for (id = 0; id < PERF_COUNT; ++id)
+		if (stats[id].calls || stats[id].errors || stats[id].octets ||
+			stats[id].ticks ||
+			!memIsZero(stats[id].hist, sizeof(stats[id].hist)))
+			return FALSE;
+	// учет в функциях библиотеки
+	if (sizeof(state) < beltHash_keep())
+		return FALSE;
+	memSetZero(buf, sizeof(buf));
+	beltHashStart(state);
+	beltHashStepH(buf, 13, state);
+	beltHashStepH(buf, 51, state);
+	beltHashStepG(hash, state);
+	if (bashHash(hash, 128, buf, sizeof(buf)) != ERR_OK ||
+		bashHash(hash, 129, buf, sizeof(buf)) != ERR_BAD_PARAMS)
+		return FALSE;
+	perfSnapshot(stats);
+	if (perfIsEnabled())
+	{
+		if (stats[PERF_BELT_HASH].calls != 2 ||
+			stats[PERF_BELT_HASH].octets != 64 ||
+			stats[PERF_BELT_HASH].errors != 0 ||
+			stats[PERF_BASH_HASH].calls != 2 ||
+			stats[PERF_BASH_HASH].errors != 1 ||
+			stats[PERF_BASH_HASH].octets != 64)
+			return FALSE;
+	}
+	else if (stats[PERF_BELT_HASH].calls || stats[PERF_BASH_HASH].calls)
+		return FALSE;
+	perfReset();
+	// все нормально
+	return TRUE;
+}
@@ -0,0 +1,67 @@
+/*
+*******************************************************************************
+\file rng_bench.c
+\brief Benchmarks for random number generators
+\project bee2/test
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include <stdio.h>
+#include <bee2/core/err.h>
+#include <bee2/core/rng.h>
+#include <bee2/core/tm.h>
+#include <bee2/core/util.h>
+#include <bee2/crypto/bash.h>
+
+/*
+*******************************************************************************
+Замер производительности
+*******************************************************************************
+*/
+
+bool_t rngBench()
+{
+	const char* engines[] = { "brng-ctr", "bash-prg" };
+	const size_t reps = 2000;
+	octet buf[1024];
+	size_t pos;
+	size_t i;
+	tm_ticks_t ticks;
+	err_t code;
+	// пробежать механизмы
+	for (pos = 0; pos < COUNT_OF(engines); ++pos)
+	{
+		// генератор уже создан с другим механизмом?
+		code = rngCreate2(0, 0, engines[pos]);
+		if (code == ERR_BAD_PARAMS && rngIsValid())
+		{
+			printf("rngBench::%s: skipped (engine %s is running)\n",
+				engines[pos], rngEngine());
+			continue;
+		}
+		if (code != ERR_OK)
+			return FALSE;
+		// скорость rngStepR2()
+		for (i = 0, ticks = tmTicks(); i < reps; ++i)
+			rngStepR2(buf, sizeof(buf), 0);
+		ticks = tmTicks() - ticks;
+		printf("rngBench::%s[%s]: %3u cpb [%5u kBytes/sec]\n",
+			engines[pos],
+			pos ? bashPlatform() : "belt",
+			(unsigned)(ticks / 1024 / reps),
+			(unsigned)tmSpeed(reps, ticks));
+		// скорость rngRekey()
+		for (i = 0, ticks = tmTicks(); i < reps; ++i)
+			rngRekey();
+		ticks = tmTicks() - ticks;
+		printf("rngBench::%s::rekey: %5u cycles / rekey\n",
+			engines[pos],
+			(unsigned)(ticks / reps));
+		rngClose();
+	}
+	return TRUE;
+}
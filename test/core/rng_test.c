@@ -4,17 +4,19 @@
 \brief Tests for random number generators
 \project bee2/test
 \created 2014.10.10
-\version 2023.12.16
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
 #include <stdio.h>
+#include <bee2/core/err.h>
 #include <bee2/core/mem.h>
 #include <bee2/core/hex.h>
 #include <bee2/core/prng.h>
 #include <bee2/core/rng.h>
+#include <bee2/core/str.h>
 #include <bee2/core/util.h>
 
 /*
@@ -83,6 +85,28 @@ bool_t rngTest()
 	rngClose();
 	if (rngIsValid())
 		return FALSE;
+	// механизм bash-prg
+	if (rngCreate2(0, 0, "belt-ctr") != ERR_BAD_PARAMS ||
+		rngCreate2(0, 0, "bash-prg") != ERR_OK ||
+		!strEq(rngEngine(), "bash-prg"))
+		return FALSE;
+	if (rngCreate2(0, 0, "brng-ctr") != ERR_BAD_PARAMS ||
+		rngCreate(0, 0) != ERR_OK)
+		return FALSE;
+	rngClose();
+	rngStepR(buf, 2500, 0);
+	rngRekey();
+	rngStepR2(buf, 2500, 0);
+	hexFrom(hex, buf, 16);
+	printf("rngStepR2[bash]:  %s... [FIPS: 1%c 2%c 3%c 4%c]\n",
+		hex,
+		rngTestFIPS1(buf) ? '+' : '-',
+		rngTestFIPS2(buf) ? '+' : '-',
+		rngTestFIPS3(buf) ? '+' : '-',
+		rngTestFIPS4(buf) ? '+' : '-');
+	rngClose();
+	if (rngIsValid() || rngEngine() != 0)
+		return FALSE;
 	// все нормально
 	return TRUE;
 }
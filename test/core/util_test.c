@@ -4,7 +4,7 @@
 \brief Tests for utilities
 \project bee2/test
 \created 2017.01.17
-\version 2021.05.18
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -71,6 +71,11 @@ bool_t utilTest()
 		return FALSE;
 	if (utilFNV32("3pjNqM", 6, 0x811C9DC5) != 0)
 		return FALSE;
+	// возможности процессора
+	if (utilCPUHas("unknown") ||
+		utilCPUHas("avx512f") && !utilCPUHas("avx2") ||
+		utilCPUHas("avx2") && !utilCPUHas("sse2"))
+		return FALSE;
 	// все нормально
 	return TRUE;
 }
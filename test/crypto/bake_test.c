@@ -4,7 +4,7 @@
 \brief Tests for STB 34.101.66 (bake)
 \project bee2/test
 \created 2014.04.23
-\version 2023.09.22
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -217,6 +217,7 @@ bool_t bakeTest()
 	octet keyb[32];
 	octet secret[32];
 	octet iv[64];
+	octet ws[1024];
 	// подготовить память
 	if (sizeof(echoa) < prngEcho_keep())
 		return FALSE;
@@ -335,6 +336,12 @@ bool_t bakeTest()
 			"54AC058284D679CF4C47D3D72651F3E4"
 			"EF0D61D1D0ED5BAF8FF30B8924E599D8"))
 		return FALSE;
+	// тест bakeKDF_ws
+	if (sizeof(ws) < bakeKDF_keep())
+		return FALSE;
+	if (bakeKDF_ws(keya, secret, 32, iv, 64, 1, ws) != ERR_OK ||
+		!memEq(keya, keyb, 32))
+		return FALSE;
 	// тест bakeSWU (по данным из теста Б.4)
 	hexTo(secret, 
 		"AD1362A8F9A3D42FBE1B8E6F1C88AAD5"
@@ -4,7 +4,7 @@
 \brief Benchmarks for STB 34.101.77 (bash)
 \project bee2/test
 \created 2014.07.15
-\version 2023.03.30
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -25,8 +25,6 @@
 *******************************************************************************
 */
 
-extern const char bash_platform[];
-
 bool_t bashBench()
 {
 	octet belt_state[256];
@@ -45,7 +43,7 @@ bool_t bashBench()
 	prngCOMBOStart(combo_state, utilNonce32());
 	prngCOMBOStepR(buf, sizeof(buf), combo_state);
 	// платформа
-	printf("bashBench::platform = %s\n", bash_platform);
+	printf("bashBench::platform = %s\n", bashPlatform());
 	// оценить скорость хэширования
 	{
 		const size_t reps = 2000;
@@ -73,6 +71,29 @@ bool_t bashBench()
 				(unsigned)(ticks / sizeof(buf) / reps),
 				(unsigned)tmSpeed(reps, ticks));
 		}
+		// эксперимент с bashHashMulti над короткими сообщениями
+		{
+			const void* src[64];
+			size_t count[64];
+			octet hashes[64 * 32];
+			for (i = 0; i < 64; ++i)
+				src[i] = buf + 15 * i, count[i] = 64;
+			for (i = 0, ticks = tmTicks(); i < reps / 16; ++i)
+				for (d = 0; d < 64; ++d)
+					bashHash(hashes + 32 * d, 128, src[d], count[d]);
+			ticks = tmTicks() - ticks;
+			printf("bashBench::bash256[64 x 64]: %3u cpb [%5u kBytes/sec]\n",
+				(unsigned)(ticks / 4096 / (reps / 16)),
+				(unsigned)tmSpeed(reps / 16 * 4, ticks));
+			for (i = 0, ticks = tmTicks(); i < reps / 16; ++i)
+				bashHashMulti(hashes, 128, src, count, 64);
+			ticks = tmTicks() - ticks;
+			printf("bashBench::bash256-multi[64 x 64]: %3u cpb "
+				"[%5u kBytes/sec] (%u lanes)\n",
+				(unsigned)(ticks / 4096 / (reps / 16)),
+				(unsigned)tmSpeed(reps / 16 * 4, ticks),
+				(unsigned)bashFxLanes());
+		}
 		// эксперимент с bash-prg-hashLLLD
 		for (l = 128; l <= 256; l += 64)
 		for (d = 1; d <= 2; ++d)
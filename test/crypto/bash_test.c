@@ -4,12 +4,13 @@
 \brief Tests for STB 34.101.77 (bash)
 \project bee2/test
 \created 2015.09.22
-\version 2023.03.30
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
+#include <bee2/core/err.h>
 #include <bee2/core/mem.h>
 #include <bee2/core/hex.h>
 #include <bee2/core/str.h>
@@ -31,6 +32,7 @@ bool_t bashTest()
 	octet hash[64];
 	octet state[1024];
 	octet state1[1024];
+	iov_t iov[3];
 	size_t pos;
 	// подготовить память
 	if (sizeof(state) < utilMax(3,
@@ -153,6 +155,50 @@ bool_t bashTest()
 		"6C3D3931857C4FF6CCCD49BD99852FE9"
 		"EAA7495ECCDD96B571E0EDCF47F89768"))
 		return FALSE;
+	// многобуферная bash-f
+	{
+		octet blocks[8][192];
+		octet* ptrs[8];
+		for (pos = 0; pos < 8; ++pos)
+		{
+			memCopy(blocks[pos], beltH() + pos, 192);
+			ptrs[pos] = blocks[pos];
+		}
+		bashFx8(ptrs, state);
+		bashFx4(ptrs + 4, state);
+		bashFx2(ptrs + 6, state);
+		for (pos = 0; pos < 8; ++pos)
+		{
+			memCopy(buf, beltH() + pos, 192);
+			bashF(buf, state);
+			if (pos >= 4)
+				bashF(buf, state);
+			if (pos >= 6)
+				bashF(buf, state);
+			if (!memEq(buf, blocks[pos], 192))
+				return FALSE;
+		}
+	}
+	// многобуферное хэширование
+	{
+		const void* src[11];
+		size_t count[11];
+		octet hashes[11 * 64];
+		size_t l;
+		for (pos = 0; pos < 11; ++pos)
+			src[pos] = beltH() + pos, count[pos] = pos * 23 % 241;
+		for (l = 128; l <= 256; l += 64)
+		{
+			if (bashHashMulti(hashes, l, src, count, 11) != ERR_OK)
+				return FALSE;
+			for (pos = 0; pos < 11; ++pos)
+			{
+				bashHash(hash, l, src[pos], count[pos]);
+				if (!memEq(hash, hashes + pos * l / 4, l / 4))
+					return FALSE;
+			}
+		}
+	}
 	// A.4.alpha
 	bashPrgStart(state, 256, 2, 0, 0, beltH(), 32);
 	bashPrgAbsorb(beltH() + 32, 95, state);
@@ -293,6 +339,84 @@ bool_t bashTest()
 	bashPrgSqueezeStep(buf + 14, 32 - 14, state);
 	if (!memEq(buf, hash, 32))
 		return FALSE;
+	// A.6.encr [фрагменты]
+	memCopy(buf, beltH() + 64, 49);
+	iov[0].buf = buf, iov[0].count = 17;
+	iov[1].buf = buf + 17, iov[1].count = 0;
+	iov[2].buf = buf + 17, iov[2].count = 32;
+	bashPrgStart(state, 256, 1, beltH(), 16, beltH() + 32, 32);
+	bashPrgAbsorbStart(state);
+	bashPrgAbsorbStepV(iov, 3, state);
+	memSetZero(buf, 192);
+	iov[0].count = 100, iov[1].buf = buf + 100, iov[2].buf = buf + 100;
+	iov[2].count = 92;
+	bashPrgEncrStart(state);
+	bashPrgEncrStepV(iov, 3, state);
+	bashPrgSqueeze(hash + 32, 32, state);
+	if (!memEq(hash, hash + 32, 32))
+		return FALSE;
+	bashPrgStart(state, 256, 1, beltH(), 16, beltH() + 32, 32);
+	bashPrgAbsorb(beltH() + 64, 49, state);
+	bashPrgDecrStart(state);
+	bashPrgDecrStepV(iov, 3, state);
+	if (!memIsZero(buf, 192))
+		return FALSE;
+	// bash-hash [фрагменты]
+	memCopy(buf, beltH(), 192);
+	iov[0].buf = buf, iov[0].count = 50;
+	iov[1].buf = buf + 50, iov[1].count = 100;
+	iov[2].buf = buf + 150, iov[2].count = 42;
+	bashHashStart(state, 128);
+	bashHashStepHV(iov, 3, state);
+	bashHashStepG(hash, 32, state);
+	bashHash(hash + 32, 128, buf, 192);
+	if (!memEq(hash, hash + 32, 32))
+		return FALSE;
+	// bash-hash: сохранение состояния
+	bashHashStart(state, 192);
+	bashHashStepH(buf, 100, state);
+	pos = sizeof(state1);
+	if (bashHashStateEnc(state1, &pos, state) != ERR_OK || pos != 198)
+		return FALSE;
+	memCopy(state1 + 256, state1, pos);
+	if (bashHashStateDec(state, state1 + 256, pos) != ERR_OK)
+		return FALSE;
+	bashHashStepH(buf + 100, 92, state);
+	bashHashStepG(hash, 48, state);
+	bashHash(hash + 48, 192, buf, 192);
+	if (!memEq(hash, hash + 48, 48))
+		return FALSE;
+	state1[256 + 197] = 200;
+	if (bashHashStateDec(state, state1 + 256, pos) != ERR_BAD_FORMAT)
+		return FALSE;
+	// bash-prg: сохранение состояния
+	bashPrgStart(state, 256, 1, beltH(), 16, beltH() + 32, 32);
+	bashPrgAbsorbStart(state);
+	bashPrgAbsorbStep(beltH() + 64, 20, state);
+	pos = sizeof(state1);
+	if (bashPrgStateEnc(state1, &pos, state) != ERR_OK || pos != 200 ||
+		bashPrgStateDec(state, state1, pos) != ERR_OK)
+		return FALSE;
+	bashPrgAbsorbStep(beltH() + 64 + 20, 29, state);
+	memSetZero(buf, 192);
+	bashPrgEncr(buf, 192, state);
+	if (!hexEq(buf,
+		"690673766C3E848CAC7C05169FFB7B77"
+		"51E52A011040E5602573FAF991044A00"
+		"4329EEF7BED8E6875830A91854D1BD2E"
+		"DC6FC2FF37851DBAC249DF400A0549EA"
+		"2E0C811D499E1FF1E5E32FAE7F0532FA"
+		"4051D0F9E300D9B1DBF119AC8CFFC48D"
+		"D3CBF1CA0DBA5DD97481C88DF0BE4127"
+		"85E40988B31585537948B80F5A9C49E0"
+		"8DD684A7DCA871C380DFDC4C4DFBE61F"
+		"50D2D0FBD24D8B9D32974A347247D001"
+		"BAD5B168440025693967E77394DC088B"
+		"0ECCFA8D291BA13D44F60B06E2EDB351"))
+		return FALSE;
+	state1[198] = 100;
+	if (bashPrgStateDec(state, state1, pos) != ERR_BAD_FORMAT)
+		return FALSE;
 	// все нормально
 	return TRUE;
 }
@@ -4,12 +4,13 @@
 \brief Tests for STB 34.101.60 (bels)
 \project bee2/test
 \created 2013.06.27
-\version 2023.03.29
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
+#include <bee2/core/blob.h>
 #include <bee2/core/mem.h>
 #include <bee2/core/hex.h>
 #include <bee2/core/prng.h>
@@ -35,6 +36,8 @@ bool_t belsTest()
 	octet mi[32 * 5];
 	octet s[32];
 	octet si[33 * 5];
+	octet si1[33 * 5];
+	void* ws;
 	char id[] = "Alice";
 	octet echo_state[64];
 	octet combo_state[512];
@@ -138,6 +141,19 @@ bool_t belsTest()
 			"71ADE959FC88CCBB1C521FA9A1168C18"
 			"4619832AB66265E08A65DD48EE406418"))
 			return FALSE;
+		// разделить секрет с рабочей памятью
+		ws = blobCreate(belsShare_keep(3, len));
+		if (ws == 0)
+			return FALSE;
+		prngEchoStart(echo_state, beltH() + 128, 128);
+		if (belsShare_ws(si1, 5, 3, len, beltH(), m0, mi, prngEchoStepR,
+				echo_state, ws) != ERR_OK ||
+			!memEq(si1, si, 5 * len))
+		{
+			blobClose(ws);
+			return FALSE;
+		}
+		blobClose(ws);
 		// восстановить секрет
 		if (belsRecover(s, 1, len, si, m0, mi) != ERR_OK ||
 			memEq(s, beltH(), len))
@@ -4,12 +4,13 @@
 \brief Tests for STB 34.101.31 (belt)
 \project bee2/test
 \created 2012.06.20
-\version 2024.01.25
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
+#include <bee2/core/err.h>
 #include <bee2/core/mem.h>
 #include <bee2/core/hex.h>
 #include <bee2/core/u32.h>
@@ -132,6 +133,9 @@ bool_t beltTest()
 	u32 block[4];
 	octet level[12];
 	octet state[1024];
+	octet state1[1024];
+	octet saved[256];
+	iov_t iov[3];
 	size_t count;
 	// подготовить память
 	if (sizeof(state) < utilMax(17,
@@ -474,6 +478,80 @@ bool_t beltTest()
 		beltH() + 128, 32, beltH() + 192);
 	if (!memEq(buf, buf1, 16) || !memEq(mac, mac1, 8))
 		return FALSE;
+	// belt-dwp: тест A.19-1 [фрагменты]
+	beltDWPStart(state, beltH() + 128, 32, beltH() + 192);
+	memCopy(buf1, beltH(), 16);
+	iov[0].buf = buf1, iov[0].count = 7;
+	iov[1].buf = buf1 + 7, iov[1].count = 0;
+	iov[2].buf = buf1 + 7, iov[2].count = 9;
+	beltDWPStepEV(iov, 3, state);
+	beltDWPStepI(beltH() + 16, 32, state);
+	beltDWPStepAV(iov, 3, state);
+	beltDWPStepG(mac1, state);
+	if (!memEq(buf, buf1, 16) || !memEq(mac, mac1, 8))
+		return FALSE;
+	beltDWPStart(state, beltH() + 128, 32, beltH() + 192);
+	beltDWPStepDV(iov, 3, state);
+	if (!memEq(buf1, beltH(), 16))
+		return FALSE;
+	// belt-hash, belt-mac: фрагменты
+	memCopy(buf, beltH(), 48);
+	iov[0].buf = buf, iov[0].count = 13;
+	iov[1].buf = buf + 13, iov[1].count = 19;
+	iov[2].buf = buf + 32, iov[2].count = 16;
+	beltHashStart(state);
+	beltHashStepHV(iov, 3, state);
+	beltHashStepG(hash, state);
+	beltHash(hash1, buf, 48);
+	if (!memEq(hash, hash1, 32))
+		return FALSE;
+	beltMACStart(state, beltH() + 128, 32);
+	beltMACStepAV(iov, 3, state);
+	beltMACStepG(mac, state);
+	beltMAC(mac1, buf, 48, beltH() + 128, 32);
+	if (!memEq(mac, mac1, 8))
+		return FALSE;
+	// belt-hash, belt-mac, belt-hmac: сохранение состояний
+	beltHashStart(state);
+	beltHashStepH(buf, 45, state);
+	count = sizeof(saved);
+	if (beltHashStateEnc(saved, &count, state) != ERR_OK || count != 101)
+		return FALSE;
+	memSetZero(state1, sizeof(state1));
+	if (beltHashStateDec(state1, saved, count) != ERR_OK)
+		return FALSE;
+	beltHashStepH(buf + 45, 3, state1);
+	beltHashStepG(hash1, state1);
+	if (!memEq(hash, hash1, 32))
+		return FALSE;
+	beltMACStart(state, beltH() + 128, 32);
+	beltMACStepA(buf, 32, state);
+	count = sizeof(saved);
+	if (beltMACStateEnc(saved, &count, state) != ERR_OK ||
+		beltMACStateDec(state1, saved, count) != ERR_OK)
+		return FALSE;
+	beltMACStepA(buf + 32, 16, state1);
+	beltMACStepG(mac1, state1);
+	if (!memEq(mac, mac1, 8))
+		return FALSE;
+	beltHMACStart(state, beltH() + 128, 32);
+	beltHMACStepA(buf, 7, state);
+	count = sizeof(saved);
+	if (beltHMACStateEnc(saved, &count, state) != ERR_OK ||
+		beltHMACStateDec(state1, saved, count) != ERR_OK)
+		return FALSE;
+	beltHMACStepA(buf + 7, 41, state1);
+	beltHMACStepG(hash1, state1);
+	beltHMAC(hash, buf, 48, beltH() + 128, 32);
+	if (!memEq(hash, hash1, 32))
+		return FALSE;
+	saved[1] ^= 1;
+	if (beltHMACStateDec(state1, saved, count) != ERR_BAD_FORMAT)
+		return FALSE;
+	saved[1] ^= 1, saved[count - 1] = 32;
+	if (beltHMACStateDec(state1, saved, count) != ERR_BAD_FORMAT ||
+		beltHMACStateDec(state1, saved, count - 1) != ERR_BAD_FORMAT)
+		return FALSE;
 	// belt-che: тест A.19-2 [+ инкрементальность]
 	beltCHEStart(state, beltH() + 128, 32, beltH() + 192);
 	memCopy(buf, beltH(), 15);
@@ -541,6 +619,40 @@ bool_t beltTest()
 		beltH() + 128 + 32, 32, beltH() + 192 + 16);
 	if (!memEq(buf1, beltH() + 64, 20) || !memEq(mac, mac1, 8))
 		return FALSE;
+	// belt-che: тест A.20-2 [рабочая память]
+	if (beltCHEUnwrap_ws(buf1, beltH() + 64, 20, beltH() + 64 + 16, 32,
+		mac, beltH() + 128 + 32, 32, beltH() + 192 + 16, state) != ERR_OK ||
+		!memEq(buf, buf1, 20))
+		return FALSE;
+	if (beltCHEWrap_ws(buf1, mac1, buf, 20, beltH() + 64 + 16, 32,
+		beltH() + 128 + 32, 32, beltH() + 192 + 16, state) != ERR_OK ||
+		!memEq(buf1, beltH() + 64, 20) || !memEq(mac, mac1, 8))
+		return FALSE;
+	// belt-ctr, belt-mac, belt-dwp, belt-hash: рабочая память
+	if (beltCTR_ws(buf1, beltH(), 48, beltH() + 128, 32, beltH() + 192,
+		state) != ERR_OK ||
+		!hexEq(buf1,
+			"52C9AF96FF50F64435FC43DEF56BD797"
+			"D5B5B1FF79FB41257AB9CDF6E63E81F8"
+			"F00341473EAE409833622DE05213773A"))
+		return FALSE;
+	if (beltMAC_ws(mac1, beltH(), 48, beltH() + 128, 32, state) != ERR_OK ||
+		!hexEq(mac1, "2DAB59771B4B16D0"))
+		return FALSE;
+	if (beltDWPWrap_ws(buf1, mac1, beltH(), 16, beltH() + 16, 32,
+		beltH() + 128, 32, beltH() + 192, state) != ERR_OK ||
+		!hexEq(buf1, "52C9AF96FF50F64435FC43DEF56BD797") ||
+		!hexEq(mac1, "3B2E0AEB2B91854B"))
+		return FALSE;
+	if (beltDWPUnwrap_ws(buf, buf1, 16, beltH() + 16, 32, mac1,
+		beltH() + 128, 32, beltH() + 192, state) != ERR_OK ||
+		!memEq(buf, beltH(), 16))
+		return FALSE;
+	if (beltHash_ws(hash1, beltH(), 48, state) != ERR_OK ||
+		!hexEq(hash1,
+			"9D02EE446FB6A29FE5C982D4B13AF9D3"
+			"E90861BC4CEF27CF306BFB0B174A154A"))
+		return FALSE;
 	// belt-kwp: тест A.21
 	beltKWPStart(state, beltH() + 128, 32);
 	memCopy(buf, beltH(), 32);
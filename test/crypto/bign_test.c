@@ -4,12 +4,13 @@
 \brief Tests for STB 34.101.45 (bign)
 \project bee2/test
 \created 2012.08.27
-\version 2023.09.25
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
+#include <bee2/core/blob.h>
 #include <bee2/core/err.h>
 #include <bee2/core/mem.h>
 #include <bee2/core/hex.h>
@@ -133,9 +134,11 @@ bool_t bignTest()
 	word k[W_OF_O(32)];
 	word S0[W_OF_O(32)];
 	word S1[W_OF_O(32)];
+	void* ws;
 	char pwd[] = "B194BAC80A08F53B";
 	size_t iter = 10000;
 	octet key[32];
+	size_t pre_len;
 	// подготовить память
 	if (sizeof(brng_state) < brngCTRX_keep() ||
 		sizeof(zz_stack) < zzMulMod_deep(W_OF_O(32)))
@@ -160,6 +163,16 @@ bool_t bignTest()
 		bignParamsDec(params1, der, count) != ERR_OK ||
 		!memEq(params, params1, sizeof(bign_params)))
 		return FALSE;
+	// повторная проверка (кэш проверенных параметров)
+	memCopy(params1, params, sizeof(bign_params));
+	params1->b[0] ^= 1;
+	if (bignParamsVal(params) != ERR_OK ||
+		bignParamsVal(params1) == ERR_OK ||
+		bignParamsVal(params1) == ERR_OK ||
+		(params1->b[0] ^= 1, params1->seed[0] ^= 1,
+			bignParamsVal(params1) == ERR_OK) ||
+		bignParamsVal(params) != ERR_OK)
+		return FALSE;
 	// генерация таблицы Б.1
 	if (bignParamsStd(params1, "1.2.112.0.2.0.34.101.45.3.1") != ERR_OK)
 		return FALSE;
@@ -332,6 +345,23 @@ bool_t bignTest()
 		"7ADC8713283EBFA547A2AD9CDFB245AE"
 		"0F7B968DF0F91CB785D1F932A3583107"))
 		return FALSE;
+	// тест Г.7 [рабочая память]
+	ws = blobCreate(utilMax(3, bignSign2_keep(params->l), 
+		bignVerify_keep(params->l), bignDH_keep(params->l)));
+	if (ws == 0)
+		return FALSE;
+	if (bignSign2_ws(id_sig, params, der, count, hash, privkey,
+			beltH() + 128 + 64, 23, ws) != ERR_OK ||
+		!memEq(id_sig, sig, 48) ||
+		bignVerify_ws(params, der, count, hash, sig, pubkey, ws) != ERR_OK ||
+		bignDH_ws(id_sig, params, privkey, pubkey, 64, ws) != ERR_OK ||
+		bignDH(id_sig + 64, params, privkey, pubkey, 64) != ERR_OK ||
+		!memEq(id_sig, id_sig + 64, 64))
+	{
+		blobClose(ws);
+		return FALSE;
+	}
+	blobClose(ws);
 	// тест Г.9
 	if (beltHash(hash, beltH() + 32, 16) != ERR_OK)
 		return FALSE;
@@ -426,6 +456,48 @@ bool_t bignTest()
 		"E48329259BC1211DDAC2EF1DADFFC993"
 		"2702A92F1DD66C14A9BA1D7300C8713C"))
 		return FALSE;
+	// предвычисления
+	if (bignParamsStd(params, "1.2.112.0.2.0.34.101.45.3.1") != ERR_OK ||
+		bignParamsStd(params1, "1.2.112.0.2.0.34.101.45.3.2") != ERR_OK ||
+		bignPreCreate(0, &pre_len, params, 4) != ERR_OK ||
+		(ws = blobCreate(pre_len)) == 0)
+		return FALSE;
+	count = sizeof(der);
+	hexTo(privkey,
+		"1F66B5B84B7339674533F0329C74F218"
+		"34281FED0732429E0C79235FC273E269");
+	if (bignPreCreate(ws, &pre_len, params, 4) != ERR_OK ||
+		bignPreVal(params, ws, pre_len) != ERR_OK ||
+		bignPreVal(params1, ws, pre_len) == ERR_OK ||
+		bignOidToDER(der, &count, "1.2.112.0.2.0.34.101.31.81") != ERR_OK ||
+		beltHash(hash, beltH(), 13) != ERR_OK ||
+		bignSign2(token, params, der, count, hash, privkey, 0, 0) != ERR_OK ||
+		bignPreAttach(params, ws, pre_len) != ERR_OK ||
+		bignSign2(sig, params, der, count, hash, privkey, 0, 0) != ERR_OK ||
+		!memEq(sig, token, 48) ||
+		bignPubkeyCalc(pubkey, params, privkey) != ERR_OK ||
+		!hexEq(pubkey,
+			"BD1A5650179D79E03FCEE49D4C2BD5DD"
+			"F54CE46D0CF11E4FF87BF7A890857FD0"
+			"7AC6A60361E8C8173491686D461B2826"
+			"190C2EDA5909054A9AB84D2AB9D99A90") ||
+		bignVerify(params, der, count, hash, sig, pubkey) != ERR_OK ||
+		bignPreAttach(params, 0, 0) != ERR_OK)
+	{
+		blobClose(ws);
+		return FALSE;
+	}
+	((octet*)ws)[pre_len / 2] ^= 1;
+	if (bignPreVal(params, ws, pre_len) != ERR_BAD_HASH ||
+		bignPreAttach(params, ws, pre_len) != ERR_BAD_HASH ||
+		beltHash((octet*)ws + pre_len - 32, ws, pre_len - 32) != ERR_OK ||
+		bignPreVal(params, ws, pre_len) != ERR_BAD_POINT ||
+		bignPreAttach(params, ws, pre_len) != ERR_BAD_POINT)
+	{
+		blobClose(ws);
+		return FALSE;
+	}
+	blobClose(ws);
 	// все нормально
 	return TRUE;
 }
@@ -4,12 +4,13 @@
 \brief Tests for STB 34.101.47/botp
 \project bee2/test
 \created 2015.11.06
-\version 2023.03.29
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
+#include <bee2/core/err.h>
 #include <bee2/core/mem.h>
 #include <bee2/core/hex.h>
 #include <bee2/core/str.h>
@@ -36,12 +37,15 @@ bool_t botpTest()
 	char s_str[136];
 	tm_time_t t;
 	octet state[2048];
+	octet ws[2048];
 	// подготовить память
 	if (sizeof(state) < utilMax(3,
 		botpHOTP_keep(),
 		botpTOTP_keep(),
 		botpOCRA_keep()))
 		return FALSE;
+	if (sizeof(ws) < botpHOTP_keep())
+		return FALSE;
 	// HOTP.1
 	memCopy(ctr, beltH() + 192, 8); 
 	botpHOTPStart(state, 8, beltH() + 128, 32);
@@ -55,7 +59,12 @@ bool_t botpTest()
 		return FALSE;
 	botpHOTPRand(otp1, 8, beltH() + 128, 32, ctr);
 	if (!strEq(otp1, otp) ||
-		botpHOTPVerify(otp1, beltH() + 128, 32, ctr) != ERR_OK)
+		botpHOTPVerify(otp1, beltH() + 128, 32, ctr) != ERR_OK ||
+		botpHOTPVerify_ws(otp1, beltH() + 128, 32, ctr, ws) != ERR_OK)
+		return FALSE;
+	strCopy(otp2, otp1);
+	otp2[0] = otp2[0] == '0' ? '1' : '0';
+	if (botpHOTPVerify_ws(otp2, beltH() + 128, 32, ctr, ws) != ERR_BAD_PWD)
 		return FALSE;
 	// HOTP.2
 	botpHOTPStepR(otp2, state);
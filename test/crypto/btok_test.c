@@ -4,7 +4,7 @@
 \brief Tests for STB 34.101.79 (btok)
 \project bee2/test
 \created 2022.07.07
-\version 2023.12.19
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -260,6 +260,43 @@ static bool_t btokCVCTest()
 		btokCVCVal2(cvc2, cert2, cert2_len, cvc1, cvc0->until) == ERR_OK ||
 		btokCVCVal2(cvc3, cert3, cert3_len, cvc1, 0) != ERR_OK)
 		return FALSE;
+	// проверить сертификаты с кэшированием
+	{
+		size_t hits, misses;
+		if (btokCVCCacheStart(0) == ERR_OK ||
+			btokCVCCacheStart(2) != ERR_OK)
+			return FALSE;
+		if (btokCVCVal2(cvc1, cert1, cert1_len, cvc0, 0) != ERR_OK ||
+			btokCVCVal2(cvc2, cert2, cert2_len, cvc1, 0) != ERR_OK ||
+			btokCVCVal2(cvc1, cert1, cert1_len, cvc0, 0) != ERR_OK ||
+			btokCVCVal(cert2, cert2_len, cert1, cert1_len, 0) != ERR_OK ||
+			btokCVCVal2(cvc2, cert2, cert2_len, cvc1, cvc0->until) == ERR_OK ||
+			btokCVCVal2(cvc2, cert2, cert2_len, cvc0, 0) == ERR_OK)
+		{
+			btokCVCCacheStop();
+			return FALSE;
+		}
+		btokCVCCacheStat(&hits, &misses);
+		if (hits != 3 || misses != 3)
+		{
+			btokCVCCacheStop();
+			return FALSE;
+		}
+		// вытеснение
+		if (btokCVCVal2(cvc3, cert3, cert3_len, cvc1, 0) != ERR_OK ||
+			btokCVCVal2(cvc1, cert1, cert1_len, cvc0, 0) != ERR_OK)
+		{
+			btokCVCCacheStop();
+			return FALSE;
+		}
+		btokCVCCacheStat(&hits, &misses);
+		btokCVCCacheStop();
+		if (hits != 3 || misses != 5)
+			return FALSE;
+		btokCVCCacheStat(&hits, &misses);
+		if (hits != 0 || misses != 0)
+			return FALSE;
+	}
 	// все хорошо
 	return TRUE;
 }
@@ -4,7 +4,7 @@
 \brief Tests for DSTU 4145-2002 (Ukraine)
 \project bee2/test
 \created 2012.03.01
-\version 2024.02.29
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -55,6 +55,12 @@ bool_t dstuTest()
 	if (dstuParamsStd(params, "1.2.804.2.1.1.1.1.3.1.1.1.2.0") != ERR_OK ||
 		dstuParamsVal(params) != ERR_OK)
 		return FALSE;
+	params->B[0] ^= 1;
+	if (dstuParamsVal(params) == ERR_OK)
+		return FALSE;
+	params->B[0] ^= 1;
+	if (dstuParamsVal(params) != ERR_OK)
+		return FALSE;
 	// тест Б.1 [генерация ключей]
 	hexToRev(buf, 
 		"0183F60FDF7951FF47D67193F8D073790C1C"
@@ -0,0 +1,220 @@
+/*
+*******************************************************************************
+\file job_test.c
+\brief Tests for asynchronous cryptographic jobs
+\project bee2/test
+\created 2026.10.18
+\version 2026.10.18
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include <bee2/core/err.h>
+#include <bee2/core/mem.h>
+#include <bee2/core/mt.h>
+#include <bee2/core/hex.h>
+#include <bee2/core/util.h>
+#include <bee2/crypto/belt.h>
+#include <bee2/crypto/bign.h>
+#include <bee2/crypto/job.h>
+
+/*
+*******************************************************************************
+Тестирование
+
+Задания разных типов передаются в обработчик вперемешку, часть -- с
+функцией обратного вызова. Результаты сравниваются с результатами
+синхронных вызовов. Тест повторяется с подключенной таблицей кратных
+базовой точки.
+*******************************************************************************
+*/
+
+#define JOB_TEST_COUNT 32
+
+static void jobTestCallback(job_t* job, void* arg)
+{
+	mtAtomicIncr((size_t*)arg);
+}
+
+static bool_t jobTestEngine(size_t workers, size_t batch)
+{
+	bign_params params[1];
+	bign_params params1[1];
+	octet oid_der[16];
+	size_t oid_len = sizeof(oid_der);
+	octet privkey[32];
+	octet pubkey[64];
+	octet sig[48];
+	octet buf[64];
+	job_t jobs[JOB_TEST_COUNT];
+	octet outs[JOB_TEST_COUNT][64];
+	octet macs[JOB_TEST_COUNT][8];
+	size_t callbacks[1] = { SIZE_0 };
+	job_engine_t* engine;
+	job_stat_t stat[1];
+	size_t i;
+	bool_t ret = TRUE;
+	// подготовить параметры и ключи
+	if (bignParamsStd(params, "1.2.112.0.2.0.34.101.45.3.1") != ERR_OK ||
+		bignOidToDER(oid_der, &oid_len, "1.2.112.0.2.0.34.101.31.81") !=
+			ERR_OK)
+		return FALSE;
+	hexTo(privkey,
+		"1F66B5B84B7339674533F0329C74F218"
+		"34281FED0732429E0C79235FC273E269");
+	if (bignPubkeyCalc(pubkey, params, privkey) != ERR_OK ||
+		bignSign2(sig, params, oid_der, oid_len, beltH(), privkey, 0, 0) !=
+			ERR_OK)
+		return FALSE;
+	// создать обработчик
+	engine = jobEngineCreate(workers, batch);
+	if (engine == 0)
+		return FALSE;
+	// некорректные задания
+	memSetZero(jobs, sizeof(job_t));
+	if (jobSubmit(engine, jobs) != ERR_BAD_INPUT)
+		ret = FALSE;
+	memSetZero(params1, sizeof(bign_params));
+	jobs->type = JOB_BIGN_SIGN, jobs->params = params1;
+	if (jobSubmit(engine, jobs) != ERR_BAD_PARAMS)
+		ret = FALSE;
+	// передать задания
+	memSetZero(jobs, sizeof(jobs));
+	for (i = 0; ret && i < JOB_TEST_COUNT; ++i)
+	{
+		job_t* job = jobs + i;
+		job->params = params;
+		job->oid_der = oid_der, job->oid_len = oid_len;
+		job->hash = beltH();
+		job->privkey = privkey;
+		job->pubkey = pubkey;
+		job->key = beltH() + 128, job->key_len = 32;
+		job->iv = beltH() + 192;
+		job->src1 = beltH() + 32, job->count1 = i % 17;
+		job->src2 = beltH() + 64, job->count2 = i % 5;
+		job->dest = outs[i];
+		job->mac = macs[i];
+		switch (i % 5)
+		{
+		case 0:
+			job->type = JOB_BIGN_SIGN, job->sig = outs[i];
+			break;
+		case 1:
+			job->type = JOB_BIGN_VERIFY, job->sig = sig;
+			break;
+		case 2:
+			job->type = JOB_BIGN_DH, job->key_len = 32 + i;
+			break;
+		case 3:
+			job->type = JOB_BELT_DWP_WRAP;
+			break;
+		default:
+			job->type = JOB_BELT_CHE_WRAP;
+		}
+		if (i % 3 == 0)
+			job->callback = jobTestCallback, job->arg = callbacks;
+		if (jobSubmit(engine, job) != ERR_OK)
+			ret = FALSE;
+	}
+	// дождаться завершения
+	for (i = 0; ret && i < JOB_TEST_COUNT; ++i)
+		if (jobs[i].callback == 0)
+		{
+			while (i % 2 == 0 && !jobIsDone(jobs + i))
+				mtSleep(0);
+			jobWait(engine, jobs + i);
+		}
+	// статистика
+	jobEngineStat(stat, engine);
+	if (stat->jobs > JOB_TEST_COUNT || stat->batches > stat->jobs ||
+		stat->jobs && stat->batches == 0)
+		ret = FALSE;
+	jobEngineClose(engine);
+	if (!ret || *callbacks != (JOB_TEST_COUNT + 2) / 3)
+		return FALSE;
+	// проверить результаты
+	for (i = 0; i < JOB_TEST_COUNT; ++i)
+	{
+		const job_t* job = jobs + i;
+		if (job->code != ERR_OK)
+			return FALSE;
+		switch (job->type)
+		{
+		case JOB_BIGN_SIGN:
+			if (bignSign2(buf, params, oid_der, oid_len, beltH(), privkey,
+					job->src1, job->count1) != ERR_OK ||
+				!memEq(buf, outs[i], 48))
+				return FALSE;
+			break;
+		case JOB_BIGN_DH:
+			if (bignDH(buf, params, privkey, pubkey, job->key_len) != ERR_OK ||
+				!memEq(buf, outs[i], job->key_len))
+				return FALSE;
+			break;
+		case JOB_BELT_DWP_WRAP:
+			if (beltDWPUnwrap(buf, outs[i], job->count1, job->src2,
+					job->count2, macs[i], job->key, 32, job->iv) != ERR_OK ||
+				!memEq(buf, job->src1, job->count1))
+				return FALSE;
+			break;
+		case JOB_BELT_CHE_WRAP:
+			if (beltCHEUnwrap(buf, outs[i], job->count1, job->src2,
+					job->count2, macs[i], job->key, 32, job->iv) != ERR_OK ||
+				!memEq(buf, job->src1, job->count1))
+				return FALSE;
+			break;
+		}
+	}
+	// снятие защиты и испорченная подпись
+	engine = jobEngineCreate(workers, batch);
+	if (engine == 0)
+		return FALSE;
+	jobs[3].type = JOB_BELT_DWP_UNWRAP;
+	jobs[3].src1 = outs[3], jobs[3].dest = buf;
+	jobs[3].callback = 0;
+	memCopy(outs[1], sig, 48);
+	outs[1][47] ^= 1;
+	jobs[1].sig = outs[1];
+	if (jobSubmit(engine, jobs + 3) != ERR_OK ||
+		jobSubmit(engine, jobs + 1) != ERR_OK ||
+		jobWait(engine, jobs + 3) != ERR_OK ||
+		!memEq(buf, beltH() + 32, jobs[3].count1) ||
+		jobWait(engine, jobs + 1) != ERR_BAD_SIG)
+		ret = FALSE;
+	jobEngineClose(engine);
+	return ret;
+}
+
+static bool_t jobTestPre()
+{
+	bign_params params[1];
+	octet* pre;
+	size_t count;
+	bool_t ret;
+	// построить и подключить предвычисления
+	if (bignParamsStd(params, "1.2.112.0.2.0.34.101.45.3.1") != ERR_OK ||
+		bignPreCreate(0, &count, params, 4) != ERR_OK ||
+		!(pre = (octet*)memAlloc(count)))
+		return FALSE;
+	if (bignPreCreate(pre, &count, params, 4) != ERR_OK ||
+		bignPreAttach(params, pre, count) != ERR_OK)
+	{
+		memFree(pre);
+		return FALSE;
+	}
+	// задания выполняются с предвычислениями
+	ret = jobTestEngine(2, 0);
+	// отключить предвычисления
+	bignPreAttach(params, 0, 0);
+	memFree(pre);
+	return ret;
+}
+
+bool_t jobTest()
+{
+	return jobTestEngine(1, 1) &&
+		jobTestEngine(3, 4) &&
+		jobTestEngine(0, 0) &&
+		jobTestPre();
+}
@@ -4,13 +4,14 @@
 \brief Benchmarks for elliptic curves over prime fields
 \project bee2/test
 \created 2013.10.17
-\version 2023.09.22
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
 #include <stdio.h>
+#include <bee2/core/blob.h>
 #include <bee2/core/mem.h>
 #include <bee2/core/prng.h>
 #include <bee2/core/stack.h>
@@ -30,7 +31,9 @@ static size_t _ecpBench_deep(size_t n, size_t f_deep, size_t ec_d,
 	size_t ec_deep)
 {
 	return O_OF_W(3 * n) + prngCOMBO_keep() +
-		ecMulA_deep(n, ec_d, ec_deep, n);
+		utilMax(2,
+			ecMulA_deep(n, ec_d, ec_deep, n),
+			ecPreA_deep(n, ec_d, ec_deep));
 }
 
 bool_t ecpBench()
@@ -66,6 +69,7 @@ bool_t ecpBench()
 		size_t i;
 		tm_ticks_t ticks;
 		// эксперимент
+		qrProfReset(ec->f);
 		for (i = 0, ticks = tmTicks(); i < reps; ++i)
 		{
 			prngCOMBOStepR(d, ec->f->no, combo_state);
@@ -76,6 +80,46 @@ bool_t ecpBench()
 		printf("ecpBench: %u cycles/mulpoint [%u mulpoints/sec]\n", 
 			(unsigned)(ticks / reps),
 			(unsigned)tmSpeed(reps, ticks));
+#ifdef BEE2_PROFILE_QR
+		// стоимость в операциях поля
+		{
+			qr_prof_t prof[1];
+			qrProfGet(prof, ec->f);
+			printf("ecpBench: %u mul + %u sqr + %u inv + %u add "
+				"per mulpoint\n",
+				(unsigned)(prof->mul / reps), (unsigned)(prof->sqr / reps),
+				(unsigned)(prof->inv / reps), (unsigned)(prof->add / reps));
+		}
+#endif
+	}
+	// то же самое, но с таблицей предвычислений
+	{
+		const size_t reps = 1000;
+		size_t i;
+		tm_ticks_t ticks;
+		word* pre;
+		// построить таблицу
+		pre = (word*)blobCreate(ecPreA_keep(ec->f->n, 4, ec->f->n));
+		if (pre == 0)
+			return FALSE;
+		if (!ecPreA(pre, ec->base, ec, 4, ec->f->n, stack))
+		{
+			blobClose(pre);
+			return FALSE;
+		}
+		// эксперимент
+		for (i = 0, ticks = tmTicks(); i < reps; ++i)
+		{
+			prngCOMBOStepR(d, ec->f->no, combo_state);
+			ecMulPreA(pt, pre, 4, ec, d, ec->f->n, stack);
+		}
+		ticks = tmTicks() - ticks;
+		blobClose(pre);
+		// печать результатов
+		printf("ecpBench: %u cycles/mulpoint (precomputed, w = 4) "
+			"[%u mulpoints/sec]\n",
+			(unsigned)(ticks / reps),
+			(unsigned)tmSpeed(reps, ticks));
 	}
 	// все нормально
 	return TRUE;
@@ -4,7 +4,7 @@
 \brief Tests for elliptic curves over prime fields
 \project bee2/test
 \created 2017.05.29
-\version 2023.03.30
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -124,10 +124,23 @@ bool_t ecpTest()
 		ecpNegA(pts + 2 * n, pts + 2 * n, ec);
 		if (ecpAddAA(pts + 2 * n, pts, pts + 2 * n, ec, stack))
 			return FALSE;
-		// вычислить кратную точку
+		// вычислить кратную точку (с подсчетом операций)
+		qrProfReset(f), qrProfReset(0);
 		if (!ecMulA(pts + 2 * n, ec->base, ec, &d, 1, stack) ||
 			!memEq(pts, pts + 2 * n, 2 * n))
 			return FALSE;
+		{
+			qr_prof_t prof[2];
+			qrProfGet(prof, f), qrProfGet(prof + 1, 0);
+#ifdef BEE2_PROFILE_QR
+			if (prof->add == 0 || prof->mul == 0 || prof->sqr == 0 ||
+				prof->inv == 0 || !memEq(prof, prof + 1, sizeof(qr_prof_t)))
+				return FALSE;
+#else
+			if (!memIsZero(prof, sizeof(prof)))
+				return FALSE;
+#endif
+		}
 		// утроить напрямую
 		if (!ec->froma || !ec->tpl || !ec->toa)
 			return FALSE;
@@ -178,10 +191,23 @@ bool_t ecpTest()
 		ecpNegA(pts + 2 * n, pts + 2 * n, ec);
 		if (ecpAddAA(pts + 2 * n, pts, pts + 2 * n, ec, stack))
 			return FALSE;
-		// вычислить кратную точку
+		// вычислить кратную точку (с подсчетом операций)
+		qrProfReset(f), qrProfReset(0);
 		if (!ecMulA(pts + 2 * n, ec->base, ec, &d, 1, stack) ||
 			!memEq(pts, pts + 2 * n, 2 * n))
 			return FALSE;
+		{
+			qr_prof_t prof[2];
+			qrProfGet(prof, f), qrProfGet(prof + 1, 0);
+#ifdef BEE2_PROFILE_QR
+			if (prof->add == 0 || prof->mul == 0 || prof->sqr == 0 ||
+				prof->inv == 0 || !memEq(prof, prof + 1, sizeof(qr_prof_t)))
+				return FALSE;
+#else
+			if (!memIsZero(prof, sizeof(prof)))
+				return FALSE;
+#endif
+		}
 		// утроить напрямую
 		if (!ec->froma || !ec->tpl || !ec->toa)
 			return FALSE;
@@ -4,7 +4,7 @@
 \brief Bee2 testing
 \project bee2/test
 \created 2014.04.02
-\version 2023.12.19
+\version 2026.10.18
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -22,15 +22,19 @@
 extern bool_t apduTest();
 extern bool_t b64Test();
 extern bool_t blobTest();
+extern bool_t cacheTest();
 extern bool_t decTest();
 extern bool_t derTest();
 extern bool_t hexTest();
 extern bool_t memTest();
 extern bool_t mtTest();
+extern bool_t mtBench();
 extern bool_t objTest();
 extern bool_t oidTest();
+extern bool_t perfTest();
 extern bool_t prngTest();
 extern bool_t rngTest();
+extern bool_t rngBench();
 extern bool_t strTest();
 extern bool_t tmTest();
 extern bool_t u16Test();
@@ -45,15 +49,19 @@ int testCore()
 	printf("apduTest: %s\n", (code = apduTest()) ? "OK" : "Err"), ret |= !code;
 	printf("b64Test: %s\n", (code = b64Test()) ? "OK" : "Err"), ret |= !code;
 	printf("blobTest: %s\n", (code = blobTest()) ? "OK" : "Err"), ret |= !code;
+	printf("cacheTest: %s\n", (code = cacheTest()) ? "OK" : "Err"), ret |= !code;
 	printf("decTest: %s\n", (code = decTest()) ? "OK" : "Err"), ret |= !code;
 	printf("derTest: %s\n", (code = derTest()) ? "OK" : "Err"), ret |= !code;
 	printf("hexTest: %s\n", (code = hexTest()) ? "OK" : "Err"), ret |= !code;
 	printf("memTest: %s\n", (code = memTest()) ? "OK" : "Err"), ret |= !code;
 	printf("mtTest: %s\n", (code = mtTest()) ? "OK" : "Err"), ret |= !code;
+	code = mtBench(), ret |= !code;
 	printf("objTest: %s\n", (code = objTest()) ? "OK" : "Err"), ret |= !code;
 	printf("oidTest: %s\n", (code = oidTest()) ? "OK" : "Err"), ret |= !code;
+	printf("perfTest: %s\n", (code = perfTest()) ? "OK" : "Err"), ret |= !code;
 	printf("genTest: %s\n", (code = prngTest()) ? "OK" : "Err"), ret |= !code;
 	printf("rngTest: %s\n", (code = rngTest()) ? "OK" : "Err"), ret |= !code;
+	code = rngBench(), ret |= !code;
 	printf("strTest: %s\n", (code = strTest()) ? "OK" : "Err"), ret |= !code;
 	printf("tmTest: %s\n", (code = tmTest()) ? "OK" : "Err"), ret |= !code;
 	printf("u16Test: %s\n", (code = u16Test()) ? "OK" : "Err"), ret |= !code;
@@ -112,6 +120,7 @@ extern bool_t bpkiTest();
 extern bool_t btokTest();
 extern bool_t dstuTest();
 extern bool_t g12sTest();
+extern bool_t jobTest();
 extern bool_t pfokTest();
 extern bool_t pfokTestParamsStd();
 extern bool_t stb99Test();
@@ -135,6 +144,7 @@ int testCrypto()
 	printf("btokTest: %s\n", (code = btokTest()) ? "OK" : "Err"), ret |= !code;
 	printf("dstuTest: %s\n", (code = dstuTest()) ? "OK" : "Err"), ret |= !code;
 	printf("g12sTest: %s\n", (code = g12sTest()) ? "OK" : "Err"), ret |= !code;
+	printf("jobTest: %s\n", (code = jobTest()) ? "OK" : "Err"), ret |= !code;
 	printf("pfokTest: %s\n", (code = pfokTest()) ? "OK" : "Err"), ret |= !code;
 	printf("stb99Test: %s\n", (code = stb99Test()) ? "OK" : "Err"),
 		ret |= !code;